@@ -0,0 +1,38 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ofc_atom_h__
+#define __ofc_atom_h__
+
+#include <stdbool.h>
+
+/* Atoms are small integers which uniquely identify a case-folded
+   identifier, so two names are equal ignoring case exactly when their
+   atoms are equal. Zero is never a valid atom. */
+
+typedef unsigned ofc_atom_t;
+
+#define OFC_ATOM_NONE 0
+
+/* Returns the atom for a name, adding it to the table if needed,
+   or OFC_ATOM_NONE if it can't be added. Names are only interned when
+   they're parsed or created, this is safe to call from any thread. */
+ofc_atom_t ofc_atom(const char* base, unsigned size);
+
+/* The folded spelling of an atom, this isn't NUL terminated
+   but stays valid until the program exits. */
+const char* ofc_atom_name(ofc_atom_t atom, unsigned* size);
+
+#endif
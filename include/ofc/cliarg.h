@@ -37,6 +37,7 @@ typedef enum
 	OFC_CLIARG_NO_WARN_PEDANTIC,
 	OFC_CLIARG_PARSE_ONLY,
 	OFC_CLIARG_PARSE_TREE,
+	OFC_CLIARG_PARSE_STATS,
 	OFC_CLIARG_SEMA_TREE,
 	OFC_CLIARG_FIXED_FORM,
 	OFC_CLIARG_FREE_FORM,
@@ -57,6 +58,14 @@ typedef enum
 	OFC_CLIARG_SEMA_UNUSED_DECL,
 	OFC_CLIARG_NO_ESCAPE,
 	OFC_CLIARG_COMMON_USAGE,
+	OFC_CLIARG_STORAGE_LAYOUT,
+	OFC_CLIARG_COMMON_INDEX,
+	OFC_CLIARG_OUTPUT_DIR,
+	OFC_CLIARG_CALL_GRAPH,
+	OFC_CLIARG_JOBS,
+	OFC_CLIARG_CFG,
+	OFC_CLIARG_DATAFLOW,
+	OFC_CLIARG_STREAM,
 
 	OFC_CLIARG_INVALID
 } ofc_cliarg_e;
@@ -64,6 +73,8 @@ typedef enum
 typedef enum
 {
 	OFC_CLIARG_PARAM_GLOB_NONE = 0,
+	OFC_CLIARG_PARAM_GLOB_STR,
+	OFC_CLIARG_PARAM_GLOB_INT,
 	OFC_CLIARG_PARAM_PRIN_NONE,
 	OFC_CLIARG_PARAM_PRIN_INT,
 	OFC_CLIARG_PARAM_LANG_NONE,
@@ -24,6 +24,12 @@ typedef struct ofc_colstr_s ofc_colstr_t;
 ofc_colstr_t* ofc_colstr_create(
 	const ofc_print_opts_t print_opts,
 	unsigned cols, unsigned ext);
+
+/* Completed lines are written to fd in large chunks as they're printed,
+   ofc_colstr_fdprint must still be called to write out the remainder. */
+ofc_colstr_t* ofc_colstr_create_fd(
+	const ofc_print_opts_t print_opts,
+	unsigned cols, unsigned ext, int fd);
 void ofc_colstr_delete(ofc_colstr_t* cstr);
 
 bool ofc_colstr_newline(
@@ -51,12 +57,24 @@ bool ofc_colstr_writef(
 bool ofc_colstr_atomic_write(
 	ofc_colstr_t* cstr, const char* base, unsigned size);
 
+bool ofc_colstr_atomic_write_str(
+	ofc_colstr_t* cstr, const char* str);
+bool ofc_colstr_atomic_write_char(
+	ofc_colstr_t* cstr, char c);
+bool ofc_colstr_atomic_write_unsigned(
+	ofc_colstr_t* cstr, unsigned value);
+
 bool ofc_colstr_atomic_writef(
 	ofc_colstr_t* cstr,
 	const char* format, ...);
 
 bool ofc_colstr_fdprint(ofc_colstr_t* cstr, int fd);
 
+/* Totals of everything written to a file descriptor so far. */
+void ofc_colstr_written(
+	const ofc_colstr_t* cstr,
+	unsigned long* bytes, unsigned long* lines);
+
 
 const ofc_print_opts_t* ofc_colstr_print_opts_get(const ofc_colstr_t* cstr);
 
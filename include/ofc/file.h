@@ -72,6 +72,8 @@ void ofc_file_include_list_delete(
 #include <stdarg.h>
 
 bool ofc_file_no_errors(void);
+/* Errors and warnings reported so far, including suppressed warnings. */
+unsigned ofc_file_diagnostic_count(void);
 
 void ofc_file_error(
 	const ofc_file_t* file, const char* ptr,
@@ -28,9 +28,24 @@ typedef struct
 	bool no_warn_namespace_col;
 	bool parse_only;
 	bool parse_print;
+	bool parse_stats;
 	bool sema_print;
 	bool no_escape;
 	bool common_usage_print;
+	bool storage_layout_print;
+	bool common_index_print;
+	bool call_graph_print;
+	bool cfg_print;
+	bool dataflow_warn;
+
+	/* Analyse and print each program unit as soon as it's parsed. */
+	bool stream;
+
+	/* Threads used for whole program analysis, zero for one per CPU. */
+	unsigned jobs;
+
+	/* Write the reprinted source of each file under this directory. */
+	char* output_dir;
 } ofc_global_opts_t;
 
 static const ofc_global_opts_t
@@ -44,9 +59,18 @@ static const ofc_global_opts_t
 	.no_warn_namespace_col = false,
 	.parse_only            = false,
 	.parse_print           = false,
+	.parse_stats           = false,
 	.sema_print            = false,
 	.common_usage_print    = false,
+	.storage_layout_print  = false,
+	.common_index_print    = false,
+	.call_graph_print      = false,
+	.cfg_print             = false,
+	.dataflow_warn         = false,
+	.stream                = false,
+	.jobs                  = 0,
 	.no_escape             = false,
+	.output_dir            = NULL,
 };
 
 extern ofc_global_opts_t global_opts;
@@ -52,5 +52,6 @@ typedef struct ofc_parse_lhs_implicit_do_s  ofc_parse_lhs_implicit_do_t;
 #include <ofc/parse/pointer.h>
 #include <ofc/parse/stmt.h>
 #include <ofc/parse/file.h>
+#include <ofc/parse/memo.h>
 
 #endif
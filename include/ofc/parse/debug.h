@@ -19,10 +19,15 @@
 #include <ofc/sparse.h>
 
 typedef struct ofc_parse_debug_s ofc_parse_debug_t;
+typedef struct ofc_parse_memo_s ofc_parse_memo_t;
 
 ofc_parse_debug_t* ofc_parse_debug_create(void);
 void ofc_parse_debug_delete(ofc_parse_debug_t* stack);
 
+/* The debug stack is passed to every parser, so it also carries
+   the table of memoized parses for the current statement. */
+ofc_parse_memo_t* ofc_parse_debug_memo(ofc_parse_debug_t* stack);
+
 unsigned ofc_parse_debug_position(const ofc_parse_debug_t* stack);
 void ofc_parse_debug_rewind(ofc_parse_debug_t* stack, unsigned position);
 
@@ -30,6 +35,8 @@ void ofc_parse_debug_print(const ofc_parse_debug_t* stack);
 
 #include <stdarg.h>
 
+/* Formatting is deferred until the message is printed, so any pointer
+   arguments must remain valid for the lifetime of the stack. */
 void ofc_parse_debug_warning(
 	ofc_parse_debug_t* stack,
 	ofc_sparse_ref_t ref,
@@ -33,7 +33,7 @@ struct ofc_parse_expr_s
 {
 	ofc_parse_expr_e type;
 
-	ofc_sparse_ref_t src;
+	ofc_sparse_loc_t src;
 
 	union
 	{
@@ -22,6 +22,16 @@ typedef struct
 {
 	ofc_sparse_t*          source;
 	ofc_parse_stmt_list_t* stmt;
+
+	/* State of a file which is parsed one program unit at a time. */
+	ofc_parse_debug_t* debug;
+	unsigned           offset;
+	unsigned           stage;
+
+	/* Included source is kept after its statements are released,
+	   since diagnostics and the semantic tree still refer to it. */
+	unsigned       include_count;
+	ofc_sparse_t** include;
 } ofc_parse_file_t;
 
 bool ofc_parse_file_include(
@@ -32,6 +42,12 @@ bool ofc_parse_file_include(
 ofc_parse_file_t* ofc_parse_file(ofc_sparse_t* src);
 void ofc_parse_file_delete(ofc_parse_file_t* file);
 
+/* Creates a file with an empty statement list, each call to
+   ofc_parse_file_next replaces the list with the statements of the
+   next program unit, and it's left empty at the end of the file. */
+ofc_parse_file_t* ofc_parse_file_stream(ofc_sparse_t* src);
+bool ofc_parse_file_next(ofc_parse_file_t* file);
+
 bool ofc_parse_file_print(
 	ofc_colstr_t* cs,
 	const ofc_parse_file_t* file);
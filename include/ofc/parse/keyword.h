@@ -131,6 +131,10 @@ ofc_sparse_ref_t* ofc_parse_name_alloc(
 const char* ofc_parse_keyword_name(
 	ofc_parse_keyword_e keyword);
 
+/* Cheap test of whether ptr could start with keyword, it never warns. */
+bool ofc_parse_keyword_begins(
+	const char* ptr, ofc_parse_keyword_e keyword);
+
 unsigned ofc_parse_keyword(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug,
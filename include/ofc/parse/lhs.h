@@ -36,7 +36,7 @@ struct ofc_parse_lhs_s
 {
 	ofc_parse_lhs_e type;
 
-	ofc_sparse_ref_t src;
+	ofc_sparse_loc_t src;
 
 	union
 	{
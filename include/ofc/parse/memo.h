@@ -0,0 +1,59 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ofc_parse_memo_h__
+#define __ofc_parse_memo_h__
+
+/* Results of expression and lhs parses within a single statement,
+   keyed by parser and source position, so that when a statement parser
+   backtracks the same text isn't parsed again by the next attempt. */
+
+typedef enum
+{
+	OFC_PARSE_MEMO_EXPR = 0,
+	OFC_PARSE_MEMO_EXPR_NO_SLASH,
+	OFC_PARSE_MEMO_LHS,
+	OFC_PARSE_MEMO_LHS_STAR_LEN,
+	OFC_PARSE_MEMO_LHS_VARIABLE,
+
+	OFC_PARSE_MEMO_COUNT
+} ofc_parse_memo_e;
+
+ofc_parse_memo_t* ofc_parse_memo_create(void);
+void ofc_parse_memo_delete(ofc_parse_memo_t* memo);
+
+/* Forget every result, called at the start of each statement. */
+void ofc_parse_memo_reset(ofc_parse_memo_t* memo);
+
+/* Returns true if there's a result for this parse, *result is then set
+   to a copy owned by the caller or NULL if the parse failed. */
+bool ofc_parse_memo_find(
+	ofc_parse_memo_t* memo,
+	ofc_parse_memo_e kind, const char* ptr,
+	void** result, unsigned* len);
+
+/* Records the result of a parse, a successful result is copied.
+   Parses which left debug messages on the stack can't be replayed
+   so they're never stored. */
+void ofc_parse_memo_store(
+	ofc_parse_memo_t* memo,
+	ofc_parse_memo_e kind, const char* ptr,
+	const void* result, unsigned len,
+	bool replayable);
+
+void ofc_parse_memo_print_stats(
+	const ofc_parse_memo_t* memo);
+
+#endif
@@ -99,7 +99,7 @@ struct ofc_parse_stmt_s
 
 	unsigned label;
 
-	ofc_sparse_ref_t src;
+	ofc_sparse_loc_t src;
 
 	union
 	{
@@ -56,6 +56,8 @@ ofc_parse_type_t* ofc_parse_type(
 	unsigned* len);
 void ofc_parse_type_delete(ofc_parse_type_t* type);
 
+bool ofc_parse_type_begins(const char* ptr);
+
 bool ofc_parse_type_print(
 	ofc_colstr_t* cs, const ofc_parse_type_t* type, bool colons);
 bool ofc_parse_type_print_f77(
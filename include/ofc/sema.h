@@ -45,10 +45,12 @@ typedef struct ofc_sema_format_label_list_s ofc_sema_format_label_list_t;
 #include <ofc/sema/parameter.h>
 #include <ofc/sema/equiv.h>
 #include <ofc/sema/common.h>
+#include <ofc/sema/name_index.h>
 #include <ofc/sema/format.h>
 #include <ofc/sema/label.h>
 #include <ofc/sema/intrinsic.h>
 #include <ofc/sema/io.h>
+#include <ofc/sema/io_spec.h>
 #include <ofc/sema/arg.h>
 
 #include <ofc/sema/stmt.h>
@@ -59,6 +61,11 @@ typedef struct ofc_sema_format_label_list_s ofc_sema_format_label_list_t;
 #include <ofc/sema/implicit.h>
 #include <ofc/sema/scope.h>
 #include <ofc/sema/module.h>
+#include <ofc/sema/storage.h>
+#include <ofc/sema/ir.h>
+#include <ofc/sema/call_graph.h>
+#include <ofc/sema/cfg.h>
+#include <ofc/sema/dataflow.h>
 
 #include <ofc/sema/pass.h>
 
@@ -21,11 +21,22 @@ typedef struct
 {
 	ofc_sema_expr_t* first;
 	ofc_sema_expr_t* last;
+
+	/* Only valid when the array shape is constant. */
+	int      base;
+	unsigned count;
+	unsigned stride;
 } ofc_sema_array_dims_t;
 
 typedef struct
 {
-	unsigned              dimensions;
+	unsigned dimensions;
+
+	/* Set when every bound resolved to a constant on creation,
+	   the resolved shape is then used instead of the expressions. */
+	bool     constant;
+	unsigned total;
+
 	ofc_sema_array_dims_t segment[0];
 } ofc_sema_array_t;
 
@@ -50,6 +61,13 @@ bool ofc_sema_array_total(
 	const ofc_sema_array_t* array,
 	unsigned* total);
 
+/* Writes the index of count consecutive elements starting at offset,
+   index must have room for (count * dimensions) values. */
+bool ofc_sema_array_index_range(
+	const ofc_sema_array_t* array,
+	unsigned offset, unsigned count,
+	int* index);
+
 bool ofc_sema_array_print(
 	ofc_colstr_t* cs,
 	const ofc_sema_array_t* array);
@@ -88,6 +106,8 @@ ofc_sema_array_index_t* ofc_sema_array_index_copy(
 void ofc_sema_array_index_delete(
 	ofc_sema_array_index_t* index);
 
+ofc_sema_array_index_t* ofc_sema_array_index_from_int(
+	unsigned dimensions, const int* index);
 ofc_sema_array_index_t* ofc_sema_array_index_from_offset(
 	const ofc_sema_decl_t* decl, unsigned offset);
 
@@ -0,0 +1,136 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ofc_sema_call_graph_h__
+#define __ofc_sema_call_graph_h__
+
+/* Calls between every procedure in all the files of a run, so that
+   checks which need to see both sides of a call can be made. */
+
+typedef struct
+{
+	/* Location of the call, or of the procedure name where it's
+	   only passed as an argument. */
+	ofc_sparse_loc_t            src;
+	const ofc_sema_decl_t*      decl;
+	const ofc_sema_expr_list_t* args;
+
+	/* Index of the called node, or the node count if it's external. */
+	unsigned callee;
+
+	/* Procedures passed as arguments are treated as being called. */
+	bool is_reference;
+	bool is_entry;
+	bool args_counted;
+} ofc_sema_call_graph_site_t;
+
+typedef struct
+{
+	const ofc_sema_type_t* type;
+	bool                   is_array;
+	bool                   is_constant;
+	bool                   alt_return;
+} ofc_sema_call_graph_arg_t;
+
+typedef struct
+{
+	ofc_sema_scope_t* scope;
+
+	/* Dummy arguments, these start at arg_first in the graph arg table,
+	   the actual arguments of each site follow those of the nodes. */
+	unsigned arg_first;
+	unsigned arg_count;
+	bool     has_args;
+
+	/* Directly referenced COMMON blocks, as sorted atoms. */
+	unsigned common_first;
+	unsigned common_count;
+
+	unsigned scc;
+	bool     reachable;
+} ofc_sema_call_graph_node_t;
+
+typedef enum
+{
+	OFC_SEMA_CALL_GRAPH_DIAG_ARG_COUNT,
+	OFC_SEMA_CALL_GRAPH_DIAG_ARG_TYPE,
+	OFC_SEMA_CALL_GRAPH_DIAG_ARG_RANK,
+} ofc_sema_call_graph_diag_e;
+
+typedef struct
+{
+	ofc_sema_call_graph_diag_e type;
+	unsigned                   site;
+	unsigned                   arg;
+} ofc_sema_call_graph_diag_t;
+
+typedef struct
+{
+	/* Range of the scc_node table. */
+	unsigned first;
+	unsigned count;
+
+	bool recursive;
+
+	/* COMMON blocks used by the SCC or anything it calls. */
+	unsigned    common_count;
+	ofc_atom_t* common;
+
+	unsigned                    diag_count;
+	ofc_sema_call_graph_diag_t* diag;
+} ofc_sema_call_graph_scc_t;
+
+typedef struct
+{
+	unsigned                    node_count;
+	ofc_sema_call_graph_node_t* node;
+
+	/* Sites are stored in compressed row form, the calls made by node i
+	   are site[site_first[i]] up to site[site_first[i + 1]]. */
+	unsigned*                   site_first;
+	ofc_sema_call_graph_site_t* site;
+	unsigned*                   site_arg_first;
+
+	unsigned                   arg_count;
+	ofc_sema_call_graph_arg_t* arg;
+
+	unsigned    common_count;
+	ofc_atom_t* common;
+
+	/* Strongly connected components, numbered so that every SCC comes
+	   after all of the SCCs it calls. */
+	unsigned                   scc_count;
+	ofc_sema_call_graph_scc_t* scc;
+	unsigned*                  scc_node;
+} ofc_sema_call_graph_t;
+
+ofc_sema_call_graph_t* ofc_sema_call_graph_create(
+	ofc_sema_scope_t* super);
+void ofc_sema_call_graph_delete(
+	ofc_sema_call_graph_t* graph);
+
+/* Computes the summary of each SCC bottom-up, independent SCCs are
+   handled in parallel by up to jobs threads, zero uses one per CPU. */
+bool ofc_sema_call_graph_analyse(
+	ofc_sema_call_graph_t* graph, unsigned jobs);
+
+/* Reports what analyse found, returns the number of warnings. */
+unsigned ofc_sema_call_graph_warn(
+	const ofc_sema_call_graph_t* graph);
+
+bool ofc_sema_call_graph_print(
+	const ofc_sema_call_graph_t* graph);
+
+#endif
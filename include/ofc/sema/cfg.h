@@ -0,0 +1,85 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __ofc_sema_cfg_h__
+#define __ofc_sema_cfg_h__
+
+#include <stdint.h>
+
+/* Control flow graph of the statements in a single scope. Blocks are
+   numbered with 32-bit ids, edges are held in compressed row form,
+   and the dominator tree is computed when the graph is created. */
+
+#define OFC_SEMA_CFG_ENTRY 0
+#define OFC_SEMA_CFG_EXIT  1
+#define OFC_SEMA_CFG_NONE  UINT32_MAX
+
+typedef struct
+{
+	const ofc_sema_stmt_t* stmt;
+	uint32_t               block;
+} ofc_sema_cfg_index_t;
+
+typedef struct
+{
+	uint32_t block_count;
+	uint32_t stmt_count;
+
+	/* The statements of block b are stmt[stmt_first[b]]
+	   up to stmt[stmt_first[b + 1]], entry and exit are empty. */
+	uint32_t*               stmt_first;
+	const ofc_sema_stmt_t** stmt;
+
+	uint32_t* succ_first;
+	uint32_t* succ;
+	uint32_t* pred_first;
+	uint32_t* pred;
+
+	/* Immediate dominator of each block, the entry block is its own
+	   and blocks which can't be reached from entry have none. */
+	uint32_t* idom;
+
+	/* Preorder and postorder numbers in the dominator tree,
+	   so that dominance can be tested in constant time. */
+	uint32_t* dom_pre;
+	uint32_t* dom_post;
+
+	/* Block of each statement, sorted by statement address. */
+	ofc_sema_cfg_index_t* index;
+} ofc_sema_cfg_t;
+
+ofc_sema_cfg_t* ofc_sema_cfg_create(
+	const ofc_sema_scope_t* scope);
+void ofc_sema_cfg_delete(
+	ofc_sema_cfg_t* cfg);
+
+static inline bool ofc_sema_cfg_reachable(
+	const ofc_sema_cfg_t* cfg, uint32_t block)
+	{ return (cfg->idom[block] != OFC_SEMA_CFG_NONE); }
+
+/* Returns true if every path from entry to b passes through a. */
+bool ofc_sema_cfg_dominates(
+	const ofc_sema_cfg_t* cfg, uint32_t a, uint32_t b);
+
+/* Returns the block holding a statement, or OFC_SEMA_CFG_NONE. */
+uint32_t ofc_sema_cfg_block(
+	const ofc_sema_cfg_t* cfg,
+	const ofc_sema_stmt_t* stmt);
+
+bool ofc_sema_cfg_print(
+	const ofc_sema_cfg_t* cfg);
+
+#endif
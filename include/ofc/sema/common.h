@@ -70,4 +70,57 @@ bool ofc_sema_common_map_print(
 	ofc_colstr_t* cs,
 	unsigned indent,
 	const ofc_sema_common_map_t* map);
+
+
+/* Index of COMMON block layouts across every program unit and file
+   in a run, each distinct member layout of a block is kept once. */
+
+typedef struct
+{
+	char*    signature;
+	uint64_t hash;
+	unsigned size;
+
+	/* Number of program units which use this layout,
+	   and the first of them. */
+	unsigned units;
+	char*    unit;
+	char*    path;
+} ofc_sema_common_layout_t;
+
+typedef struct
+{
+	char*         name_strz;
+	ofc_str_ref_t name;
+
+	unsigned                  count;
+	ofc_sema_common_layout_t* layout;
+} ofc_sema_common_index_entry_t;
+
+typedef struct
+{
+	ofc_hashmap_t* map;
+
+	unsigned                        count;
+	ofc_sema_common_index_entry_t** entry;
+} ofc_sema_common_index_t;
+
+ofc_sema_common_index_t* ofc_sema_common_index_create(
+	bool case_sensitive);
+void ofc_sema_common_index_delete(
+	ofc_sema_common_index_t* index);
+
+/* Adds every COMMON block in scope and its child scopes, warns where a
+   named block differs from the layout it was first declared with. */
+bool ofc_sema_common_index_add_scope(
+	ofc_sema_common_index_t* index,
+	const char* path,
+	const ofc_sema_scope_t* scope);
+
+/* Number of blocks with more than one layout. */
+unsigned ofc_sema_common_index_mismatch_count(
+	const ofc_sema_common_index_t* index);
+
+bool ofc_sema_common_index_print(
+	const ofc_sema_common_index_t* index);
 #endif
@@ -0,0 +1,103 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __ofc_sema_dataflow_h__
+#define __ofc_sema_dataflow_h__
+
+#include <stdint.h>
+
+/* Iterative bit-vector dataflow over the blocks of a control flow graph.
+   A problem gives the effect of each statement on a set of bits, which
+   is composed into sparse gen and kill sets for each block, then the
+   dense sets are solved to a fixed point in reverse postorder. */
+
+#define OFC_SEMA_BITSET_WORDS(bits) (((bits) + 63) >> 6)
+
+static inline bool ofc_sema_bitset_test(
+	const uint64_t* set, uint32_t bit)
+	{ return ((set[bit >> 6] >> (bit & 63)) & 1); }
+static inline void ofc_sema_bitset_set(
+	uint64_t* set, uint32_t bit)
+	{ set[bit >> 6] |= (1ULL << (bit & 63)); }
+static inline void ofc_sema_bitset_clear(
+	uint64_t* set, uint32_t bit)
+	{ set[bit >> 6] &= ~(1ULL << (bit & 63)); }
+
+/* A statement sets the gen bits after clearing the kill bits. */
+typedef struct
+{
+	uint32_t  gen_count, gen_max;
+	uint32_t* gen;
+	uint32_t  kill_count, kill_max;
+	uint32_t* kill;
+} ofc_sema_dataflow_effect_t;
+
+bool ofc_sema_dataflow_effect_gen(
+	ofc_sema_dataflow_effect_t* effect, uint32_t bit);
+bool ofc_sema_dataflow_effect_kill(
+	ofc_sema_dataflow_effect_t* effect, uint32_t bit);
+void ofc_sema_dataflow_effect_apply(
+	const ofc_sema_dataflow_effect_t* effect, uint64_t* set);
+
+typedef bool (*ofc_sema_dataflow_effect_f)(
+	const ofc_sema_stmt_t* stmt,
+	ofc_sema_dataflow_effect_t* effect,
+	void* param);
+
+typedef struct
+{
+	const ofc_sema_cfg_t* cfg;
+
+	bool     forward;
+	bool     intersect;
+	uint32_t bits, words;
+
+	/* Composed effect of each block, in compressed row form. */
+	uint32_t* gen_first;
+	uint32_t* gen;
+	uint32_t* kill_first;
+	uint32_t* kill;
+
+	/* Value flowing into entry, or into exit when solving backward. */
+	uint64_t* boundary;
+
+	/* Value leaving each block in the direction of flow. */
+	uint64_t* out;
+
+	/* Number of block transfers needed to reach the fixed point. */
+	unsigned long visits;
+} ofc_sema_dataflow_t;
+
+/* Solves the problem, a NULL boundary is the empty set. */
+ofc_sema_dataflow_t* ofc_sema_dataflow_create(
+	const ofc_sema_cfg_t* cfg, uint32_t bits,
+	bool forward, bool intersect,
+	const uint64_t* boundary,
+	ofc_sema_dataflow_effect_f func, void* param);
+void ofc_sema_dataflow_delete(
+	ofc_sema_dataflow_t* dataflow);
+
+/* Sets set to the value entering a block in the direction of flow. */
+void ofc_sema_dataflow_in(
+	const ofc_sema_dataflow_t* dataflow,
+	uint32_t block, uint64_t* set);
+
+/* Warns about local variables which may be used before they're set
+   and about assigned values which are never used. */
+bool ofc_sema_dataflow_warn(
+	const ofc_sema_scope_t* scope);
+
+#endif
@@ -140,7 +140,7 @@ bool ofc_sema_decl_type_finalize(
 bool ofc_sema_decl_array_set(
 	ofc_sema_decl_t*  decl,
 	ofc_sema_array_t* array,
-	ofc_sparse_ref_t  err_pos);
+	ofc_sparse_loc_t  err_pos);
 
 bool ofc_sema_decl_is_final(
 	const ofc_sema_decl_t* decl);
@@ -280,6 +280,9 @@ bool ofc_sema_decl_print_name(ofc_colstr_t* cs,
 bool ofc_sema_decl_list_stmt_func_print(
 	ofc_colstr_t* cs, unsigned indent,
 	const ofc_sema_decl_list_t* decl_list);
+bool ofc_sema_decl_procedure_print(
+	ofc_colstr_t* cs, unsigned indent,
+	const ofc_sema_decl_t* decl);
 bool ofc_sema_decl_list_procedure_print(
 	ofc_colstr_t* cs, unsigned indent,
 	const ofc_sema_decl_list_t* decl_list);
@@ -52,7 +52,7 @@ struct ofc_sema_expr_s
 {
 	ofc_sema_expr_e type;
 
-	ofc_sparse_ref_t src;
+	ofc_sparse_loc_t src;
 
 	ofc_sema_typeval_t* constant;
 	ofc_sema_label_t*   label;
@@ -65,6 +65,10 @@ struct ofc_sema_expr_s
 	bool is_label;
 	bool is_format;
 
+	/* Cached result of ofc_sema_expr_elem_count. */
+	bool     elem_count_valid;
+	unsigned elem_count;
+
 	union
 	{
 		ofc_sema_lhs_t* lhs;
@@ -109,6 +113,22 @@ struct ofc_sema_expr_list_s
 {
 	unsigned          count;
 	ofc_sema_expr_t** expr;
+
+	/* Lazily built prefix sums of the element count (including repeats)
+	   of each entry, has count + 1 entries or is NULL. */
+	unsigned* elem_offset;
+};
+
+/* The values of the integer iterators of the enclosing implicit DO loops
+   for a single iteration, used to evaluate elements of an implicit DO
+   lazily rather than by copying the loop body for every iteration. */
+typedef struct ofc_sema_expr_bind_s ofc_sema_expr_bind_t;
+
+struct ofc_sema_expr_bind_s
+{
+	const ofc_sema_decl_t*      iter;
+	int                         value;
+	const ofc_sema_expr_bind_t* next;
 };
 
 ofc_sema_expr_t* ofc_sema_expr(
@@ -162,6 +182,9 @@ bool ofc_sema_expr_elem_count(
 	unsigned* count);
 ofc_sema_expr_t* ofc_sema_expr_elem_get(
 	const ofc_sema_expr_t* expr, unsigned offset);
+ofc_sema_expr_t* ofc_sema_expr_elem_get_bind(
+	const ofc_sema_expr_t* expr, unsigned offset,
+	const ofc_sema_expr_bind_t* bind);
 
 bool ofc_sema_expr_compare(
 	const ofc_sema_expr_t* a,
@@ -185,6 +208,11 @@ uint8_t ofc_sema_expr_hash(
 
 const ofc_sema_type_t* ofc_sema_expr_type(
 	const ofc_sema_expr_t* expr);
+/* Result type of an operator given the types of its operands. */
+const ofc_sema_type_t* ofc_sema_expr_type_operator(
+	ofc_sema_expr_e op,
+	const ofc_sema_type_t* a,
+	const ofc_sema_type_t* b);
 bool ofc_sema_expr_type_is_character(
 	const ofc_sema_expr_t* expr);
 bool ofc_sema_expr_type_is_integer(
@@ -205,6 +233,19 @@ bool ofc_sema_expr_resolve_int(
 	const ofc_sema_expr_t* expr,
 	int* value);
 
+const ofc_sema_expr_bind_t* ofc_sema_expr_bind_find(
+	const ofc_sema_expr_bind_t* bind,
+	const ofc_sema_decl_t* iter);
+ofc_sema_expr_t* ofc_sema_expr_bind_value(
+	const ofc_sema_expr_bind_t* bind);
+bool ofc_sema_expr_resolve_int_bind(
+	const ofc_sema_expr_t* expr,
+	const ofc_sema_expr_bind_t* bind,
+	int* value);
+ofc_sema_expr_t* ofc_sema_expr_copy_bind(
+	const ofc_sema_expr_t* expr,
+	const ofc_sema_expr_bind_t* bind);
+
 
 ofc_sema_expr_list_t* ofc_sema_expr_list(
 	ofc_sema_scope_t*            scope,
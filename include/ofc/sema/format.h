@@ -40,4 +40,25 @@ ofc_parse_format_desc_t* ofc_sema_format_desc_set_def(
 	const ofc_parse_format_desc_t* desc,
 	const ofc_sema_expr_t* expr,
 	const ofc_sema_lhs_t* lhs);
+
+/* FORMAT lists are interned so that one which is repeated through a
+   program is stored once and only validated again if it produced
+   diagnostics, every reference must be released. */
+typedef struct ofc_sema_format_intern_s ofc_sema_format_intern_t;
+
+ofc_sema_format_intern_t* ofc_sema_format_intern(
+	const ofc_parse_format_desc_list_t* format);
+void ofc_sema_format_release(
+	ofc_sema_format_intern_t* intern);
+const ofc_parse_format_desc_list_t* ofc_sema_format_intern_list(
+	const ofc_sema_format_intern_t* intern);
+
+/* IO list type signatures which have been checked against a list
+   without diagnostics, so they don't need to be checked again. */
+bool ofc_sema_format_intern_checked(
+	const ofc_sema_format_intern_t* intern, bool input,
+	const ofc_sema_type_t** type, unsigned count);
+void ofc_sema_format_intern_check_add(
+	ofc_sema_format_intern_t* intern, bool input,
+	const ofc_sema_type_t** type, unsigned count);
 #endif
@@ -24,7 +24,7 @@ const ofc_sema_intrinsic_t* ofc_sema_intrinsic(
 	ofc_str_ref_t name, bool case_sensitive);
 
 ofc_sema_expr_list_t* ofc_sema_intrinsic_cast(
-	ofc_sparse_ref_t src,
+	ofc_sparse_loc_t src,
 	const ofc_sema_intrinsic_t* intrinsic,
 	const ofc_sema_expr_list_t* args);
 
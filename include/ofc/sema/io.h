@@ -41,6 +41,11 @@ typedef enum
 	OFC_SEMA_CALL_ARG_ADVANCE_NO,
 	OFC_SEMA_CALL_ARG_KEEP,
 	OFC_SEMA_CALL_ARG_DELETE,
+	OFC_SEMA_CALL_ARG_UNKNOWN,
+	OFC_SEMA_CALL_ARG_REPLACE,
+	OFC_SEMA_CALL_ARG_OLD,
+	OFC_SEMA_CALL_ARG_NEW,
+	OFC_SEMA_CALL_ARG_SCRATCH,
 
 	OFC_SEMA_CALL_ARG_COUNT
 } ofc_sema_call_arg_e;
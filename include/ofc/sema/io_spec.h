@@ -0,0 +1,101 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __ofc_sema_io_spec_h__
+#define __ofc_sema_io_spec_h__
+
+/* Control list specifiers of the IO statements, resolved by name
+   through a single table which also records where each is allowed. */
+
+typedef enum
+{
+	OFC_SEMA_IO_SPEC_UNIT = 0,
+	OFC_SEMA_IO_SPEC_FMT,
+	OFC_SEMA_IO_SPEC_REC,
+	OFC_SEMA_IO_SPEC_ERR,
+	OFC_SEMA_IO_SPEC_END,
+	OFC_SEMA_IO_SPEC_EOR,
+	OFC_SEMA_IO_SPEC_IOSTAT,
+	OFC_SEMA_IO_SPEC_ADVANCE,
+	OFC_SEMA_IO_SPEC_SIZE,
+	OFC_SEMA_IO_SPEC_FILE,
+	OFC_SEMA_IO_SPEC_ACCESS,
+	OFC_SEMA_IO_SPEC_ACTION,
+	OFC_SEMA_IO_SPEC_BLANK,
+	OFC_SEMA_IO_SPEC_DELIM,
+	OFC_SEMA_IO_SPEC_FORM,
+	OFC_SEMA_IO_SPEC_PAD,
+	OFC_SEMA_IO_SPEC_POSITION,
+	OFC_SEMA_IO_SPEC_RECL,
+	OFC_SEMA_IO_SPEC_STATUS,
+	OFC_SEMA_IO_SPEC_DIRECT,
+	OFC_SEMA_IO_SPEC_EXIST,
+	OFC_SEMA_IO_SPEC_FORMATTED,
+	OFC_SEMA_IO_SPEC_NAME,
+	OFC_SEMA_IO_SPEC_NAMED,
+	OFC_SEMA_IO_SPEC_NEXTREC,
+	OFC_SEMA_IO_SPEC_NUMBER,
+	OFC_SEMA_IO_SPEC_OPENED,
+	OFC_SEMA_IO_SPEC_READ,
+	OFC_SEMA_IO_SPEC_READWRITE,
+	OFC_SEMA_IO_SPEC_SEQUENTIAL,
+	OFC_SEMA_IO_SPEC_UNFORMATTED,
+	OFC_SEMA_IO_SPEC_WRITE,
+
+	OFC_SEMA_IO_SPEC_COUNT
+} ofc_sema_io_spec_e;
+
+typedef enum
+{
+	OFC_SEMA_IO_STMT_OPEN = 0,
+	OFC_SEMA_IO_STMT_CLOSE,
+	OFC_SEMA_IO_STMT_INQUIRE,
+	OFC_SEMA_IO_STMT_READ,
+	OFC_SEMA_IO_STMT_WRITE,
+	OFC_SEMA_IO_STMT_REWIND,
+	OFC_SEMA_IO_STMT_END_FILE,
+	OFC_SEMA_IO_STMT_BACKSPACE,
+
+	OFC_SEMA_IO_STMT_COUNT
+} ofc_sema_io_stmt_e;
+
+const char* ofc_sema_io_stmt_name(
+	ofc_sema_io_stmt_e stmt);
+const char* ofc_sema_io_spec_name(
+	ofc_sema_io_spec_e spec);
+
+/* Returns OFC_SEMA_IO_SPEC_COUNT if name isn't a specifier. */
+ofc_sema_io_spec_e ofc_sema_io_spec_lookup(
+	ofc_str_ref_t name);
+
+/* Fills arg with the argument given for each specifier or NULL,
+   reports unknown, misplaced and repeated specifiers. */
+bool ofc_sema_io_spec_resolve(
+	ofc_sema_io_stmt_e stmt,
+	const ofc_parse_call_arg_list_t* params,
+	const ofc_parse_call_arg_t* arg[OFC_SEMA_IO_SPEC_COUNT]);
+
+/* Checks that a specifier is a CHARACTER expression and if it's
+   constant that its value is allowed, *value is set to
+   OFC_SEMA_CALL_ARG_RUNTIME when it isn't constant. */
+bool ofc_sema_io_spec_value(
+	ofc_sema_io_stmt_e stmt,
+	ofc_sema_io_spec_e spec,
+	ofc_sparse_loc_t src,
+	const ofc_sema_expr_t* expr,
+	ofc_sema_call_arg_e* value);
+
+#endif
@@ -0,0 +1,108 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __ofc_sema_ir_h__
+#define __ofc_sema_ir_h__
+
+/* A flat copy of the expressions in a scope, stored as a column per
+   field and indexed by id so that passes can scan them linearly rather
+   than chasing pointers through the tree.
+
+   Ids are assigned in post-order, so the operands of a node always come
+   before it and the subtree of a node is the range [first, id]. */
+
+typedef uint32_t ofc_sema_ir_id_t;
+
+#define OFC_SEMA_IR_NONE UINT32_MAX
+
+typedef enum
+{
+	OFC_SEMA_IR_CONSTANT   = (1 << 0),
+	OFC_SEMA_IR_BRACKETS   = (1 << 1),
+	OFC_SEMA_IR_LABEL      = (1 << 2),
+	OFC_SEMA_IR_FORMAT     = (1 << 3),
+	OFC_SEMA_IR_ALT_RETURN = (1 << 4),
+
+	/* The node was changed in place, its operands are out of date. */
+	OFC_SEMA_IR_REWRITTEN  = (1 << 6),
+	/* The node was deleted from the tree. */
+	OFC_SEMA_IR_DELETED    = (1 << 7),
+} ofc_sema_ir_flag_e;
+
+typedef struct
+{
+	unsigned count, max;
+
+	/* Hot columns. */
+	uint8_t*                op;
+	uint8_t*                flags;
+	const ofc_sema_type_t** type;
+	ofc_sema_ir_id_t*       first;
+
+	/* Operands of a node are a run of the child array, the operands of
+	   an IMPLICIT_DO are init, last and step followed by its body. */
+	unsigned*         child_first;
+	unsigned*         child_count;
+	unsigned          child_total, child_max;
+	ofc_sema_ir_id_t* child;
+
+	/* Cold columns. */
+	ofc_sparse_loc_t*          src;
+	const ofc_sema_typeval_t** constant;
+	ofc_sema_expr_t**          expr;
+} ofc_sema_ir_t;
+
+ofc_sema_ir_t* ofc_sema_ir_create(void);
+void ofc_sema_ir_delete(ofc_sema_ir_t* ir);
+
+/* Appends an expression and all of its operands. */
+bool ofc_sema_ir_add(
+	ofc_sema_ir_t* ir,
+	ofc_sema_expr_t* expr,
+	ofc_sema_ir_id_t* id);
+
+/* Every expression in a scope, excluding its child scopes. */
+ofc_sema_ir_t* ofc_sema_ir_create_scope(
+	ofc_sema_scope_t* scope);
+
+/* Reload the columns of a node after a pass has changed it in place. */
+void ofc_sema_ir_refresh(
+	ofc_sema_ir_t* ir, ofc_sema_ir_id_t id);
+void ofc_sema_ir_remove(
+	ofc_sema_ir_t* ir, ofc_sema_ir_id_t id);
+
+static inline ofc_sema_ir_id_t ofc_sema_ir_child(
+	const ofc_sema_ir_t* ir, ofc_sema_ir_id_t id, unsigned index)
+{
+	if (index >= ir->child_count[id])
+		return OFC_SEMA_IR_NONE;
+	return ir->child[ir->child_first[id] + index];
+}
+
+/* Calls func for every live node in id order, so operands are
+   visited before the expressions which use them. */
+bool ofc_sema_ir_foreach(
+	ofc_sema_ir_t* ir, void* param,
+	bool (*func)(ofc_sema_ir_t* ir, ofc_sema_ir_id_t id, void* param));
+/* Visits expressions before their operands. */
+bool ofc_sema_ir_foreach_reverse(
+	ofc_sema_ir_t* ir, void* param,
+	bool (*func)(ofc_sema_ir_t* ir, ofc_sema_ir_id_t id, void* param));
+bool ofc_sema_ir_foreach_op(
+	ofc_sema_ir_t* ir, ofc_sema_expr_e op, void* param,
+	bool (*func)(ofc_sema_ir_t* ir, ofc_sema_ir_id_t id, void* param));
+
+#endif
@@ -39,7 +39,7 @@ typedef struct
 	bool used;
 } ofc_sema_label_t;
 
-ofc_sparse_ref_t ofc_sema_label_src(
+ofc_sparse_loc_t ofc_sema_label_src(
 	const ofc_sema_label_t* label);
 
 
@@ -30,7 +30,7 @@ struct ofc_sema_lhs_s
 {
 	ofc_sema_lhs_e type;
 
-	ofc_sparse_ref_t src;
+	ofc_sparse_loc_t src;
 
 	union
 	{
@@ -75,6 +75,10 @@ struct ofc_sema_lhs_s
 
 	const ofc_sema_type_t* data_type;
 
+	/* Cached result of ofc_sema_lhs_elem_count. */
+	bool     elem_count_valid;
+	unsigned elem_count;
+
 	unsigned refcnt;
 };
 
@@ -82,6 +86,10 @@ struct ofc_sema_lhs_list_s
 {
 	unsigned         count;
 	ofc_sema_lhs_t** lhs;
+
+	/* Lazily built prefix sums of the element count of each entry,
+	   has count + 1 entries or is NULL. */
+	unsigned* elem_offset;
 };
 
 
@@ -107,6 +115,9 @@ ofc_sema_lhs_t* ofc_sema_lhs_copy_replace(
 	const ofc_sema_expr_t* with);
 ofc_sema_lhs_t* ofc_sema_lhs_copy(
 	const ofc_sema_lhs_t* lhs);
+ofc_sema_lhs_t* ofc_sema_lhs_copy_bind(
+	const ofc_sema_lhs_t* lhs,
+	const ofc_sema_expr_bind_t* bind);
 bool ofc_sema_lhs_reference(
 	ofc_sema_lhs_t* lhs);
 void ofc_sema_lhs_delete(
@@ -158,6 +169,9 @@ bool ofc_sema_lhs_elem_count(
 	unsigned* count);
 ofc_sema_lhs_t* ofc_sema_lhs_elem_get(
 	ofc_sema_lhs_t* lhs, unsigned offset);
+ofc_sema_lhs_t* ofc_sema_lhs_elem_get_bind(
+	ofc_sema_lhs_t* lhs, unsigned offset,
+	const ofc_sema_expr_bind_t* bind);
 
 bool ofc_sema_lhs_equiv(
 	ofc_sema_lhs_t* a,
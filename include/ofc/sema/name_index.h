@@ -0,0 +1,60 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ofc_sema_name_index_h__
+#define __ofc_sema_name_index_h__
+
+/* Case folded index of the names declared in a global scope, used to
+   make the namespace collision checks a single lookup per name. */
+
+typedef struct
+{
+	ofc_str_ref_t name;
+
+	/* These are cached since they scan the keyword and intrinsic lists. */
+	bool keyword;
+	bool reserved;
+
+	/* Scopes which contain a program unit or block data of this name. */
+	unsigned                 unit_count;
+	const ofc_sema_scope_t** unit_parent;
+} ofc_sema_name_t;
+
+typedef struct
+{
+	ofc_hashmap_t* map;
+} ofc_sema_name_index_t;
+
+ofc_sema_name_index_t* ofc_sema_name_index_create(void);
+void ofc_sema_name_index_delete(
+	ofc_sema_name_index_t* index);
+
+const ofc_sema_name_t* ofc_sema_name_index_find(
+	const ofc_sema_name_index_t* index,
+	ofc_str_ref_t name);
+const ofc_sema_name_t* ofc_sema_name_index_find_create(
+	ofc_sema_name_index_t* index,
+	ofc_str_ref_t name);
+
+bool ofc_sema_name_index_add_unit(
+	ofc_sema_name_index_t* index,
+	ofc_str_ref_t name,
+	const ofc_sema_scope_t* parent);
+
+bool ofc_sema_name_is_unit(
+	const ofc_sema_name_t* entry,
+	const ofc_sema_scope_t* parent);
+
+#endif
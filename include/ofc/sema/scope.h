@@ -36,13 +36,17 @@ typedef struct
 {
 	unsigned           count;
 	ofc_sema_scope_t** scope;
+
+	/* Open addressed index of scope + 1 keyed on name atom. */
+	unsigned  map_size;
+	unsigned* map;
 } ofc_sema_scope_list_t;
 
 
 struct ofc_sema_scope_s
 {
 	ofc_parse_file_t* file;
-	ofc_sparse_ref_t src;
+	ofc_sparse_loc_t src;
 
 	ofc_sema_scope_t*      parent;
 	ofc_sema_scope_list_t* child;
@@ -67,6 +71,9 @@ struct ofc_sema_scope_s
 	ofc_sema_structure_list_t* structure;
 	ofc_sema_structure_list_t* derived_type;
 
+	/* Only the super and global scopes have a name index. */
+	ofc_sema_name_index_t* names;
+
 	union
 	{
 		ofc_sema_stmt_list_t* stmt;
@@ -84,6 +91,24 @@ ofc_sema_scope_t* ofc_sema_scope_global(
 	ofc_sema_scope_t* super,
 	ofc_parse_file_t* list);
 
+/* The global scope of a file which is analysed one program unit at
+   a time, each top level statement is added as it's parsed and unit
+   is set to the scope of the program unit it defines, if any. */
+ofc_sema_scope_t* ofc_sema_scope_global_stream(
+	ofc_sema_scope_t* super,
+	ofc_parse_file_t* file);
+bool ofc_sema_scope_global_add(
+	ofc_sema_scope_t* scope,
+	const ofc_parse_stmt_t* stmt,
+	ofc_sema_scope_t** unit);
+bool ofc_sema_scope_global_end(
+	ofc_sema_scope_t* scope);
+
+/* Frees the statements and labels of a scope and the scopes within it,
+   their declarations are kept since other scopes may refer to them. */
+bool ofc_sema_scope_release_stmt(
+	ofc_sema_scope_t* scope);
+
 ofc_sema_scope_t* ofc_sema_scope_program(
 	ofc_sema_scope_t* scope,
 	const ofc_parse_stmt_t* stmt);
@@ -168,6 +193,11 @@ bool ofc_sema_scope_print(
 	ofc_colstr_t* cs, unsigned indent,
 	const ofc_sema_scope_t* scope);
 
+/* Prints a program unit as it's printed within the global scope. */
+bool ofc_sema_scope_unit_print(
+	ofc_colstr_t* cs, unsigned indent,
+	const ofc_sema_scope_t* scope);
+
 ofc_sema_scope_list_t* ofc_sema_scope_list_create(void);
 
 ofc_sema_scope_t* ofc_sema_scope_list_find_name(
@@ -213,5 +243,11 @@ bool ofc_sema_scope_foreach_structure(
 
 void ofc_sema_scope_common_usage_print(
 	const ofc_sema_scope_t* scope);
+bool ofc_sema_scope_storage_print(
+	const ofc_sema_scope_t* scope);
+bool ofc_sema_scope_cfg_print(
+	const ofc_sema_scope_t* scope);
+bool ofc_sema_scope_dataflow_warn(
+	const ofc_sema_scope_t* scope);
 
 #endif
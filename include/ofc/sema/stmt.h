@@ -59,7 +59,7 @@ struct ofc_sema_stmt_s
 {
 	ofc_sema_stmt_e type;
 
-	ofc_sparse_ref_t src;
+	ofc_sparse_loc_t src;
 
 	union
 	{
@@ -98,6 +98,8 @@ struct ofc_sema_stmt_s
 
 		struct
 		{
+			/* Interned, so the parse tree can be released. */
+			ofc_sema_format_intern_t*           intern;
 			const ofc_parse_format_desc_list_t* src;
 			ofc_parse_format_desc_list_t*       format;
 			bool is_default_possible;
@@ -387,6 +389,12 @@ ofc_sema_stmt_list_t* ofc_sema_stmt_list(
 	ofc_sema_scope_t* scope,
 	ofc_sema_stmt_t*  block,
 	const ofc_parse_stmt_list_t* body);
+/* Analyses body into the end of an existing list. */
+bool ofc_sema_stmt_list_append(
+	ofc_sema_scope_t* scope,
+	ofc_sema_stmt_t*  block,
+	ofc_sema_stmt_list_t* list,
+	const ofc_parse_stmt_list_t* body);
 
 void ofc_sema_stmt_list_delete(
 	ofc_sema_stmt_list_t* list);
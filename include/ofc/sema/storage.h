@@ -0,0 +1,93 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ofc_sema_storage_h__
+#define __ofc_sema_storage_h__
+
+/* Storage layout of the COMMON and EQUIVALENCE associated declarations
+   in a single scope. Declarations which share storage are grouped into
+   a class, and each has a byte offset from the start of that class. */
+
+typedef struct
+{
+	const ofc_sema_decl_t* decl;
+
+	unsigned class;
+	unsigned offset;
+	unsigned size;
+} ofc_sema_storage_entry_t;
+
+typedef struct
+{
+	/* NULL unless the class is a COMMON block. */
+	const ofc_sema_common_t* common;
+	unsigned size;
+
+	/* Range of entries in the class, these are sorted by offset. */
+	unsigned first;
+	unsigned count;
+} ofc_sema_storage_class_t;
+
+typedef struct
+{
+	const ofc_sema_decl_t* decl;
+	unsigned               index;
+} ofc_sema_storage_slot_t;
+
+typedef struct
+{
+	unsigned                  count;
+	ofc_sema_storage_entry_t* entry;
+
+	/* The largest end offset in the implicit binary tree rooted
+	   at each entry, used for interval queries within a class. */
+	unsigned* max_end;
+
+	unsigned                  class_count;
+	ofc_sema_storage_class_t* class;
+
+	/* Open addressed table of entries keyed by decl. */
+	unsigned                 map_size;
+	ofc_sema_storage_slot_t* map;
+} ofc_sema_storage_t;
+
+ofc_sema_storage_t* ofc_sema_storage_create(
+	const ofc_sema_scope_t* scope);
+void ofc_sema_storage_delete(
+	ofc_sema_storage_t* storage);
+
+const ofc_sema_storage_entry_t* ofc_sema_storage_find(
+	const ofc_sema_storage_t* storage,
+	const ofc_sema_decl_t* decl);
+
+/* Calls func for every entry in class which overlaps [offset, offset + size),
+   stops and returns false if func returns false. */
+bool ofc_sema_storage_overlap(
+	const ofc_sema_storage_t* storage,
+	unsigned class, unsigned offset, unsigned size,
+	void* param,
+	bool (*func)(const ofc_sema_storage_entry_t* entry, void* param));
+
+/* Calls func for every other entry which shares storage with decl. */
+bool ofc_sema_storage_alias(
+	const ofc_sema_storage_t* storage,
+	const ofc_sema_decl_t* decl,
+	void* param,
+	bool (*func)(const ofc_sema_storage_entry_t* entry, void* param));
+
+bool ofc_sema_storage_print(
+	const ofc_sema_storage_t* storage);
+
+#endif
@@ -38,6 +38,34 @@ typedef struct
 	};
 } ofc_sema_structure_member_t;
 
+typedef struct
+{
+	ofc_sema_structure_member_t* member;
+
+	/* Byte offset from the start of the structure. */
+	bool     offset_valid;
+	unsigned offset;
+
+	bool     size_valid;
+	unsigned size;
+} ofc_sema_structure_layout_entry_t;
+
+/* Computed once a structure is complete, anonymous UNION and MAP
+   members are flattened into the member table and name map. */
+typedef struct
+{
+	bool     size_valid;
+	unsigned size;
+
+	bool     elem_count_valid;
+	unsigned elem_count;
+
+	unsigned                           count;
+	ofc_sema_structure_layout_entry_t* entry;
+
+	ofc_hashmap_t* map;
+} ofc_sema_structure_layout_t;
+
 struct ofc_sema_structure_s
 {
 	ofc_sparse_ref_t      name;
@@ -50,6 +78,8 @@ struct ofc_sema_structure_s
 
 	ofc_hashmap_t* map;
 
+	ofc_sema_structure_layout_t* layout;
+
 	unsigned refcnt;
 };
 
@@ -76,6 +106,9 @@ bool ofc_sema_structure_is_nested(
 bool ofc_sema_structure_is_derived_type(
 	const ofc_sema_structure_t* structure);
 
+const ofc_sema_structure_layout_t* ofc_sema_structure_layout(
+	const ofc_sema_structure_t* structure);
+
 bool ofc_sema_structure_member_count(
 	const ofc_sema_structure_t* structure,
 	unsigned* count);
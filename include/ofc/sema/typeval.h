@@ -20,7 +20,7 @@ typedef struct
 {
     const ofc_sema_type_t* type;
 
-	ofc_sparse_ref_t src;
+	ofc_sparse_loc_t src;
 
 	struct
 	{
@@ -41,20 +41,24 @@ typedef struct
 
 ofc_sema_typeval_t* ofc_sema_typeval_create_logical(
 	bool value, ofc_sema_kind_e kind,
-	ofc_sparse_ref_t ref);
+	ofc_sparse_loc_t loc);
 ofc_sema_typeval_t* ofc_sema_typeval_create_integer(
 	int value, ofc_sema_kind_e kind,
-	ofc_sparse_ref_t ref);
+	ofc_sparse_loc_t loc);
 ofc_sema_typeval_t* ofc_sema_typeval_create_real(
 	long double value, ofc_sema_kind_e kind,
-	ofc_sparse_ref_t ref);
+	ofc_sparse_loc_t loc);
 ofc_sema_typeval_t* ofc_sema_typeval_create_complex(
 	long double real, long double imaginary,
 	ofc_sema_kind_e kind,
-	ofc_sparse_ref_t ref);
+	ofc_sparse_loc_t loc);
 ofc_sema_typeval_t* ofc_sema_typeval_create_character(
 	const char* data, ofc_sema_kind_e kind, unsigned len,
-	ofc_sparse_ref_t ref);
+	ofc_sparse_loc_t loc);
+
+/* Character data is shared between copies and mustn't be modified
+   once the typeval has been created. */
+char* ofc_sema_typeval_character_alloc(unsigned size);
 
 ofc_sema_typeval_t* ofc_sema_typeval_literal(
 	const ofc_parse_literal_t* literal,
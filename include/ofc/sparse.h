@@ -17,6 +17,7 @@
 #define __ofc_sparse_h__
 
 #include <stdbool.h>
+#include <stdint.h>
 
 
 typedef struct ofc_sparse_s ofc_sparse_t;
@@ -30,6 +31,15 @@ typedef struct
 	ofc_str_ref_t       string;
 } ofc_sparse_ref_t;
 
+/* A compact source location, each locked sparse is given a range of
+   positions in a space shared by the whole run so pos alone identifies
+   the sparse. Position zero is never given out. */
+typedef struct
+{
+	uint32_t pos;
+	uint32_t size;
+} ofc_sparse_loc_t;
+
 
 #include "file.h"
 #include "label_table.h"
@@ -42,6 +52,11 @@ void      ofc_sparse_delete(ofc_sparse_t* sparse);
 
 unsigned ofc_sparse_len(const ofc_sparse_t* sparse);
 
+/* Ensures len more characters can be appended without reallocation. */
+bool ofc_sparse_reserve(ofc_sparse_t* sparse, unsigned len);
+
+/* Text is copied into the sparse as it's appended, src must point into
+   the parent sparse or file. */
 bool ofc_sparse_append_strn(ofc_sparse_t* sparse, const char* src, unsigned len);
 
 /* No modifications are allowed after this call. */
@@ -99,6 +114,30 @@ static inline bool ofc_sparse_ref_print(
 	ofc_colstr_t* cs, ofc_sparse_ref_t ref)
 	{ return ofc_str_ref_print(cs, ref.string); }
 
+
+#define OFC_SPARSE_LOC_EMPTY (ofc_sparse_loc_t){ .pos = 0, .size = 0 }
+
+/* Refs which aren't in a locked sparse have an empty location. */
+ofc_sparse_loc_t ofc_sparse_loc(
+	const ofc_sparse_t* sparse, const char* ptr, unsigned size);
+
+static inline ofc_sparse_loc_t ofc_sparse_ref_loc(ofc_sparse_ref_t ref)
+	{ return ofc_sparse_loc(ref.sparse, ref.string.base, ref.string.size); }
+
+/* Decodes a location, this is empty if its sparse has been deleted. */
+ofc_sparse_ref_t ofc_sparse_loc_ref(ofc_sparse_loc_t loc);
+
+static inline bool ofc_sparse_loc_empty(ofc_sparse_loc_t loc)
+	{ return ((loc.pos == 0) || (loc.size == 0)); }
+
+bool ofc_sparse_loc_bridge(
+	ofc_sparse_loc_t a, ofc_sparse_loc_t b,
+	ofc_sparse_loc_t* c);
+
+static inline bool ofc_sparse_loc_print(
+	ofc_colstr_t* cs, ofc_sparse_loc_t loc)
+	{ return ofc_sparse_ref_print(cs, ofc_sparse_loc_ref(loc)); }
+
 const char* ofc_sparse_file_pointer(
 	const ofc_sparse_t* sparse, const char* ptr);
 
@@ -139,4 +178,13 @@ void ofc_sparse_ref_warning(
 	const char* format, ...)
 	__attribute__ ((format (printf, 2, 3)));
 
+void ofc_sparse_loc_error(
+	ofc_sparse_loc_t loc,
+	const char* format, ...)
+	__attribute__ ((format (printf, 2, 3)));
+void ofc_sparse_loc_warning(
+	ofc_sparse_loc_t loc,
+	const char* format, ...)
+	__attribute__ ((format (printf, 2, 3)));
+
 #endif
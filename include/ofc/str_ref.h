@@ -21,21 +21,29 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <ofc/colstr.h>
+#include <ofc/atom.h>
 
+/* Identifiers have their atom set when they're parsed, it's
+   OFC_ATOM_NONE for any other string or when it isn't known. */
 typedef struct
 {
 	const char* base;
 	unsigned    size;
+	ofc_atom_t  atom;
 } ofc_str_ref_t;
 
-#define OFC_STR_REF_EMPTY (ofc_str_ref_t){ .base = NULL, .size = 0 }
+#define OFC_STR_REF_EMPTY (ofc_str_ref_t){ .base = NULL, .size = 0, .atom = OFC_ATOM_NONE }
 
 static inline ofc_str_ref_t ofc_str_ref(const char* base, unsigned size)
-	{ return (ofc_str_ref_t){ base, size }; }
+	{ return (ofc_str_ref_t){ base, size, OFC_ATOM_NONE }; }
 static inline ofc_str_ref_t ofc_str_ref_from_strz(const char* strz)
-	{ return (ofc_str_ref_t){ strz, strlen(strz) }; }
+	{ return (ofc_str_ref_t){ strz, strlen(strz), OFC_ATOM_NONE }; }
 
 bool    ofc_str_ref_empty(const ofc_str_ref_t ref);
+
+/* Returns the atom of ref, interning it if it isn't already set. */
+ofc_atom_t ofc_str_ref_atom(const ofc_str_ref_t ref);
+
 uint8_t ofc_str_ref_hash(const ofc_str_ref_t ref);
 uint8_t ofc_str_ref_hash_ci(const ofc_str_ref_t ref);
 bool    ofc_str_ref_equal(const ofc_str_ref_t a, const ofc_str_ref_t b);
@@ -22,15 +22,21 @@ typedef struct
 {
 	char*    base;
 	unsigned size;
+
+	/* A borrowed string points into a buffer which outlives it,
+	   it isn't owned and isn't nul terminated. */
+	bool borrowed;
 } ofc_string_t;
 
 ofc_string_t* ofc_string_create(const char* base, unsigned size);
+ofc_string_t* ofc_string_create_ref(const char* base, unsigned size);
 ofc_string_t* ofc_string_copy(const ofc_string_t* src);
 void          ofc_string_delete(ofc_string_t* string);
 
 bool ofc_string_empty(const ofc_string_t* string);
 
-/* May return truncated string if string contains nul characters. */
+/* May return truncated string if string contains nul characters,
+   returns NULL for a borrowed string since it isn't terminated. */
 const char* ofc_string_strz(const ofc_string_t* string);
 
 unsigned ofc_string_length(const ofc_string_t* string);
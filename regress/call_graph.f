@@ -0,0 +1,39 @@
+C     Calls across files, a recursive cycle, mismatched calls and a
+C     procedure passed as an argument.
+      PROGRAM CALLS
+      EXTERNAL TICK
+      INTEGER N
+      REAL X
+      DOUBLE PRECISION D(4)
+      N = 3
+      X = 1.0
+      D(1) = 1.0
+      CALL PING(N)
+      CALL RESIZE(X, N)
+      CALL RESIZE(N)
+      CALL APPLY(TICK)
+      CALL CLEAR(D)
+      END
+
+      SUBROUTINE PING(N)
+      INTEGER N
+      IF (N .GT. 0) CALL PONG(N - 1)
+      END
+
+      SUBROUTINE PONG(N)
+      INTEGER N
+      IF (N .GT. 0) CALL PING(N - 1)
+      END
+
+      SUBROUTINE APPLY(F)
+      EXTERNAL F
+      CALL F
+      END
+
+      SUBROUTINE TICK
+      END
+
+      SUBROUTINE CLEAR(B)
+      REAL B(*)
+      B(1) = 0.0
+      END
@@ -0,0 +1,5 @@
+      SUBROUTINE RESIZE(X, N)
+      REAL X
+      INTEGER N
+      X = X * N
+      END
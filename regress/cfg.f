@@ -0,0 +1,15 @@
+C     GOTO-heavy control flow with a loop and an unreachable block.
+      SUBROUTINE FLOW(N, M)
+      INTEGER N, M, I
+      M = 0
+      I = 1
+   10 IF (I .GT. N) GOTO 30
+      IF (MOD(I, 2) .EQ. 0) GOTO 20
+      M = M + I
+   20 I = I + 1
+      GOTO 10
+      M = -1
+   30 GOTO (40, 50) M
+   40 RETURN
+   50 M = M * 2
+      END
@@ -0,0 +1,16 @@
+C     Statements removed by the unlabelled CONTINUE and unused label
+C     passes leave holes in the statement lists.
+      PROGRAM HOLES
+      INTEGER I, J
+      J = 0
+      DO 10 I = 1, 3
+        J = J + I
+        CONTINUE
+   10 CONTINUE
+      IF (J .GT. 5) THEN
+        J = J - 1
+        CONTINUE
+      END IF
+   20 J = J + 1
+      CONTINUE
+      END
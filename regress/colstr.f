@@ -0,0 +1,16 @@
+C     Reprinted lines which need continuations.
+      PROGRAM COLSTR
+      INTEGER ALPHA, BETA, GAMMA, DELTA, EPSILO, RESULT
+      CHARACTER*80 LONG
+      ALPHA = 1
+      BETA = 2
+      GAMMA = 3
+      DELTA = 4
+      EPSILO = 5
+      RESULT = ALPHA * BETA + GAMMA * DELTA + EPSILO * ALPHA
+     1       + BETA * GAMMA + DELTA * EPSILO + ALPHA * GAMMA
+     2       + BETA * DELTA + EPSILO * BETA + GAMMA * EPSILO
+      LONG = 'A string literal which is far too long to fit on a'
+     1 // ' single fixed form line'
+      PRINT *, RESULT, LONG
+      END
@@ -0,0 +1,10 @@
+C     A COMMON block laid out differently in two units, and one which
+C     matches.
+      SUBROUTINE S1
+      INTEGER A, B, C
+      COMMON /BLK/ A, B
+      COMMON /SAME/ C
+      A = 1
+      B = 2
+      C = 3
+      END
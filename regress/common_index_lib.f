@@ -0,0 +1,8 @@
+      SUBROUTINE S2
+      REAL X
+      INTEGER C
+      COMMON /BLK/ X
+      COMMON /SAME/ C
+      X = 1.0
+      C = 3
+      END
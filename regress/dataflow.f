@@ -0,0 +1,36 @@
+C     Use before set, a dead store and an EQUIVALENCE alias.
+      SUBROUTINE FLOW(N, M)
+      INTEGER N, M, I, J, K, L, A(2), E
+      EQUIVALENCE (E, A(2))
+      IF (N .GT. 0) I = 1
+      M = I
+      J = 1
+      J = 2
+      M = M + J
+      A(1) = 0
+      M = M + E + K
+      L = 3
+      END
+C     Holes left by the unlabelled CONTINUE and unused label passes.
+      SUBROUTINE HOLES(M)
+      INTEGER M, I, J
+      J = 0
+      DO 10 I = 1, 3
+        J = J + I
+        CONTINUE
+   10 CONTINUE
+   20 M = J
+      CONTINUE
+      END
+C     Names which share storage only through EQUIVALENCE.
+      SUBROUTINE ALIAS(M)
+      INTEGER M, I, J, P, Q, A(4), B(4)
+      EQUIVALENCE (I, B(1)), (J, A(3)), (P, Q)
+      M = I
+      I = 1
+      J = 1
+      J = 2
+      M = M + J + A(3)
+      P = 1
+      M = M + Q
+      END
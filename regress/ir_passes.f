@@ -0,0 +1,13 @@
+C     Integers used as logicals and characters stored in integers,
+C     including operands nested inside other expressions.
+      PROGRAM PASSES
+      INTEGER I, J, K
+      LOGICAL L
+      I = 1
+      J = 0
+      L = .NOT. I
+      L = (.NOT. (I .AND. J)) .OR. L
+      IF (I) K = 2
+      K = 'AB'
+      PRINT *, L, K
+      END
@@ -0,0 +1,6 @@
+C     Each input is reprinted to the same relative path under @OUT@.
+      PROGRAM OUTDIR
+      INTEGER I
+      I = 1
+      CALL SUB(I)
+      END
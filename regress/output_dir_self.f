@@ -0,0 +1,3 @@
+C     Writing to the input's own directory must not overwrite it.
+      PROGRAM SELF
+      END
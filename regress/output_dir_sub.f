@@ -0,0 +1,4 @@
+      SUBROUTINE SUB(I)
+      INTEGER I
+      PRINT *, I
+      END
@@ -0,0 +1,11 @@
+C     Implied DO lists are first tried as parenthesized expressions, so
+C     the items are parsed again once that fails.
+      PROGRAM STATS
+      INTEGER I, J, A(3), B(3, 2)
+      DO 10 I = 1, 3
+        A(I) = I
+        DO 10 J = 1, 2
+   10 B(I, J) = I * J
+      PRINT *, (A(I), I = 1, 3)
+      PRINT *, ((B(I, J), I = 1, 3), J = 1, 2)
+      END
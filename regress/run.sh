@@ -0,0 +1,47 @@
+#!/bin/bash
+
+# Runs ofc over each NAME.f which has a NAME.args, passing the options in
+# NAME.args, and compares stdout, stderr and the exit status with NAME.out.
+# An @OUT@ in the options is replaced with an empty directory, every file
+# written there is appended to the output.
+#
+# Usage: regress/run.sh OFC [NAME...]
+# Set REGRESS_UPDATE=1 to rewrite the expected output instead.
+
+OFC=$(realpath "$1")
+shift
+DIR=$(dirname "$(realpath "$0")")
+cd "$DIR" || exit 1
+
+if [ $# -eq 0 ]; then
+	set -- $(ls *.args | sed 's/\.args$//')
+fi
+
+FAIL=0
+for NAME in "$@"; do
+	OUT=$(mktemp -d)
+	ARGS=$(sed "s|@OUT@|$OUT|g" "$NAME.args")
+
+	RESULT=$( (
+		$OFC $ARGS "$NAME.f" 2>&1
+		echo "exit: $?"
+		(cd "$OUT" && find . -type f | sort | while read -r F; do
+			echo "== $F"
+			cat "$F"
+		done)
+	) | sed -e "s|$OUT|@OUT@|g" \
+		-e 's|in [0-9.]*s, [0-9]* lines/s, [0-9]* bytes/s|in @TIME@|')
+	rm -rf "$OUT"
+
+	if [ -n "$REGRESS_UPDATE" ]; then
+		echo "$RESULT" > "$NAME.out"
+	elif echo "$RESULT" | diff -u "$NAME.out" - > /dev/null; then
+		echo "PASS: $NAME"
+	else
+		echo "FAIL: $NAME"
+		echo "$RESULT" | diff -u "$NAME.out" -
+		FAIL=1
+	fi
+done
+
+exit $FAIL
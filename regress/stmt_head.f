@@ -0,0 +1,18 @@
+C     Statement heads which look like keywords but aren't.
+      REAL FUNCTION F(X)
+      REAL X
+      F = X * 2.0
+      END
+
+      PROGRAM HEADS
+      INTEGER IF(2), DO10I, REALX, I
+      REAL F, R
+      DO10I = 1.5
+      DO 10 I = 1, 2
+        IF(I) = I
+   10 CONTINUE
+      REALX = IF(1) + IF(2) + DO10I
+      R = F(1.0)
+      WRITE (*, 20) REALX, R
+   20 FORMAT (I4, F6.1)
+      END
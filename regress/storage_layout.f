@@ -0,0 +1,12 @@
+C     EQUIVALENCE classes, one of them extending a COMMON block.
+      SUBROUTINE LAYOUT
+      INTEGER I, J, A(4), B(4)
+      REAL X, Y
+      DOUBLE PRECISION D
+      CHARACTER*8 S
+      CHARACTER*4 T
+      COMMON /BLK/ X, Y
+      EQUIVALENCE (I, B(1)), (J, A(3)), (D, A(1))
+      EQUIVALENCE (T, S(5:8))
+      EQUIVALENCE (Y, B(2))
+      END
@@ -0,0 +1,17 @@
+C     Statements before any unit form an implicit PROGRAM.
+      INTEGER I
+      I = 1
+      CALL TWICE(I)
+      END
+
+      SUBROUTINE TWICE(I)
+      INTEGER I
+      I = I * 2
+      END
+
+      INTEGER FUNCTION THRICE(I)
+      INTEG ER J
+      INTEGER I
+      J = 3
+      THRICE = I * J
+      END
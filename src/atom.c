@@ -0,0 +1,242 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ctype.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ofc/atom.h"
+
+typedef struct
+{
+	const char* name;
+	unsigned    size;
+	uint32_t    hash;
+} ofc_atom__entry_t;
+
+#define OFC_ATOM__BLOCK_SIZE 4096
+
+/* Folded names are packed into blocks which never move, entry[atom - 1]
+   describes each one and slot is an open addressed index of atoms.
+   Every access is under lock, since sema passes may run on threads. */
+static struct
+{
+	unsigned           count, max;
+	ofc_atom__entry_t* entry;
+
+	unsigned block_count;
+	char**   block;
+	unsigned block_used, block_max;
+
+	unsigned    slot_size;
+	ofc_atom_t* slot;
+} ofc_atom__table = { 0 };
+
+static pthread_mutex_t ofc_atom__lock = PTHREAD_MUTEX_INITIALIZER;
+
+
+static void ofc_atom__cleanup(void)
+{
+	unsigned i;
+	for (i = 0; i < ofc_atom__table.block_count; i++)
+		free(ofc_atom__table.block[i]);
+	free(ofc_atom__table.block);
+	free(ofc_atom__table.slot);
+	free(ofc_atom__table.entry);
+	memset(&ofc_atom__table, 0x00, sizeof(ofc_atom__table));
+}
+
+static uint32_t ofc_atom__hash(const char* base, unsigned size)
+{
+	uint32_t h = 2166136261U;
+	unsigned i;
+	for (i = 0; i < size; i++)
+	{
+		h ^= (uint8_t)toupper((unsigned char)base[i]);
+		h *= 16777619U;
+	}
+	return h;
+}
+
+static bool ofc_atom__match(
+	const ofc_atom__entry_t* entry, uint32_t hash,
+	const char* base, unsigned size)
+{
+	if ((entry->hash != hash)
+		|| (entry->size != size))
+		return false;
+
+	unsigned i;
+	for (i = 0; i < size; i++)
+	{
+		if (entry->name[i] != toupper((unsigned char)base[i]))
+			return false;
+	}
+	return true;
+}
+
+/* Returns the slot which either holds the name or where it belongs. */
+static ofc_atom_t* ofc_atom__slot(
+	uint32_t hash, const char* base, unsigned size)
+{
+	if (ofc_atom__table.slot_size == 0)
+		return NULL;
+
+	unsigned mask = (ofc_atom__table.slot_size - 1);
+	unsigned s = (hash & mask);
+	while (true)
+	{
+		ofc_atom_t* slot = &ofc_atom__table.slot[s];
+		if ((*slot == OFC_ATOM_NONE)
+			|| ofc_atom__match(&ofc_atom__table.entry[*slot - 1],
+				hash, base, size))
+			return slot;
+
+		s = (s + 1) & mask;
+	}
+}
+
+static bool ofc_atom__resize(void)
+{
+	unsigned size = (ofc_atom__table.slot_size > 0
+		? (ofc_atom__table.slot_size * 2) : 1024);
+	ofc_atom_t* slot
+		= (ofc_atom_t*)calloc(size, sizeof(ofc_atom_t));
+	if (!slot) return false;
+
+	if (!ofc_atom__table.slot)
+		atexit(ofc_atom__cleanup);
+
+	free(ofc_atom__table.slot);
+	ofc_atom__table.slot      = slot;
+	ofc_atom__table.slot_size = size;
+
+	unsigned mask = (size - 1);
+	unsigned i;
+	for (i = 0; i < ofc_atom__table.count; i++)
+	{
+		unsigned s = (ofc_atom__table.entry[i].hash & mask);
+		while (slot[s] != OFC_ATOM_NONE)
+			s = (s + 1) & mask;
+		slot[s] = (i + 1);
+	}
+
+	return true;
+}
+
+/* Returns space for a folded name, which stays where it is. */
+static char* ofc_atom__name_alloc(unsigned size)
+{
+	if ((ofc_atom__table.block_count == 0)
+		|| ((ofc_atom__table.block_used + size) > ofc_atom__table.block_max))
+	{
+		unsigned max = (size > OFC_ATOM__BLOCK_SIZE
+			? size : OFC_ATOM__BLOCK_SIZE);
+		char* nblock = (char*)malloc(max > 0 ? max : 1);
+		if (!nblock) return NULL;
+
+		char** nlist = (char**)realloc(ofc_atom__table.block,
+			sizeof(char*) * (ofc_atom__table.block_count + 1));
+		if (!nlist)
+		{
+			free(nblock);
+			return NULL;
+		}
+		ofc_atom__table.block = nlist;
+		ofc_atom__table.block[ofc_atom__table.block_count++] = nblock;
+		ofc_atom__table.block_used = 0;
+		ofc_atom__table.block_max  = max;
+	}
+
+	char* name = &ofc_atom__table.block[ofc_atom__table.block_count - 1]
+		[ofc_atom__table.block_used];
+	ofc_atom__table.block_used += size;
+	return name;
+}
+
+static ofc_atom_t ofc_atom__add(const char* base, unsigned size)
+{
+	uint32_t hash = ofc_atom__hash(base, size);
+	ofc_atom_t* slot = ofc_atom__slot(hash, base, size);
+	if (slot && (*slot != OFC_ATOM_NONE))
+		return *slot;
+
+	if (((ofc_atom__table.count + 1) * 2) > ofc_atom__table.slot_size)
+	{
+		if (!ofc_atom__resize())
+			return OFC_ATOM_NONE;
+		slot = ofc_atom__slot(hash, base, size);
+	}
+
+	if (ofc_atom__table.count >= ofc_atom__table.max)
+	{
+		unsigned max = (ofc_atom__table.max > 0
+			? (ofc_atom__table.max * 2) : 256);
+		ofc_atom__entry_t* nentry
+			= (ofc_atom__entry_t*)realloc(ofc_atom__table.entry,
+				sizeof(ofc_atom__entry_t) * max);
+		if (!nentry) return OFC_ATOM_NONE;
+		ofc_atom__table.entry = nentry;
+		ofc_atom__table.max   = max;
+	}
+
+	char* name = ofc_atom__name_alloc(size);
+	if (!name) return OFC_ATOM_NONE;
+
+	unsigned i;
+	for (i = 0; i < size; i++)
+		name[i] = toupper((unsigned char)base[i]);
+
+	ofc_atom__entry_t* entry
+		= &ofc_atom__table.entry[ofc_atom__table.count];
+	entry->name = name;
+	entry->size = size;
+	entry->hash = hash;
+
+	*slot = ++ofc_atom__table.count;
+	return *slot;
+}
+
+
+ofc_atom_t ofc_atom(const char* base, unsigned size)
+{
+	if (!base)
+		return OFC_ATOM_NONE;
+
+	pthread_mutex_lock(&ofc_atom__lock);
+	ofc_atom_t atom = ofc_atom__add(base, size);
+	pthread_mutex_unlock(&ofc_atom__lock);
+	return atom;
+}
+
+const char* ofc_atom_name(ofc_atom_t atom, unsigned* size)
+{
+	const char* name = NULL;
+
+	pthread_mutex_lock(&ofc_atom__lock);
+	if ((atom != OFC_ATOM_NONE)
+		&& (atom <= ofc_atom__table.count))
+	{
+		const ofc_atom__entry_t* entry
+			= &ofc_atom__table.entry[atom - 1];
+		if (size) *size = entry->size;
+		name = entry->name;
+	}
+	pthread_mutex_unlock(&ofc_atom__lock);
+
+	return name;
+}
@@ -51,6 +51,9 @@ static bool ofc_cliarg_global_opts__set_flag(
 		case OFC_CLIARG_PARSE_TREE:
 			global->parse_print = true;
 			break;
+		case OFC_CLIARG_PARSE_STATS:
+			global->parse_stats = true;
+			break;
 		case OFC_CLIARG_SEMA_TREE:
 			global->sema_print = true;
 			break;
@@ -60,6 +63,69 @@ static bool ofc_cliarg_global_opts__set_flag(
 		case OFC_CLIARG_COMMON_USAGE:
 			global->common_usage_print = true;
 			break;
+		case OFC_CLIARG_STORAGE_LAYOUT:
+			global->storage_layout_print = true;
+			break;
+		case OFC_CLIARG_COMMON_INDEX:
+			global->common_index_print = true;
+			break;
+		case OFC_CLIARG_CALL_GRAPH:
+			global->call_graph_print = true;
+			break;
+		case OFC_CLIARG_CFG:
+			global->cfg_print = true;
+			break;
+		case OFC_CLIARG_DATAFLOW:
+			global->dataflow_warn = true;
+			break;
+		case OFC_CLIARG_STREAM:
+			global->stream = true;
+			break;
+
+		default:
+			return false;
+	}
+
+	return true;
+}
+
+static bool ofc_cliarg_global_opts__set_num(
+	ofc_global_opts_t* global,
+	int arg_type, unsigned value)
+{
+	if (!global)
+		return false;
+
+	switch (arg_type)
+	{
+		case OFC_CLIARG_JOBS:
+			global->jobs = value;
+			break;
+
+		default:
+			return false;
+	}
+
+	return true;
+}
+
+static bool ofc_cliarg_global_opts__set_str(
+	ofc_global_opts_t* global,
+	int arg_type, const char* str)
+{
+	if (!global || !str)
+		return false;
+
+	switch (arg_type)
+	{
+		case OFC_CLIARG_OUTPUT_DIR:
+		{
+			char* output_dir = strdup(str);
+			if (!output_dir) return false;
+			free(global->output_dir);
+			global->output_dir = output_dir;
+			break;
+		}
 
 		default:
 			return false;
@@ -232,6 +298,7 @@ static const ofc_cliarg_body_t cliargs[] =
 	{ OFC_CLIARG_NO_WARN_PEDANTIC,      "no-warn-pedantic",      'p',  "Suppress all pedantic warnings",             OFC_CLIARG_PARAM_GLOB_NONE, 0, true  },
 	{ OFC_CLIARG_PARSE_ONLY,            "parse-only",            '\0', "Runs the parser only",                       OFC_CLIARG_PARAM_GLOB_NONE, 0, true  },
 	{ OFC_CLIARG_PARSE_TREE,            "parse-tree",            '\0', "Prints the parse tree",                      OFC_CLIARG_PARAM_GLOB_NONE, 0, true  },
+	{ OFC_CLIARG_PARSE_STATS,           "parse-stats",           '\0', "Prints parser memoization statistics",       OFC_CLIARG_PARAM_GLOB_NONE, 0, true  },
 	{ OFC_CLIARG_SEMA_TREE,             "sema-tree",             's',  "Prints the semantic analysis tree",          OFC_CLIARG_PARAM_GLOB_NONE, 0, true  },
 	{ OFC_CLIARG_FIXED_FORM,            "free-form",             '\0', "Sets free form type",                        OFC_CLIARG_PARAM_LANG_NONE, 0, true  },
 	{ OFC_CLIARG_FREE_FORM,             "fixed-form",            '\0', "Sets fixed form type",                       OFC_CLIARG_PARAM_LANG_NONE, 0, true  },
@@ -252,6 +319,14 @@ static const ofc_cliarg_body_t cliargs[] =
 	{ OFC_CLIARG_SEMA_UNUSED_DECL,      "sema-unused-decl",      '\0', "Enable unused declarations semantic pass",   OFC_CLIARG_PARAM_SEMA_PASS, 0, true  },
 	{ OFC_CLIARG_NO_ESCAPE,             "no-escape",             '\0', "Treat backslash as an ordinary character",   OFC_CLIARG_PARAM_GLOB_NONE, 0, true  },
 	{ OFC_CLIARG_COMMON_USAGE,          "common-usage",          '\0', "Print COMMON block usage for a file list",   OFC_CLIARG_PARAM_GLOB_NONE, 0, true  },
+	{ OFC_CLIARG_STORAGE_LAYOUT,        "storage-layout",        '\0', "Print COMMON and EQUIVALENCE storage layout", OFC_CLIARG_PARAM_GLOB_NONE, 0, true  },
+	{ OFC_CLIARG_COMMON_INDEX,          "common-index",          '\0', "Check COMMON block layouts across all files", OFC_CLIARG_PARAM_GLOB_NONE, 0, true  },
+	{ OFC_CLIARG_OUTPUT_DIR,            "output-dir",            '\0', "Write reprinted source for each file to <s>", OFC_CLIARG_PARAM_GLOB_STR,  1, true  },
+	{ OFC_CLIARG_CALL_GRAPH,            "call-graph",            '\0', "Check calls across all files, print the call graph", OFC_CLIARG_PARAM_GLOB_NONE, 0, true  },
+	{ OFC_CLIARG_JOBS,                  "jobs",                  '\0', "Use <n> threads for whole program analysis",  OFC_CLIARG_PARAM_GLOB_INT,  1, true  },
+	{ OFC_CLIARG_CFG,                   "cfg",                   '\0', "Print the control flow graph of each procedure", OFC_CLIARG_PARAM_GLOB_NONE, 0, true  },
+	{ OFC_CLIARG_DATAFLOW,              "dataflow",              '\0', "Warn about unset variables and unused assignments", OFC_CLIARG_PARAM_GLOB_NONE, 0, true  },
+	{ OFC_CLIARG_STREAM,                "stream",                '\0', "Process each program unit as it's parsed",     OFC_CLIARG_PARAM_GLOB_NONE, 0, true  },
 };
 
 static const char* ofc_cliarg_file_ext__get(
@@ -343,6 +418,10 @@ static bool ofc_cliarg__apply(
 	{
 		case OFC_CLIARG_PARAM_GLOB_NONE:
 			return ofc_cliarg_global_opts__set_flag(global_opts, arg_type);
+		case OFC_CLIARG_PARAM_GLOB_STR:
+			return ofc_cliarg_global_opts__set_str(global_opts, arg_type, arg->str);
+		case OFC_CLIARG_PARAM_GLOB_INT:
+			return ofc_cliarg_global_opts__set_num(global_opts, arg_type, arg->value);
 		case OFC_CLIARG_PARAM_LANG_NONE:
 			return ofc_cliarg_lang_opts__set_flag(lang_opts, arg_type);
 		case OFC_CLIARG_PARAM_LANG_INT:
@@ -476,6 +555,7 @@ bool ofc_cliarg_parse(
 						resolved_arg = ofc_cliarg_create(arg_body, NULL);
 						break;
 
+					case OFC_CLIARG_PARAM_GLOB_INT:
 					case OFC_CLIARG_PARAM_LANG_INT:
 					case OFC_CLIARG_PARAM_PRIN_INT:
 					{
@@ -490,6 +570,7 @@ bool ofc_cliarg_parse(
 						break;
 					}
 
+					case OFC_CLIARG_PARAM_GLOB_STR:
 					case OFC_CLIARG_PARAM_FILE_STR:
 					{
 						if (ofc_cliarg_param__resolve_str(argv[i]))
@@ -636,10 +717,12 @@ void ofc_cliarg_print_usage(const char* name)
 
 		switch (cliargs[i].param_type)
 		{
+			case OFC_CLIARG_PARAM_GLOB_INT:
 			case OFC_CLIARG_PARAM_LANG_INT:
 				line_len = printf("  --%s <n>", cliargs[i].name);
 				break;
 
+			case OFC_CLIARG_PARAM_GLOB_STR:
 			case OFC_CLIARG_PARAM_FILE_STR:
 				line_len = printf("  --%s <s>", cliargs[i].name);
 				break;
@@ -676,11 +759,13 @@ ofc_cliarg_t* ofc_cliarg_create(
 	{
 		switch (arg_body->param_type)
 		{
+			case OFC_CLIARG_PARAM_GLOB_INT:
 			case OFC_CLIARG_PARAM_LANG_INT:
 			case OFC_CLIARG_PARAM_PRIN_INT:
 				arg->value = *((int*)param);
 				break;
 
+			case OFC_CLIARG_PARAM_GLOB_STR:
 			case OFC_CLIARG_PARAM_FILE_STR:
 				arg->str = strdup((char*)param);
 				break;
@@ -699,7 +784,8 @@ void ofc_cliarg_delete(ofc_cliarg_t* arg)
 	if (!arg)
 		return;
 
-	if (arg->body->param_type == OFC_CLIARG_PARAM_FILE_STR)
+	if ((arg->body->param_type == OFC_CLIARG_PARAM_GLOB_STR)
+		|| (arg->body->param_type == OFC_CLIARG_PARAM_FILE_STR))
 		free (arg->str);
 
 	free(arg);
@@ -16,9 +16,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+#include <errno.h>
 
 #include "ofc/colstr.h"
 
+/* When streaming, completed lines are written out once this much
+   has been buffered rather than holding the whole output in memory. */
+#define OFC_COLSTR_CHUNK_SIZE 65536
 
 struct ofc_colstr_s
 {
@@ -29,12 +34,26 @@ struct ofc_colstr_s
 	unsigned col, col_max, col_ext;
 	bool oversize;
 	unsigned oversize_off;
+
+	int  fd;
+	bool flushed;
+
+	unsigned long written_bytes;
+	unsigned long written_lines;
 };
 
 
 ofc_colstr_t* ofc_colstr_create(
 	const ofc_print_opts_t print_opts,
 	unsigned cols, unsigned ext)
+{
+	return ofc_colstr_create_fd(
+		print_opts, cols, ext, -1);
+}
+
+ofc_colstr_t* ofc_colstr_create_fd(
+	const ofc_print_opts_t print_opts,
+	unsigned cols, unsigned ext, int fd)
 {
 	if (cols == 0)
 		cols = 72;
@@ -56,6 +75,11 @@ ofc_colstr_t* ofc_colstr_create(
 	cstr->col_max    = cols;
 	cstr->col_ext    = ext;
 	cstr->oversize   = false;
+	cstr->fd         = fd;
+	cstr->flushed    = false;
+
+	cstr->written_bytes = 0;
+	cstr->written_lines = 0;
 
 	return cstr;
 }
@@ -98,11 +122,64 @@ static bool ofc_colstr__enlarge(
 }
 
 
+static bool ofc_colstr__fdwrite(
+	ofc_colstr_t* cstr, int fd,
+	const char* base, unsigned size)
+{
+	cstr->written_bytes += size;
+
+	const char* end = &base[size];
+	const char* nl;
+	for (nl = memchr(base, '\n', size); nl;
+		nl = memchr(&nl[1], '\n', (end - &nl[1])))
+		cstr->written_lines++;
+
+	while (size > 0)
+	{
+		ssize_t w = write(fd, base, size);
+		if (w < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			return false;
+		}
+
+		base += w;
+		size -= w;
+	}
+
+	return true;
+}
+
+/* Only called at the start of a line, since the previous
+   line can't be modified after that point. */
+static bool ofc_colstr__flush(
+	ofc_colstr_t* cstr)
+{
+	if ((cstr->fd < 0) || (cstr->size < OFC_COLSTR_CHUNK_SIZE))
+		return true;
+
+	if (!ofc_colstr__fdwrite(cstr,
+		cstr->fd, cstr->base, cstr->size))
+		return false;
+
+	cstr->size    = 0;
+	cstr->flushed = true;
+	return true;
+}
+
 bool ofc_colstr_newline(
 	ofc_colstr_t* cstr, unsigned indent,
 	const unsigned* label)
 {
-	bool first = (cstr->size == 0);
+	/* The reserved space after oversized text stays blank once we've
+	   started a new line, so the previous line is now complete. */
+	cstr->oversize = false;
+
+	if (!ofc_colstr__flush(cstr))
+		return false;
+
+	bool first = ((cstr->size == 0) && !cstr->flushed);
 
 	if (!ofc_colstr__enlarge(cstr, (first ? 6 : 7)))
 		return false;
@@ -131,18 +208,26 @@ bool ofc_colstr_newline(
 	if (indent > cstr->print_opts.indent_max_level)
 		indent = cstr->print_opts.indent_max_level;
 
-	for (i = 0; i < indent; i++)
+	unsigned spaces = (indent * cstr->print_opts.indent_width);
+	if ((cstr->col + spaces) <= cstr->col_max)
+	{
+		if (!ofc_colstr__enlarge(cstr, spaces))
+			return false;
+
+		memset(&cstr->base[cstr->size], ' ', spaces);
+		cstr->size += spaces;
+		cstr->col  += spaces;
+	}
+	else
 	{
-		unsigned j;
-		for (j = 0; j < cstr->print_opts.indent_width; j++)
+		/* Indentation wider than a line must wrap like any other text. */
+		for (i = 0; i < spaces; i++)
 		{
-			if (!ofc_colstr_atomic_writef(cstr, " "))
+			if (!ofc_colstr_atomic_write_char(cstr, ' '))
 				return false;
 		}
 	}
 
-	cstr->oversize = false;
-
 	return true;
 }
 
@@ -532,6 +617,38 @@ bool ofc_colstr_atomic_write(
 	return true;
 }
 
+bool ofc_colstr_atomic_write_str(
+	ofc_colstr_t* cstr, const char* str)
+{
+	if (!str)
+		return false;
+
+	return ofc_colstr_atomic_write(
+		cstr, str, strlen(str));
+}
+
+bool ofc_colstr_atomic_write_char(
+	ofc_colstr_t* cstr, char c)
+{
+	return ofc_colstr_atomic_write(
+		cstr, &c, 1);
+}
+
+bool ofc_colstr_atomic_write_unsigned(
+	ofc_colstr_t* cstr, unsigned value)
+{
+	char buff[16];
+	unsigned i = sizeof(buff);
+	do
+	{
+		buff[--i] = '0' + (value % 10);
+		value /= 10;
+	} while (value > 0);
+
+	return ofc_colstr_atomic_write(
+		cstr, &buff[i], (sizeof(buff) - i));
+}
+
 bool ofc_colstr_atomic_writef(
 	ofc_colstr_t* cstr,
 	const char* format, ...)
@@ -539,6 +656,45 @@ bool ofc_colstr_atomic_writef(
 	va_list args;
 	va_start(args, format);
 
+	/* Most writes are punctuation, keywords or a single
+	   conversion, so avoid formatting those twice. */
+	if (!strchr(format, '%'))
+	{
+		va_end(args);
+		return ofc_colstr_atomic_write_str(cstr, format);
+	}
+	else if (strcmp(format, "%s") == 0)
+	{
+		const char* str = va_arg(args, const char*);
+		va_end(args);
+		return ofc_colstr_atomic_write_str(cstr, str);
+	}
+	else if (strcmp(format, "%u") == 0)
+	{
+		unsigned value = va_arg(args, unsigned);
+		va_end(args);
+		return ofc_colstr_atomic_write_unsigned(cstr, value);
+	}
+	else if (strcmp(format, "%c") == 0)
+	{
+		char c = (char)va_arg(args, int);
+		va_end(args);
+		return ofc_colstr_atomic_write_char(cstr, c);
+	}
+	else if (strcmp(format, "%.*s") == 0)
+	{
+		int size = va_arg(args, int);
+		const char* base = va_arg(args, const char*);
+		va_end(args);
+
+		if (size < 0)
+			return ofc_colstr_atomic_write_str(cstr, base);
+
+		const char* end = memchr(base, '\0', size);
+		if (end) size = (end - base);
+		return ofc_colstr_atomic_write(cstr, base, size);
+	}
+
 	va_list largs;
 	va_copy(largs, args);
 	int len = vsnprintf(NULL, 0, format, largs);
@@ -563,15 +719,29 @@ bool ofc_colstr_atomic_writef(
 
 bool ofc_colstr_fdprint(ofc_colstr_t* cstr, int fd)
 {
-	if (!cstr || !cstr->base)
+	if (!cstr || (!cstr->base && !cstr->flushed))
+		return false;
+
+	if (!ofc_colstr__enlarge(cstr, 1))
 		return false;
+	cstr->base[cstr->size++] = '\n';
 
-	return (dprintf(fd, "%.*s\n",
-		cstr->size, cstr->base) > 0);
+	bool success = ofc_colstr__fdwrite(
+		cstr, fd, cstr->base, cstr->size);
+	cstr->size = 0;
+	return success;
 }
 
 
 
+void ofc_colstr_written(
+	const ofc_colstr_t* cstr,
+	unsigned long* bytes, unsigned long* lines)
+{
+	if (bytes) *bytes = (cstr ? cstr->written_bytes : 0);
+	if (lines) *lines = (cstr ? cstr->written_lines : 0);
+}
+
 const ofc_print_opts_t* ofc_colstr_print_opts_get(const ofc_colstr_t* cstr)
 {
 	if (!cstr)
@@ -38,6 +38,10 @@ struct ofc_file_s
 	ofc_lang_opts_t          opts;
 	unsigned                 size;
 	unsigned                 ref;
+
+	/* Offset of the start of each row, for finding positions. */
+	unsigned  row_count;
+	unsigned* row;
 };
 
 
@@ -75,6 +79,49 @@ static char* ofc_file__read(const char* path, unsigned* size)
 	return buff;
 }
 
+/* Every vertical space character starts a new row. */
+static bool ofc_file__rows(ofc_file_t* file)
+{
+	unsigned count = 1;
+	unsigned i;
+	for (i = 0; i < file->size; i++)
+	{
+		if (ofc_is_vspace(file->strz[i]))
+			count++;
+	}
+
+	file->row = (unsigned*)malloc(
+		sizeof(unsigned) * count);
+	if (!file->row) return false;
+
+	file->row[0] = 0;
+	file->row_count = 1;
+	for (i = 0; i < file->size; i++)
+	{
+		if (ofc_is_vspace(file->strz[i]))
+			file->row[file->row_count++] = (i + 1);
+	}
+
+	return true;
+}
+
+/* Returns the row containing pos by binary search of the row starts. */
+static unsigned ofc_file__row(
+	const ofc_file_t* file, unsigned pos)
+{
+	unsigned first = 0;
+	unsigned last  = file->row_count;
+	while ((last - first) > 1)
+	{
+		unsigned mid = first + ((last - first) / 2);
+		if (file->row[mid] <= pos)
+			first = mid;
+		else
+			last = mid;
+	}
+	return first;
+}
+
 ofc_file_t* ofc_file_create(const char* path, ofc_lang_opts_t opts)
 {
 	ofc_file_t* file = (ofc_file_t*)malloc(sizeof(ofc_file_t));
@@ -89,7 +136,11 @@ ofc_file_t* ofc_file_create(const char* path, ofc_lang_opts_t opts)
 
 	file->ref = 0;
 
-	if (!file->path || !file->strz)
+	file->row_count = 0;
+	file->row       = NULL;
+
+	if (!file->path || !file->strz
+		|| !ofc_file__rows(file))
 	{
 		ofc_file_delete(file);
 		return NULL;
@@ -231,6 +282,7 @@ void ofc_file_delete(ofc_file_t* file)
 		return;
 	}
 
+	free(file->row);
 	free(file->strz);
 	free(file->path);
 
@@ -277,25 +329,9 @@ bool ofc_file_get_position(
 	if (pos >= file->size)
 		return false;
 
-	/* TODO - Use binary tree of line positions to find faster. */
-	unsigned i, r, c;
-	for (i = 0, r = 0, c = 0; i < pos; i++)
-	{
-		switch (file->strz[i])
-		{
-			case '\r':
-			case '\n':
-				r += 1;
-				c = 0;
-				break;
-			default:
-				c++;
-				break;
-		}
-	}
-
+	unsigned r = ofc_file__row(file, pos);
 	if (row) *row = r;
-	if (col) *col = c;
+	if (col) *col = (pos - file->row[r]);
 	return true;
 }
 
@@ -463,27 +499,17 @@ static void ofc_file__debug_va(
 		if (!sol)
 			sol = ptr;
 
-		const char* s = file->strz;
-		const char* p;
-		for (p = file->strz; p < sol; p++)
-		{
-			if (ofc_is_vspace(*p))
-				s = &p[1];
-		}
+		unsigned r = ofc_file__row(file,
+			((uintptr_t)sol - (uintptr_t)file->strz));
+		const char* s = &file->strz[file->row[r]];
 
 		unsigned len = ((uintptr_t)ptr - (uintptr_t)s);
 		for (; !ofc_is_vspace(s[len]) && (s[len] != '\0'); len++);
 
 		/* Print line(s) above if line is empty. */
-		while (line_empty(s, len)
-			&& (s != file->strz))
+		while (line_empty(s, len) && (r > 0))
 		{
-			const char* ns = file->strz;
-			for (p = file->strz; p < s; p++)
-			{
-				if (ofc_is_vspace(*p))
-					ns = &p[1];
-			}
+			const char* ns = &file->strz[file->row[--r]];
 			len += ((uintptr_t)s - (uintptr_t)ns);
 			s = ns;
 		}
@@ -498,12 +524,19 @@ static void ofc_file__debug_va(
 }
 
 static unsigned ofc_file__error_count = 0;
+static unsigned ofc_file__warning_count = 0;
 
 bool ofc_file_no_errors(void)
 {
 	return (ofc_file__error_count == 0);
 }
 
+unsigned ofc_file_diagnostic_count(void)
+{
+	return (ofc_file__error_count
+		+ ofc_file__warning_count);
+}
+
 void ofc_file_error_va(
 	const ofc_file_t* file,
 	const char* sol, const char* ptr,
@@ -524,6 +557,7 @@ void ofc_file_warning_va(
 		ofc_file__debug_va(
 			file, sol, ptr, "Warning", format, args);
 	}
+	ofc_file__warning_count++;
 }
 
 
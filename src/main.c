@@ -17,6 +17,10 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/stat.h>
 
 #include "ofc/file.h"
 #include "ofc/parse/file.h"
@@ -26,6 +30,429 @@
 
 ofc_global_opts_t global_opts;
 
+
+/* Identities of the files written by --output-dir, used to catch
+   two inputs which map onto the same output. */
+typedef struct
+{
+	unsigned count;
+	dev_t*   dev;
+	ino_t*   ino;
+} ofc_main__output_t;
+
+static void ofc_main__output_cleanup(
+	ofc_main__output_t* output)
+{
+	free(output->dev);
+	free(output->ino);
+	output->dev   = NULL;
+	output->ino   = NULL;
+	output->count = 0;
+}
+
+static bool ofc_main__output_add(
+	ofc_main__output_t* output, dev_t dev, ino_t ino)
+{
+	dev_t* ndev = (dev_t*)realloc(output->dev,
+		sizeof(dev_t) * (output->count + 1));
+	if (!ndev) return false;
+	output->dev = ndev;
+
+	ino_t* nino = (ino_t*)realloc(output->ino,
+		sizeof(ino_t) * (output->count + 1));
+	if (!nino) return false;
+	output->ino = nino;
+
+	output->dev[output->count] = dev;
+	output->ino[output->count] = ino;
+	output->count++;
+	return true;
+}
+
+/* Builds the path mirroring a source file under dir. Empty and '.'
+   components are dropped, the rest are escaped so that distinct
+   paths never map to the same output: '%' becomes "%25", '..' becomes
+   "%2E%2E" and the root of an absolute path becomes "%2F". */
+static char* ofc_main__output_path(
+	const char* dir, const char* path)
+{
+	if (!dir || !path)
+		return NULL;
+
+	unsigned dir_len = strlen(dir);
+	unsigned path_len = strlen(path);
+	char* opath = (char*)malloc(
+		dir_len + (path_len * 3) + 8);
+	if (!opath) return NULL;
+
+	memcpy(opath, dir, dir_len);
+	unsigned o = dir_len;
+
+	if (path[0] == '/')
+	{
+		memcpy(&opath[o], "/%2F", 4);
+		o += 4;
+	}
+
+	bool named = false;
+	const char* c = path;
+	while (*c != '\0')
+	{
+		const char* n = strchr(c, '/');
+		unsigned len = (n ? (unsigned)(n - c) : strlen(c));
+
+		bool skip = ((len == 0)
+			|| ((len == 1) && (c[0] == '.')));
+		bool up = ((len == 2)
+			&& (c[0] == '.') && (c[1] == '.'));
+
+		if (up)
+		{
+			memcpy(&opath[o], "/%2E%2E", 7);
+			o += 7;
+		}
+		else if (!skip)
+		{
+			opath[o++] = '/';
+
+			unsigned i;
+			for (i = 0; i < len; i++)
+			{
+				if (c[i] == '%')
+				{
+					memcpy(&opath[o], "%25", 3);
+					o += 3;
+				}
+				else
+				{
+					opath[o++] = c[i];
+				}
+			}
+		}
+
+		/* The last component must name the file itself. */
+		named = (!n && !skip && !up);
+
+		c += len;
+		if (*c == '/') c++;
+	}
+	opath[o] = '\0';
+
+	if (!named)
+	{
+		free(opath);
+		return NULL;
+	}
+
+	return opath;
+}
+
+/* Opens the output mirroring file under dir, refusing to write over
+   the input or over the output of an earlier input. */
+static int ofc_main__output_open(
+	const char* dir, const ofc_file_t* file,
+	ofc_main__output_t* output)
+{
+	const char* path = ofc_file_get_path(file);
+
+	char* opath = ofc_main__output_path(dir, path);
+	if (!opath)
+	{
+		ofc_file_error(file, NULL,
+			"Can't mirror '%s' under output directory", path);
+		return -1;
+	}
+
+	/* Create each directory in the output path. */
+	unsigned i;
+	for (i = strlen(dir); opath[i] != '\0'; i++)
+	{
+		if (opath[i] != '/')
+			continue;
+
+		opath[i] = '\0';
+		bool made = ((mkdir(opath, 0777) == 0)
+			|| (errno == EEXIST));
+		opath[i] = '/';
+
+		if (!made)
+		{
+			ofc_file_error(file, NULL,
+				"Failed to create output directory for '%s'", opath);
+			free(opath);
+			return -1;
+		}
+	}
+
+	struct stat in;
+	if (stat(path, &in) != 0)
+	{
+		ofc_file_error(file, NULL,
+			"Failed to stat input file '%s'", path);
+		free(opath);
+		return -1;
+	}
+
+	/* Not truncated until we know it's safe to overwrite. */
+	int fd = open(opath, (O_WRONLY | O_CREAT), 0666);
+	struct stat out;
+	if ((fd < 0) || (fstat(fd, &out) != 0))
+	{
+		ofc_file_error(file, NULL,
+			"Failed to open output file '%s'", opath);
+		if (fd >= 0) close(fd);
+		free(opath);
+		return -1;
+	}
+
+	if ((out.st_dev == in.st_dev)
+		&& (out.st_ino == in.st_ino))
+	{
+		ofc_file_error(file, NULL,
+			"Output file '%s' is the input file", opath);
+		close(fd);
+		free(opath);
+		return -1;
+	}
+
+	for (i = 0; i < output->count; i++)
+	{
+		if ((out.st_dev == output->dev[i])
+			&& (out.st_ino == output->ino[i]))
+		{
+			ofc_file_error(file, NULL,
+				"Output file '%s' was already written for another input", opath);
+			close(fd);
+			free(opath);
+			return -1;
+		}
+	}
+
+	if (!ofc_main__output_add(output, out.st_dev, out.st_ino)
+		|| (ftruncate(fd, 0) != 0))
+	{
+		ofc_file_error(file, NULL,
+			"Failed to open output file '%s'", opath);
+		close(fd);
+		free(opath);
+		return -1;
+	}
+
+	free(opath);
+	return fd;
+}
+
+/* Releases everything main owns on every exit path. */
+static void ofc_main__cleanup(
+	ofc_sema_common_index_t* common_index,
+	ofc_sema_scope_t* super,
+	ofc_file_list_t* file_list,
+	ofc_main__output_t* output)
+{
+	ofc_sema_common_index_delete(common_index);
+	ofc_sema_scope_delete(super);
+	ofc_file_list_delete(file_list);
+
+	if (output)
+		ofc_main__output_cleanup(output);
+
+	free(global_opts.output_dir);
+	global_opts.output_dir = NULL;
+}
+
+static double ofc_main__time(void)
+{
+	struct timespec ts;
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+		return 0.0;
+	return ts.tv_sec + (ts.tv_nsec / 1000000000.0);
+}
+
+
+/* Per unit work for --stream. */
+static bool ofc_main__stream_unit(
+	ofc_file_t* file, ofc_sema_scope_t* unit,
+	ofc_print_opts_t print_opts,
+	ofc_sema_pass_opts_t* sema_pass_opts,
+	ofc_colstr_t* output)
+{
+	if (!ofc_sema_run_passes(file, sema_pass_opts, unit))
+		return false;
+
+	if (global_opts.sema_print)
+	{
+		ofc_colstr_t* cs = ofc_colstr_create_fd(
+			print_opts, 72, 0, STDOUT_FILENO);
+		bool success = (cs && ofc_sema_scope_unit_print(cs, 0, unit));
+		ofc_colstr_fdprint(cs, STDOUT_FILENO);
+		ofc_colstr_delete(cs);
+		if (!success)
+		{
+			ofc_file_error(file, NULL, "Failed to print semantic tree");
+			return false;
+		}
+	}
+
+	if (output && !ofc_sema_scope_unit_print(output, 0, unit))
+	{
+		ofc_file_error(file, NULL, "Failed to write output file");
+		return false;
+	}
+
+	if (global_opts.common_usage_print)
+		ofc_sema_scope_common_usage_print(unit);
+
+	if (global_opts.storage_layout_print
+		&& !ofc_sema_scope_storage_print(unit))
+	{
+		ofc_file_error(file, NULL, "Failed to print storage layout");
+		return false;
+	}
+
+	if (global_opts.cfg_print
+		&& !ofc_sema_scope_cfg_print(unit))
+	{
+		ofc_file_error(file, NULL, "Failed to build control flow graph");
+		return false;
+	}
+
+	if (global_opts.dataflow_warn
+		&& !ofc_sema_scope_dataflow_warn(unit))
+	{
+		ofc_file_error(file, NULL, "Failed to analyze data flow");
+		return false;
+	}
+
+	/* Only whole program analysis needs statements after this. */
+	if (!global_opts.call_graph_print)
+		ofc_sema_scope_release_stmt(unit);
+
+	/* Keep printf output ahead of the next unit's colstr output. */
+	fflush(stdout);
+	return true;
+}
+
+/* Parses, analyses and prints a file one program unit at a time,
+   releasing the parse tree of each unit once it's been handled.
+   On success *sema is the global scope, which owns the parse file. */
+static bool ofc_main__stream(
+	ofc_file_t* file, ofc_sparse_t* condense,
+	ofc_sema_scope_t* super,
+	ofc_print_opts_t print_opts,
+	ofc_sema_pass_opts_t* sema_pass_opts,
+	ofc_colstr_t* output,
+	ofc_sema_scope_t** sema)
+{
+	ofc_parse_file_t* program
+		= ofc_parse_file_stream(condense);
+	if (!program)
+	{
+		ofc_sparse_delete(condense);
+		return false;
+	}
+
+	/* The global scope owns program once it exists. */
+	ofc_sema_scope_t* global = NULL;
+	if (!global_opts.parse_only)
+	{
+		global = ofc_sema_scope_global_stream(super, program);
+		if (!global)
+		{
+			ofc_parse_file_delete(program);
+			return false;
+		}
+	}
+
+	if (global_opts.common_usage_print
+		|| global_opts.storage_layout_print
+		|| global_opts.cfg_print)
+	{
+		const char* path = ofc_file_get_path(file);
+		if (path) printf("%s:\n", path);
+		fflush(stdout);
+	}
+
+	bool success = true;
+	while (success)
+	{
+		if (!ofc_parse_file_next(program))
+		{
+			if (ofc_file_no_errors())
+				ofc_file_error(file, NULL, "Failed to parse program");
+			success = false;
+			break;
+		}
+
+		const ofc_parse_stmt_list_t* list = program->stmt;
+		if (list->count == 0)
+			break;
+
+		if (global_opts.parse_print)
+		{
+			ofc_colstr_t* cs = ofc_colstr_create_fd(
+				print_opts, 72, 0, STDOUT_FILENO);
+			success = (cs && ofc_parse_stmt_list_print(cs, 0, list));
+			ofc_colstr_fdprint(cs, STDOUT_FILENO);
+			ofc_colstr_delete(cs);
+			if (!success)
+			{
+				ofc_file_error(file, NULL, "Failed to print parse tree");
+				break;
+			}
+		}
+
+		if (!global)
+		{
+			if (output && !ofc_parse_stmt_list_print(output, 0, list))
+			{
+				ofc_file_error(file, NULL, "Failed to write output file");
+				success = false;
+			}
+			continue;
+		}
+
+		unsigned i;
+		for (i = 0; success && (i < list->count); i++)
+		{
+			ofc_sema_scope_t* unit = NULL;
+			if (!ofc_sema_scope_global_add(
+				global, list->stmt[i], &unit))
+			{
+				if (ofc_file_no_errors())
+					ofc_file_error(file, NULL, "Program failed semantic analysis");
+				success = false;
+			}
+			else if (unit)
+			{
+				success = ofc_main__stream_unit(
+					file, unit, print_opts, sema_pass_opts, output);
+			}
+		}
+	}
+
+	/* Matches the blank line ending ofc_parse_file_print. */
+	if (success && global_opts.parse_print)
+	{
+		printf("\n");
+		fflush(stdout);
+	}
+
+	if (success && global
+		&& !ofc_sema_scope_global_end(global))
+	{
+		if (ofc_file_no_errors())
+			ofc_file_error(file, NULL, "Program failed semantic analysis");
+		success = false;
+	}
+
+	if (!global)
+		ofc_parse_file_delete(program);
+
+	*sema = global;
+	return success;
+}
+
+
 int main(int argc, const char* argv[])
 {
 	global_opts = OFC_GLOBAL_OPTS_DEFAULT;
@@ -38,7 +465,7 @@ int main(int argc, const char* argv[])
 	if (!ofc_cliarg_parse(argc, argv, &file_list,
 		&print_opts, &global_opts, &sema_pass_opts))
 	{
-		ofc_file_list_delete(file_list);
+		ofc_main__cleanup(NULL, NULL, file_list, NULL);
 		return EXIT_FAILURE;
 	}
 
@@ -46,10 +473,28 @@ int main(int argc, const char* argv[])
 		= ofc_sema_scope_super();
 	if (!super)
 	{
-		ofc_file_list_delete(file_list);
+		ofc_main__cleanup(NULL, NULL, file_list, NULL);
 		return EXIT_FAILURE;
 	}
 
+	ofc_sema_common_index_t* common_index = NULL;
+	if (global_opts.common_index_print)
+	{
+		common_index = ofc_sema_common_index_create(
+			global_opts.case_sensitive);
+		if (!common_index)
+		{
+			ofc_main__cleanup(NULL, super, file_list, NULL);
+			return EXIT_FAILURE;
+		}
+	}
+
+	ofc_main__output_t output_written = { 0, NULL, NULL };
+	double output_start = ofc_main__time();
+	unsigned      output_files = 0;
+	unsigned long output_bytes = 0;
+	unsigned long output_lines = 0;
+
 	unsigned i;
 	for (i = 0; i < file_list->count; i++)
 	{
@@ -60,11 +505,73 @@ int main(int argc, const char* argv[])
 		{
 			if (ofc_file_no_errors())
 				ofc_file_error(file, NULL, "Failed to preprocess source file");
-			ofc_sema_scope_delete(super);
-			ofc_file_list_delete(file_list);
+			ofc_main__cleanup(common_index, super, file_list, &output_written);
 			return EXIT_FAILURE;
 		}
 
+		if (global_opts.stream)
+		{
+			ofc_colstr_t* output = NULL;
+			int fd = -1;
+			if (global_opts.output_dir)
+			{
+				fd = ofc_main__output_open(
+					global_opts.output_dir, file, &output_written);
+				output = (fd >= 0 ? ofc_colstr_create_fd(
+					print_opts, 72, 0, fd) : NULL);
+				if (!output)
+				{
+					if (fd >= 0)
+					{
+						ofc_file_error(file, NULL, "Failed to open output file");
+						close(fd);
+					}
+					ofc_sparse_delete(condense);
+					ofc_main__cleanup(common_index, super, file_list, &output_written);
+					return EXIT_FAILURE;
+				}
+			}
+
+			ofc_sema_scope_t* sema = NULL;
+			bool success = ofc_main__stream(file, condense, super,
+				print_opts, &sema_pass_opts, output, &sema);
+
+			if (output)
+			{
+				if (success && !sema)
+					success = ofc_colstr_writef(output, "\n");
+				if (!ofc_colstr_fdprint(output, fd) && success)
+				{
+					ofc_file_error(file, NULL, "Failed to write output file");
+					success = false;
+				}
+
+				unsigned long bytes, lines;
+				ofc_colstr_written(output, &bytes, &lines);
+				output_files += 1;
+				output_bytes += bytes;
+				output_lines += lines;
+
+				ofc_colstr_delete(output);
+				close(fd);
+			}
+
+			if (success && common_index && sema
+				&& !ofc_sema_common_index_add_scope(
+					common_index, ofc_file_get_path(file), sema))
+			{
+				ofc_file_error(file, NULL, "Failed to index COMMON blocks");
+				success = false;
+			}
+
+			if (!success)
+			{
+				ofc_main__cleanup(common_index, super, file_list, &output_written);
+				return EXIT_FAILURE;
+			}
+			continue;
+		}
+
 		ofc_parse_file_t* program
 			= ofc_parse_file(condense);
 		if (!program)
@@ -72,20 +579,19 @@ int main(int argc, const char* argv[])
 			if (ofc_file_no_errors())
 				ofc_file_error(file, NULL, "Failed to parse program");
 			ofc_sparse_delete(condense);
-			ofc_sema_scope_delete(super);
-			ofc_file_list_delete(file_list);
+			ofc_main__cleanup(common_index, super, file_list, &output_written);
 			return EXIT_FAILURE;
 		}
 
 		if (global_opts.parse_print)
 		{
-			ofc_colstr_t* cs = ofc_colstr_create(print_opts, 72, 0);
+			ofc_colstr_t* cs = ofc_colstr_create_fd(
+				print_opts, 72, 0, STDOUT_FILENO);
 			if (!ofc_parse_file_print(cs, program))
 			{
 				ofc_file_error(file, NULL, "Failed to print parse tree");
 				ofc_parse_file_delete(program);
-				ofc_sema_scope_delete(super);
-				ofc_file_list_delete(file_list);
+				ofc_main__cleanup(common_index, super, file_list, &output_written);
 				return EXIT_FAILURE;
 			}
 			ofc_colstr_fdprint(cs, STDOUT_FILENO);
@@ -101,43 +607,160 @@ int main(int argc, const char* argv[])
 				if (ofc_file_no_errors())
 					ofc_file_error(file, NULL, "Program failed semantic analysis");
 				ofc_parse_file_delete(program);
-				ofc_sema_scope_delete(super);
-				ofc_file_list_delete(file_list);
+				ofc_main__cleanup(common_index, super, file_list, &output_written);
 				return EXIT_FAILURE;
 			}
 		}
 
-		if (!ofc_sema_run_passes(file, &sema_pass_opts, sema))
+		if (sema && !ofc_sema_run_passes(file, &sema_pass_opts, sema))
 		{
-			ofc_sema_scope_delete(super);
-			ofc_file_list_delete(file_list);
+			ofc_main__cleanup(common_index, super, file_list, &output_written);
 			return EXIT_FAILURE;
 		}
 
 		if (global_opts.sema_print)
 		{
-			ofc_colstr_t* cs = ofc_colstr_create(print_opts, 72, 0);
+			ofc_colstr_t* cs = ofc_colstr_create_fd(
+				print_opts, 72, 0, STDOUT_FILENO);
 			if (!ofc_sema_scope_print(cs, 0, sema))
 			{
 				ofc_file_error(file, NULL, "Failed to print semantic tree");
 				ofc_colstr_delete(cs);
-				ofc_sema_scope_delete(super);
-				ofc_file_list_delete(file_list);
+				ofc_main__cleanup(common_index, super, file_list, &output_written);
 				return EXIT_FAILURE;
 			}
 			ofc_colstr_fdprint(cs, STDOUT_FILENO);
 			ofc_colstr_delete(cs);
 		}
 
+		if (global_opts.output_dir)
+		{
+			/* The parse tree is reprinted when there's no semantic tree. */
+			int fd = ofc_main__output_open(
+				global_opts.output_dir, file, &output_written);
+			if (fd < 0)
+			{
+				ofc_main__cleanup(common_index, super, file_list, &output_written);
+				return EXIT_FAILURE;
+			}
+
+			ofc_colstr_t* cs = ofc_colstr_create_fd(
+				print_opts, 72, 0, fd);
+			bool success = (cs && (sema
+				? ofc_sema_scope_print(cs, 0, sema)
+				: ofc_parse_file_print(cs, program)));
+			if (!ofc_colstr_fdprint(cs, fd))
+				success = false;
+
+			unsigned long bytes, lines;
+			ofc_colstr_written(cs, &bytes, &lines);
+			output_files += 1;
+			output_bytes += bytes;
+			output_lines += lines;
+
+			ofc_colstr_delete(cs);
+			close(fd);
+
+			if (!success)
+			{
+				ofc_file_error(file, NULL, "Failed to write output file");
+				ofc_main__cleanup(common_index, super, file_list, &output_written);
+				return EXIT_FAILURE;
+			}
+		}
+
 		if (global_opts.common_usage_print)
 		{
 			const char* path = ofc_file_get_path(file);
 			if (path) printf("%s:\n", path);
 			ofc_sema_scope_common_usage_print(sema);
 		}
+
+		if (global_opts.storage_layout_print && sema)
+		{
+			const char* path = ofc_file_get_path(file);
+			if (path) printf("%s:\n", path);
+			if (!ofc_sema_scope_storage_print(sema))
+			{
+				ofc_file_error(file, NULL, "Failed to print storage layout");
+				ofc_main__cleanup(common_index, super, file_list, &output_written);
+				return EXIT_FAILURE;
+			}
+		}
+
+		if (global_opts.cfg_print && sema)
+		{
+			const char* path = ofc_file_get_path(file);
+			if (path) printf("%s:\n", path);
+			if (!ofc_sema_scope_cfg_print(sema))
+			{
+				ofc_file_error(file, NULL, "Failed to build control flow graph");
+				ofc_main__cleanup(common_index, super, file_list, &output_written);
+				return EXIT_FAILURE;
+			}
+		}
+
+		if (global_opts.dataflow_warn && sema
+			&& !ofc_sema_scope_dataflow_warn(sema))
+		{
+			ofc_file_error(file, NULL, "Failed to analyze data flow");
+			ofc_main__cleanup(common_index, super, file_list, &output_written);
+			return EXIT_FAILURE;
+		}
+
+		if (common_index && sema
+			&& !ofc_sema_common_index_add_scope(
+				common_index, ofc_file_get_path(file), sema))
+		{
+			ofc_file_error(file, NULL, "Failed to index COMMON blocks");
+			ofc_main__cleanup(common_index, super, file_list, &output_written);
+			return EXIT_FAILURE;
+		}
 	}
 
-	ofc_sema_scope_delete(super);
-	ofc_file_list_delete(file_list);
+	if (common_index)
+	{
+		ofc_sema_common_index_print(common_index);
+
+		unsigned mismatch
+			= ofc_sema_common_index_mismatch_count(common_index);
+		if (mismatch > 0)
+		{
+			ofc_file_warning(NULL, NULL,
+				"%u COMMON block(s) declared with more than one layout",
+				mismatch);
+		}
+	}
+
+	if (global_opts.call_graph_print)
+	{
+		ofc_sema_call_graph_t* graph
+			= ofc_sema_call_graph_create(super);
+		if (!graph || !ofc_sema_call_graph_analyse(
+			graph, global_opts.jobs))
+		{
+			ofc_file_error(NULL, NULL, "Failed to analyse call graph");
+			ofc_sema_call_graph_delete(graph);
+			ofc_main__cleanup(common_index, super, file_list, &output_written);
+			return EXIT_FAILURE;
+		}
+
+		ofc_sema_call_graph_warn(graph);
+		ofc_sema_call_graph_print(graph);
+		ofc_sema_call_graph_delete(graph);
+	}
+
+	if (global_opts.output_dir)
+	{
+		double elapsed = ofc_main__time() - output_start;
+		if (elapsed <= 0.0) elapsed = 1e-9;
+
+		fprintf(stderr, "Wrote %u file(s), %lu lines (%lu bytes) in %.3fs,"
+			" %.0f lines/s, %.0f bytes/s\n",
+			output_files, output_lines, output_bytes, elapsed,
+			(output_lines / elapsed), (output_bytes / elapsed));
+	}
+
+	ofc_main__cleanup(common_index, super, file_list, &output_written);
 	return EXIT_SUCCESS;
 }
@@ -15,19 +15,64 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+#include "ofc/parse.h"
+
+/* Messages are only formatted if they survive to ofc_parse_debug_print,
+   most are discarded when a speculative parse is rewound, so we store
+   the format and its arguments and rewinding just resets the count. */
+
+#define OFC_PARSE_DEBUG_ARG_MAX 8
+
+/* Only the conversions parser warnings use are deferred:
+   %s, %.*s, %d, %u and %%, anything else is formatted eagerly. */
+typedef enum
+{
+	OFC_PARSE_DEBUG_ARG_STR,
+	OFC_PARSE_DEBUG_ARG_STR_LEN,
+	OFC_PARSE_DEBUG_ARG_INT,
+	OFC_PARSE_DEBUG_ARG_UNSIGNED,
+} ofc_parse_debug_arg_e;
 
-#include "ofc/parse/debug.h"
+typedef struct
+{
+	ofc_parse_debug_arg_e type;
+	int                   len;
+
+	union
+	{
+		const char* s;
+		int         i;
+		unsigned    u;
+	};
+} ofc_parse_debug_arg_t;
 
 typedef struct
 {
 	ofc_sparse_ref_t ref;
-	char*            message;
+	const char*      format;
+
+	unsigned              argc;
+	ofc_parse_debug_arg_t arg[OFC_PARSE_DEBUG_ARG_MAX];
+
+	/* Offset of the text of a message which couldn't be deferred,
+	   and the size of the text buffer when the message was pushed. */
+	bool     eager;
+	unsigned text;
+	unsigned text_base;
 } ofc_parse_debug_msg_t;
 
 struct ofc_parse_debug_s
 {
-	unsigned                count, max;
-	ofc_parse_debug_msg_t** message;
+	unsigned               count, max;
+	ofc_parse_debug_msg_t* message;
+
+	unsigned text_size, text_max;
+	char*    text;
+
+	ofc_parse_memo_t* memo;
 };
 
 
@@ -40,8 +85,26 @@ ofc_parse_debug_t* ofc_parse_debug_create(void)
 	if (!stack) return NULL;
 
 	stack->count   = 0;
-	stack->max     = 0;
-	stack->message = NULL;
+	stack->max     = 64;
+	stack->message = (ofc_parse_debug_msg_t*)malloc(
+		sizeof(ofc_parse_debug_msg_t) * stack->max);
+	if (!stack->message)
+	{
+		free(stack);
+		return NULL;
+	}
+
+	stack->text_size = 0;
+	stack->text_max  = 0;
+	stack->text      = NULL;
+
+	stack->memo = ofc_parse_memo_create();
+	if (!stack->memo)
+	{
+		free(stack->message);
+		free(stack);
+		return NULL;
+	}
 
 	return stack;
 }
@@ -51,18 +114,17 @@ void ofc_parse_debug_delete(ofc_parse_debug_t* stack)
 	if (!stack)
 		return;
 
-	unsigned i;
-	for (i = 0; i < stack->count; i++)
-	{
-		if (!stack->message[i])
-			continue;
-		free(stack->message[i]->message);
-		free(stack->message[i]);
-	}
+	ofc_parse_memo_delete(stack->memo);
+	free(stack->text);
 	free(stack->message);
 	free(stack);
 }
 
+ofc_parse_memo_t* ofc_parse_debug_memo(ofc_parse_debug_t* stack)
+{
+	return (stack ? stack->memo : NULL);
+}
+
 
 unsigned ofc_parse_debug_position(const ofc_parse_debug_t* stack)
 {
@@ -72,21 +134,150 @@ unsigned ofc_parse_debug_position(const ofc_parse_debug_t* stack)
 void ofc_parse_debug_rewind(
 	ofc_parse_debug_t* stack, unsigned position)
 {
-	if (!stack)
+	if (!stack || (position >= stack->count))
 		return;
 
+	stack->text_size = stack->message[position].text_base;
+	stack->count = position;
+}
+
+
+static bool ofc_parse_debug__defer(
+	ofc_parse_debug_msg_t* message,
+	const char* format, va_list args)
+{
+	ofc_parse_debug_arg_e type[OFC_PARSE_DEBUG_ARG_MAX];
+	unsigned argc = 0;
+
 	unsigned i;
-	for (i = position; i < stack->count; i++)
+	for (i = 0; format[i] != '\0'; i++)
 	{
-		if (!stack->message[i])
+		if (format[i] != '%')
+			continue;
+		i++;
+
+		if (format[i] == '%')
 			continue;
 
-		free(stack->message[i]->message);
-		free(stack->message[i]);
-		stack->message[i] = NULL;
+		if (argc >= OFC_PARSE_DEBUG_ARG_MAX)
+			return false;
+
+		if (strncmp(&format[i], ".*s", 3) == 0)
+		{
+			type[argc++] = OFC_PARSE_DEBUG_ARG_STR_LEN;
+			i += 2;
+		}
+		else if (format[i] == 's')
+			type[argc++] = OFC_PARSE_DEBUG_ARG_STR;
+		else if (format[i] == 'd')
+			type[argc++] = OFC_PARSE_DEBUG_ARG_INT;
+		else if (format[i] == 'u')
+			type[argc++] = OFC_PARSE_DEBUG_ARG_UNSIGNED;
+		else
+			return false;
 	}
 
-	stack->count = position;
+	for (i = 0; i < argc; i++)
+	{
+		ofc_parse_debug_arg_t* arg = &message->arg[i];
+		arg->type = type[i];
+		arg->len  = 0;
+
+		switch (type[i])
+		{
+			case OFC_PARSE_DEBUG_ARG_STR_LEN:
+				arg->len = va_arg(args, int);
+				arg->s   = va_arg(args, const char*);
+				break;
+			case OFC_PARSE_DEBUG_ARG_STR:
+				arg->s = va_arg(args, const char*);
+				break;
+			case OFC_PARSE_DEBUG_ARG_INT:
+				arg->i = va_arg(args, int);
+				break;
+			case OFC_PARSE_DEBUG_ARG_UNSIGNED:
+				arg->u = va_arg(args, unsigned);
+				break;
+		}
+	}
+
+	message->format = format;
+	message->argc   = argc;
+	return true;
+}
+
+static void ofc_parse_debug__put(
+	char* buff, unsigned size, unsigned* len,
+	const char* str, unsigned str_len)
+{
+	unsigned i;
+	for (i = 0; i < str_len; i++, (*len)++)
+	{
+		if ((*len + 1) < size)
+			buff[*len] = str[i];
+	}
+}
+
+/* Formats a deferred message like snprintf. */
+static unsigned ofc_parse_debug__render(
+	const ofc_parse_debug_msg_t* message,
+	char* buff, unsigned size)
+{
+	const char* format = message->format;
+	unsigned len = 0;
+	unsigned argc = 0;
+
+	unsigned i;
+	for (i = 0; format[i] != '\0'; i++)
+	{
+		if (format[i] != '%')
+		{
+			ofc_parse_debug__put(
+				buff, size, &len, &format[i], 1);
+			continue;
+		}
+		i++;
+
+		if (format[i] == '%')
+		{
+			ofc_parse_debug__put(
+				buff, size, &len, "%", 1);
+			continue;
+		}
+
+		const ofc_parse_debug_arg_t* arg
+			= &message->arg[argc++];
+
+		char num[16];
+		int w;
+		switch (arg->type)
+		{
+			case OFC_PARSE_DEBUG_ARG_STR_LEN:
+				i += 2;
+				w = strnlen(arg->s, (arg->len < 0 ? 0 : arg->len));
+				ofc_parse_debug__put(
+					buff, size, &len, arg->s, w);
+				break;
+			case OFC_PARSE_DEBUG_ARG_STR:
+				ofc_parse_debug__put(
+					buff, size, &len, arg->s, strlen(arg->s));
+				break;
+			case OFC_PARSE_DEBUG_ARG_INT:
+				w = snprintf(num, sizeof(num), "%d", arg->i);
+				ofc_parse_debug__put(
+					buff, size, &len, num, w);
+				break;
+			case OFC_PARSE_DEBUG_ARG_UNSIGNED:
+				w = snprintf(num, sizeof(num), "%u", arg->u);
+				ofc_parse_debug__put(
+					buff, size, &len, num, w);
+				break;
+		}
+	}
+
+	if (size > 0)
+		buff[(len < size) ? len : (size - 1)] = '\0';
+	return len;
 }
 
 void ofc_parse_debug_print(const ofc_parse_debug_t* stack)
@@ -97,18 +288,28 @@ void ofc_parse_debug_print(const ofc_parse_debug_t* stack)
 	unsigned i;
 	for (i = 0; i < stack->count; i++)
 	{
-		ofc_parse_debug_msg_t* message
-			= stack->message[i];
-		if (!message) continue;
+		const ofc_parse_debug_msg_t* message
+			= &stack->message[i];
+
+		if (message->eager)
+		{
+			ofc_sparse_ref_warning(message->ref,
+				"%s", &stack->text[message->text]);
+			continue;
+		}
+
+		unsigned len = ofc_parse_debug__render(
+			message, NULL, 0);
+		char text[len + 1];
+		ofc_parse_debug__render(
+			message, text, (len + 1));
 
 		ofc_sparse_ref_warning(message->ref,
-			"%s", message->message);
+			"%s", text);
 	}
 }
 
 
-#include <stdarg.h>
-
 static void ofc_parse_debug_message(
 	ofc_parse_debug_t* stack,
 	ofc_sparse_ref_t ref,
@@ -119,37 +320,60 @@ static void ofc_parse_debug_message(
 	if (!stack)
 		abort();
 
+	if (stack->count >= stack->max)
+	{
+		unsigned nmax = (stack->max << 1);
+		if (nmax == 0) nmax = 64;
+		ofc_parse_debug_msg_t* nstack
+			= (ofc_parse_debug_msg_t*)realloc(stack->message,
+				sizeof(ofc_parse_debug_msg_t) * nmax);
+		if (!nstack) abort();
+		stack->message = nstack;
+		stack->max = nmax;
+	}
+
 	ofc_parse_debug_msg_t* message
-		= (ofc_parse_debug_msg_t*)malloc(
-			sizeof(ofc_parse_debug_msg_t));
-	if (!message) abort();
+		= &stack->message[stack->count];
 
-	message->ref = ref;
+	message->ref       = ref;
+	message->eager     = false;
+	message->text      = 0;
+	message->text_base = stack->text_size;
 
 	va_list largs;
 	va_copy(largs, args);
-	int len = vsnprintf(NULL, 0, format, largs);
+	bool deferred = ofc_parse_debug__defer(
+		message, format, largs);
 	va_end(largs);
 
-	if (len <= 0) abort();
-
-	message->message = (char*)malloc(len + 1);
-	if (!message->message) abort();
-	vsprintf(message->message, format, args);
-
-	if (stack->count >= stack->max)
+	if (!deferred)
 	{
-		unsigned nmax = (stack->max << 1);
-		if (nmax == 0) nmax = 16;
-		ofc_parse_debug_msg_t** nstack
-			= (ofc_parse_debug_msg_t**)realloc(stack->message,
-				sizeof(ofc_parse_debug_msg_t*) * nmax);
-		if (!nstack) abort();
-		stack->message = nstack;
-		stack->max = nmax;
+		/* Formats we can't defer are written to the text buffer. */
+		va_copy(largs, args);
+		int len = vsnprintf(NULL, 0, format, largs);
+		va_end(largs);
+
+		if (len <= 0) abort();
+
+		unsigned nsize = stack->text_size + len + 1;
+		if (nsize > stack->text_max)
+		{
+			unsigned nmax = (stack->text_max << 1);
+			if (nmax < nsize) nmax = nsize;
+			char* ntext = (char*)realloc(stack->text, nmax);
+			if (!ntext) abort();
+			stack->text = ntext;
+			stack->text_max = nmax;
+		}
+
+		vsprintf(&stack->text[stack->text_size], format, args);
+
+		message->eager = true;
+		message->text  = stack->text_size;
+		stack->text_size = nsize;
 	}
 
-	stack->message[stack->count++] = message;
+	stack->count++;
 }
 
 void ofc_parse_debug_warning(
@@ -62,7 +62,7 @@ static ofc_parse_expr_t* ofc_parse_expr__literal(
 	}
 
 	expr->type    = OFC_PARSE_EXPR_CONSTANT;
-	expr->src     = ofc_sparse_ref(src, ptr, l);
+	expr->src     = ofc_sparse_loc(src, ptr, l);
 	expr->literal = literal;
 
 	if (len) *len = l;
@@ -95,7 +95,7 @@ ofc_parse_expr_t* ofc_parse_expr_integer(
 	}
 
 	expr->type    = OFC_PARSE_EXPR_CONSTANT;
-	expr->src     = ofc_sparse_ref(src, ptr, l);
+	expr->src     = ofc_sparse_loc(src, ptr, l);
 	expr->literal = literal;
 
 	if (len) *len = l;
@@ -128,7 +128,7 @@ ofc_parse_expr_t* ofc_parse_expr_integer_variable(
 	}
 
 	expr->type = OFC_PARSE_EXPR_VARIABLE;
-	expr->src  = ofc_sparse_ref(src, ptr, l);
+	expr->src  = ofc_sparse_loc(src, ptr, l);
 	expr->variable = variable;
 
 	if (len) *len = l;
@@ -161,7 +161,7 @@ static ofc_parse_expr_t* ofc_parse_expr__primary(
 		}
 
 		expr->type = OFC_PARSE_EXPR_VARIABLE;
-		expr->src  = ofc_sparse_ref(src, ptr, l);
+		expr->src  = ofc_sparse_loc(src, ptr, l);
 		expr->variable = variable;
 
 		if (len) *len = l;
@@ -195,7 +195,7 @@ static ofc_parse_expr_t* ofc_parse_expr__primary(
 	}
 
 	expr->type = OFC_PARSE_EXPR_BRACKETS;
-	expr->src  = ofc_sparse_ref(src, ptr, l);
+	expr->src  = ofc_sparse_loc(src, ptr, l);
 	expr->brackets.expr = expr_brackets;
 
 	if (len) *len = l;
@@ -242,7 +242,7 @@ static ofc_parse_expr_t* ofc_parse_expr__unary(
 	}
 
 	expr->type = OFC_PARSE_EXPR_UNARY;
-	expr->src  = ofc_sparse_ref(src, ptr, l);
+	expr->src  = ofc_sparse_loc(src, ptr, l);
 	expr->unary.operator = op;
 	expr->unary.a = expr_unary;
 
@@ -283,21 +283,21 @@ static bool ofc_parse_expr__cull_right_ambig_point(
 			if (expr->literal.type == OFC_PARSE_LITERAL_NUMBER)
 			{
 				expr->literal.number.size -= 1;
-				expr->src.string.size     -= 1;
+				expr->src.size     -= 1;
 			}
 			return true;
 
 		case OFC_PARSE_EXPR_UNARY:
 			if (ofc_parse_expr__cull_right_ambig_point(expr->unary.a))
 			{
-				expr->src.string.size -= 1;
+				expr->src.size -= 1;
 				return true;
 			}
 			break;
 		case OFC_PARSE_EXPR_BINARY:
 			if (ofc_parse_expr__cull_right_ambig_point(expr->binary.b))
 			{
-				expr->src.string.size -= 1;
+				expr->src.size -= 1;
 				return true;
 			}
 			break;
@@ -324,7 +324,7 @@ static ofc_parse_expr_t* ofc_parse_expr__binary_insert(
 		if (!expr) return NULL;
 
 		expr->type = OFC_PARSE_EXPR_BINARY;
-		if (!ofc_sparse_ref_bridge(
+		if (!ofc_sparse_loc_bridge(
 			a->src, b->src, &expr->src))
 			abort();
 
@@ -343,7 +343,7 @@ static ofc_parse_expr_t* ofc_parse_expr__binary_insert(
 		if (!c) return NULL;
 
 		a->unary.a = c;
-		if (!ofc_sparse_ref_bridge(
+		if (!ofc_sparse_loc_bridge(
 			a->src, c->src, &a->src))
 			abort();
 		return a;
@@ -355,7 +355,7 @@ static ofc_parse_expr_t* ofc_parse_expr__binary_insert(
 		if (!c) return NULL;
 
 		a->binary.b = c;
-		if (!ofc_sparse_ref_bridge(
+		if (!ofc_sparse_loc_bridge(
 			a->src, c->src, &a->src))
 			abort();
 		return a;
@@ -364,7 +364,9 @@ static ofc_parse_expr_t* ofc_parse_expr__binary_insert(
 	return NULL;
 }
 
+/* The expression a must start at ptr. */
 static ofc_parse_expr_t* ofc_parse_expr__binary(
+	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_expr_t* a,
 	ofc_parse_debug_t* debug,
 	bool no_slash)
@@ -373,9 +375,7 @@ static ofc_parse_expr_t* ofc_parse_expr__binary(
 
 	unsigned dpos = ofc_parse_debug_position(debug);
 
-	const ofc_sparse_t* src = a->src.sparse;
-	const char* ptr = a->src.string.base;
-	unsigned a_len = a->src.string.size;
+	unsigned a_len = a->src.size;
 
 	ofc_parse_operator_e op;
 	unsigned op_len = 0;
@@ -393,7 +393,7 @@ static ofc_parse_expr_t* ofc_parse_expr__binary(
 			&& (!no_slash || (op != OFC_PARSE_OPERATOR_DIVIDE)))
 		{
 			ofc_parse_expr__cull_right_ambig_point(a);
-			a_len = a->src.string.size;
+			a_len = a->src.size;
 		}
 		else
 		{
@@ -439,7 +439,7 @@ static ofc_parse_expr_t* ofc_parse_expr__binary(
 	return expr;
 }
 
-static ofc_parse_expr_t* ofc_parse__expr(
+static ofc_parse_expr_t* ofc_parse_expr__parse(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug,
 	unsigned* len, bool no_slash)
@@ -449,13 +449,43 @@ static ofc_parse_expr_t* ofc_parse__expr(
 	if (!a) return NULL;
 
 	ofc_parse_expr_t* c;
-	for (c = ofc_parse_expr__binary(a, debug, no_slash); c != NULL;
-		a = c, c = ofc_parse_expr__binary(a, debug, no_slash));
+	for (c = ofc_parse_expr__binary(src, ptr, a, debug, no_slash); c != NULL;
+		a = c, c = ofc_parse_expr__binary(src, ptr, a, debug, no_slash));
 
-	if (len) *len = a->src.string.size;
+	if (len) *len = a->src.size;
 	return a;
 }
 
+static ofc_parse_expr_t* ofc_parse__expr(
+	const ofc_sparse_t* src, const char* ptr,
+	ofc_parse_debug_t* debug,
+	unsigned* len, bool no_slash)
+{
+	ofc_parse_memo_e kind = (no_slash
+		? OFC_PARSE_MEMO_EXPR_NO_SLASH
+		: OFC_PARSE_MEMO_EXPR);
+	ofc_parse_memo_t* memo
+		= ofc_parse_debug_memo(debug);
+
+	ofc_parse_expr_t* expr;
+	unsigned l = 0;
+	if (ofc_parse_memo_find(
+		memo, kind, ptr, (void**)&expr, &l))
+	{
+		if (expr && len) *len = l;
+		return expr;
+	}
+
+	unsigned dpos = ofc_parse_debug_position(debug);
+	expr = ofc_parse_expr__parse(
+		src, ptr, debug, &l, no_slash);
+	ofc_parse_memo_store(memo, kind, ptr, expr, l,
+		(ofc_parse_debug_position(debug) == dpos));
+
+	if (expr && len) *len = l;
+	return expr;
+}
+
 ofc_parse_expr_t* ofc_parse_expr(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug,
@@ -489,7 +519,7 @@ ofc_parse_expr_t* ofc_parse_expr_id(
 		}
 
 		expr->type = OFC_PARSE_EXPR_IMPLICIT_DO;
-		expr->src  = ofc_sparse_ref(src, ptr, l);
+		expr->src  = ofc_sparse_loc(src, ptr, l);
 		expr->implicit_do = id;
 
 		if (len) *len = l;
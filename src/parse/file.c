@@ -14,6 +14,7 @@
  */
 
 #include "ofc/parse.h"
+#include "ofc/global_opts.h"
 
 
 unsigned ofc_parse_stmt_program_end(
@@ -76,8 +77,14 @@ ofc_parse_file_t* ofc_parse_file(ofc_sparse_t* src)
 		= ofc_parse_stmt_list_create();
 	if (!list) return NULL;
 
-	if (!ofc_parse_file_include(
-		src, list, debug))
+	bool success = ofc_parse_file_include(
+		src, list, debug);
+
+	if (global_opts.parse_stats)
+		ofc_parse_memo_print_stats(
+			ofc_parse_debug_memo(debug));
+
+	if (!success)
 	{
 		ofc_parse_debug_print(debug);
 		ofc_parse_debug_delete(debug);
@@ -103,6 +110,13 @@ ofc_parse_file_t* ofc_parse_file(ofc_sparse_t* src)
 
 	file->source = src;
 	file->stmt   = list;
+
+	file->debug  = NULL;
+	file->offset = 0;
+	file->stage  = 0;
+
+	file->include_count = 0;
+	file->include       = NULL;
 	return file;
 }
 
@@ -112,10 +126,251 @@ void ofc_parse_file_delete(ofc_parse_file_t* file)
 		return;
 
 	ofc_parse_stmt_list_delete(file->stmt);
+
+	unsigned i;
+	for (i = 0; i < file->include_count; i++)
+		ofc_sparse_delete(file->include[i]);
+	free(file->include);
+
+	ofc_parse_debug_delete(file->debug);
 	ofc_sparse_delete(file->source);
 	free(file);
 }
 
+
+ofc_parse_file_t* ofc_parse_file_stream(ofc_sparse_t* src)
+{
+	ofc_parse_file_t* file
+		= (ofc_parse_file_t*)malloc(
+			sizeof(ofc_parse_file_t));
+	if (!file) return NULL;
+
+	file->stmt  = ofc_parse_stmt_list_create();
+	file->debug = ofc_parse_debug_create();
+	if (!file->stmt || !file->debug)
+	{
+		ofc_parse_stmt_list_delete(file->stmt);
+		ofc_parse_debug_delete(file->debug);
+		free(file);
+		return NULL;
+	}
+
+	file->source = src;
+	file->offset = 0;
+	file->stage  = 0;
+
+	file->include_count = 0;
+	file->include       = NULL;
+	return file;
+}
+
+static bool ofc_parse_file__keep_include(
+	ofc_parse_file_t* file,
+	const ofc_parse_stmt_list_t* list)
+{
+	if (!list)
+		return true;
+
+	unsigned i;
+	for (i = 0; i < list->count; i++)
+	{
+		const ofc_parse_stmt_t* stmt = list->stmt[i];
+		if (!stmt) continue;
+
+		bool success = true;
+		switch (stmt->type)
+		{
+			case OFC_PARSE_STMT_INCLUDE:
+			{
+				if (!stmt->include.src)
+					break;
+
+				ofc_sparse_t** include
+					= (ofc_sparse_t**)realloc(file->include,
+						(sizeof(ofc_sparse_t*) * (file->include_count + 1)));
+				if (!include) return false;
+				file->include = include;
+
+				if (!ofc_sparse_reference(stmt->include.src))
+					return false;
+				file->include[file->include_count++]
+					= stmt->include.src;
+				break;
+			}
+
+			case OFC_PARSE_STMT_PROGRAM:
+			case OFC_PARSE_STMT_SUBROUTINE:
+			case OFC_PARSE_STMT_FUNCTION:
+			case OFC_PARSE_STMT_BLOCK_DATA:
+			case OFC_PARSE_STMT_MODULE:
+				success = ofc_parse_file__keep_include(
+					file, stmt->program.body);
+				break;
+
+			case OFC_PARSE_STMT_IF_THEN:
+				success = (ofc_parse_file__keep_include(
+						file, stmt->if_then.block_then)
+					&& ofc_parse_file__keep_include(
+						file, stmt->if_then.block_else));
+				break;
+
+			case OFC_PARSE_STMT_DO_BLOCK:
+				success = ofc_parse_file__keep_include(
+					file, stmt->do_block.block);
+				break;
+
+			case OFC_PARSE_STMT_DO_WHILE_BLOCK:
+				success = ofc_parse_file__keep_include(
+					file, stmt->do_while_block.block);
+				break;
+
+			case OFC_PARSE_STMT_STRUCTURE:
+			case OFC_PARSE_STMT_UNION:
+			case OFC_PARSE_STMT_MAP:
+			case OFC_PARSE_STMT_TYPE:
+				success = ofc_parse_file__keep_include(
+					file, stmt->structure.block);
+				break;
+
+			default:
+				break;
+		}
+
+		if (!success)
+			return false;
+	}
+
+	return true;
+}
+
+static bool ofc_parse_file__is_unit(
+	const ofc_parse_stmt_list_t* list)
+{
+	if (!list || (list->count == 0))
+		return false;
+
+	unsigned i;
+	for (i = 0; i < list->count; i++)
+	{
+		switch (list->stmt[i]->type)
+		{
+			case OFC_PARSE_STMT_EMPTY:
+			case OFC_PARSE_STMT_INCLUDE:
+			case OFC_PARSE_STMT_PROGRAM:
+			case OFC_PARSE_STMT_SUBROUTINE:
+			case OFC_PARSE_STMT_FUNCTION:
+			case OFC_PARSE_STMT_BLOCK_DATA:
+			case OFC_PARSE_STMT_MODULE:
+				break;
+			default:
+				return false;
+		}
+	}
+
+	return true;
+}
+
+bool ofc_parse_file_next(ofc_parse_file_t* file)
+{
+	if (!file || !file->debug)
+		return false;
+
+	/* Release the previous unit. */
+	if (!ofc_parse_file__keep_include(file, file->stmt))
+		return false;
+	unsigned i;
+	for (i = 0; i < file->stmt->count; i++)
+		ofc_parse_stmt_delete(file->stmt->stmt[i]);
+	file->stmt->count = 0;
+
+	const ofc_sparse_t* src = file->source;
+	const char* ptr = ofc_sparse_strz(src);
+	if (!ptr) return false;
+
+	/* Statements outside of a program unit are held until we know whether
+	   they're the body of an implicit PROGRAM, the stages follow the
+	   order of ofc_parse_file_include. */
+	bool success = true;
+	bool unit    = false;
+	while (success && !unit && (file->stage < 4))
+	{
+		switch (file->stage)
+		{
+			case 0:
+			case 2:
+			{
+				unsigned len;
+				ofc_parse_stmt_t* stmt = ofc_parse_stmt(
+					file->stmt, src, &ptr[file->offset],
+					file->debug, &len);
+				if (!stmt)
+				{
+					file->stage++;
+					break;
+				}
+				file->offset += len;
+
+				if (!ofc_parse_stmt_list_add(file->stmt, stmt))
+				{
+					ofc_parse_stmt_delete(stmt);
+					success = false;
+					break;
+				}
+
+				if (stmt->type == OFC_PARSE_STMT_ERROR)
+					file->stage++;
+				else
+					unit = ofc_parse_file__is_unit(file->stmt);
+				break;
+			}
+
+			case 1:
+			{
+				unsigned l = ofc_parse_stmt_program_end(
+					src, &ptr[file->offset], file->debug, file->stmt);
+				if (l == 0)
+				{
+					file->stage = 3;
+					break;
+				}
+
+				ofc_sparse_warning(src, ofc_str_ref(&ptr[file->offset], 0),
+					"Implicit PROGRAM statement");
+				file->offset += l;
+				file->stage = 2;
+				unit = true;
+				break;
+			}
+
+			case 3:
+				if (ptr[file->offset] != '\0')
+				{
+					ofc_sparse_error(src, ofc_str_ref(&ptr[file->offset], 0),
+						"Expected end of input");
+					ofc_parse_debug_rewind(file->debug, 0);
+					success = false;
+					break;
+				}
+
+				file->stage = 4;
+				if (global_opts.parse_stats)
+					ofc_parse_memo_print_stats(
+						ofc_parse_debug_memo(file->debug));
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	/* Messages are printed even if the parse failed, as in ofc_parse_file,
+	   which also drops them when there's unexpected trailing input. Units
+	   before the failure have already been printed here, unlike there. */
+	ofc_parse_debug_print(file->debug);
+	ofc_parse_debug_rewind(file->debug, 0);
+	return success;
+}
+
 bool ofc_parse_file_print(
 	ofc_colstr_t* cs,
 	const ofc_parse_file_t* file)
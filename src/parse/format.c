@@ -392,14 +392,15 @@ bool ofc_parse_format_desc_print(
 		case OFC_PARSE_FORMAT_DESC_HOLLERITH:
 			if (ofc_string_empty(desc->string))
 				return false;
-			if (!ofc_colstr_atomic_writef(cs, "%uH%s",
+			if (!ofc_colstr_atomic_writef(cs, "%uH%.*s",
 				ofc_string_length(desc->string),
-				ofc_string_strz(desc->string)))
+				ofc_string_length(desc->string),
+				desc->string->base))
 				return false;
 			break;
 		case OFC_PARSE_FORMAT_DESC_STRING:
 			if (!ofc_colstr_write_escaped(cs, '\"',
-					ofc_string_strz(desc->string),
+					desc->string->base,
 					ofc_string_length(desc->string)))
 				return false;
 			break;
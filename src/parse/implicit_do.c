@@ -28,7 +28,7 @@ bool ofc_parse__implicit_do_iter(
 	/* Are we sure it's not in the list already? */
 	*iter = ofc_parse_expr(
 		src, &ptr[i], debug, &l);
-	if (!iter) return false;
+	if (!*iter) return false;
 	i += l;
 
 	if (ptr[i++] != '=')
@@ -36,7 +36,7 @@ bool ofc_parse__implicit_do_iter(
 
 	*init = ofc_parse_expr(
 		src, &ptr[i], debug, &l);
-	if (!init) return false;
+	if (!*init) return false;
 	i += l;
 
 	if (ptr[i++] != ',')
@@ -44,7 +44,7 @@ bool ofc_parse__implicit_do_iter(
 
 	*limit = ofc_parse_expr(
 		src, &ptr[i], debug, &l);
-	if (!limit) return false;
+	if (!*limit) return false;
 	i += l;
 
 	if (ptr[i] == ',')
@@ -53,7 +53,7 @@ bool ofc_parse__implicit_do_iter(
 
 		*step = ofc_parse_expr(
 			src, &ptr[i], debug, &l);
-		if (!step) return false;
+		if (!*step) return false;
 		i += l;
 	}
 
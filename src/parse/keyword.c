@@ -152,7 +152,11 @@ unsigned ofc_parse_ident(
 			i, ptr);
 	}
 
-	if (ident) *ident = ofc_sparse_ref(src, ptr, i);
+	if (ident)
+	{
+		*ident = ofc_sparse_ref(src, ptr, i);
+		ident->string.atom = ofc_atom(ptr, i);
+	}
 	return i;
 }
 
@@ -200,13 +204,24 @@ const char* ofc_parse_keyword_name(
 	return ofc_parse_keyword__name[keyword];
 }
 
+bool ofc_parse_keyword_begins(
+	const char* ptr, ofc_parse_keyword_e keyword)
+{
+	if (!ptr || (keyword >= OFC_PARSE_KEYWORD_COUNT))
+		return false;
+
+	/* Keywords never begin with a space, and the first letter
+	   rejects almost every keyword a statement is tried against. */
+	return (toupper(ptr[0]) == ofc_parse_keyword__name[keyword][0]);
+}
+
 unsigned ofc_parse_keyword_named(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug,
 	ofc_parse_keyword_e keyword,
 	ofc_sparse_ref_t* name)
 {
-	if (keyword >= OFC_PARSE_KEYWORD_COUNT)
+	if (!ofc_parse_keyword_begins(ptr, keyword))
 		return 0;
 
 	const char* kwstr = ofc_parse_keyword__name[keyword];
@@ -65,7 +65,7 @@ static bool ofc_parse_lhs__clone(
 	if (!src || !dst)
 		return NULL;
 
-	ofc_parse_lhs_t clone;
+	ofc_parse_lhs_t clone = { 0 };
 	clone.type = src->type;
 	clone.src  = src->src;
 
@@ -171,7 +171,7 @@ static ofc_parse_lhs_t* ofc_parse_lhs__array(
 	i += l;
 
 	lhs.type   = OFC_PARSE_LHS_ARRAY;
-	lhs.src    = ofc_sparse_ref(src, ptr, i);
+	lhs.src    = ofc_sparse_loc(src, ptr, i);
 	lhs.parent = NULL;
 
 	ofc_parse_lhs_t* alhs
@@ -217,7 +217,7 @@ static ofc_parse_lhs_t* ofc_parse_lhs__star_len(
 		&lhs.star_len.var);
 	if (i == 0) return NULL;
 
-	lhs.src = ofc_sparse_ref(src, ptr, i);
+	lhs.src = ofc_sparse_loc(src, ptr, i);
 
 	ofc_parse_lhs_t* alhs
 		= ofc_parse_lhs__alloc(lhs);
@@ -280,7 +280,7 @@ static ofc_parse_lhs_t* ofc_parse_lhs__member(
 	if (l == 0) return NULL;
 	i += l;
 
-	lhs.src = ofc_sparse_ref(src, ptr, i);
+	lhs.src = ofc_sparse_loc(src, ptr, i);
 
 	ofc_parse_lhs_t* alhs
 		= ofc_parse_lhs__alloc(lhs);
@@ -297,7 +297,7 @@ static ofc_parse_lhs_t* ofc_parse_lhs__member(
 }
 
 
-static ofc_parse_lhs_t* ofc_parse__lhs(
+static ofc_parse_lhs_t* ofc_parse_lhs__parse(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug, bool allow_array,
 	bool star_len,
@@ -312,7 +312,7 @@ static ofc_parse_lhs_t* ofc_parse__lhs(
 		src, ptr, debug, &lhs.variable);
 	if (i == 0) return NULL;
 
-	lhs.src = ofc_sparse_ref(src, ptr, i);
+	lhs.src = ofc_sparse_loc(src, ptr, i);
 
 	ofc_parse_lhs_t* alhs
 		= ofc_parse_lhs__alloc(lhs);
@@ -335,7 +335,7 @@ static ofc_parse_lhs_t* ofc_parse__lhs(
 			if (child_lhs)
 			{
 				i += l;
-				alhs->src = ofc_sparse_ref(src, ptr, i);
+				alhs->src = ofc_sparse_loc(src, ptr, i);
 				alhs = child_lhs;
 				continue;
 			}
@@ -348,7 +348,7 @@ static ofc_parse_lhs_t* ofc_parse__lhs(
 			if (child_lhs)
 			{
 				i += l;
-				alhs->src = ofc_sparse_ref(src, ptr, i);
+				alhs->src = ofc_sparse_loc(src, ptr, i);
 				alhs = child_lhs;
 				continue;
 			}
@@ -359,7 +359,7 @@ static ofc_parse_lhs_t* ofc_parse__lhs(
 		if (child_lhs)
 		{
 			i += l;
-			alhs->src = ofc_sparse_ref(src, ptr, i);
+			alhs->src = ofc_sparse_loc(src, ptr, i);
 			alhs = child_lhs;
 			continue;
 		}
@@ -371,6 +371,40 @@ static ofc_parse_lhs_t* ofc_parse__lhs(
 	return alhs;
 }
 
+static ofc_parse_lhs_t* ofc_parse__lhs(
+	const ofc_sparse_t* src, const char* ptr,
+	ofc_parse_debug_t* debug, bool allow_array,
+	bool star_len,
+	unsigned* len)
+{
+	ofc_parse_memo_e kind = OFC_PARSE_MEMO_LHS;
+	if (!allow_array)
+		kind = OFC_PARSE_MEMO_LHS_VARIABLE;
+	else if (star_len)
+		kind = OFC_PARSE_MEMO_LHS_STAR_LEN;
+
+	ofc_parse_memo_t* memo
+		= ofc_parse_debug_memo(debug);
+
+	ofc_parse_lhs_t* lhs;
+	unsigned l = 0;
+	if (ofc_parse_memo_find(
+		memo, kind, ptr, (void**)&lhs, &l))
+	{
+		if (lhs && len) *len = l;
+		return lhs;
+	}
+
+	unsigned dpos = ofc_parse_debug_position(debug);
+	lhs = ofc_parse_lhs__parse(
+		src, ptr, debug, allow_array, star_len, &l);
+	ofc_parse_memo_store(memo, kind, ptr, lhs, l,
+		(ofc_parse_debug_position(debug) == dpos));
+
+	if (lhs && len) *len = l;
+	return lhs;
+}
+
 ofc_parse_lhs_t* ofc_parse_lhs_star_len(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug,
@@ -456,8 +490,8 @@ ofc_parse_lhs_t* ofc_parse_lhs_id(
 			return NULL;
 		}
 
-		lhs->type = OFC_PARSE_EXPR_IMPLICIT_DO;
-		lhs->src  = ofc_sparse_ref(src, ptr, l);
+		lhs->type = OFC_PARSE_LHS_IMPLICIT_DO;
+		lhs->src  = ofc_sparse_loc(src, ptr, l);
 		lhs->implicit_do = id;
 
 		if (len) *len = l;
@@ -228,15 +228,13 @@ ofc_string_t* ofc_parse_hollerith(
 	if (toupper(ptr[i]) != 'H')
 		return NULL;
 
-	char s[holl_len + 1];
-
 	const char* pptr
 		= ofc_sparse_parent_pointer(src, &ptr[i]);
 	if (!pptr) return NULL;
 	i += 1;
 
 	unsigned j, holl_pos;
-	for (j = 1, holl_pos = 0; holl_pos < holl_len; j++)
+	for (j = 1, holl_pos = 0; holl_pos < holl_len; j++, holl_pos++)
 	{
 		if ((pptr[j] == '\r')
 			|| (pptr[j] == '\n')
@@ -245,20 +243,26 @@ ofc_string_t* ofc_parse_hollerith(
 
 		if (ptr[i] == pptr[j])
 			i++;
-
-		s[holl_pos++] = pptr[j];
 	}
 
+	/* Only a constant cut short by the end of the line needs a copy,
+	   otherwise it's referenced in place in the source. */
+	ofc_string_t* string;
 	if (holl_pos < holl_len)
 	{
-		while (holl_pos < holl_len)
-			s[holl_pos++] = ' ';
+		string = ofc_string_create(NULL, holl_len);
+		if (string)
+		{
+			memcpy(string->base, &pptr[1], holl_pos);
+			memset(&string->base[holl_pos], ' ',
+				(holl_len - holl_pos));
+		}
+	}
+	else
+	{
+		string = ofc_string_create_ref(
+			&pptr[1], holl_len);
 	}
-
-	s[holl_pos] = '\0';
-
-	ofc_string_t* string
-		= ofc_string_create(s, holl_len);
 	if (!string) return NULL;
 
 	if (len) *len = i;
@@ -325,6 +329,7 @@ ofc_string_t* ofc_parse__character(
 
 	unsigned str_len = 0;
 	unsigned j = 1;
+	bool contiguous = true;
 	is_escaped = false;
 	while (true)
 	{
@@ -346,6 +351,7 @@ ofc_string_t* ofc_parse__character(
 				is_escaped = is_escaped && allow_escape;
 				if (is_escaped)
 				{
+					contiguous = false;
 					j++;
 					continue;
 				}
@@ -354,6 +360,7 @@ ofc_string_t* ofc_parse__character(
 				for (k = 1; ofc_is_hspace(pptr[j + k]); k++);
 				if (pptr[j + k] == quote)
 				{
+					contiguous = false;
 					j += (k + 1);
 					continue;
 				}
@@ -367,6 +374,7 @@ ofc_string_t* ofc_parse__character(
 				is_escaped = allow_escape;
 				if (is_escaped)
 				{
+					contiguous = false;
 					j++;
 					continue;
 				}
@@ -378,6 +386,18 @@ ofc_string_t* ofc_parse__character(
 		str_len++;
 	}
 
+	/* Without escapes or joined quotes the string is exactly the
+	   source between the quotes, so we reference it in place. */
+	if (contiguous)
+	{
+		ofc_string_t* string
+			= ofc_string_create_ref(&pptr[1], str_len);
+		if (!string) return NULL;
+
+		if (len) *len = i;
+		return string;
+	}
+
 	unsigned str_pos = 0;
 	unsigned str_end = j;
 
@@ -803,12 +823,13 @@ bool ofc_parse_literal_print(
 			return ofc_colstr_write_quoted(cs, "Z", '\"',
 				literal.number.base, literal.number.size);
 		case OFC_PARSE_LITERAL_HOLLERITH:
-			return (ofc_colstr_atomic_writef(cs, "%uH%s",
+			return (ofc_colstr_atomic_writef(cs, "%uH%.*s",
+				ofc_string_length(literal.string),
 				ofc_string_length(literal.string),
-				ofc_string_strz(literal.string)));
+				literal.string->base));
 		case OFC_PARSE_LITERAL_CHARACTER:
 			return ofc_colstr_write_escaped(cs, '\"',
-					ofc_string_strz(literal.string),
+					literal.string->base,
 					ofc_string_length(literal.string));
 		case OFC_PARSE_LITERAL_COMPLEX:
 			return ofc_colstr_atomic_writef(cs, "(%.*s, %.*s)",
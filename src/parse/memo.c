@@ -0,0 +1,339 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ofc/parse.h"
+
+typedef struct
+{
+	const char*      ptr;
+	ofc_parse_memo_e kind;
+
+	bool     stored;
+	void*    result;
+	unsigned len;
+} ofc_parse_memo__entry_t;
+
+typedef struct
+{
+	unsigned gen;
+	unsigned index;
+} ofc_parse_memo__slot_t;
+
+struct ofc_parse_memo_s
+{
+	unsigned                 count, max;
+	ofc_parse_memo__entry_t* entry;
+
+	/* Open addressed index of entries, a slot is empty unless its
+	   generation matches so a reset doesn't need to clear the table. */
+	unsigned                slot_size;
+	ofc_parse_memo__slot_t* slot;
+	unsigned                gen;
+
+	unsigned long requests;
+	unsigned long hits;
+	unsigned long parses;
+	unsigned long distinct;
+};
+
+
+ofc_parse_memo_t* ofc_parse_memo_create(void)
+{
+	ofc_parse_memo_t* memo
+		= (ofc_parse_memo_t*)malloc(
+			sizeof(ofc_parse_memo_t));
+	if (!memo) return NULL;
+
+	memo->count = 0;
+	memo->max   = 0;
+	memo->entry = NULL;
+
+	memo->slot_size = 0;
+	memo->slot      = NULL;
+	memo->gen       = 1;
+
+	memo->requests = 0;
+	memo->hits     = 0;
+	memo->parses   = 0;
+	memo->distinct = 0;
+
+	return memo;
+}
+
+static void* ofc_parse_memo__copy(
+	ofc_parse_memo_e kind, const void* result)
+{
+	switch (kind)
+	{
+		case OFC_PARSE_MEMO_EXPR:
+		case OFC_PARSE_MEMO_EXPR_NO_SLASH:
+			return ofc_parse_expr_copy(
+				(const ofc_parse_expr_t*)result);
+
+		case OFC_PARSE_MEMO_LHS:
+		case OFC_PARSE_MEMO_LHS_STAR_LEN:
+		case OFC_PARSE_MEMO_LHS_VARIABLE:
+			return ofc_parse_lhs_copy(
+				(ofc_parse_lhs_t*)result);
+
+		default:
+			break;
+	}
+
+	return NULL;
+}
+
+static void ofc_parse_memo__free(
+	ofc_parse_memo_e kind, void* result)
+{
+	switch (kind)
+	{
+		case OFC_PARSE_MEMO_EXPR:
+		case OFC_PARSE_MEMO_EXPR_NO_SLASH:
+			ofc_parse_expr_delete(
+				(ofc_parse_expr_t*)result);
+			break;
+
+		case OFC_PARSE_MEMO_LHS:
+		case OFC_PARSE_MEMO_LHS_STAR_LEN:
+		case OFC_PARSE_MEMO_LHS_VARIABLE:
+			ofc_parse_lhs_delete(
+				(ofc_parse_lhs_t*)result);
+			break;
+
+		default:
+			break;
+	}
+}
+
+void ofc_parse_memo_reset(ofc_parse_memo_t* memo)
+{
+	if (!memo)
+		return;
+
+	unsigned i;
+	for (i = 0; i < memo->count; i++)
+	{
+		ofc_parse_memo__free(
+			memo->entry[i].kind,
+			memo->entry[i].result);
+	}
+	memo->count = 0;
+
+	memo->gen++;
+	if (memo->gen == 0)
+	{
+		if (memo->slot)
+		{
+			memset(memo->slot, 0x00,
+				sizeof(ofc_parse_memo__slot_t) * memo->slot_size);
+		}
+		memo->gen = 1;
+	}
+}
+
+void ofc_parse_memo_delete(ofc_parse_memo_t* memo)
+{
+	if (!memo)
+		return;
+
+	ofc_parse_memo_reset(memo);
+	free(memo->slot);
+	free(memo->entry);
+	free(memo);
+}
+
+
+static unsigned ofc_parse_memo__hash(
+	ofc_parse_memo_e kind, const char* ptr)
+{
+	uintptr_t h = ((uintptr_t)ptr * OFC_PARSE_MEMO_COUNT) + kind;
+	h ^= (h >> 16);
+	h *= 0x45D9F3B;
+	h ^= (h >> 16);
+	return (unsigned)h;
+}
+
+/* Returns the slot for a key, which is either empty or holds the key. */
+static ofc_parse_memo__slot_t* ofc_parse_memo__slot(
+	const ofc_parse_memo_t* memo,
+	ofc_parse_memo_e kind, const char* ptr)
+{
+	if (memo->slot_size == 0)
+		return NULL;
+
+	unsigned mask = (memo->slot_size - 1);
+	unsigned s = ofc_parse_memo__hash(kind, ptr) & mask;
+	while (true)
+	{
+		ofc_parse_memo__slot_t* slot = &memo->slot[s];
+		if (slot->gen != memo->gen)
+			return slot;
+
+		const ofc_parse_memo__entry_t* entry
+			= &memo->entry[slot->index];
+		if ((entry->ptr == ptr) && (entry->kind == kind))
+			return slot;
+
+		s = (s + 1) & mask;
+	}
+}
+
+static bool ofc_parse_memo__resize(
+	ofc_parse_memo_t* memo)
+{
+	unsigned size = (memo->slot_size > 0
+		? (memo->slot_size * 2) : 64);
+	ofc_parse_memo__slot_t* slot
+		= (ofc_parse_memo__slot_t*)calloc(
+			size, sizeof(ofc_parse_memo__slot_t));
+	if (!slot) return false;
+
+	free(memo->slot);
+	memo->slot      = slot;
+	memo->slot_size = size;
+
+	/* The new table is zeroed, so 0 must never be a live generation. */
+	unsigned i;
+	for (i = 0; i < memo->count; i++)
+	{
+		ofc_parse_memo__slot_t* s = ofc_parse_memo__slot(
+			memo, memo->entry[i].kind, memo->entry[i].ptr);
+		s->gen   = memo->gen;
+		s->index = i;
+	}
+
+	return true;
+}
+
+
+bool ofc_parse_memo_find(
+	ofc_parse_memo_t* memo,
+	ofc_parse_memo_e kind, const char* ptr,
+	void** result, unsigned* len)
+{
+	if (!memo || !result)
+		return false;
+
+	memo->requests++;
+
+	const ofc_parse_memo__slot_t* slot
+		= ofc_parse_memo__slot(memo, kind, ptr);
+	if (!slot || (slot->gen != memo->gen))
+		return false;
+
+	const ofc_parse_memo__entry_t* entry
+		= &memo->entry[slot->index];
+	if (!entry->stored)
+		return false;
+
+	void* copy = NULL;
+	if (entry->result)
+	{
+		copy = ofc_parse_memo__copy(
+			kind, entry->result);
+		if (!copy) return false;
+	}
+
+	memo->hits++;
+
+	*result = copy;
+	if (len) *len = entry->len;
+	return true;
+}
+
+void ofc_parse_memo_store(
+	ofc_parse_memo_t* memo,
+	ofc_parse_memo_e kind, const char* ptr,
+	const void* result, unsigned len,
+	bool replayable)
+{
+	if (!memo)
+		return;
+
+	memo->parses++;
+
+	if (((memo->count + 1) * 2) > memo->slot_size)
+	{
+		if (!ofc_parse_memo__resize(memo))
+			return;
+	}
+
+	ofc_parse_memo__slot_t* slot
+		= ofc_parse_memo__slot(memo, kind, ptr);
+
+	ofc_parse_memo__entry_t* entry;
+	bool repeat = (slot->gen == memo->gen);
+	if (repeat)
+	{
+		entry = &memo->entry[slot->index];
+		ofc_parse_memo__free(kind, entry->result);
+	}
+	else
+	{
+		if (memo->count >= memo->max)
+		{
+			unsigned max = (memo->max > 0
+				? (memo->max * 2) : 32);
+			ofc_parse_memo__entry_t* nentry
+				= (ofc_parse_memo__entry_t*)realloc(memo->entry,
+					sizeof(ofc_parse_memo__entry_t) * max);
+			if (!nentry) return;
+			memo->entry = nentry;
+			memo->max   = max;
+		}
+
+		slot->gen   = memo->gen;
+		slot->index = memo->count;
+
+		entry = &memo->entry[memo->count++];
+		entry->ptr  = ptr;
+		entry->kind = kind;
+
+		memo->distinct++;
+	}
+
+	entry->result = NULL;
+	entry->len    = len;
+	entry->stored = (replayable && !result);
+
+	/* A successful parse is copied straight away, the first repeat is
+	   usually the backtrack which discarded the original. */
+	if (replayable && result)
+	{
+		entry->result = ofc_parse_memo__copy(kind, result);
+		entry->stored = (entry->result != NULL);
+	}
+}
+
+
+void ofc_parse_memo_print_stats(
+	const ofc_parse_memo_t* memo)
+{
+	if (!memo)
+		return;
+
+	double distinct = (memo->distinct > 0
+		? (double)memo->distinct : 1.0);
+
+	fprintf(stderr, "Parse memo: %lu requests, %lu distinct, %lu hits,"
+		" reparse ratio %.3f without memo, %.3f with memo\n",
+		memo->requests, memo->distinct, memo->hits,
+		(memo->requests / distinct), (memo->parses / distinct));
+}
@@ -436,10 +436,19 @@ ofc_parse_stmt_t* ofc_parse_stmt(
 
 	unsigned dpos = ofc_parse_debug_position(debug);
 
+	ofc_parse_memo_reset(
+		ofc_parse_debug_memo(debug));
+
 	unsigned i = 0;
 
-	if (i == 0) i = ofc_parse_stmt_function(src, ptr, debug, &stmt);
-	if (i == 0) i = ofc_parse_stmt_decl(src, ptr, debug, &stmt);
+	/* Classify the start of the statement once, most statements can't
+	   begin with a type so we don't need to try FUNCTION or a declaration. */
+	bool has_type = ofc_parse_type_begins(ptr);
+	if ((i == 0) && (has_type || ofc_parse_keyword_begins(
+		ptr, OFC_PARSE_KEYWORD_FUNCTION)))
+		i = ofc_parse_stmt_function(src, ptr, debug, &stmt);
+	if ((i == 0) && has_type)
+		i = ofc_parse_stmt_decl(src, ptr, debug, &stmt);
 
 	/* Drop incomplete statements. */
 	if ((i > 0) && (stmt.type != OFC_PARSE_STMT_ERROR)
@@ -609,7 +618,7 @@ ofc_parse_stmt_t* ofc_parse_stmt(
 	}
 	i += l;
 
-	stmt.src = ofc_sparse_ref(src, ptr, i);
+	stmt.src = ofc_sparse_loc(src, ptr, i);
 
 	ofc_parse_stmt_t* astmt
 		= ofc_parse_stmt__alloc(stmt);
@@ -47,6 +47,13 @@ unsigned ofc_parse_stmt_equivalence(
 	return i;
 }
 
+static bool ofc_parse_stmt_equivalence__group_print(
+	ofc_colstr_t* cs, const ofc_parse_lhs_list_t* group)
+{
+	return ofc_parse_lhs_list_bracketed_print(
+		cs, group, false);
+}
+
 bool ofc_parse_stmt_equivalence_print(
 	ofc_colstr_t* cs, const ofc_parse_stmt_t* stmt)
 {
@@ -57,5 +64,5 @@ bool ofc_parse_stmt_equivalence_print(
 		&& ofc_parse_list_print(cs,
 			stmt->equivalence.count,
 			(const void**)stmt->equivalence.group,
-			(void*)ofc_parse_lhs_list_bracketed_print));
+			(void*)ofc_parse_stmt_equivalence__group_print));
 }
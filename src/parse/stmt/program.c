@@ -135,10 +135,10 @@ unsigned ofc_parse_stmt_program_end(
 
 	stmt->type = OFC_PARSE_STMT_PROGRAM;
 	stmt->label = 0;
-	stmt->src = ofc_sparse_ref(src, ptr, i);
+	stmt->src = ofc_sparse_loc(src, ptr, i);
 
 	if (list->count > 0)
-		ofc_sparse_ref_bridge(list->stmt[0]->src, stmt->src, &stmt->src);
+		ofc_sparse_loc_bridge(list->stmt[0]->src, stmt->src, &stmt->src);
 
 	stmt->program.name = OFC_SPARSE_REF_EMPTY;
 	stmt->program.type = NULL;
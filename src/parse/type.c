@@ -83,6 +83,19 @@ static const ofc_parse_type__keyword_t ofc_parse_type__keyword_map[] =
 	{ OFC_PARSE_TYPE_NONE            , 0 },
 };
 
+bool ofc_parse_type_begins(const char* ptr)
+{
+	unsigned j;
+	for (j = 0; ofc_parse_type__keyword_map[j].type != OFC_PARSE_TYPE_NONE; j++)
+	{
+		if (ofc_parse_keyword_begins(ptr,
+			ofc_parse_type__keyword_map[j].keyword))
+			return true;
+	}
+
+	return false;
+}
+
 ofc_parse_type_t* ofc_parse_type(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug,
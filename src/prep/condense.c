@@ -13,34 +13,74 @@
  * limitations under the License.
  */
 
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "ofc/fctype.h"
 #include "ofc/prep.h"
 
 
+#define OFC_PREP_CONDENSE__ONES  0x0101010101010101ULL
+#define OFC_PREP_CONDENSE__HIGHS 0x8080808080808080ULL
+
+/* Returns the length of the run of non-whitespace at src, which can't
+   extend beyond len. Eight bytes are tested at a time, since any byte
+   which ends a run (hspace or '\0') is less than '!' and the test for
+   that can be done across a whole word. */
+static unsigned ofc_prep_condense__run(
+	const char* src, unsigned len)
+{
+	unsigned i = 0;
+	while ((i + sizeof(uint64_t)) <= len)
+	{
+		uint64_t word;
+		memcpy(&word, &src[i], sizeof(word));
+
+		uint64_t less = (word - (OFC_PREP_CONDENSE__ONES * '!'))
+			& ~word & OFC_PREP_CONDENSE__HIGHS;
+		if (less != 0)
+			break;
+
+		i += sizeof(word);
+	}
+
+	for (; (i < len) && (src[i] != '\0') && !ofc_is_hspace(src[i]); i++);
+	return i;
+}
+
 ofc_sparse_t* ofc_prep_condense(ofc_sparse_t* unformat)
 {
 	const char* src = ofc_sparse_strz(unformat);
 	if (!src) return NULL;
 
+	unsigned len = ofc_sparse_len(unformat);
+
 	ofc_sparse_t* condense
 		= ofc_sparse_create_child(unformat);
 	if (!condense) return NULL;
 
+	/* Condensed text can never be longer than its source. */
+	if (!ofc_sparse_reserve(condense, len))
+	{
+		ofc_sparse_delete(condense);
+		return NULL;
+	}
+
 	unsigned i = 0;
-	while (src[i] != '\0')
+	while (i < len)
 	{
 		/* Skip whitespace. */
-		for (; (src[i] != '\0') && ofc_is_hspace(src[i]); i++);
+		for (; (i < len) && ofc_is_hspace(src[i]); i++);
 
-		if (src[i] == '\0')
+		if (i >= len)
 			break;
 
 		/* Parse non-whitespace. */
 		const char* base = &src[i];
-		unsigned size;
-		for(size = 0; (src[i] != '\0') && !ofc_is_hspace(src[i]); size++, i++);
+		unsigned size = ofc_prep_condense__run(base, (len - i));
+		if (size == 0) break;
+		i += size;
 
 		/* Append non-whitespace to condense sparse. */
 		if (!ofc_sparse_append_strn(condense, base, size))
@@ -13,9 +13,69 @@
  * limitations under the License.
  */
 
+#include <limits.h>
+
 #include "ofc/sema.h"
 
 
+/* Resolves a single dimension, using the frozen shape where possible. */
+static bool ofc_sema_array__dims(
+	const ofc_sema_array_t* array, unsigned i,
+	int* base, unsigned* count)
+{
+	const ofc_sema_array_dims_t* seg
+		= &array->segment[i];
+
+	if (array->constant)
+	{
+		if (base ) *base  = seg->base;
+		if (count) *count = seg->count;
+		return true;
+	}
+
+	int first = 1, last;
+	if (seg->first && !ofc_sema_expr_resolve_int(
+		seg->first, &first))
+		return false;
+	if (!ofc_sema_expr_resolve_int(
+		seg->last, &last))
+		return false;
+
+	if (last < first)
+		return false;
+
+	if (base ) *base  = first;
+	if (count) *count = ((last - first) + 1);
+	return true;
+}
+
+static void ofc_sema_array__freeze(
+	ofc_sema_array_t* array)
+{
+	array->constant = false;
+	array->total    = 0;
+
+	uint64_t total = 1;
+	unsigned i;
+	for (i = 0; i < array->dimensions; i++)
+	{
+		ofc_sema_array_dims_t* seg
+			= &array->segment[i];
+
+		seg->stride = total;
+		if (!seg->last || !ofc_sema_array__dims(
+			array, i, &seg->base, &seg->count))
+			return;
+
+		total *= seg->count;
+		if (total > UINT_MAX)
+			return;
+	}
+
+	array->total    = total;
+	array->constant = true;
+}
+
 
 ofc_sema_array_t* ofc_sema_array(
 	ofc_sema_scope_t*              scope,
@@ -64,7 +124,7 @@ ofc_sema_array_t* ofc_sema_array(
 				scope, index->range[i]->first);
 			if (!seg->first)
 			{
-				ofc_sparse_ref_error(
+				ofc_sparse_loc_error(
 					index->range[i]->first->src,
 					"Invalid array base expression");
 				ofc_sema_array_delete(array);
@@ -100,7 +160,7 @@ ofc_sema_array_t* ofc_sema_array(
 				scope, index->range[i]->last);
 			if (!seg->last)
 			{
-				ofc_sparse_ref_error(
+				ofc_sparse_loc_error(
 					index->range[i]->last->src,
 					"Invalid array last expression");
 				ofc_sema_array_delete(array);
@@ -136,6 +196,7 @@ ofc_sema_array_t* ofc_sema_array(
 		}
 	}
 
+	ofc_sema_array__freeze(array);
 	return array;
 }
 
@@ -179,6 +240,7 @@ ofc_sema_array_t* ofc_sema_array_copy_replace(
 		return NULL;
 	}
 
+	ofc_sema_array__freeze(copy);
 	return copy;
 }
 
@@ -272,28 +334,76 @@ bool ofc_sema_array_total(
 	if (!array)
 		return false;
 
+	if (array->constant)
+	{
+		if (total) *total = array->total;
+		return true;
+	}
+
 	unsigned t = 1;
 	unsigned i;
 	for (i = 0; i < array->dimensions; i++)
 	{
-		ofc_sema_array_dims_t seg
-			= array->segment[i];
-
-		int first = 1, last;
-		if (seg.first && !ofc_sema_expr_resolve_int(
-			seg.first, &first))
-			return false;
-		if (!ofc_sema_expr_resolve_int(
-			seg.last, &last))
+		unsigned count;
+		if (!ofc_sema_array__dims(
+			array, i, NULL, &count))
 			return false;
+		t *= count;
+	}
+
+	if (total) *total = t;
+	return true;
+}
+
+bool ofc_sema_array_index_range(
+	const ofc_sema_array_t* array,
+	unsigned offset, unsigned count,
+	int* index)
+{
+	if (!array || !index)
+		return false;
+
+	unsigned d = array->dimensions;
+	if (count == 0)
+		return true;
+
+	int      base[d];
+	unsigned dcount[d];
 
-		if (last < first)
+	unsigned i;
+	for (i = 0; i < d; i++)
+	{
+		if (!ofc_sema_array__dims(
+			array, i, &base[i], &dcount[i]))
 			return false;
+	}
 
-		t *= ((last - first) + 1);
+	/* Divide once for the first element, then count up. */
+	for (i = 0; i < d; i++)
+	{
+		index[i] = base[i] + (offset % dcount[i]);
+		offset /= dcount[i];
+	}
+
+	unsigned e;
+	for (e = 1; e < count; e++)
+	{
+		int* prev = &index[(e - 1) * d];
+		int* next = &index[e * d];
+
+		bool carry = true;
+		for (i = 0; i < d; i++)
+		{
+			next[i] = prev[i];
+			if (!carry)
+				continue;
+
+			next[i]++;
+			carry = ((unsigned)(next[i] - base[i]) >= dcount[i]);
+			if (carry) next[i] = base[i];
+		}
 	}
 
-	if (total) *total = t;
 	return true;
 }
 
@@ -456,7 +566,7 @@ ofc_sema_array_index_t* ofc_sema_array_index(
 
 		if (!ofc_sema_type_is_scalar(type))
 		{
-			ofc_sparse_ref_error(expr->src,
+			ofc_sparse_loc_error(expr->src,
 				"Array index type must be scalar.");
 			ofc_sema_array_index_delete(ai);
 			return NULL;
@@ -482,7 +592,7 @@ ofc_sema_array_index_t* ofc_sema_array_index(
 			if (!ofc_sema_expr_resolve_int(
 				expr, &idx))
 			{
-				ofc_sparse_ref_error(expr->src,
+				ofc_sparse_loc_error(expr->src,
 					"Array index must resolve as integer");
 				ofc_sema_array_index_delete(ai);
 				return NULL;
@@ -493,7 +603,7 @@ ofc_sema_array_index_t* ofc_sema_array_index(
 				array->segment[i].first, &first)
 				&& (idx < first))
 			{
-				ofc_sparse_ref_warning(expr->src,
+				ofc_sparse_loc_warning(expr->src,
 					"Array index out-of-bounds (underflow)");
 			}
 
@@ -502,7 +612,7 @@ ofc_sema_array_index_t* ofc_sema_array_index(
 				array->segment[i].last, &last)
 				&& (idx > last))
 			{
-				ofc_sparse_ref_warning(expr->src,
+				ofc_sparse_loc_warning(expr->src,
 					"Array index out-of-bounds (overflow)");
 			}
 		}
@@ -593,54 +703,22 @@ void ofc_sema_array_index_delete(
 }
 
 
-ofc_sema_array_index_t* ofc_sema_array_index_from_offset(
-	const ofc_sema_decl_t* decl, unsigned offset)
+ofc_sema_array_index_t* ofc_sema_array_index_from_int(
+	unsigned dimensions, const int* idx)
 {
-	if (!ofc_sema_decl_is_array(decl))
+	if (!idx)
 		return NULL;
 
-	ofc_sema_array_t* array
-		= decl->array;
-	if (!array) return NULL;
-
-	int      first[array->dimensions];
-	unsigned count[array->dimensions];
-
-	unsigned i;
-	for (i = 0; i < array->dimensions; i++)
-	{
-		first[i] = 1;
-		if (array->segment[i].first
-			&& !ofc_sema_expr_resolve_int(
-				array->segment[i].first, &first[i]))
-			return NULL;
-
-		int last;
-		if (!ofc_sema_expr_resolve_int(
-			array->segment[i].last, &last))
-			return NULL;
-
-		if (last < first[i])
-			return NULL;
-
-		count[i] = ((last + 1) - first[i]);
-	}
-
-	int idx[array->dimensions];
-	for (i = 0; i < array->dimensions; i++)
-	{
-		idx[i] = first[i] + (offset % count[i]);
-		offset /= count[i];
-	}
-
 	ofc_sema_array_index_t* index
 		= (ofc_sema_array_index_t*)malloc(sizeof(ofc_sema_array_index_t)
-				+ (array->dimensions * sizeof(ofc_sema_expr_t*)));
+				+ (dimensions * sizeof(ofc_sema_expr_t*)));
 	if (!index) return NULL;
 
 	bool success = true;
-	index->dimensions = array->dimensions;
-	for (i = 0; i < array->dimensions; i++)
+	index->dimensions = dimensions;
+
+	unsigned i;
+	for (i = 0; i < dimensions; i++)
 	{
 		index->index[i] = ofc_sema_expr_integer(
 			idx[i], OFC_SEMA_KIND_DEFAULT);
@@ -658,6 +736,25 @@ ofc_sema_array_index_t* ofc_sema_array_index_from_offset(
 	return index;
 }
 
+ofc_sema_array_index_t* ofc_sema_array_index_from_offset(
+	const ofc_sema_decl_t* decl, unsigned offset)
+{
+	if (!ofc_sema_decl_is_array(decl))
+		return NULL;
+
+	ofc_sema_array_t* array
+		= decl->array;
+	if (!array) return NULL;
+
+	int idx[array->dimensions];
+	if (!ofc_sema_array_index_range(
+		array, offset, 1, idx))
+		return NULL;
+
+	return ofc_sema_array_index_from_int(
+		array->dimensions, idx);
+}
+
 ofc_sema_array_index_t* ofc_sema_array_slice_index_from_offset(
 	const ofc_sema_array_slice_t* slice, unsigned offset)
 {
@@ -765,9 +862,6 @@ bool ofc_sema_array_index_offset(
 	unsigned i;
 	for (i = 0; i < index->dimensions; i++)
 	{
-		const ofc_sema_array_dims_t dims
-			= array->segment[i];
-
 		const ofc_sema_expr_t* expr
 			= index->index[i];
 		if (!expr) return false;
@@ -776,36 +870,42 @@ bool ofc_sema_array_index_offset(
 		if (!ofc_sema_typeval_get_integer(
 			ofc_sema_expr_constant(expr), &so))
 		{
-			ofc_sparse_ref_error(expr->src,
+			ofc_sparse_loc_error(expr->src,
 				"Failed to resolve array index");
 			return false;
 		}
 
-		int first = 1;
-		if (dims.first && !ofc_sema_expr_resolve_int(
-			dims.first, &first))
-			return false;
-
-		int last;
-		if (!ofc_sema_expr_resolve_int(
-			dims.last, &last))
+		int first;
+		unsigned count;
+		if (!ofc_sema_array__dims(
+			array, i, &first, &count))
 			return false;
+		int64_t last = (first + (int64_t)count) - 1;
 
 		if (so < first)
 		{
-			ofc_sparse_ref_error(expr->src,
+			ofc_sparse_loc_error(expr->src,
 				"Array index out-of-range, too low");
 			return false;
 		}
 		else if (so > last)
 		{
-			ofc_sparse_ref_error(expr->src,
+			ofc_sparse_loc_error(expr->src,
 				"Array index out-of-range, too high");
 			return false;
 		}
 
-		o += ((so - first) * s);
-		s *= ((last - first) + 1);
+		/* Constant shapes have their strides computed on creation. */
+		if (array->constant)
+		{
+			o += ((so - first)
+				* (int64_t)array->segment[i].stride);
+		}
+		else
+		{
+			o += ((so - first) * s);
+			s *= count;
+		}
 	}
 
 	unsigned uo = o;
@@ -910,7 +1010,7 @@ ofc_sema_array_slice_t* ofc_sema_array_slice(
 					array->segment[i].first, &afirst)
 					&& (sfirst < afirst))
 				{
-					ofc_sparse_ref_error(range->first->src,
+					ofc_sparse_loc_error(range->first->src,
 						"Array slice lower bound underflow");
 					ofc_sema_array_slice_delete(slice);
 					return NULL;
@@ -921,7 +1021,7 @@ ofc_sema_array_slice_t* ofc_sema_array_slice(
 					array->segment[i].last, &alast)
 					&& (sfirst > alast))
 				{
-					ofc_sparse_ref_error(range->first->src,
+					ofc_sparse_loc_error(range->first->src,
 						"Array slice lower bound overflow");
 					ofc_sema_array_slice_delete(slice);
 					return NULL;
@@ -945,7 +1045,7 @@ ofc_sema_array_slice_t* ofc_sema_array_slice(
 			{
 				if (resolved_first && (sfirst > slast))
 				{
-					ofc_sparse_ref_error(range->last->src,
+					ofc_sparse_loc_error(range->last->src,
 						"Array slice upper bound smaller than lower bound");
 					ofc_sema_array_slice_delete(slice);
 					return NULL;
@@ -956,7 +1056,7 @@ ofc_sema_array_slice_t* ofc_sema_array_slice(
 					array->segment[i].first, &afirst)
 					&& (slast < afirst))
 				{
-					ofc_sparse_ref_error(range->last->src,
+					ofc_sparse_loc_error(range->last->src,
 						"Array slice upper bound underflow");
 					ofc_sema_array_slice_delete(slice);
 					return NULL;
@@ -967,7 +1067,7 @@ ofc_sema_array_slice_t* ofc_sema_array_slice(
 					array->segment[i].last, &alast)
 					&& (slast > alast))
 				{
-					ofc_sparse_ref_error(range->last->src,
+					ofc_sparse_loc_error(range->last->src,
 						"Array slice upper bound overflow");
 					ofc_sema_array_slice_delete(slice);
 					return NULL;
@@ -990,7 +1090,7 @@ ofc_sema_array_slice_t* ofc_sema_array_slice(
 				slice->segment[i].stride, &stride)
 				&& (stride == 0))
 			{
-				ofc_sparse_ref_error(range->stride->src,
+				ofc_sparse_loc_error(range->stride->src,
 					"Stride can't be zero");
 				ofc_sema_array_slice_delete(slice);
 				return NULL;
@@ -1266,6 +1366,7 @@ ofc_sema_array_t* ofc_sema_array_slice_dims(
 		return NULL;
 	}
 
+	ofc_sema_array__freeze(dims);
 	return dims;
 }
 
@@ -0,0 +1,1630 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "ofc/sema.h"
+
+
+/* Open addressed table from a non-zero key to an index, used while
+   building the graph to find nodes by scope and by name. */
+typedef struct
+{
+	unsigned   size, count;
+	uintptr_t* key;
+	unsigned*  value;
+} ofc_sema_call_graph__map_t;
+
+static unsigned ofc_sema_call_graph__map_hash(uintptr_t key)
+{
+	uint64_t h = (uint64_t)key;
+	h ^= (h >> 33);
+	h *= 0xFF51AFD7ED558CCDULL;
+	h ^= (h >> 33);
+	return (unsigned)h;
+}
+
+static bool ofc_sema_call_graph__map_find(
+	const ofc_sema_call_graph__map_t* map,
+	uintptr_t key, unsigned* value)
+{
+	if (!map->size || (key == 0))
+		return false;
+
+	unsigned mask = (map->size - 1);
+	unsigned s = (ofc_sema_call_graph__map_hash(key) & mask);
+	for (; map->key[s] != 0; s = ((s + 1) & mask))
+	{
+		if (map->key[s] == key)
+		{
+			if (value) *value = map->value[s];
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Keeps the existing value if the key is already present. */
+static bool ofc_sema_call_graph__map_add(
+	ofc_sema_call_graph__map_t* map,
+	uintptr_t key, unsigned value)
+{
+	if (key == 0)
+		return false;
+
+	if (((map->count + 1) * 2) > map->size)
+	{
+		unsigned size = (map->size > 0 ? (map->size * 2) : 64);
+		uintptr_t* nkey = (uintptr_t*)calloc(size, sizeof(uintptr_t));
+		unsigned* nvalue = (unsigned*)malloc(size * sizeof(unsigned));
+		if (!nkey || !nvalue)
+		{
+			free(nkey);
+			free(nvalue);
+			return false;
+		}
+
+		unsigned i;
+		for (i = 0; i < map->size; i++)
+		{
+			if (map->key[i] == 0)
+				continue;
+
+			unsigned s = (ofc_sema_call_graph__map_hash(
+				map->key[i]) & (size - 1));
+			while (nkey[s] != 0)
+				s = ((s + 1) & (size - 1));
+			nkey[s]   = map->key[i];
+			nvalue[s] = map->value[i];
+		}
+
+		free(map->key);
+		free(map->value);
+		map->key   = nkey;
+		map->value = nvalue;
+		map->size  = size;
+	}
+
+	unsigned mask = (map->size - 1);
+	unsigned s = (ofc_sema_call_graph__map_hash(key) & mask);
+	for (; map->key[s] != 0; s = ((s + 1) & mask))
+	{
+		if (map->key[s] == key)
+			return true;
+	}
+
+	map->key[s]   = key;
+	map->value[s] = value;
+	map->count++;
+	return true;
+}
+
+static void ofc_sema_call_graph__map_cleanup(
+	ofc_sema_call_graph__map_t* map)
+{
+	free(map->key);
+	free(map->value);
+}
+
+
+typedef struct
+{
+	unsigned    caller;
+	const void* key;
+
+	ofc_sema_call_graph_site_t site;
+} ofc_sema_call_graph__raw_t;
+
+typedef struct
+{
+	ofc_sema_call_graph_t* graph;
+	unsigned               node_max;
+
+	ofc_sema_call_graph__map_t visit_map;
+	ofc_sema_call_graph__map_t scope_map;
+
+	/* Values are the node index shifted left by one,
+	   with the low bit set for ENTRY names. */
+	ofc_sema_call_graph__map_t name_map;
+
+	unsigned                    raw_count, raw_max;
+	ofc_sema_call_graph__raw_t* raw;
+
+	unsigned caller;
+	bool     failed;
+} ofc_sema_call_graph__build_t;
+
+
+static bool ofc_sema_call_graph__is_node(
+	const ofc_sema_scope_t* scope)
+{
+	switch (scope->type)
+	{
+		case OFC_SEMA_SCOPE_PROGRAM:
+		case OFC_SEMA_SCOPE_SUBROUTINE:
+		case OFC_SEMA_SCOPE_FUNCTION:
+		case OFC_SEMA_SCOPE_STMT_FUNC:
+			return true;
+
+		/* Statements outside of any program unit form
+		   an implicit main program. */
+		case OFC_SEMA_SCOPE_GLOBAL:
+			return (scope->stmt && (scope->stmt->count > 0));
+
+		default:
+			break;
+	}
+
+	return false;
+}
+
+static bool ofc_sema_call_graph__node_add(
+	ofc_sema_call_graph__build_t* build,
+	ofc_sema_scope_t* scope)
+{
+	ofc_sema_call_graph_t* graph = build->graph;
+	if (graph->node_count >= build->node_max)
+	{
+		unsigned max = (build->node_max > 0
+			? (build->node_max * 2) : 64);
+		ofc_sema_call_graph_node_t* nnode
+			= (ofc_sema_call_graph_node_t*)realloc(graph->node,
+				sizeof(ofc_sema_call_graph_node_t) * max);
+		if (!nnode) return false;
+		graph->node     = nnode;
+		build->node_max = max;
+	}
+
+	if (!ofc_sema_call_graph__map_add(
+		&build->scope_map, (uintptr_t)scope, graph->node_count))
+		return false;
+
+	ofc_sema_call_graph_node_t* node
+		= &graph->node[graph->node_count++];
+	node->scope        = scope;
+	node->arg_first    = 0;
+	node->arg_count    = 0;
+	node->has_args     = false;
+	node->common_first = 0;
+	node->common_count = 0;
+	node->scc          = 0;
+	node->reachable    = false;
+	return true;
+}
+
+/* Procedures are found both in child scope lists and through the
+   declarations which define them, so each scope is visited once. */
+static bool ofc_sema_call_graph__scope_walk(
+	ofc_sema_call_graph__build_t* build,
+	ofc_sema_scope_t* scope)
+{
+	if (!scope || ofc_sema_call_graph__map_find(
+		&build->visit_map, (uintptr_t)scope, NULL))
+		return true;
+
+	if (!ofc_sema_call_graph__map_add(
+		&build->visit_map, (uintptr_t)scope, 0))
+		return false;
+
+	if (ofc_sema_call_graph__is_node(scope)
+		&& !ofc_sema_call_graph__node_add(build, scope))
+		return false;
+
+	unsigned i;
+	if (scope->child)
+	{
+		for (i = 0; i < scope->child->count; i++)
+		{
+			if (!ofc_sema_call_graph__scope_walk(
+				build, scope->child->scope[i]))
+				return false;
+		}
+	}
+
+	if (scope->decl)
+	{
+		for (i = 0; i < scope->decl->count; i++)
+		{
+			const ofc_sema_decl_t* decl = scope->decl->decl_ref[i];
+			if (decl && !ofc_sema_call_graph__scope_walk(
+				build, decl->func))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+
+static bool ofc_sema_call_graph__site_add(
+	ofc_sema_call_graph__build_t* build,
+	const void* key, ofc_sparse_loc_t src,
+	const ofc_sema_decl_t* decl,
+	const ofc_sema_expr_list_t* args,
+	bool is_reference)
+{
+	if (!decl)
+		return true;
+
+	if (build->raw_count >= build->raw_max)
+	{
+		unsigned max = (build->raw_max > 0
+			? (build->raw_max * 2) : 256);
+		ofc_sema_call_graph__raw_t* nraw
+			= (ofc_sema_call_graph__raw_t*)realloc(build->raw,
+				sizeof(ofc_sema_call_graph__raw_t) * max);
+		if (!nraw)
+		{
+			build->failed = true;
+			return false;
+		}
+		build->raw     = nraw;
+		build->raw_max = max;
+	}
+
+	ofc_sema_call_graph__raw_t* raw
+		= &build->raw[build->raw_count++];
+	raw->caller = build->caller;
+	raw->key    = key;
+
+	raw->site.src          = src;
+	raw->site.decl         = decl;
+	raw->site.args         = args;
+	raw->site.callee       = 0;
+	raw->site.is_reference = is_reference;
+	raw->site.is_entry     = false;
+	raw->site.args_counted = false;
+	return true;
+}
+
+static void ofc_sema_call_graph__expr(
+	ofc_sema_call_graph__build_t* build,
+	const ofc_sema_expr_t* expr);
+
+static void ofc_sema_call_graph__args(
+	ofc_sema_call_graph__build_t* build,
+	const ofc_sema_expr_list_t* args)
+{
+	if (!args)
+		return;
+
+	unsigned i;
+	for (i = 0; i < args->count; i++)
+	{
+		const ofc_sema_expr_t* arg = args->expr[i];
+		if (!arg) continue;
+
+		/* A procedure passed as an argument may be called. */
+		if ((arg->type == OFC_SEMA_EXPR_LHS)
+			&& arg->lhs && (arg->lhs->type == OFC_SEMA_LHS_DECL)
+			&& (ofc_sema_decl_is_procedure(arg->lhs->decl)
+				|| ofc_sema_decl_is_external(arg->lhs->decl)))
+		{
+			ofc_sema_call_graph__site_add(
+				build, arg, arg->src, arg->lhs->decl, NULL, true);
+		}
+
+		ofc_sema_call_graph__expr(build, arg);
+	}
+}
+
+static void ofc_sema_call_graph__lhs(
+	ofc_sema_call_graph__build_t* build,
+	const ofc_sema_lhs_t* lhs)
+{
+	if (!lhs)
+		return;
+
+	switch (lhs->type)
+	{
+		case OFC_SEMA_LHS_ARRAY_INDEX:
+			if (lhs->index)
+			{
+				unsigned i;
+				for (i = 0; i < lhs->index->dimensions; i++)
+					ofc_sema_call_graph__expr(build, lhs->index->index[i]);
+			}
+			ofc_sema_call_graph__lhs(build, lhs->parent);
+			break;
+
+		case OFC_SEMA_LHS_SUBSTRING:
+			ofc_sema_call_graph__expr(build, lhs->substring.first);
+			ofc_sema_call_graph__expr(build, lhs->substring.last);
+			ofc_sema_call_graph__lhs(build, lhs->parent);
+			break;
+
+		case OFC_SEMA_LHS_ARRAY_SLICE:
+		case OFC_SEMA_LHS_STRUCTURE_MEMBER:
+			ofc_sema_call_graph__lhs(build, lhs->parent);
+			break;
+
+		case OFC_SEMA_LHS_IMPLICIT_DO:
+			if (lhs->implicit_do.lhs)
+			{
+				unsigned i;
+				for (i = 0; i < lhs->implicit_do.lhs->count; i++)
+				{
+					ofc_sema_call_graph__lhs(build,
+						lhs->implicit_do.lhs->lhs[i]);
+				}
+			}
+			ofc_sema_call_graph__expr(build, lhs->implicit_do.init);
+			ofc_sema_call_graph__expr(build, lhs->implicit_do.last);
+			ofc_sema_call_graph__expr(build, lhs->implicit_do.step);
+			break;
+
+		default:
+			break;
+	}
+}
+
+static void ofc_sema_call_graph__expr(
+	ofc_sema_call_graph__build_t* build,
+	const ofc_sema_expr_t* expr)
+{
+	if (!expr)
+		return;
+
+	switch (expr->type)
+	{
+		case OFC_SEMA_EXPR_CONSTANT:
+			break;
+
+		case OFC_SEMA_EXPR_LHS:
+			ofc_sema_call_graph__lhs(build, expr->lhs);
+			break;
+
+		case OFC_SEMA_EXPR_CAST:
+			ofc_sema_call_graph__expr(build, expr->cast.expr);
+			break;
+
+		case OFC_SEMA_EXPR_FUNCTION:
+			ofc_sema_call_graph__site_add(
+				build, expr, expr->src, expr->function, expr->args, false);
+			/* Fall through. */
+		case OFC_SEMA_EXPR_INTRINSIC:
+			ofc_sema_call_graph__args(build, expr->args);
+			break;
+
+		case OFC_SEMA_EXPR_IMPLICIT_DO:
+			if (expr->implicit_do.expr)
+			{
+				unsigned i;
+				for (i = 0; i < expr->implicit_do.expr->count; i++)
+				{
+					ofc_sema_call_graph__expr(build,
+						expr->implicit_do.expr->expr[i]);
+				}
+			}
+			ofc_sema_call_graph__expr(build, expr->implicit_do.init);
+			ofc_sema_call_graph__expr(build, expr->implicit_do.last);
+			ofc_sema_call_graph__expr(build, expr->implicit_do.step);
+			break;
+
+		default:
+			ofc_sema_call_graph__expr(build, expr->a);
+			ofc_sema_call_graph__expr(build, expr->b);
+			break;
+	}
+}
+
+static bool ofc_sema_call_graph__expr_walk(
+	ofc_sema_expr_t* expr, void* param)
+{
+	ofc_sema_call_graph__build_t* build
+		= (ofc_sema_call_graph__build_t*)param;
+	ofc_sema_call_graph__expr(build, expr);
+	return !build->failed;
+}
+
+static bool ofc_sema_call_graph__stmt_walk(
+	ofc_sema_stmt_t* stmt, void* param)
+{
+	ofc_sema_call_graph__build_t* build
+		= (ofc_sema_call_graph__build_t*)param;
+
+	if (stmt->type == OFC_SEMA_STMT_CALL)
+	{
+		ofc_sema_call_graph__site_add(build,
+			stmt, stmt->src, stmt->call.subroutine,
+			stmt->call.args, false);
+		ofc_sema_call_graph__args(build, stmt->call.args);
+	}
+
+	/* This only visits the top of each expression tree but the walk
+	   covers the rest, duplicates are removed once sites are sorted. */
+	ofc_sema_stmt_foreach_expr(stmt, param,
+		ofc_sema_call_graph__expr_walk);
+
+	/* Statement lists don't descend into logical IF statements. */
+	if ((stmt->type == OFC_SEMA_STMT_IF_STATEMENT)
+		&& stmt->if_stmt.stmt)
+		ofc_sema_call_graph__stmt_walk(stmt->if_stmt.stmt, param);
+
+	return !build->failed;
+}
+
+static bool ofc_sema_call_graph__entry_add(
+	ofc_sema_stmt_t* stmt, void* param)
+{
+	ofc_sema_call_graph__build_t* build
+		= (ofc_sema_call_graph__build_t*)param;
+
+	if ((stmt->type == OFC_SEMA_STMT_ENTRY)
+		&& !ofc_str_ref_empty(stmt->entry.name)
+		&& !ofc_sema_call_graph__map_add(&build->name_map,
+			ofc_str_ref_atom(stmt->entry.name),
+			((build->caller << 1) | 1)))
+		build->failed = true;
+
+	return !build->failed;
+}
+
+
+static int ofc_sema_call_graph__raw_compare(
+	const void* a, const void* b)
+{
+	const ofc_sema_call_graph__raw_t* ra
+		= (const ofc_sema_call_graph__raw_t*)a;
+	const ofc_sema_call_graph__raw_t* rb
+		= (const ofc_sema_call_graph__raw_t*)b;
+
+	if (ra->caller != rb->caller)
+		return (ra->caller < rb->caller ? -1 : 1);
+
+	if (ra->site.src.pos != rb->site.src.pos)
+		return (ra->site.src.pos < rb->site.src.pos ? -1 : 1);
+
+	uintptr_t pa = (uintptr_t)ra->key;
+	uintptr_t pb = (uintptr_t)rb->key;
+	if (pa != pb)
+		return (pa < pb ? -1 : 1);
+	return 0;
+}
+
+static int ofc_sema_call_graph__atom_compare(
+	const void* a, const void* b)
+{
+	ofc_atom_t aa = *((const ofc_atom_t*)a);
+	ofc_atom_t ab = *((const ofc_atom_t*)b);
+	if (aa != ab)
+		return (aa < ab ? -1 : 1);
+	return 0;
+}
+
+static unsigned ofc_sema_call_graph__atom_unique(
+	ofc_atom_t* atom, unsigned count)
+{
+	if (count == 0)
+		return 0;
+
+	qsort(atom, count, sizeof(ofc_atom_t),
+		ofc_sema_call_graph__atom_compare);
+
+	unsigned i, j;
+	for (i = 1, j = 1; i < count; i++)
+	{
+		if (atom[i] != atom[j - 1])
+			atom[j++] = atom[i];
+	}
+	return j;
+}
+
+
+static void ofc_sema_call_graph__arg_set(
+	ofc_sema_call_graph_arg_t* arg,
+	const ofc_sema_expr_t* expr)
+{
+	arg->type        = NULL;
+	arg->is_array    = false;
+	arg->is_constant = false;
+	arg->alt_return  = false;
+
+	if (!expr)
+		return;
+
+	arg->alt_return  = expr->is_alt_return;
+	arg->is_constant = (expr->type == OFC_SEMA_EXPR_CONSTANT);
+	if (arg->alt_return)
+		return;
+
+	arg->type = ofc_sema_expr_type(expr);
+	arg->is_array = ((expr->type == OFC_SEMA_EXPR_LHS)
+		&& expr->lhs && (expr->lhs->type == OFC_SEMA_LHS_DECL)
+		&& ofc_sema_decl_is_array(expr->lhs->decl));
+}
+
+static bool ofc_sema_call_graph__tables(
+	ofc_sema_call_graph__build_t* build)
+{
+	ofc_sema_call_graph_t* graph = build->graph;
+
+	unsigned arg_count = 0;
+	unsigned common_count = 0;
+	unsigned i;
+	for (i = 0; i < graph->node_count; i++)
+	{
+		const ofc_sema_scope_t* scope = graph->node[i].scope;
+		if (scope->args)
+			arg_count += scope->args->count;
+		if (scope->common)
+			common_count += scope->common->count;
+	}
+
+	unsigned site_count = graph->site_first[graph->node_count];
+	for (i = 0; i < site_count; i++)
+	{
+		const ofc_sema_call_graph_site_t* site = &graph->site[i];
+		if (!site->is_reference && site->args)
+			arg_count += site->args->count;
+	}
+
+	graph->arg = (ofc_sema_call_graph_arg_t*)malloc(
+		sizeof(ofc_sema_call_graph_arg_t) * (arg_count + 1));
+	graph->common = (ofc_atom_t*)malloc(
+		sizeof(ofc_atom_t) * (common_count + 1));
+	graph->site_arg_first = (unsigned*)malloc(
+		sizeof(unsigned) * (site_count + 1));
+	if (!graph->arg || !graph->common
+		|| !graph->site_arg_first)
+		return false;
+
+	for (i = 0; i < graph->node_count; i++)
+	{
+		ofc_sema_call_graph_node_t* node = &graph->node[i];
+		const ofc_sema_scope_t* scope = node->scope;
+
+		node->has_args = (scope->type != OFC_SEMA_SCOPE_PROGRAM)
+			&& (scope->type != OFC_SEMA_SCOPE_GLOBAL);
+
+		node->arg_first = graph->arg_count;
+		if (scope->args)
+		{
+			unsigned a;
+			for (a = 0; a < scope->args->count; a++)
+			{
+				const ofc_sema_arg_t* sarg = &scope->args->arg[a];
+				ofc_sema_call_graph_arg_t* arg
+					= &graph->arg[graph->arg_count++];
+
+				arg->type        = NULL;
+				arg->is_array    = false;
+				arg->is_constant = false;
+				arg->alt_return  = sarg->alt_return;
+				if (arg->alt_return)
+					continue;
+
+				const ofc_sema_decl_t* decl
+					= ofc_sema_scope_decl_find(
+						scope, sarg->name.string, true);
+				if (!decl) continue;
+
+				arg->type     = decl->type;
+				arg->is_array = ofc_sema_decl_is_array(decl);
+			}
+			node->arg_count = scope->args->count;
+		}
+
+		node->common_first = graph->common_count;
+		if (scope->common)
+		{
+			unsigned c;
+			for (c = 0; c < scope->common->count; c++)
+			{
+				graph->common[graph->common_count++]
+					= ofc_str_ref_atom(scope->common->common[c]->name);
+			}
+
+			node->common_count = ofc_sema_call_graph__atom_unique(
+				&graph->common[node->common_first],
+				scope->common->count);
+			graph->common_count = node->common_first + node->common_count;
+		}
+	}
+
+	for (i = 0; i < site_count; i++)
+	{
+		const ofc_sema_call_graph_site_t* site = &graph->site[i];
+		graph->site_arg_first[i] = graph->arg_count;
+		if (site->is_reference || !site->args)
+			continue;
+
+		unsigned a;
+		for (a = 0; a < site->args->count; a++)
+		{
+			ofc_sema_call_graph__arg_set(
+				&graph->arg[graph->arg_count++],
+				site->args->expr[a]);
+		}
+	}
+	graph->site_arg_first[site_count] = graph->arg_count;
+
+	return true;
+}
+
+static bool ofc_sema_call_graph__sites(
+	ofc_sema_call_graph__build_t* build)
+{
+	ofc_sema_call_graph_t* graph = build->graph;
+
+	unsigned i;
+	for (i = 0; i < graph->node_count; i++)
+	{
+		ofc_sema_scope_t* scope = graph->node[i].scope;
+		build->caller = i;
+
+		if (scope->type == OFC_SEMA_SCOPE_STMT_FUNC)
+			ofc_sema_call_graph__expr(build, scope->expr);
+		else if (scope->stmt)
+			ofc_sema_scope_foreach_stmt(scope, build,
+				ofc_sema_call_graph__stmt_walk);
+
+		if (build->failed)
+			return false;
+	}
+
+	if (build->raw_count > 0)
+	{
+		qsort(build->raw, build->raw_count,
+			sizeof(ofc_sema_call_graph__raw_t),
+			ofc_sema_call_graph__raw_compare);
+	}
+
+	graph->site_first = (unsigned*)calloc(
+		(graph->node_count + 1), sizeof(unsigned));
+	graph->site = (ofc_sema_call_graph_site_t*)malloc(
+		sizeof(ofc_sema_call_graph_site_t) * (build->raw_count + 1));
+	if (!graph->site_first || !graph->site)
+		return false;
+
+	unsigned count = 0;
+	for (i = 0; i < build->raw_count; i++)
+	{
+		const ofc_sema_call_graph__raw_t* raw = &build->raw[i];
+		if ((i > 0)
+			&& (raw->caller == build->raw[i - 1].caller)
+			&& (raw->key == build->raw[i - 1].key))
+			continue;
+
+		ofc_sema_call_graph_site_t site = raw->site;
+		site.callee = graph->node_count;
+
+		unsigned value;
+		if (site.decl->func
+			&& ofc_sema_call_graph__map_find(&build->scope_map,
+				(uintptr_t)site.decl->func, &value))
+		{
+			/* The argument count was checked when the call was made. */
+			site.callee       = value;
+			site.args_counted = true;
+		}
+		else if (!site.decl->is_argument
+			&& ofc_sema_call_graph__map_find(&build->name_map,
+				ofc_str_ref_atom(site.decl->name.string), &value))
+		{
+			site.callee   = (value >> 1);
+			site.is_entry = ((value & 1) != 0);
+		}
+
+		graph->site[count++] = site;
+		graph->site_first[raw->caller + 1]++;
+	}
+
+	for (i = 0; i < graph->node_count; i++)
+		graph->site_first[i + 1] += graph->site_first[i];
+
+	return true;
+}
+
+
+/* Tarjan's algorithm without recursion, SCCs are found callees first. */
+static bool ofc_sema_call_graph__scc(
+	ofc_sema_call_graph_t* graph)
+{
+	unsigned n = graph->node_count;
+
+	unsigned* index = (unsigned*)malloc(sizeof(unsigned) * (n + 1));
+	unsigned* low   = (unsigned*)malloc(sizeof(unsigned) * (n + 1));
+	unsigned* stack = (unsigned*)malloc(sizeof(unsigned) * (n + 1));
+	unsigned* call  = (unsigned*)malloc(sizeof(unsigned) * (n + 1));
+	unsigned* edge  = (unsigned*)malloc(sizeof(unsigned) * (n + 1));
+	bool* on_stack  = (bool*)calloc(n + 1, sizeof(bool));
+
+	graph->scc      = (ofc_sema_call_graph_scc_t*)malloc(
+		sizeof(ofc_sema_call_graph_scc_t) * (n + 1));
+	graph->scc_node = (unsigned*)malloc(sizeof(unsigned) * (n + 1));
+
+	bool success = (index && low && stack && call && edge
+		&& on_stack && graph->scc && graph->scc_node);
+
+	unsigned v;
+	for (v = 0; success && (v < n); v++)
+		index[v] = (unsigned)-1;
+
+	unsigned next = 0, sp = 0, out = 0;
+	unsigned root;
+	for (root = 0; success && (root < n); root++)
+	{
+		if (index[root] != (unsigned)-1)
+			continue;
+
+		unsigned depth = 0;
+		call[depth] = root;
+		edge[depth] = graph->site_first[root];
+		index[root] = low[root] = next++;
+		stack[sp++] = root;
+		on_stack[root] = true;
+
+		while (true)
+		{
+			v = call[depth];
+			if (edge[depth] < graph->site_first[v + 1])
+			{
+				unsigned w = graph->site[edge[depth]++].callee;
+				if (w >= n)
+					continue;
+
+				if (index[w] == (unsigned)-1)
+				{
+					depth++;
+					call[depth] = w;
+					edge[depth] = graph->site_first[w];
+					index[w] = low[w] = next++;
+					stack[sp++] = w;
+					on_stack[w] = true;
+				}
+				else if (on_stack[w] && (index[w] < low[v]))
+				{
+					low[v] = index[w];
+				}
+				continue;
+			}
+
+			if (low[v] == index[v])
+			{
+				ofc_sema_call_graph_scc_t* scc
+					= &graph->scc[graph->scc_count];
+				scc->first        = out;
+				scc->count        = 0;
+				scc->recursive    = false;
+				scc->common_count = 0;
+				scc->common       = NULL;
+				scc->diag_count   = 0;
+				scc->diag         = NULL;
+
+				unsigned w;
+				do
+				{
+					w = stack[--sp];
+					on_stack[w] = false;
+					graph->node[w].scc = graph->scc_count;
+					graph->scc_node[out++] = w;
+					scc->count++;
+				} while (w != v);
+
+				graph->scc_count++;
+			}
+
+			if (depth == 0)
+				break;
+
+			depth--;
+			unsigned u = call[depth];
+			if (low[v] < low[u])
+				low[u] = low[v];
+		}
+	}
+
+	/* An SCC is recursive if it has more than one node or calls itself. */
+	unsigned s;
+	for (s = 0; success && (s < graph->scc_count); s++)
+	{
+		ofc_sema_call_graph_scc_t* scc = &graph->scc[s];
+		if (scc->count > 1)
+		{
+			scc->recursive = true;
+			continue;
+		}
+
+		unsigned u = graph->scc_node[scc->first];
+		unsigned e;
+		for (e = graph->site_first[u]; e < graph->site_first[u + 1]; e++)
+		{
+			if (graph->site[e].callee == u)
+				scc->recursive = true;
+		}
+	}
+
+	free(index);
+	free(low);
+	free(stack);
+	free(call);
+	free(edge);
+	free(on_stack);
+	return success;
+}
+
+static bool ofc_sema_call_graph__reachable(
+	ofc_sema_call_graph_t* graph)
+{
+	unsigned n = graph->node_count;
+	unsigned* queue = (unsigned*)malloc(sizeof(unsigned) * (n + 1));
+	if (!queue) return false;
+
+	unsigned head = 0, tail = 0;
+	unsigned i;
+	for (i = 0; i < n; i++)
+	{
+		ofc_sema_scope_e type = graph->node[i].scope->type;
+		if ((type == OFC_SEMA_SCOPE_PROGRAM)
+			|| (type == OFC_SEMA_SCOPE_GLOBAL))
+		{
+			graph->node[i].reachable = true;
+			queue[tail++] = i;
+		}
+	}
+
+	while (head < tail)
+	{
+		unsigned v = queue[head++];
+		unsigned e;
+		for (e = graph->site_first[v]; e < graph->site_first[v + 1]; e++)
+		{
+			unsigned w = graph->site[e].callee;
+			if ((w < n) && !graph->node[w].reachable)
+			{
+				graph->node[w].reachable = true;
+				queue[tail++] = w;
+			}
+		}
+	}
+
+	free(queue);
+	return true;
+}
+
+
+ofc_sema_call_graph_t* ofc_sema_call_graph_create(
+	ofc_sema_scope_t* super)
+{
+	if (!super)
+		return NULL;
+
+	ofc_sema_call_graph_t* graph
+		= (ofc_sema_call_graph_t*)malloc(
+			sizeof(ofc_sema_call_graph_t));
+	if (!graph) return NULL;
+
+	graph->node_count     = 0;
+	graph->node           = NULL;
+	graph->site_first     = NULL;
+	graph->site           = NULL;
+	graph->site_arg_first = NULL;
+	graph->arg_count      = 0;
+	graph->arg            = NULL;
+	graph->common_count   = 0;
+	graph->common         = NULL;
+	graph->scc_count      = 0;
+	graph->scc            = NULL;
+	graph->scc_node       = NULL;
+
+	ofc_sema_call_graph__build_t build =
+	{
+		.graph    = graph,
+		.node_max = 0,
+		.raw      = NULL,
+		.failed   = false,
+	};
+
+	bool success = ofc_sema_call_graph__scope_walk(
+		&build, super);
+
+	/* Only procedures outside of any other program unit
+	   can be called from another file. */
+	unsigned i;
+	for (i = 0; success && (i < graph->node_count); i++)
+	{
+		ofc_sema_scope_t* scope = graph->node[i].scope;
+		if (((scope->type == OFC_SEMA_SCOPE_SUBROUTINE)
+			|| (scope->type == OFC_SEMA_SCOPE_FUNCTION))
+			&& scope->parent
+			&& (scope->parent->type == OFC_SEMA_SCOPE_GLOBAL)
+			&& !ofc_str_ref_empty(scope->name))
+		{
+			success = ofc_sema_call_graph__map_add(&build.name_map,
+				ofc_str_ref_atom(scope->name), (i << 1));
+		}
+
+		if (success && scope->stmt
+			&& (scope->type != OFC_SEMA_SCOPE_STMT_FUNC))
+		{
+			build.caller = i;
+			ofc_sema_scope_foreach_stmt(scope, &build,
+				ofc_sema_call_graph__entry_add);
+			success = !build.failed;
+		}
+	}
+
+	success = success
+		&& ofc_sema_call_graph__sites(&build)
+		&& ofc_sema_call_graph__tables(&build)
+		&& ofc_sema_call_graph__scc(graph)
+		&& ofc_sema_call_graph__reachable(graph);
+
+	ofc_sema_call_graph__map_cleanup(&build.visit_map);
+	ofc_sema_call_graph__map_cleanup(&build.scope_map);
+	ofc_sema_call_graph__map_cleanup(&build.name_map);
+	free(build.raw);
+
+	if (!success)
+	{
+		ofc_sema_call_graph_delete(graph);
+		return NULL;
+	}
+
+	return graph;
+}
+
+void ofc_sema_call_graph_delete(
+	ofc_sema_call_graph_t* graph)
+{
+	if (!graph)
+		return;
+
+	unsigned s;
+	for (s = 0; graph->scc && (s < graph->scc_count); s++)
+	{
+		free(graph->scc[s].common);
+		free(graph->scc[s].diag);
+	}
+
+	free(graph->scc_node);
+	free(graph->scc);
+	free(graph->common);
+	free(graph->arg);
+	free(graph->site_arg_first);
+	free(graph->site);
+	free(graph->site_first);
+	free(graph->node);
+	free(graph);
+}
+
+
+typedef struct
+{
+	ofc_sema_call_graph_t* graph;
+
+	/* Callers of each SCC in compressed row form. */
+	unsigned* caller_first;
+	unsigned* caller;
+
+	/* Number of called SCCs which have yet to be analysed. */
+	unsigned* pending;
+
+	unsigned* ready;
+	unsigned  ready_head, ready_tail;
+	unsigned  done;
+	bool      failed;
+
+	pthread_mutex_t lock;
+	pthread_cond_t  cond;
+} ofc_sema_call_graph__sched_t;
+
+static bool ofc_sema_call_graph__diag_add(
+	ofc_sema_call_graph_scc_t* scc, unsigned* max,
+	ofc_sema_call_graph_diag_e type, unsigned site, unsigned arg)
+{
+	if (scc->diag_count >= *max)
+	{
+		unsigned nmax = (*max > 0 ? (*max * 2) : 8);
+		ofc_sema_call_graph_diag_t* ndiag
+			= (ofc_sema_call_graph_diag_t*)realloc(scc->diag,
+				sizeof(ofc_sema_call_graph_diag_t) * nmax);
+		if (!ndiag) return false;
+		scc->diag = ndiag;
+		*max = nmax;
+	}
+
+	ofc_sema_call_graph_diag_t* diag
+		= &scc->diag[scc->diag_count++];
+	diag->type = type;
+	diag->site = site;
+	diag->arg  = arg;
+	return true;
+}
+
+static bool ofc_sema_call_graph__arg_match(
+	const ofc_sema_call_graph_arg_t* actual,
+	const ofc_sema_call_graph_arg_t* dummy)
+{
+	const ofc_sema_type_t* a = actual->type;
+	const ofc_sema_type_t* d = dummy->type;
+	if (!a || !d
+		|| (a->type > OFC_SEMA_TYPE_CHARACTER)
+		|| (d->type > OFC_SEMA_TYPE_CHARACTER))
+		return true;
+
+	/* Hollerith constants are commonly passed for numeric arguments. */
+	if (actual->is_constant
+		&& (a->type == OFC_SEMA_TYPE_CHARACTER))
+		return true;
+
+	if (a->type != d->type)
+		return false;
+
+	/* A REAL passed for a DOUBLE PRECISION dummy is a mismatch even
+	   though the base types agree, character lengths may differ. */
+	unsigned as, ds;
+	if ((a->type == OFC_SEMA_TYPE_CHARACTER)
+		|| !ofc_sema_type_base_size(a, &as)
+		|| !ofc_sema_type_base_size(d, &ds))
+		return true;
+	return (as == ds);
+}
+
+/* Only reads the graph and the summaries of SCCs which are already
+   complete, so it's safe to run for independent SCCs at once. */
+static bool ofc_sema_call_graph__summarize(
+	ofc_sema_call_graph_t* graph, unsigned s)
+{
+	ofc_sema_call_graph_scc_t* scc = &graph->scc[s];
+
+	unsigned common_count = 0;
+	unsigned i;
+	for (i = 0; i < scc->count; i++)
+	{
+		unsigned v = graph->scc_node[scc->first + i];
+		common_count += graph->node[v].common_count;
+
+		unsigned e;
+		for (e = graph->site_first[v]; e < graph->site_first[v + 1]; e++)
+		{
+			unsigned w = graph->site[e].callee;
+			if ((w < graph->node_count) && (graph->node[w].scc != s))
+				common_count += graph->scc[graph->node[w].scc].common_count;
+		}
+	}
+
+	if (common_count > 0)
+	{
+		scc->common = (ofc_atom_t*)malloc(
+			sizeof(ofc_atom_t) * common_count);
+		if (!scc->common) return false;
+	}
+
+	unsigned diag_max = 0;
+	for (i = 0; i < scc->count; i++)
+	{
+		unsigned v = graph->scc_node[scc->first + i];
+		const ofc_sema_call_graph_node_t* node = &graph->node[v];
+
+		if (node->common_count > 0)
+		{
+			memcpy(&scc->common[scc->common_count],
+				&graph->common[node->common_first],
+				(sizeof(ofc_atom_t) * node->common_count));
+			scc->common_count += node->common_count;
+		}
+
+		unsigned e;
+		for (e = graph->site_first[v]; e < graph->site_first[v + 1]; e++)
+		{
+			const ofc_sema_call_graph_site_t* site = &graph->site[e];
+			if (site->callee >= graph->node_count)
+				continue;
+
+			const ofc_sema_call_graph_node_t* callee
+				= &graph->node[site->callee];
+			if ((callee->scc != s)
+				&& (graph->scc[callee->scc].common_count > 0))
+			{
+				const ofc_sema_call_graph_scc_t* cscc
+					= &graph->scc[callee->scc];
+				memcpy(&scc->common[scc->common_count], cscc->common,
+					(sizeof(ofc_atom_t) * cscc->common_count));
+				scc->common_count += cscc->common_count;
+			}
+
+			if (site->is_reference || site->is_entry
+				|| !callee->has_args)
+				continue;
+
+			unsigned first = graph->site_arg_first[e];
+			unsigned count = graph->site_arg_first[e + 1] - first;
+			if (count != callee->arg_count)
+			{
+				if (!site->args_counted
+					&& !ofc_sema_call_graph__diag_add(scc, &diag_max,
+						OFC_SEMA_CALL_GRAPH_DIAG_ARG_COUNT, e, count))
+					return false;
+				continue;
+			}
+
+			unsigned a;
+			for (a = 0; a < count; a++)
+			{
+				const ofc_sema_call_graph_arg_t* actual
+					= &graph->arg[first + a];
+				const ofc_sema_call_graph_arg_t* dummy
+					= &graph->arg[callee->arg_first + a];
+				if (actual->alt_return || dummy->alt_return)
+					continue;
+
+				if (!ofc_sema_call_graph__arg_match(actual, dummy))
+				{
+					if (!ofc_sema_call_graph__diag_add(scc, &diag_max,
+						OFC_SEMA_CALL_GRAPH_DIAG_ARG_TYPE, e, a))
+						return false;
+				}
+				else if (actual->is_array && dummy->type
+					&& !dummy->is_array)
+				{
+					if (!ofc_sema_call_graph__diag_add(scc, &diag_max,
+						OFC_SEMA_CALL_GRAPH_DIAG_ARG_RANK, e, a))
+						return false;
+				}
+			}
+		}
+	}
+
+	scc->common_count = ofc_sema_call_graph__atom_unique(
+		scc->common, scc->common_count);
+	return true;
+}
+
+static void* ofc_sema_call_graph__worker(void* param)
+{
+	ofc_sema_call_graph__sched_t* sched
+		= (ofc_sema_call_graph__sched_t*)param;
+	unsigned scc_count = sched->graph->scc_count;
+
+	pthread_mutex_lock(&sched->lock);
+	while (true)
+	{
+		while ((sched->ready_head == sched->ready_tail)
+			&& (sched->done < scc_count) && !sched->failed)
+			pthread_cond_wait(&sched->cond, &sched->lock);
+
+		if ((sched->done >= scc_count) || sched->failed)
+			break;
+
+		unsigned s = sched->ready[sched->ready_head++];
+		pthread_mutex_unlock(&sched->lock);
+
+		bool success = ofc_sema_call_graph__summarize(
+			sched->graph, s);
+
+		pthread_mutex_lock(&sched->lock);
+		if (!success)
+			sched->failed = true;
+
+		sched->done++;
+		unsigned c;
+		for (c = sched->caller_first[s]; c < sched->caller_first[s + 1]; c++)
+		{
+			unsigned d = sched->caller[c];
+			if (--sched->pending[d] == 0)
+				sched->ready[sched->ready_tail++] = d;
+		}
+
+		pthread_cond_broadcast(&sched->cond);
+	}
+	pthread_mutex_unlock(&sched->lock);
+
+	return NULL;
+}
+
+bool ofc_sema_call_graph_analyse(
+	ofc_sema_call_graph_t* graph, unsigned jobs)
+{
+	if (!graph)
+		return false;
+
+	unsigned n = graph->scc_count;
+	if (n == 0)
+		return true;
+
+	ofc_sema_call_graph__sched_t sched =
+	{
+		.graph        = graph,
+		.caller_first = (unsigned*)calloc(n + 1, sizeof(unsigned)),
+		.pending      = (unsigned*)calloc(n, sizeof(unsigned)),
+		.ready        = (unsigned*)malloc(sizeof(unsigned) * n),
+		.caller       = NULL,
+		.ready_head   = 0,
+		.ready_tail   = 0,
+		.done         = 0,
+		.failed       = false,
+	};
+
+	/* Each distinct SCC to SCC edge is counted once, mark holds the
+	   caller SCC which last saw a callee. */
+	unsigned* mark = (unsigned*)malloc(sizeof(unsigned) * n);
+	unsigned edge_count = 0;
+	bool success = (sched.caller_first && sched.pending
+		&& sched.ready && mark);
+
+	unsigned s, i;
+	unsigned pass;
+	for (pass = 0; success && (pass < 2); pass++)
+	{
+		for (s = 0; s < n; s++)
+			mark[s] = (unsigned)-1;
+
+		for (s = 0; s < n; s++)
+		{
+			const ofc_sema_call_graph_scc_t* scc = &graph->scc[s];
+			for (i = 0; i < scc->count; i++)
+			{
+				unsigned v = graph->scc_node[scc->first + i];
+				unsigned e;
+				for (e = graph->site_first[v]; e < graph->site_first[v + 1]; e++)
+				{
+					unsigned w = graph->site[e].callee;
+					if (w >= graph->node_count)
+						continue;
+
+					unsigned t = graph->node[w].scc;
+					if ((t == s) || (mark[t] == s))
+						continue;
+					mark[t] = s;
+
+					if (pass == 0)
+					{
+						sched.pending[s]++;
+						sched.caller_first[t + 1]++;
+						edge_count++;
+					}
+					else
+					{
+						sched.caller[sched.caller_first[t]++] = s;
+					}
+				}
+			}
+		}
+
+		if (pass == 0)
+		{
+			for (s = 0; s < n; s++)
+				sched.caller_first[s + 1] += sched.caller_first[s];
+
+			sched.caller = (unsigned*)malloc(
+				sizeof(unsigned) * (edge_count + 1));
+			success = (sched.caller != NULL);
+		}
+		else
+		{
+			/* Filling shifted each start to the next, shift back. */
+			for (s = n; s > 0; s--)
+				sched.caller_first[s] = sched.caller_first[s - 1];
+			sched.caller_first[0] = 0;
+		}
+	}
+	free(mark);
+
+	for (s = 0; success && (s < n); s++)
+	{
+		if (sched.pending[s] == 0)
+			sched.ready[sched.ready_tail++] = s;
+	}
+
+	if (success)
+	{
+		if (jobs == 0)
+		{
+			long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+			jobs = (cpus > 0 ? (unsigned)cpus : 1);
+		}
+		if (jobs > n)
+			jobs = n;
+
+		pthread_mutex_init(&sched.lock, NULL);
+		pthread_cond_init(&sched.cond, NULL);
+
+		pthread_t* thread = NULL;
+		unsigned threads = 0;
+		if (jobs > 1)
+		{
+			thread = (pthread_t*)malloc(
+				sizeof(pthread_t) * (jobs - 1));
+			for (; thread && (threads < (jobs - 1)); threads++)
+			{
+				if (pthread_create(&thread[threads], NULL,
+					ofc_sema_call_graph__worker, &sched) != 0)
+					break;
+			}
+		}
+
+		/* The calling thread does its share of the work. */
+		ofc_sema_call_graph__worker(&sched);
+
+		for (i = 0; i < threads; i++)
+			pthread_join(thread[i], NULL);
+		free(thread);
+
+		pthread_cond_destroy(&sched.cond);
+		pthread_mutex_destroy(&sched.lock);
+
+		success = !sched.failed && (sched.done == n);
+	}
+
+	free(sched.caller_first);
+	free(sched.caller);
+	free(sched.pending);
+	free(sched.ready);
+	return success;
+}
+
+
+static ofc_sparse_ref_t ofc_sema_call_graph__node_name(
+	const ofc_sema_call_graph_node_t* node)
+{
+	ofc_sparse_ref_t ref = ofc_sparse_loc_ref(node->scope->src);
+	if (!ofc_str_ref_empty(node->scope->name))
+		ref.string = node->scope->name;
+	return ref;
+}
+
+static const char* ofc_sema_call_graph__node_kind(
+	const ofc_sema_call_graph_node_t* node)
+{
+	switch (node->scope->type)
+	{
+		case OFC_SEMA_SCOPE_PROGRAM:
+		case OFC_SEMA_SCOPE_GLOBAL:
+			return "PROGRAM";
+		case OFC_SEMA_SCOPE_SUBROUTINE:
+			return "SUBROUTINE";
+		case OFC_SEMA_SCOPE_FUNCTION:
+			return "FUNCTION";
+		case OFC_SEMA_SCOPE_STMT_FUNC:
+			return "STATEMENT FUNCTION";
+		default:
+			break;
+	}
+
+	return "PROCEDURE";
+}
+
+static int ofc_sema_call_graph__diag_compare(
+	const void* a, const void* b)
+{
+	const ofc_sema_call_graph_diag_t* da
+		= (const ofc_sema_call_graph_diag_t*)a;
+	const ofc_sema_call_graph_diag_t* db
+		= (const ofc_sema_call_graph_diag_t*)b;
+
+	if (da->site != db->site)
+		return (da->site < db->site ? -1 : 1);
+	if (da->arg != db->arg)
+		return (da->arg < db->arg ? -1 : 1);
+	if (da->type != db->type)
+		return (da->type < db->type ? -1 : 1);
+	return 0;
+}
+
+static void ofc_sema_call_graph__diag_warn(
+	const ofc_sema_call_graph_t* graph,
+	const ofc_sema_call_graph_diag_t* diag)
+{
+	const ofc_sema_call_graph_site_t* site = &graph->site[diag->site];
+	const ofc_sema_call_graph_node_t* callee = &graph->node[site->callee];
+	const ofc_sema_call_graph_arg_t* actual
+		= &graph->arg[graph->site_arg_first[diag->site] + diag->arg];
+	const ofc_sema_call_graph_arg_t* dummy
+		= &graph->arg[callee->arg_first + diag->arg];
+	ofc_str_ref_t name = site->decl->name.string;
+
+	switch (diag->type)
+	{
+		case OFC_SEMA_CALL_GRAPH_DIAG_ARG_COUNT:
+			ofc_sparse_loc_warning(site->src,
+				"Call to '%.*s' has %u argument(s) but it's declared with %u",
+				name.size, name.base, diag->arg, callee->arg_count);
+			break;
+
+		case OFC_SEMA_CALL_GRAPH_DIAG_ARG_TYPE:
+		{
+			/* Types which only differ in kind are shown with their size. */
+			unsigned as, ds;
+			if ((actual->type->type == dummy->type->type)
+				&& ofc_sema_type_base_size(actual->type, &as)
+				&& ofc_sema_type_base_size(dummy->type, &ds))
+			{
+				ofc_sparse_loc_warning(site->src,
+					"Argument %u of call to '%.*s' is %s*%u but the dummy argument is %s*%u",
+					(diag->arg + 1), name.size, name.base,
+					ofc_sema_type_str_rep(actual->type), as,
+					ofc_sema_type_str_rep(dummy->type), ds);
+			}
+			else
+			{
+				ofc_sparse_loc_warning(site->src,
+					"Argument %u of call to '%.*s' is %s but the dummy argument is %s",
+					(diag->arg + 1), name.size, name.base,
+					ofc_sema_type_str_rep(actual->type),
+					ofc_sema_type_str_rep(dummy->type));
+			}
+			break;
+		}
+
+		case OFC_SEMA_CALL_GRAPH_DIAG_ARG_RANK:
+			ofc_sparse_loc_warning(site->src,
+				"Argument %u of call to '%.*s' is an array but the dummy argument is a scalar",
+				(diag->arg + 1), name.size, name.base);
+			break;
+
+		default:
+			break;
+	}
+}
+
+unsigned ofc_sema_call_graph_warn(
+	const ofc_sema_call_graph_t* graph)
+{
+	if (!graph)
+		return 0;
+
+	unsigned diag_count = 0;
+	unsigned s;
+	for (s = 0; s < graph->scc_count; s++)
+		diag_count += graph->scc[s].diag_count;
+
+	ofc_sema_call_graph_diag_t* diag = NULL;
+	if (diag_count > 0)
+	{
+		diag = (ofc_sema_call_graph_diag_t*)malloc(
+			sizeof(ofc_sema_call_graph_diag_t) * diag_count);
+		if (!diag) return 0;
+
+		unsigned d = 0;
+		for (s = 0; s < graph->scc_count; s++)
+		{
+			if (graph->scc[s].diag_count == 0)
+				continue;
+
+			memcpy(&diag[d], graph->scc[s].diag,
+				(sizeof(ofc_sema_call_graph_diag_t) * graph->scc[s].diag_count));
+			d += graph->scc[s].diag_count;
+		}
+
+		qsort(diag, diag_count, sizeof(ofc_sema_call_graph_diag_t),
+			ofc_sema_call_graph__diag_compare);
+	}
+
+	/* Unreachable procedures are only reported for a whole program. */
+	bool have_main = false;
+	unsigned i;
+	for (i = 0; i < graph->node_count; i++)
+	{
+		ofc_sema_scope_e type = graph->node[i].scope->type;
+		if ((type == OFC_SEMA_SCOPE_PROGRAM)
+			|| (type == OFC_SEMA_SCOPE_GLOBAL))
+			have_main = true;
+	}
+
+	unsigned count = 0;
+	unsigned d = 0;
+	for (i = 0; i < graph->node_count; i++)
+	{
+		const ofc_sema_call_graph_node_t* node = &graph->node[i];
+		ofc_sparse_ref_t name = ofc_sema_call_graph__node_name(node);
+		bool is_procedure
+			= (node->scope->type == OFC_SEMA_SCOPE_SUBROUTINE)
+				|| (node->scope->type == OFC_SEMA_SCOPE_FUNCTION);
+
+		if (is_procedure && graph->scc[node->scc].recursive)
+		{
+			ofc_sparse_ref_warning(name,
+				"%s '%.*s' is called recursively",
+				ofc_sema_call_graph__node_kind(node),
+				name.string.size, name.string.base);
+			count++;
+		}
+
+		if (is_procedure && have_main && !node->reachable)
+		{
+			ofc_sparse_ref_warning(name,
+				"%s '%.*s' is never called",
+				ofc_sema_call_graph__node_kind(node),
+				name.string.size, name.string.base);
+			count++;
+		}
+
+		for (; (d < diag_count)
+			&& (diag[d].site < graph->site_first[i + 1]); d++)
+		{
+			ofc_sema_call_graph__diag_warn(graph, &diag[d]);
+			count++;
+		}
+	}
+
+	free(diag);
+	return count;
+}
+
+
+bool ofc_sema_call_graph_print(
+	const ofc_sema_call_graph_t* graph)
+{
+	if (!graph)
+		return false;
+
+	printf("Call graph: %u procedure(s), %u call site(s), %u SCC(s)\n",
+		graph->node_count, graph->site_first[graph->node_count],
+		graph->scc_count);
+
+	unsigned i;
+	for (i = 0; i < graph->node_count; i++)
+	{
+		const ofc_sema_call_graph_node_t* node = &graph->node[i];
+		const ofc_sema_call_graph_scc_t* scc = &graph->scc[node->scc];
+		ofc_sparse_ref_t name = ofc_sema_call_graph__node_name(node);
+
+		const ofc_file_t* file = ofc_sparse_file(name.sparse);
+		const char* path = (file ? ofc_file_get_path(file) : NULL);
+
+		printf("%s %.*s", ofc_sema_call_graph__node_kind(node),
+			name.string.size, name.string.base);
+		if (path) printf(" (%s)", path);
+		if (scc->recursive) printf(" recursive");
+		printf("\n");
+
+		unsigned e;
+		for (e = graph->site_first[i]; e < graph->site_first[i + 1]; e++)
+		{
+			const ofc_sema_call_graph_site_t* site = &graph->site[e];
+
+			/* Only list the first call to each procedure. */
+			unsigned f;
+			for (f = graph->site_first[i]; f < e; f++)
+			{
+				if (graph->site[f].callee < graph->node_count
+					? (graph->site[f].callee == site->callee)
+					: ofc_str_ref_equal_ci(
+						graph->site[f].decl->name.string,
+						site->decl->name.string))
+					break;
+			}
+			if (f < e) continue;
+
+			ofc_str_ref_t cname = site->decl->name.string;
+			printf("  %s %.*s\n",
+				(site->callee < graph->node_count
+					? ofc_sema_call_graph__node_kind(
+						&graph->node[site->callee])
+					: "EXTERNAL"),
+				cname.size, cname.base);
+		}
+
+		if (scc->common_count > 0)
+		{
+			printf("  COMMON");
+			unsigned c;
+			for (c = 0; c < scc->common_count; c++)
+			{
+				unsigned size = 0;
+				const char* cname = ofc_atom_name(scc->common[c], &size);
+				printf(" /%.*s/", size, (cname ? cname : ""));
+			}
+			printf("\n");
+		}
+	}
+
+	return true;
+}
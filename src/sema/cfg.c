@@ -0,0 +1,1187 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ofc/sema.h"
+
+
+/* The graph is first built over statements, where node 0 is entry,
+   node 1 is exit and the statements follow in source order, then
+   straight line runs of nodes are merged into blocks. */
+
+typedef struct
+{
+	uint32_t from, to;
+} ofc_sema_cfg__edge_t;
+
+typedef struct
+{
+	uint32_t                from;
+	const ofc_sema_label_t* label;
+} ofc_sema_cfg__jump_t;
+
+typedef struct
+{
+	uint32_t header;
+	uint32_t exit;
+
+	/* Terminal statement of a labelled DO, if it has one. */
+	const ofc_sema_stmt_t* term;
+	bool                   block;
+} ofc_sema_cfg__loop_t;
+
+typedef struct
+{
+	uint32_t                node_count;
+	const ofc_sema_stmt_t** node_stmt;
+	uint32_t*               node_size;
+
+	/* Where a jump to the END of a block statement goes. */
+	uint32_t* end_target;
+
+	/* Node of each statement, sorted by statement address. */
+	ofc_sema_cfg_index_t* index;
+
+	uint32_t              edge_count, edge_max;
+	ofc_sema_cfg__edge_t* edge;
+
+	uint32_t              jump_count, jump_max;
+	ofc_sema_cfg__jump_t* jump;
+
+	/* EXIT statements, as pairs of node and loop. */
+	uint32_t              exit_count, exit_max;
+	ofc_sema_cfg__edge_t* exit;
+
+	/* Assigned GO TO statements without a label list can go to
+	   any label which is ASSIGNed in the scope. */
+	uint32_t                 assigned_count, assigned_max;
+	uint32_t*                assigned;
+	uint32_t                 target_count, target_max;
+	const ofc_sema_label_t** target;
+
+	uint32_t              loop_count, loop_max;
+	ofc_sema_cfg__loop_t* loop;
+	uint32_t              active_count, active_max;
+	uint32_t*             active;
+} ofc_sema_cfg__build_t;
+
+
+/* Returns the array with room for one more element, or NULL. */
+static void* ofc_sema_cfg__grow(
+	void* array, uint32_t* max, uint32_t count, size_t size)
+{
+	if (count < *max)
+		return array;
+
+	uint32_t nmax = (*max > 0 ? (*max * 2) : 64);
+	void* narray = realloc(array, (nmax * size));
+	if (!narray) return NULL;
+	*max = nmax;
+	return narray;
+}
+
+static bool ofc_sema_cfg__edge(
+	ofc_sema_cfg__build_t* build,
+	uint32_t from, uint32_t to)
+{
+	if (to == OFC_SEMA_CFG_NONE)
+		return true;
+
+	ofc_sema_cfg__edge_t* edge = ofc_sema_cfg__grow(
+		build->edge, &build->edge_max, build->edge_count,
+		sizeof(ofc_sema_cfg__edge_t));
+	if (!edge) return false;
+	build->edge = edge;
+
+	edge[build->edge_count].from = from;
+	edge[build->edge_count].to   = to;
+	build->edge_count++;
+	return true;
+}
+
+static bool ofc_sema_cfg__jump(
+	ofc_sema_cfg__build_t* build,
+	uint32_t from, const ofc_sema_expr_t* label)
+{
+	if (!label || !label->label)
+		return true;
+
+	ofc_sema_cfg__jump_t* jump = ofc_sema_cfg__grow(
+		build->jump, &build->jump_max, build->jump_count,
+		sizeof(ofc_sema_cfg__jump_t));
+	if (!jump) return false;
+	build->jump = jump;
+
+	jump[build->jump_count].from  = from;
+	jump[build->jump_count].label = label->label;
+	build->jump_count++;
+	return true;
+}
+
+static bool ofc_sema_cfg__jump_list(
+	ofc_sema_cfg__build_t* build,
+	uint32_t from, const ofc_sema_expr_list_t* list)
+{
+	if (!list)
+		return true;
+
+	unsigned i;
+	for (i = 0; i < list->count; i++)
+	{
+		if (!ofc_sema_cfg__jump(
+			build, from, list->expr[i]))
+			return false;
+	}
+	return true;
+}
+
+
+static uint32_t ofc_sema_cfg__count_list(
+	const ofc_sema_stmt_list_t* list);
+
+static uint32_t ofc_sema_cfg__count(
+	const ofc_sema_stmt_t* stmt)
+{
+	if (!stmt)
+		return 0;
+
+	uint32_t count = 1;
+	switch (stmt->type)
+	{
+		case OFC_SEMA_STMT_IF_STATEMENT:
+			count += ofc_sema_cfg__count(stmt->if_stmt.stmt);
+			break;
+		case OFC_SEMA_STMT_IF_THEN:
+			count += ofc_sema_cfg__count_list(stmt->if_then.block_then);
+			count += ofc_sema_cfg__count_list(stmt->if_then.block_else);
+			break;
+		case OFC_SEMA_STMT_DO_BLOCK:
+			count += ofc_sema_cfg__count_list(stmt->do_block.block);
+			break;
+		case OFC_SEMA_STMT_DO_WHILE_BLOCK:
+			count += ofc_sema_cfg__count_list(stmt->do_while_block.block);
+			break;
+		default:
+			break;
+	}
+	return count;
+}
+
+static uint32_t ofc_sema_cfg__count_list(
+	const ofc_sema_stmt_list_t* list)
+{
+	if (!list)
+		return 0;
+
+	uint32_t count = 0;
+	unsigned i;
+	for (i = 0; i < list->count; i++)
+		count += ofc_sema_cfg__count(list->stmt[i]);
+	return count;
+}
+
+static void ofc_sema_cfg__number_list(
+	ofc_sema_cfg__build_t* build,
+	const ofc_sema_stmt_list_t* list);
+
+static void ofc_sema_cfg__number(
+	ofc_sema_cfg__build_t* build,
+	const ofc_sema_stmt_t* stmt)
+{
+	if (!stmt)
+		return;
+
+	uint32_t id = build->node_count++;
+	build->node_stmt[id]  = stmt;
+	build->end_target[id] = OFC_SEMA_CFG_NONE;
+	build->index[id - 2].stmt  = stmt;
+	build->index[id - 2].block = id;
+
+	switch (stmt->type)
+	{
+		case OFC_SEMA_STMT_IF_STATEMENT:
+			ofc_sema_cfg__number(build, stmt->if_stmt.stmt);
+			break;
+		case OFC_SEMA_STMT_IF_THEN:
+			ofc_sema_cfg__number_list(build, stmt->if_then.block_then);
+			ofc_sema_cfg__number_list(build, stmt->if_then.block_else);
+			break;
+		case OFC_SEMA_STMT_DO_BLOCK:
+			ofc_sema_cfg__number_list(build, stmt->do_block.block);
+			break;
+		case OFC_SEMA_STMT_DO_WHILE_BLOCK:
+			ofc_sema_cfg__number_list(build, stmt->do_while_block.block);
+			break;
+		default:
+			break;
+	}
+
+	build->node_size[id] = (build->node_count - id);
+}
+
+static void ofc_sema_cfg__number_list(
+	ofc_sema_cfg__build_t* build,
+	const ofc_sema_stmt_list_t* list)
+{
+	if (!list)
+		return;
+
+	unsigned i;
+	for (i = 0; i < list->count; i++)
+		ofc_sema_cfg__number(build, list->stmt[i]);
+}
+
+static int ofc_sema_cfg__index_compare(
+	const void* a, const void* b)
+{
+	uintptr_t pa = (uintptr_t)((const ofc_sema_cfg_index_t*)a)->stmt;
+	uintptr_t pb = (uintptr_t)((const ofc_sema_cfg_index_t*)b)->stmt;
+	return (pa < pb ? -1 : (pa > pb));
+}
+
+static const ofc_sema_cfg_index_t* ofc_sema_cfg__index_find(
+	const ofc_sema_cfg_index_t* index, uint32_t count,
+	const ofc_sema_stmt_t* stmt)
+{
+	if (!index || !stmt)
+		return NULL;
+
+	ofc_sema_cfg_index_t key = { .stmt = stmt };
+	return bsearch(&key, index, count,
+		sizeof(ofc_sema_cfg_index_t),
+		ofc_sema_cfg__index_compare);
+}
+
+static uint32_t ofc_sema_cfg__node(
+	const ofc_sema_cfg__build_t* build,
+	const ofc_sema_stmt_t* stmt)
+{
+	const ofc_sema_cfg_index_t* entry
+		= ofc_sema_cfg__index_find(
+			build->index, (build->node_count - 2), stmt);
+	return (entry ? entry->block : OFC_SEMA_CFG_NONE);
+}
+
+static uint32_t ofc_sema_cfg__label_target(
+	const ofc_sema_cfg__build_t* build,
+	const ofc_sema_label_t* label)
+{
+	if (!label)
+		return OFC_SEMA_CFG_NONE;
+
+	switch (label->type)
+	{
+		case OFC_SEMA_LABEL_STMT:
+			return ofc_sema_cfg__node(build, label->stmt);
+
+		case OFC_SEMA_LABEL_END_BLOCK:
+		{
+			uint32_t node = ofc_sema_cfg__node(build, label->stmt);
+			return (node != OFC_SEMA_CFG_NONE
+				? build->end_target[node] : OFC_SEMA_CFG_NONE);
+		}
+
+		case OFC_SEMA_LABEL_END_SCOPE:
+			return OFC_SEMA_CFG_EXIT;
+
+		default:
+			break;
+	}
+
+	return OFC_SEMA_CFG_NONE;
+}
+
+
+static bool ofc_sema_cfg__loop_push(
+	ofc_sema_cfg__build_t* build,
+	uint32_t header, uint32_t exit,
+	const ofc_sema_stmt_t* term, bool block)
+{
+	ofc_sema_cfg__loop_t* loop = ofc_sema_cfg__grow(
+		build->loop, &build->loop_max, build->loop_count,
+		sizeof(ofc_sema_cfg__loop_t));
+	if (!loop) return false;
+	build->loop = loop;
+
+	uint32_t* active = ofc_sema_cfg__grow(
+		build->active, &build->active_max, build->active_count,
+		sizeof(uint32_t));
+	if (!active) return false;
+	build->active = active;
+
+	loop[build->loop_count].header = header;
+	loop[build->loop_count].exit   = exit;
+	loop[build->loop_count].term   = term;
+	loop[build->loop_count].block  = block;
+	active[build->active_count++] = build->loop_count++;
+	return true;
+}
+
+/* Ends the active loops above base, each exits to the header of
+   the loop enclosing it or to next for the outermost. */
+static bool ofc_sema_cfg__loop_pop(
+	ofc_sema_cfg__build_t* build,
+	uint32_t base, uint32_t next)
+{
+	while (build->active_count > base)
+	{
+		ofc_sema_cfg__loop_t* loop
+			= &build->loop[build->active[--build->active_count]];
+		loop->exit = (build->active_count > base
+			? build->loop[build->active[build->active_count - 1]].header
+			: next);
+		if (!ofc_sema_cfg__edge(build, loop->header, loop->exit))
+			return false;
+	}
+	return true;
+}
+
+static bool ofc_sema_cfg__walk_list(
+	ofc_sema_cfg__build_t* build,
+	const ofc_sema_stmt_list_t* list,
+	uint32_t id, uint32_t cont);
+
+/* Adds the edges out of a statement, next is the statement after it
+   in the list and fall is where control goes once it's complete. */
+static bool ofc_sema_cfg__walk(
+	ofc_sema_cfg__build_t* build,
+	const ofc_sema_stmt_t* stmt, uint32_t id,
+	uint32_t next, uint32_t fall)
+{
+	const ofc_sema_cfg__loop_t* loop = (build->active_count > 0
+		? &build->loop[build->active[build->active_count - 1]] : NULL);
+
+	switch (stmt->type)
+	{
+		case OFC_SEMA_STMT_IF_STATEMENT:
+			if (!stmt->if_stmt.stmt)
+				break;
+			return (ofc_sema_cfg__edge(build, id, (id + 1))
+				&& ofc_sema_cfg__edge(build, id, fall)
+				&& ofc_sema_cfg__walk(build,
+					stmt->if_stmt.stmt, (id + 1), fall, fall));
+
+		case OFC_SEMA_STMT_IF_THEN:
+		{
+			const ofc_sema_stmt_list_t* block_then
+				= stmt->if_then.block_then;
+			const ofc_sema_stmt_list_t* block_else
+				= stmt->if_then.block_else;
+			uint32_t id_then = (id + 1);
+			uint32_t id_else = (id_then
+				+ ofc_sema_cfg__count_list(block_then));
+
+			build->end_target[id] = fall;
+			return (ofc_sema_cfg__edge(build, id,
+					(ofc_sema_stmt_list_count(block_then) > 0 ? id_then : fall))
+				&& ofc_sema_cfg__edge(build, id,
+					(ofc_sema_stmt_list_count(block_else) > 0 ? id_else : fall))
+				&& ofc_sema_cfg__walk_list(build, block_then, id_then, fall)
+				&& ofc_sema_cfg__walk_list(build, block_else, id_else, fall));
+		}
+
+		case OFC_SEMA_STMT_DO_BLOCK:
+		case OFC_SEMA_STMT_DO_WHILE_BLOCK:
+		{
+			const ofc_sema_stmt_list_t* block
+				= (stmt->type == OFC_SEMA_STMT_DO_BLOCK
+					? stmt->do_block.block : stmt->do_while_block.block);
+
+			build->end_target[id] = id;
+			if (!ofc_sema_cfg__edge(build, id,
+					(ofc_sema_stmt_list_count(block) > 0 ? (id + 1) : id))
+				|| !ofc_sema_cfg__edge(build, id, fall)
+				|| !ofc_sema_cfg__loop_push(build, id, fall, NULL, true))
+				return false;
+			bool success = ofc_sema_cfg__walk_list(
+				build, block, (id + 1), id);
+			build->active_count--;
+			return success;
+		}
+
+		case OFC_SEMA_STMT_DO_LABEL:
+		case OFC_SEMA_STMT_DO_WHILE:
+		{
+			const ofc_sema_expr_t* end_label
+				= (stmt->type == OFC_SEMA_STMT_DO_LABEL
+					? stmt->do_label.end_label : stmt->do_while.end_label);
+			const ofc_sema_stmt_t* term = NULL;
+			if (end_label && end_label->label
+				&& (end_label->label->type == OFC_SEMA_LABEL_STMT))
+				term = end_label->label->stmt;
+
+			/* The exit edge is added when the terminal statement is found. */
+			return (ofc_sema_cfg__edge(build, id, next)
+				&& ofc_sema_cfg__loop_push(build, id,
+					OFC_SEMA_CFG_NONE, term, false));
+		}
+
+		case OFC_SEMA_STMT_GO_TO:
+			if (stmt->go_to.label && stmt->go_to.label->label)
+				return ofc_sema_cfg__jump(build, id, stmt->go_to.label);
+			if (stmt->go_to.allow)
+				return ofc_sema_cfg__jump_list(build, id, stmt->go_to.allow);
+			else
+			{
+				uint32_t* assigned = ofc_sema_cfg__grow(
+					build->assigned, &build->assigned_max,
+					build->assigned_count, sizeof(uint32_t));
+				if (!assigned) return false;
+				build->assigned = assigned;
+				assigned[build->assigned_count++] = id;
+			}
+			return true;
+
+		case OFC_SEMA_STMT_GO_TO_COMPUTED:
+			return (ofc_sema_cfg__jump_list(
+					build, id, stmt->go_to_comp.label)
+				&& ofc_sema_cfg__edge(build, id, fall));
+
+		case OFC_SEMA_STMT_IF_COMPUTED:
+			return ofc_sema_cfg__jump_list(
+				build, id, stmt->if_comp.label);
+
+		case OFC_SEMA_STMT_STOP:
+		case OFC_SEMA_STMT_RETURN:
+		case OFC_SEMA_STMT_CONTAINS:
+			return ofc_sema_cfg__edge(build, id, OFC_SEMA_CFG_EXIT);
+
+		case OFC_SEMA_STMT_CYCLE:
+			return ofc_sema_cfg__edge(build, id,
+				(loop ? loop->header : fall));
+
+		case OFC_SEMA_STMT_EXIT:
+			if (!loop)
+				return ofc_sema_cfg__edge(build, id, fall);
+			else
+			{
+				ofc_sema_cfg__edge_t* exit = ofc_sema_cfg__grow(
+					build->exit, &build->exit_max, build->exit_count,
+					sizeof(ofc_sema_cfg__edge_t));
+				if (!exit) return false;
+				build->exit = exit;
+				exit[build->exit_count].from = id;
+				exit[build->exit_count].to
+					= build->active[build->active_count - 1];
+				build->exit_count++;
+			}
+			return true;
+
+		case OFC_SEMA_STMT_ENTRY:
+			return (ofc_sema_cfg__edge(build, OFC_SEMA_CFG_ENTRY, id)
+				&& ofc_sema_cfg__edge(build, id, fall));
+
+		case OFC_SEMA_STMT_ASSIGN:
+			if (stmt->assign.label && stmt->assign.label->label)
+			{
+				const ofc_sema_label_t** target = ofc_sema_cfg__grow(
+					build->target, &build->target_max,
+					build->target_count, sizeof(ofc_sema_label_t*));
+				if (!target) return false;
+				build->target = target;
+				target[build->target_count++] = stmt->assign.label->label;
+			}
+			break;
+
+		case OFC_SEMA_STMT_CALL:
+			if (stmt->call.args)
+			{
+				unsigned i;
+				for (i = 0; i < stmt->call.args->count; i++)
+				{
+					const ofc_sema_expr_t* arg
+						= stmt->call.args->expr[i];
+					if (arg && arg->is_alt_return
+						&& !ofc_sema_cfg__jump(build, id, arg))
+						return false;
+				}
+			}
+			break;
+
+		case OFC_SEMA_STMT_IO_READ:
+			if (!ofc_sema_cfg__jump(build, id, stmt->io_read.end)
+				|| !ofc_sema_cfg__jump(build, id, stmt->io_read.eor)
+				|| !ofc_sema_cfg__jump(build, id, stmt->io_read.err))
+				return false;
+			break;
+		case OFC_SEMA_STMT_IO_WRITE:
+			if (!ofc_sema_cfg__jump(build, id, stmt->io_write.err))
+				return false;
+			break;
+		case OFC_SEMA_STMT_IO_REWIND:
+		case OFC_SEMA_STMT_IO_END_FILE:
+		case OFC_SEMA_STMT_IO_BACKSPACE:
+			if (!ofc_sema_cfg__jump(build, id, stmt->io_position.err))
+				return false;
+			break;
+		case OFC_SEMA_STMT_IO_OPEN:
+			if (!ofc_sema_cfg__jump(build, id, stmt->io_open.err))
+				return false;
+			break;
+		case OFC_SEMA_STMT_IO_CLOSE:
+			if (!ofc_sema_cfg__jump(build, id, stmt->io_close.err))
+				return false;
+			break;
+		case OFC_SEMA_STMT_IO_INQUIRE:
+			if (!ofc_sema_cfg__jump(build, id, stmt->io_inquire.err))
+				return false;
+			break;
+
+		default:
+			break;
+	}
+
+	return ofc_sema_cfg__edge(build, id, fall);
+}
+
+static bool ofc_sema_cfg__walk_list(
+	ofc_sema_cfg__build_t* build,
+	const ofc_sema_stmt_list_t* list,
+	uint32_t id, uint32_t cont)
+{
+	if (!list)
+		return true;
+
+	uint32_t base = build->active_count;
+
+	/* Passes which remove statements leave holes in the list. */
+	unsigned end = list->count;
+	while ((end > 0) && !list->stmt[end - 1])
+		end--;
+
+	unsigned i;
+	for (i = 0; i < end; i++)
+	{
+		const ofc_sema_stmt_t* stmt = list->stmt[i];
+		if (!stmt) continue;
+
+		bool last = ((i + 1) >= end);
+		uint32_t next = (last ? cont : (id + build->node_size[id]));
+
+		/* Labelled DO loops which end on this statement, a loop without
+		   a terminal statement in this list ends with the list. */
+		uint32_t term = build->active_count;
+		while (term > base)
+		{
+			const ofc_sema_cfg__loop_t* loop
+				= &build->loop[build->active[term - 1]];
+			if ((loop->term != stmt) && (loop->term || !last))
+				break;
+			term--;
+		}
+
+		uint32_t active = build->active_count;
+		uint32_t fall = (term < active
+			? build->loop[build->active[active - 1]].header
+			: next);
+
+		if (!ofc_sema_cfg__walk(build, stmt, id, next, fall)
+			|| ((term < active)
+				&& !ofc_sema_cfg__loop_pop(build, term, next)))
+			return false;
+
+		id = next;
+	}
+
+	return ofc_sema_cfg__loop_pop(build, base, cont);
+}
+
+
+/* Builds compressed rows from an edge list, dropping duplicates. */
+static bool ofc_sema_cfg__rows(
+	uint32_t count, const ofc_sema_cfg__edge_t* edge,
+	uint32_t edge_count, bool reverse,
+	uint32_t** first, uint32_t** adj)
+{
+	uint32_t* f = (uint32_t*)calloc((count + 1), sizeof(uint32_t));
+	uint32_t* a = (uint32_t*)malloc(
+		(edge_count > 0 ? edge_count : 1) * sizeof(uint32_t));
+	uint32_t* seen = (uint32_t*)malloc(
+		(count > 0 ? count : 1) * sizeof(uint32_t));
+	if (!f || !a || !seen)
+	{
+		free(seen);
+		free(a);
+		free(f);
+		return false;
+	}
+
+	uint32_t e;
+	for (e = 0; e < edge_count; e++)
+		f[(reverse ? edge[e].to : edge[e].from) + 1]++;
+
+	uint32_t i;
+	for (i = 0; i < count; i++)
+	{
+		f[i + 1] += f[i];
+		seen[i] = OFC_SEMA_CFG_NONE;
+	}
+
+	/* Rows are filled in edge order using the row starts as cursors,
+	   which leaves each holding the start of the next row. */
+	for (e = 0; e < edge_count; e++)
+	{
+		uint32_t from = (reverse ? edge[e].to : edge[e].from);
+		uint32_t to   = (reverse ? edge[e].from : edge[e].to);
+		a[f[from]++] = to;
+	}
+
+	uint32_t start = 0, out = 0;
+	for (i = 0; i < count; i++)
+	{
+		uint32_t end = f[i];
+		f[i] = out;
+
+		for (e = start; e < end; e++)
+		{
+			if (seen[a[e]] == i)
+				continue;
+			seen[a[e]] = i;
+			a[out++] = a[e];
+		}
+		start = end;
+	}
+	f[count] = out;
+
+	free(seen);
+	*first = f;
+	*adj   = a;
+	return true;
+}
+
+static bool ofc_sema_cfg__blocks(
+	ofc_sema_cfg_t* cfg,
+	ofc_sema_cfg__build_t* build)
+{
+	uint32_t count = build->node_count;
+
+	uint32_t *succ_first, *succ;
+	uint32_t *pred_first, *pred;
+	if (!ofc_sema_cfg__rows(count, build->edge,
+		build->edge_count, false, &succ_first, &succ))
+		return false;
+	if (!ofc_sema_cfg__rows(count, build->edge,
+		build->edge_count, true, &pred_first, &pred))
+	{
+		free(succ_first);
+		free(succ);
+		return false;
+	}
+
+	uint32_t* block_of = (uint32_t*)malloc(count * sizeof(uint32_t));
+	uint32_t* last     = (uint32_t*)malloc(count * sizeof(uint32_t));
+	bool*     leader   = (bool*)malloc(count * sizeof(bool));
+	cfg->stmt_first = (uint32_t*)malloc((count + 1) * sizeof(uint32_t));
+	cfg->stmt = (const ofc_sema_stmt_t**)malloc(
+		(count > 2 ? (count - 2) : 1) * sizeof(ofc_sema_stmt_t*));
+
+	ofc_sema_cfg__edge_t* edge = NULL;
+	uint32_t edge_count = 0;
+	bool success = (block_of && last && leader
+		&& cfg->stmt_first && cfg->stmt);
+	if (success)
+	{
+		uint32_t v;
+		for (v = 0; v < count; v++)
+		{
+			block_of[v] = OFC_SEMA_CFG_NONE;
+
+			uint32_t u = pred[pred_first[v]];
+			leader[v] = ((v < 2)
+				|| ((pred_first[v + 1] - pred_first[v]) != 1)
+				|| (u < 2) || (u == v)
+				|| ((succ_first[u + 1] - succ_first[u]) != 1));
+		}
+
+		/* Blocks start at leaders, then at whatever is left which can
+		   only be cycles that are unreachable from entry. */
+		uint32_t pass;
+		for (pass = 0; pass < 2; pass++)
+		{
+			for (v = 0; v < count; v++)
+			{
+				if ((block_of[v] != OFC_SEMA_CFG_NONE)
+					|| (!leader[v] && (pass == 0)))
+					continue;
+
+				uint32_t b = cfg->block_count++;
+				cfg->stmt_first[b] = cfg->stmt_count;
+
+				uint32_t n = v;
+				while (true)
+				{
+					block_of[n] = b;
+					last[b] = n;
+					if (n < 2) break;
+					cfg->stmt[cfg->stmt_count++] = build->node_stmt[n];
+
+					if ((succ_first[n + 1] - succ_first[n]) != 1)
+						break;
+					uint32_t w = succ[succ_first[n]];
+					if (leader[w] || (block_of[w] != OFC_SEMA_CFG_NONE))
+						break;
+					n = w;
+				}
+			}
+		}
+		cfg->stmt_first[cfg->block_count] = cfg->stmt_count;
+
+		edge = (ofc_sema_cfg__edge_t*)malloc(
+			(succ_first[count] > 0 ? succ_first[count] : 1)
+				* sizeof(ofc_sema_cfg__edge_t));
+		success = (edge != NULL);
+	}
+
+	if (success)
+	{
+		uint32_t b;
+		for (b = 0; b < cfg->block_count; b++)
+		{
+			uint32_t n = last[b];
+			uint32_t e;
+			for (e = succ_first[n]; e < succ_first[n + 1]; e++)
+			{
+				edge[edge_count].from = b;
+				edge[edge_count].to   = block_of[succ[e]];
+				edge_count++;
+			}
+		}
+
+		uint32_t i;
+		for (i = 0; i < (count - 2); i++)
+			build->index[i].block = block_of[build->index[i].block];
+
+		success = ofc_sema_cfg__rows(cfg->block_count, edge, edge_count,
+				false, &cfg->succ_first, &cfg->succ)
+			&& ofc_sema_cfg__rows(cfg->block_count, edge, edge_count,
+				true, &cfg->pred_first, &cfg->pred);
+	}
+
+	free(edge);
+	free(leader);
+	free(last);
+	free(block_of);
+	free(pred);
+	free(pred_first);
+	free(succ);
+	free(succ_first);
+	return success;
+}
+
+
+/* Lengauer-Tarjan with path compression, run over a depth first
+   spanning tree of the blocks reachable from entry. */
+static bool ofc_sema_cfg__dominators(
+	ofc_sema_cfg_t* cfg)
+{
+	uint32_t n = cfg->block_count;
+
+	uint32_t* dfn      = (uint32_t*)malloc(n * sizeof(uint32_t));
+	uint32_t* vertex   = (uint32_t*)malloc(n * sizeof(uint32_t));
+	uint32_t* parent   = (uint32_t*)malloc(n * sizeof(uint32_t));
+	uint32_t* semi     = (uint32_t*)malloc(n * sizeof(uint32_t));
+	uint32_t* ancestor = (uint32_t*)malloc(n * sizeof(uint32_t));
+	uint32_t* best     = (uint32_t*)malloc(n * sizeof(uint32_t));
+	uint32_t* samedom  = (uint32_t*)malloc(n * sizeof(uint32_t));
+	uint32_t* bucket   = (uint32_t*)malloc(n * sizeof(uint32_t));
+	uint32_t* next     = (uint32_t*)malloc(n * sizeof(uint32_t));
+	uint32_t* stack    = (uint32_t*)malloc(n * sizeof(uint32_t));
+	uint32_t* pos      = (uint32_t*)malloc(n * sizeof(uint32_t));
+	cfg->idom     = (uint32_t*)malloc(n * sizeof(uint32_t));
+	cfg->dom_pre  = (uint32_t*)malloc(n * sizeof(uint32_t));
+	cfg->dom_post = (uint32_t*)malloc(n * sizeof(uint32_t));
+
+	bool success = (dfn && vertex && parent && semi && ancestor
+		&& best && samedom && bucket && next && stack && pos
+		&& cfg->idom && cfg->dom_pre && cfg->dom_post);
+	if (success)
+	{
+		uint32_t v;
+		for (v = 0; v < n; v++)
+		{
+			dfn[v]      = OFC_SEMA_CFG_NONE;
+			ancestor[v] = OFC_SEMA_CFG_NONE;
+			samedom[v]  = OFC_SEMA_CFG_NONE;
+			bucket[v]   = OFC_SEMA_CFG_NONE;
+			best[v]     = v;
+			cfg->idom[v]     = OFC_SEMA_CFG_NONE;
+			cfg->dom_pre[v]  = OFC_SEMA_CFG_NONE;
+			cfg->dom_post[v] = OFC_SEMA_CFG_NONE;
+		}
+
+		uint32_t count = 0, sp = 0;
+		dfn[OFC_SEMA_CFG_ENTRY] = count;
+		vertex[count++] = OFC_SEMA_CFG_ENTRY;
+		parent[OFC_SEMA_CFG_ENTRY] = OFC_SEMA_CFG_NONE;
+		stack[sp] = OFC_SEMA_CFG_ENTRY;
+		pos[sp++] = cfg->succ_first[OFC_SEMA_CFG_ENTRY];
+		while (sp > 0)
+		{
+			v = stack[sp - 1];
+			if (pos[sp - 1] >= cfg->succ_first[v + 1])
+			{
+				sp--;
+				continue;
+			}
+
+			uint32_t w = cfg->succ[pos[sp - 1]++];
+			if (dfn[w] != OFC_SEMA_CFG_NONE)
+				continue;
+
+			dfn[w] = count;
+			vertex[count++] = w;
+			parent[w] = v;
+			stack[sp] = w;
+			pos[sp++] = cfg->succ_first[w];
+		}
+
+		uint32_t i;
+		for (i = count; i-- > 1;)
+		{
+			uint32_t w = vertex[i];
+			uint32_t p = parent[w];
+			uint32_t s = p;
+
+			uint32_t e;
+			for (e = cfg->pred_first[w]; e < cfg->pred_first[w + 1]; e++)
+			{
+				v = cfg->pred[e];
+				if (dfn[v] == OFC_SEMA_CFG_NONE)
+					continue;
+
+				uint32_t t = v;
+				if (dfn[v] > dfn[w])
+				{
+					/* Find the ancestor of v with the lowest semidominator,
+					   compressing the path as we go. */
+					uint32_t depth = 0, u = v;
+					while (ancestor[ancestor[u]] != OFC_SEMA_CFG_NONE)
+					{
+						stack[depth++] = u;
+						u = ancestor[u];
+					}
+					while (depth-- > 0)
+					{
+						u = stack[depth];
+						uint32_t a = ancestor[u];
+						if (dfn[semi[best[a]]] < dfn[semi[best[u]]])
+							best[u] = best[a];
+						ancestor[u] = ancestor[a];
+					}
+					t = semi[best[v]];
+				}
+
+				if (dfn[t] < dfn[s])
+					s = t;
+			}
+
+			semi[w] = s;
+			next[w] = bucket[s];
+			bucket[s] = w;
+			ancestor[w] = p;
+
+			for (v = bucket[p]; v != OFC_SEMA_CFG_NONE; v = next[v])
+			{
+				uint32_t depth = 0, u = v;
+				while (ancestor[ancestor[u]] != OFC_SEMA_CFG_NONE)
+				{
+					stack[depth++] = u;
+					u = ancestor[u];
+				}
+				while (depth-- > 0)
+				{
+					u = stack[depth];
+					uint32_t a = ancestor[u];
+					if (dfn[semi[best[a]]] < dfn[semi[best[u]]])
+						best[u] = best[a];
+					ancestor[u] = ancestor[a];
+				}
+
+				uint32_t y = best[v];
+				if (semi[y] == semi[v])
+					cfg->idom[v] = p;
+				else
+					samedom[v] = y;
+			}
+			bucket[p] = OFC_SEMA_CFG_NONE;
+		}
+
+		cfg->idom[OFC_SEMA_CFG_ENTRY] = OFC_SEMA_CFG_ENTRY;
+		for (i = 1; i < count; i++)
+		{
+			v = vertex[i];
+			if (samedom[v] != OFC_SEMA_CFG_NONE)
+				cfg->idom[v] = cfg->idom[samedom[v]];
+		}
+
+		/* Number the dominator tree, children are linked through
+		   bucket and next which are free again by now. */
+		for (i = count; i-- > 1;)
+		{
+			v = vertex[i];
+			next[v] = bucket[cfg->idom[v]];
+			bucket[cfg->idom[v]] = v;
+		}
+
+		uint32_t pre = 0, post = 0;
+		sp = 0;
+		stack[sp++] = OFC_SEMA_CFG_ENTRY;
+		cfg->dom_pre[OFC_SEMA_CFG_ENTRY] = pre++;
+		while (sp > 0)
+		{
+			v = stack[sp - 1];
+			uint32_t c = bucket[v];
+			if (c == OFC_SEMA_CFG_NONE)
+			{
+				cfg->dom_post[v] = post++;
+				sp--;
+				continue;
+			}
+
+			bucket[v] = next[c];
+			cfg->dom_pre[c] = pre++;
+			stack[sp++] = c;
+		}
+	}
+
+	free(pos);
+	free(stack);
+	free(next);
+	free(bucket);
+	free(samedom);
+	free(best);
+	free(ancestor);
+	free(semi);
+	free(parent);
+	free(vertex);
+	free(dfn);
+	return success;
+}
+
+
+ofc_sema_cfg_t* ofc_sema_cfg_create(
+	const ofc_sema_scope_t* scope)
+{
+	if (!scope)
+		return NULL;
+
+	const ofc_sema_stmt_list_t* list = NULL;
+	switch (scope->type)
+	{
+		case OFC_SEMA_SCOPE_GLOBAL:
+		case OFC_SEMA_SCOPE_PROGRAM:
+		case OFC_SEMA_SCOPE_SUBROUTINE:
+		case OFC_SEMA_SCOPE_FUNCTION:
+			list = scope->stmt;
+			break;
+		default:
+			break;
+	}
+
+	ofc_sema_cfg_t* cfg
+		= (ofc_sema_cfg_t*)calloc(1, sizeof(ofc_sema_cfg_t));
+	if (!cfg) return NULL;
+
+	ofc_sema_cfg__build_t build;
+	memset(&build, 0x00, sizeof(build));
+
+	uint32_t count = (2 + ofc_sema_cfg__count_list(list));
+	build.node_stmt  = (const ofc_sema_stmt_t**)malloc(
+		count * sizeof(ofc_sema_stmt_t*));
+	build.node_size  = (uint32_t*)malloc(count * sizeof(uint32_t));
+	build.end_target = (uint32_t*)malloc(count * sizeof(uint32_t));
+	build.index = (ofc_sema_cfg_index_t*)malloc(
+		count * sizeof(ofc_sema_cfg_index_t));
+
+	bool success = (build.node_stmt && build.node_size
+		&& build.end_target && build.index);
+	if (success)
+	{
+		uint32_t i;
+		for (i = 0; i < 2; i++)
+		{
+			build.node_stmt[i]  = NULL;
+			build.node_size[i]  = 1;
+			build.end_target[i] = OFC_SEMA_CFG_NONE;
+		}
+		build.node_count = 2;
+		ofc_sema_cfg__number_list(&build, list);
+
+		qsort(build.index, (count - 2),
+			sizeof(ofc_sema_cfg_index_t),
+			ofc_sema_cfg__index_compare);
+
+		success = ofc_sema_cfg__edge(&build, OFC_SEMA_CFG_ENTRY,
+				(count > 2 ? 2 : OFC_SEMA_CFG_EXIT))
+			&& ofc_sema_cfg__walk_list(&build, list, 2, OFC_SEMA_CFG_EXIT);
+
+		for (i = 0; success && (i < build.jump_count); i++)
+		{
+			success = ofc_sema_cfg__edge(&build, build.jump[i].from,
+				ofc_sema_cfg__label_target(&build, build.jump[i].label));
+		}
+
+		for (i = 0; success && (i < build.exit_count); i++)
+		{
+			success = ofc_sema_cfg__edge(&build, build.exit[i].from,
+				build.loop[build.exit[i].to].exit);
+		}
+
+		for (i = 0; success && (i < build.assigned_count); i++)
+		{
+			uint32_t t;
+			for (t = 0; success && (t < build.target_count); t++)
+			{
+				success = ofc_sema_cfg__edge(&build, build.assigned[i],
+					ofc_sema_cfg__label_target(&build, build.target[t]));
+			}
+		}
+	}
+
+	success = success
+		&& ofc_sema_cfg__blocks(cfg, &build)
+		&& ofc_sema_cfg__dominators(cfg);
+
+	if (success)
+	{
+		cfg->index = build.index;
+		build.index = NULL;
+	}
+
+	free(build.active);
+	free(build.loop);
+	free(build.target);
+	free(build.assigned);
+	free(build.exit);
+	free(build.jump);
+	free(build.edge);
+	free(build.index);
+	free(build.end_target);
+	free(build.node_size);
+	free(build.node_stmt);
+
+	if (!success)
+	{
+		ofc_sema_cfg_delete(cfg);
+		return NULL;
+	}
+
+	return cfg;
+}
+
+void ofc_sema_cfg_delete(
+	ofc_sema_cfg_t* cfg)
+{
+	if (!cfg)
+		return;
+
+	free(cfg->index);
+	free(cfg->dom_post);
+	free(cfg->dom_pre);
+	free(cfg->idom);
+	free(cfg->pred);
+	free(cfg->pred_first);
+	free(cfg->succ);
+	free(cfg->succ_first);
+	free(cfg->stmt);
+	free(cfg->stmt_first);
+	free(cfg);
+}
+
+
+bool ofc_sema_cfg_dominates(
+	const ofc_sema_cfg_t* cfg, uint32_t a, uint32_t b)
+{
+	if (!cfg || (a >= cfg->block_count) || (b >= cfg->block_count)
+		|| !ofc_sema_cfg_reachable(cfg, a)
+		|| !ofc_sema_cfg_reachable(cfg, b))
+		return false;
+
+	return ((cfg->dom_pre[a] <= cfg->dom_pre[b])
+		&& (cfg->dom_post[b] <= cfg->dom_post[a]));
+}
+
+uint32_t ofc_sema_cfg_block(
+	const ofc_sema_cfg_t* cfg,
+	const ofc_sema_stmt_t* stmt)
+{
+	if (!cfg)
+		return OFC_SEMA_CFG_NONE;
+
+	const ofc_sema_cfg_index_t* entry
+		= ofc_sema_cfg__index_find(
+			cfg->index, cfg->stmt_count, stmt);
+	return (entry ? entry->block : OFC_SEMA_CFG_NONE);
+}
+
+
+static unsigned ofc_sema_cfg__line(
+	const ofc_sema_stmt_t* stmt)
+{
+	ofc_sparse_ref_t src = ofc_sparse_loc_ref(stmt->src);
+	const ofc_file_t* file = ofc_sparse_file(src.sparse);
+	const char* ptr = ofc_sparse_file_pointer(
+		src.sparse, src.string.base);
+
+	unsigned row = 0, col;
+	if (!file || !ptr
+		|| !ofc_file_get_position(file, ptr, &row, &col))
+		return 0;
+	return (row + 1);
+}
+
+bool ofc_sema_cfg_print(
+	const ofc_sema_cfg_t* cfg)
+{
+	if (!cfg)
+		return false;
+
+	uint32_t b;
+	for (b = 0; b < cfg->block_count; b++)
+	{
+		printf("  B%u", b);
+		if (b == OFC_SEMA_CFG_ENTRY)
+			printf(" ENTRY");
+		else if (b == OFC_SEMA_CFG_EXIT)
+			printf(" EXIT");
+		else
+		{
+			uint32_t count = (cfg->stmt_first[b + 1] - cfg->stmt_first[b]);
+			unsigned line = ofc_sema_cfg__line(cfg->stmt[cfg->stmt_first[b]]);
+			if (line > 0)
+				printf(" line %u", line);
+			printf(" (%u statement%s)", count, (count == 1 ? "" : "s"));
+		}
+
+		if (!ofc_sema_cfg_reachable(cfg, b))
+			printf(" unreachable");
+		else if (b != OFC_SEMA_CFG_ENTRY)
+			printf(" idom B%u", cfg->idom[b]);
+
+		if (cfg->succ_first[b] < cfg->succ_first[b + 1])
+		{
+			printf(" ->");
+			uint32_t e;
+			for (e = cfg->succ_first[b]; e < cfg->succ_first[b + 1]; e++)
+				printf(" B%u", cfg->succ[e]);
+		}
+		printf("\n");
+	}
+
+	return true;
+}
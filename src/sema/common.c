@@ -13,6 +13,8 @@
  * limitations under the License.
  */
 
+#include <stdio.h>
+
 #include "ofc/sema.h"
 
 
@@ -221,3 +223,423 @@ bool ofc_sema_common_map_print(
 
 	return true;
 }
+
+
+
+static char* ofc_sema_common__strdup(
+	const char* base, unsigned size)
+{
+	char* strz = (char*)malloc(size + 1);
+	if (!strz) return NULL;
+	if (size > 0)
+		memcpy(strz, base, size);
+	strz[size] = '\0';
+	return strz;
+}
+
+static uint64_t ofc_sema_common__hash(const char* strz)
+{
+	/* FNV-1a */
+	uint64_t hash = 14695981039346656037ULL;
+	for (; *strz != '\0'; strz++)
+	{
+		hash ^= (uint8_t)*strz;
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+static bool ofc_sema_common__member_signature(
+	const ofc_sema_decl_t* decl,
+	char* buff, unsigned size)
+{
+	if (!decl) return false;
+
+	int len;
+	if (decl->structure)
+	{
+		unsigned dsize;
+		if (ofc_sema_decl_size(decl, &dsize))
+			len = snprintf(buff, size, "STRUCTURE*%u", dsize);
+		else
+			len = snprintf(buff, size, "STRUCTURE*?");
+	}
+	else
+	{
+		const ofc_sema_type_t* type
+			= ofc_sema_decl_base_type(decl);
+		if (!type) return false;
+
+		const char* name = ofc_sema_type_str_rep(type);
+		if (!name) name = "?";
+
+		unsigned tsize;
+		if (ofc_sema_type_size(type, &tsize))
+			len = snprintf(buff, size, "%s*%u", name, tsize);
+		else
+			len = snprintf(buff, size, "%s*?", name);
+	}
+	if ((len < 0) || ((unsigned)len >= size))
+		return false;
+
+	if (decl->array)
+	{
+		unsigned total;
+		int alen;
+		if (ofc_sema_array_total(decl->array, &total))
+			alen = snprintf(&buff[len], (size - len), "(%u)", total);
+		else
+			alen = snprintf(&buff[len], (size - len), "(?)");
+		if ((alen < 0) || ((unsigned)alen >= (size - len)))
+			return false;
+	}
+
+	return true;
+}
+
+/* Signature of the members of a COMMON block, in declaration order. */
+static char* ofc_sema_common__signature(
+	const ofc_sema_common_t* common,
+	unsigned* size)
+{
+	if (!common)
+		return NULL;
+
+	char*    sig = NULL;
+	unsigned len = 0;
+	unsigned max = 0;
+
+	unsigned total = 0;
+	bool     total_known = true;
+
+	unsigned i;
+	for (i = 0; i < common->count; i++)
+	{
+		char member[128];
+		if (!ofc_sema_common__member_signature(
+			common->decl[i], member, sizeof(member)))
+		{
+			free(sig);
+			return NULL;
+		}
+
+		unsigned dsize;
+		if (total_known && ofc_sema_decl_size(
+			common->decl[i], &dsize))
+			total += dsize;
+		else
+			total_known = false;
+
+		unsigned mlen = strlen(member);
+		unsigned nlen = len + (i > 0 ? 1 : 0) + mlen;
+		if ((nlen + 1) > max)
+		{
+			unsigned nmax = (max > 0 ? (max * 2) : 64);
+			while (nmax < (nlen + 1))
+				nmax *= 2;
+
+			char* nsig = (char*)realloc(sig, nmax);
+			if (!nsig)
+			{
+				free(sig);
+				return NULL;
+			}
+			sig = nsig;
+			max = nmax;
+		}
+
+		if (i > 0) sig[len++] = ',';
+		memcpy(&sig[len], member, mlen);
+		len += mlen;
+	}
+
+	if (!sig)
+	{
+		sig = ofc_sema_common__strdup("", 0);
+		if (!sig) return NULL;
+	}
+	sig[len] = '\0';
+
+	if (size) *size = (total_known ? total : 0);
+	return sig;
+}
+
+
+static void ofc_sema_common_index__entry_delete(
+	ofc_sema_common_index_entry_t* entry)
+{
+	if (!entry)
+		return;
+
+	unsigned i;
+	for (i = 0; i < entry->count; i++)
+	{
+		free(entry->layout[i].signature);
+		free(entry->layout[i].unit);
+		free(entry->layout[i].path);
+	}
+	free(entry->layout);
+
+	free(entry->name_strz);
+	free(entry);
+}
+
+static const ofc_str_ref_t* ofc_sema_common_index__entry_key(
+	const ofc_sema_common_index_entry_t* entry)
+{
+	return (entry ? &entry->name : NULL);
+}
+
+ofc_sema_common_index_t* ofc_sema_common_index_create(
+	bool case_sensitive)
+{
+	ofc_sema_common_index_t* index
+		= (ofc_sema_common_index_t*)malloc(
+			sizeof(ofc_sema_common_index_t));
+	if (!index) return NULL;
+
+	index->map = ofc_hashmap_create(
+		(void*)(case_sensitive
+			? ofc_str_ref_ptr_hash
+			: ofc_str_ref_ptr_hash_ci),
+		(void*)(case_sensitive
+			? ofc_str_ref_ptr_equal
+			: ofc_str_ref_ptr_equal_ci),
+		(void*)ofc_sema_common_index__entry_key, NULL);
+
+	if (!index->map)
+	{
+		free(index);
+		return NULL;
+	}
+
+	index->count = 0;
+	index->entry = NULL;
+
+	return index;
+}
+
+void ofc_sema_common_index_delete(
+	ofc_sema_common_index_t* index)
+{
+	if (!index)
+		return;
+
+	unsigned i;
+	for (i = 0; i < index->count; i++)
+		ofc_sema_common_index__entry_delete(index->entry[i]);
+	free(index->entry);
+
+	ofc_hashmap_delete(index->map);
+	free(index);
+}
+
+static ofc_sema_common_index_entry_t* ofc_sema_common_index__find_create(
+	ofc_sema_common_index_t* index, ofc_str_ref_t name)
+{
+	ofc_sema_common_index_entry_t* entry
+		= ofc_hashmap_find_modify(index->map, &name);
+	if (entry) return entry;
+
+	entry = (ofc_sema_common_index_entry_t*)malloc(
+		sizeof(ofc_sema_common_index_entry_t));
+	if (!entry) return NULL;
+
+	entry->name_strz = ofc_sema_common__strdup(
+		name.base, name.size);
+	if (!entry->name_strz)
+	{
+		free(entry);
+		return NULL;
+	}
+	entry->name = ofc_str_ref(
+		entry->name_strz, name.size);
+
+	entry->count  = 0;
+	entry->layout = NULL;
+
+	ofc_sema_common_index_entry_t** nentry
+		= (ofc_sema_common_index_entry_t**)realloc(index->entry,
+			(sizeof(ofc_sema_common_index_entry_t*) * (index->count + 1)));
+	if (!nentry || !ofc_hashmap_add(index->map, entry))
+	{
+		if (nentry) index->entry = nentry;
+		ofc_sema_common_index__entry_delete(entry);
+		return NULL;
+	}
+	index->entry = nentry;
+
+	index->entry[index->count++] = entry;
+	return entry;
+}
+
+typedef struct
+{
+	ofc_sema_common_index_t* index;
+	const char*              path;
+} ofc_sema_common_index__param_t;
+
+static bool ofc_sema_common_index__add(
+	ofc_sema_common_index_t* index,
+	const char* path,
+	const ofc_sema_scope_t* scope,
+	const ofc_sema_common_t* common)
+{
+	unsigned size;
+	char* sig = ofc_sema_common__signature(common, &size);
+	if (!sig) return false;
+	uint64_t hash = ofc_sema_common__hash(sig);
+
+	ofc_sema_common_index_entry_t* entry
+		= ofc_sema_common_index__find_create(
+			index, common->name);
+	if (!entry)
+	{
+		free(sig);
+		return false;
+	}
+
+	unsigned i;
+	for (i = 0; i < entry->count; i++)
+	{
+		ofc_sema_common_layout_t* layout
+			= &entry->layout[i];
+		if ((layout->hash == hash)
+			&& (strcmp(layout->signature, sig) == 0))
+		{
+			layout->units++;
+			free(sig);
+			return true;
+		}
+	}
+
+	/* Blank COMMON may legally differ in size between program units. */
+	if ((entry->count > 0) && (common->name.size > 0)
+		&& (common->count > 0))
+	{
+		const ofc_sema_common_layout_t* first
+			= &entry->layout[0];
+		ofc_sparse_ref_warning(common->decl[0]->name,
+			"COMMON /%.*s/ layout differs from its declaration in %s (%s)",
+			common->name.size, common->name.base, first->unit,
+			(first->path ? first->path : "?"));
+	}
+
+	ofc_sema_common_layout_t* nlayout
+		= (ofc_sema_common_layout_t*)realloc(entry->layout,
+			(sizeof(ofc_sema_common_layout_t) * (entry->count + 1)));
+	if (!nlayout)
+	{
+		free(sig);
+		return false;
+	}
+	entry->layout = nlayout;
+
+	ofc_sema_common_layout_t* layout
+		= &entry->layout[entry->count];
+	layout->signature = sig;
+	layout->hash      = hash;
+	layout->size      = size;
+	layout->units     = 1;
+	layout->unit      = ofc_sema_common__strdup(
+		scope->name.base, scope->name.size);
+	layout->path      = (path ? ofc_sema_common__strdup(
+		path, strlen(path)) : NULL);
+	if (!layout->unit || (path && !layout->path))
+	{
+		free(layout->unit);
+		free(layout->path);
+		free(sig);
+		return false;
+	}
+
+	entry->count++;
+	return true;
+}
+
+static bool ofc_sema_common_index__scope(
+	ofc_sema_scope_t* scope, void* param)
+{
+	ofc_sema_common_index__param_t* p
+		= (ofc_sema_common_index__param_t*)param;
+	if (!scope || !p)
+		return false;
+
+	if (!scope->common)
+		return true;
+
+	unsigned i;
+	for (i = 0; i < scope->common->count; i++)
+	{
+		if (!ofc_sema_common_index__add(
+			p->index, p->path, scope,
+			scope->common->common[i]))
+			return false;
+	}
+
+	return true;
+}
+
+bool ofc_sema_common_index_add_scope(
+	ofc_sema_common_index_t* index,
+	const char* path,
+	const ofc_sema_scope_t* scope)
+{
+	if (!index || !scope)
+		return false;
+
+	ofc_sema_common_index__param_t param
+		= { .index = index, .path = path };
+	return ofc_sema_scope_foreach_scope(
+		(ofc_sema_scope_t*)scope, &param,
+		ofc_sema_common_index__scope);
+}
+
+unsigned ofc_sema_common_index_mismatch_count(
+	const ofc_sema_common_index_t* index)
+{
+	if (!index)
+		return 0;
+
+	unsigned count = 0;
+	unsigned i;
+	for (i = 0; i < index->count; i++)
+	{
+		if ((index->entry[i]->count > 1)
+			&& (index->entry[i]->name.size > 0))
+			count++;
+	}
+	return count;
+}
+
+bool ofc_sema_common_index_print(
+	const ofc_sema_common_index_t* index)
+{
+	if (!index)
+		return false;
+
+	unsigned i;
+	for (i = 0; i < index->count; i++)
+	{
+		const ofc_sema_common_index_entry_t* entry
+			= index->entry[i];
+
+		printf("/%.*s/:%u\n",
+			entry->name.size, entry->name.base,
+			entry->count);
+
+		unsigned j;
+		for (j = 0; j < entry->count; j++)
+		{
+			const ofc_sema_common_layout_t* layout
+				= &entry->layout[j];
+			printf("  %016llx:%u:%u:%s:%s:%s\n",
+				(unsigned long long)layout->hash,
+				layout->size, layout->units,
+				(layout->path ? layout->path : ""),
+				layout->unit, layout->signature);
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,1267 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ofc/sema.h"
+
+
+static bool ofc_sema_dataflow__push(
+	uint32_t** list, uint32_t* count, uint32_t* max,
+	uint32_t value)
+{
+	if (*count >= *max)
+	{
+		uint32_t nmax = (*max > 0 ? (*max * 2) : 16);
+		uint32_t* nlist = (uint32_t*)realloc(
+			*list, (nmax * sizeof(uint32_t)));
+		if (!nlist) return false;
+		*list = nlist;
+		*max  = nmax;
+	}
+
+	(*list)[(*count)++] = value;
+	return true;
+}
+
+bool ofc_sema_dataflow_effect_gen(
+	ofc_sema_dataflow_effect_t* effect, uint32_t bit)
+{
+	return (effect && ofc_sema_dataflow__push(
+		&effect->gen, &effect->gen_count, &effect->gen_max, bit));
+}
+
+bool ofc_sema_dataflow_effect_kill(
+	ofc_sema_dataflow_effect_t* effect, uint32_t bit)
+{
+	return (effect && ofc_sema_dataflow__push(
+		&effect->kill, &effect->kill_count, &effect->kill_max, bit));
+}
+
+void ofc_sema_dataflow_effect_apply(
+	const ofc_sema_dataflow_effect_t* effect, uint64_t* set)
+{
+	if (!effect || !set)
+		return;
+
+	uint32_t i;
+	for (i = 0; i < effect->kill_count; i++)
+		ofc_sema_bitset_clear(set, effect->kill[i]);
+	for (i = 0; i < effect->gen_count; i++)
+		ofc_sema_bitset_set(set, effect->gen[i]);
+}
+
+static void ofc_sema_dataflow__effect_cleanup(
+	ofc_sema_dataflow_effect_t* effect)
+{
+	free(effect->kill);
+	free(effect->gen);
+}
+
+
+/* Whole set operations are plain loops over words so the compiler
+   can vectorize them. */
+
+static void ofc_sema_dataflow__fill(
+	uint64_t* restrict dst, uint32_t words, uint32_t bits, bool ones)
+{
+	uint32_t w;
+	for (w = 0; w < words; w++)
+		dst[w] = (ones ? ~0ULL : 0ULL);
+
+	/* Bits past the end are always clear. */
+	if (ones && (bits & 63))
+		dst[words - 1] = ((1ULL << (bits & 63)) - 1);
+}
+
+static void ofc_sema_dataflow__meet(
+	uint64_t* restrict dst, const uint64_t* restrict src,
+	uint32_t words, bool intersect)
+{
+	uint32_t w;
+	if (intersect)
+	{
+		for (w = 0; w < words; w++)
+			dst[w] &= src[w];
+	}
+	else
+	{
+		for (w = 0; w < words; w++)
+			dst[w] |= src[w];
+	}
+}
+
+void ofc_sema_dataflow_in(
+	const ofc_sema_dataflow_t* dataflow,
+	uint32_t block, uint64_t* set)
+{
+	if (!dataflow || !set)
+		return;
+
+	const ofc_sema_cfg_t* cfg = dataflow->cfg;
+	uint32_t words = dataflow->words;
+
+	uint32_t boundary = (dataflow->forward
+		? OFC_SEMA_CFG_ENTRY : OFC_SEMA_CFG_EXIT);
+	if (block == boundary)
+	{
+		memcpy(set, dataflow->boundary, (words * sizeof(uint64_t)));
+		return;
+	}
+
+	const uint32_t* first = (dataflow->forward
+		? cfg->pred_first : cfg->succ_first);
+	const uint32_t* edge = (dataflow->forward
+		? cfg->pred : cfg->succ);
+
+	uint32_t e = first[block];
+	if (e >= first[block + 1])
+	{
+		ofc_sema_dataflow__fill(set, words,
+			dataflow->bits, dataflow->intersect);
+		return;
+	}
+
+	memcpy(set, &dataflow->out[edge[e] * words],
+		(words * sizeof(uint64_t)));
+	for (e++; e < first[block + 1]; e++)
+	{
+		ofc_sema_dataflow__meet(set,
+			&dataflow->out[edge[e] * words],
+			words, dataflow->intersect);
+	}
+}
+
+
+/* Composes the effects of the statements in each block, in the order
+   they're executed in the direction of flow. */
+static bool ofc_sema_dataflow__compose(
+	ofc_sema_dataflow_t* dataflow,
+	ofc_sema_dataflow_effect_f func, void* param)
+{
+	const ofc_sema_cfg_t* cfg = dataflow->cfg;
+	uint32_t count = cfg->block_count;
+
+	enum { NONE = 0, GEN, KILL };
+	uint8_t* mark = (uint8_t*)calloc(
+		(dataflow->bits > 0 ? dataflow->bits : 1), sizeof(uint8_t));
+	dataflow->gen_first  = (uint32_t*)malloc((count + 1) * sizeof(uint32_t));
+	dataflow->kill_first = (uint32_t*)malloc((count + 1) * sizeof(uint32_t));
+	if (!mark || !dataflow->gen_first || !dataflow->kill_first)
+	{
+		free(mark);
+		return false;
+	}
+
+	ofc_sema_dataflow_effect_t effect;
+	memset(&effect, 0x00, sizeof(effect));
+
+	uint32_t  touch_count = 0, touch_max = 0;
+	uint32_t* touch = NULL;
+	uint32_t  gen_count = 0, gen_max = 0;
+	uint32_t  kill_count = 0, kill_max = 0;
+
+	bool success = true;
+	uint32_t b;
+	for (b = 0; success && (b < count); b++)
+	{
+		dataflow->gen_first[b]  = gen_count;
+		dataflow->kill_first[b] = kill_count;
+
+		uint32_t s_first = cfg->stmt_first[b];
+		uint32_t s_count = (cfg->stmt_first[b + 1] - s_first);
+		uint32_t s;
+		for (s = 0; success && (s < s_count); s++)
+		{
+			const ofc_sema_stmt_t* stmt = cfg->stmt[s_first
+				+ (dataflow->forward ? s : (s_count - 1 - s))];
+
+			effect.gen_count  = 0;
+			effect.kill_count = 0;
+			if (!func(stmt, &effect, param))
+			{
+				success = false;
+				break;
+			}
+
+			uint32_t i;
+			for (i = 0; success && (i < effect.kill_count); i++)
+			{
+				uint32_t bit = effect.kill[i];
+				if (mark[bit] == NONE)
+					success = ofc_sema_dataflow__push(
+						&touch, &touch_count, &touch_max, bit);
+				mark[bit] = KILL;
+			}
+			for (i = 0; success && (i < effect.gen_count); i++)
+			{
+				uint32_t bit = effect.gen[i];
+				if (mark[bit] == NONE)
+					success = ofc_sema_dataflow__push(
+						&touch, &touch_count, &touch_max, bit);
+				mark[bit] = GEN;
+			}
+		}
+
+		uint32_t i;
+		for (i = 0; success && (i < touch_count); i++)
+		{
+			uint32_t bit = touch[i];
+			success = (mark[bit] == GEN
+				? ofc_sema_dataflow__push(&dataflow->gen,
+					&gen_count, &gen_max, bit)
+				: ofc_sema_dataflow__push(&dataflow->kill,
+					&kill_count, &kill_max, bit));
+			mark[bit] = NONE;
+		}
+		touch_count = 0;
+	}
+	dataflow->gen_first[count]  = gen_count;
+	dataflow->kill_first[count] = kill_count;
+
+	free(touch);
+	ofc_sema_dataflow__effect_cleanup(&effect);
+	free(mark);
+	return success;
+}
+
+/* Orders blocks by reverse postorder from the boundary block, blocks
+   which can't be reached from it are visited afterwards. */
+static uint32_t* ofc_sema_dataflow__order(
+	const ofc_sema_dataflow_t* dataflow)
+{
+	const ofc_sema_cfg_t* cfg = dataflow->cfg;
+	uint32_t count = cfg->block_count;
+
+	const uint32_t* first = (dataflow->forward
+		? cfg->succ_first : cfg->pred_first);
+	const uint32_t* edge = (dataflow->forward
+		? cfg->succ : cfg->pred);
+
+	uint32_t* order = (uint32_t*)malloc(count * sizeof(uint32_t));
+	uint32_t* stack = (uint32_t*)malloc(count * sizeof(uint32_t));
+	uint32_t* pos   = (uint32_t*)malloc(count * sizeof(uint32_t));
+	bool*     seen  = (bool*)calloc(count, sizeof(bool));
+	if (!order || !stack || !pos || !seen)
+	{
+		free(seen);
+		free(pos);
+		free(stack);
+		free(order);
+		return NULL;
+	}
+
+	uint32_t post = count;
+	uint32_t root = (dataflow->forward
+		? OFC_SEMA_CFG_ENTRY : OFC_SEMA_CFG_EXIT);
+	uint32_t r;
+	for (r = 0; r <= count; r++)
+	{
+		uint32_t start = (r == 0 ? root : (r - 1));
+		if (seen[start])
+			continue;
+
+		uint32_t sp = 0;
+		seen[start] = true;
+		stack[sp] = start;
+		pos[sp++] = first[start];
+		while (sp > 0)
+		{
+			uint32_t v = stack[sp - 1];
+			if (pos[sp - 1] >= first[v + 1])
+			{
+				order[--post] = v;
+				sp--;
+				continue;
+			}
+
+			uint32_t w = edge[pos[sp - 1]++];
+			if (seen[w])
+				continue;
+
+			seen[w] = true;
+			stack[sp] = w;
+			pos[sp++] = first[w];
+		}
+	}
+
+	free(seen);
+	free(pos);
+	free(stack);
+	return order;
+}
+
+static bool ofc_sema_dataflow__solve(
+	ofc_sema_dataflow_t* dataflow)
+{
+	const ofc_sema_cfg_t* cfg = dataflow->cfg;
+	uint32_t count = cfg->block_count;
+	uint32_t words = dataflow->words;
+
+	const uint32_t* first = (dataflow->forward
+		? cfg->succ_first : cfg->pred_first);
+	const uint32_t* edge = (dataflow->forward
+		? cfg->succ : cfg->pred);
+
+	uint32_t* order   = ofc_sema_dataflow__order(dataflow);
+	bool*     pending = (bool*)malloc(count * sizeof(bool));
+	uint64_t* set     = (uint64_t*)malloc(
+		(words > 0 ? words : 1) * sizeof(uint64_t));
+	if (!order || !pending || !set)
+	{
+		free(set);
+		free(pending);
+		free(order);
+		return false;
+	}
+
+	uint32_t b;
+	for (b = 0; b < count; b++)
+	{
+		pending[b] = true;
+		ofc_sema_dataflow__fill(&dataflow->out[b * words],
+			words, dataflow->bits, dataflow->intersect);
+	}
+
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+
+		uint32_t i;
+		for (i = 0; i < count; i++)
+		{
+			b = order[i];
+			if (!pending[b])
+				continue;
+			pending[b] = false;
+			dataflow->visits++;
+
+			ofc_sema_dataflow_in(dataflow, b, set);
+
+			uint32_t k;
+			for (k = dataflow->kill_first[b]; k < dataflow->kill_first[b + 1]; k++)
+				ofc_sema_bitset_clear(set, dataflow->kill[k]);
+			for (k = dataflow->gen_first[b]; k < dataflow->gen_first[b + 1]; k++)
+				ofc_sema_bitset_set(set, dataflow->gen[k]);
+
+			uint64_t* out = &dataflow->out[b * words];
+			if (memcmp(out, set, (words * sizeof(uint64_t))) == 0)
+				continue;
+			memcpy(out, set, (words * sizeof(uint64_t)));
+
+			uint32_t e;
+			for (e = first[b]; e < first[b + 1]; e++)
+				pending[edge[e]] = true;
+			changed = true;
+		}
+	}
+
+	free(set);
+	free(pending);
+	free(order);
+	return true;
+}
+
+ofc_sema_dataflow_t* ofc_sema_dataflow_create(
+	const ofc_sema_cfg_t* cfg, uint32_t bits,
+	bool forward, bool intersect,
+	const uint64_t* boundary,
+	ofc_sema_dataflow_effect_f func, void* param)
+{
+	if (!cfg || !func)
+		return NULL;
+
+	ofc_sema_dataflow_t* dataflow
+		= (ofc_sema_dataflow_t*)calloc(1, sizeof(ofc_sema_dataflow_t));
+	if (!dataflow) return NULL;
+
+	dataflow->cfg       = cfg;
+	dataflow->forward   = forward;
+	dataflow->intersect = intersect;
+	dataflow->bits      = bits;
+	dataflow->words     = OFC_SEMA_BITSET_WORDS(bits);
+
+	size_t words = (dataflow->words > 0 ? dataflow->words : 1);
+	dataflow->boundary = (uint64_t*)calloc(words, sizeof(uint64_t));
+	dataflow->out = (uint64_t*)malloc(
+		(cfg->block_count * words) * sizeof(uint64_t));
+	if (!dataflow->boundary || !dataflow->out)
+	{
+		ofc_sema_dataflow_delete(dataflow);
+		return NULL;
+	}
+
+	if (boundary)
+	{
+		memcpy(dataflow->boundary, boundary,
+			(dataflow->words * sizeof(uint64_t)));
+	}
+
+	if (!ofc_sema_dataflow__compose(dataflow, func, param)
+		|| !ofc_sema_dataflow__solve(dataflow))
+	{
+		ofc_sema_dataflow_delete(dataflow);
+		return NULL;
+	}
+
+	return dataflow;
+}
+
+void ofc_sema_dataflow_delete(
+	ofc_sema_dataflow_t* dataflow)
+{
+	if (!dataflow)
+		return;
+
+	free(dataflow->out);
+	free(dataflow->boundary);
+	free(dataflow->kill);
+	free(dataflow->kill_first);
+	free(dataflow->gen);
+	free(dataflow->gen_first);
+	free(dataflow);
+}
+
+
+/* Local variable usage, the bits are the scalar local variables of a
+   scope whose value can't be seen or changed from outside it. */
+
+typedef enum
+{
+	OFC_SEMA_DATAFLOW__USE,
+	OFC_SEMA_DATAFLOW__DEF,
+	/* Defines part of the variable, such as a substring. */
+	OFC_SEMA_DATAFLOW__PARTIAL,
+	/* Passed by reference, so it may be read or defined. */
+	OFC_SEMA_DATAFLOW__ARG,
+} ofc_sema_dataflow__ref_e;
+
+typedef struct
+{
+	uint32_t                 bit;
+	ofc_sema_dataflow__ref_e type;
+	ofc_sparse_loc_t         src;
+} ofc_sema_dataflow__ref_t;
+
+typedef struct
+{
+	const ofc_sema_decl_t* decl;
+	uint32_t               bit;
+} ofc_sema_dataflow__var_t;
+
+typedef struct
+{
+	uint32_t                  var_count;
+	ofc_sema_dataflow__var_t* var;
+
+	/* References made by the current statement, in evaluation order. */
+	uint32_t                  ref_count, ref_max;
+	ofc_sema_dataflow__ref_t* ref;
+
+	/* NULL unless the scope has EQUIVALENCE storage. */
+	const ofc_sema_storage_t* storage;
+
+	bool failed;
+} ofc_sema_dataflow__usage_t;
+
+typedef struct
+{
+	ofc_sparse_loc_t       src;
+	const ofc_sema_decl_t* decl;
+	bool                   unset;
+} ofc_sema_dataflow__warning_t;
+
+
+static int ofc_sema_dataflow__var_compare(
+	const void* a, const void* b)
+{
+	uintptr_t pa = (uintptr_t)((const ofc_sema_dataflow__var_t*)a)->decl;
+	uintptr_t pb = (uintptr_t)((const ofc_sema_dataflow__var_t*)b)->decl;
+	return (pa < pb ? -1 : (pa > pb));
+}
+
+static bool ofc_sema_dataflow__tracked(
+	const ofc_sema_decl_t* decl)
+{
+	/* Declarations which are never both read and written already
+	   have a warning from the usage flags. */
+	return (decl && !ofc_sparse_ref_empty(decl->name)
+		&& decl->was_read && decl->was_written
+		&& !decl->is_argument && !decl->is_return
+		&& !decl->is_static && !decl->is_volatile
+		&& !decl->is_target
+		&& !decl->is_stmt_func_arg
+		&& !decl->is_external && !decl->is_intrinsic
+		&& !ofc_sema_decl_is_procedure(decl)
+		&& !ofc_sema_decl_is_parameter(decl)
+		&& !ofc_sema_decl_is_common(decl)
+		&& !ofc_sema_decl_is_composite(decl)
+		&& !ofc_sema_decl_has_initializer(decl, NULL));
+}
+
+static void ofc_sema_dataflow__ref_add(
+	ofc_sema_dataflow__usage_t* usage,
+	const ofc_sema_decl_t* decl,
+	ofc_sema_dataflow__ref_e type,
+	ofc_sparse_loc_t src)
+{
+	ofc_sema_dataflow__var_t key = { .decl = decl };
+	const ofc_sema_dataflow__var_t* var = bsearch(
+		&key, usage->var, usage->var_count,
+		sizeof(ofc_sema_dataflow__var_t),
+		ofc_sema_dataflow__var_compare);
+	if (!var) return;
+
+	if (usage->ref_count >= usage->ref_max)
+	{
+		uint32_t max = (usage->ref_max > 0 ? (usage->ref_max * 2) : 16);
+		ofc_sema_dataflow__ref_t* ref
+			= (ofc_sema_dataflow__ref_t*)realloc(usage->ref,
+				(max * sizeof(ofc_sema_dataflow__ref_t)));
+		if (!ref)
+		{
+			usage->failed = true;
+			return;
+		}
+		usage->ref     = ref;
+		usage->ref_max = max;
+	}
+
+	ofc_sema_dataflow__ref_t* ref = &usage->ref[usage->ref_count++];
+	ref->bit  = var->bit;
+	ref->type = type;
+	ref->src  = src;
+}
+
+typedef struct
+{
+	ofc_sema_dataflow__usage_t* usage;
+	ofc_sema_dataflow__ref_e    type;
+	ofc_sparse_loc_t            src;
+} ofc_sema_dataflow__alias_t;
+
+static bool ofc_sema_dataflow__alias(
+	const ofc_sema_storage_entry_t* entry, void* param)
+{
+	ofc_sema_dataflow__alias_t* alias
+		= (ofc_sema_dataflow__alias_t*)param;
+	ofc_sema_dataflow__ref_add(alias->usage,
+		entry->decl, alias->type, alias->src);
+	return !alias->usage->failed;
+}
+
+static void ofc_sema_dataflow__ref(
+	ofc_sema_dataflow__usage_t* usage,
+	const ofc_sema_decl_t* decl,
+	ofc_sema_dataflow__ref_e type,
+	ofc_sparse_loc_t src)
+{
+	if (!decl || usage->failed || (usage->var_count == 0))
+		return;
+
+	/* A name which shares storage with a variable may read or define
+	   part of it. These come first so that the last reference of an
+	   assignment is still to the variable assigned. */
+	if (usage->storage)
+	{
+		ofc_sema_dataflow__alias_t alias =
+		{
+			.usage = usage,
+			.type  = ((type == OFC_SEMA_DATAFLOW__DEF)
+				|| (type == OFC_SEMA_DATAFLOW__PARTIAL)
+					? OFC_SEMA_DATAFLOW__PARTIAL
+					: OFC_SEMA_DATAFLOW__ARG),
+			.src   = src,
+		};
+		ofc_sema_storage_alias(usage->storage, decl,
+			&alias, ofc_sema_dataflow__alias);
+	}
+
+	ofc_sema_dataflow__ref_add(usage, decl, type, src);
+}
+
+static void ofc_sema_dataflow__expr(
+	ofc_sema_dataflow__usage_t* usage,
+	const ofc_sema_expr_t* expr);
+
+static void ofc_sema_dataflow__expr_list(
+	ofc_sema_dataflow__usage_t* usage,
+	const ofc_sema_expr_list_t* list)
+{
+	if (!list)
+		return;
+
+	unsigned i;
+	for (i = 0; i < list->count; i++)
+		ofc_sema_dataflow__expr(usage, list->expr[i]);
+}
+
+/* Adds the references made by the subscripts of an lhs, then the
+   reference of type to the variable at its root. */
+static void ofc_sema_dataflow__lhs(
+	ofc_sema_dataflow__usage_t* usage,
+	const ofc_sema_lhs_t* lhs,
+	ofc_sema_dataflow__ref_e type)
+{
+	if (!lhs)
+		return;
+
+	/* Writing any part of a variable only defines part of it. */
+	ofc_sema_dataflow__ref_e parent_type
+		= (type == OFC_SEMA_DATAFLOW__DEF
+			? OFC_SEMA_DATAFLOW__PARTIAL : type);
+
+	switch (lhs->type)
+	{
+		case OFC_SEMA_LHS_DECL:
+			ofc_sema_dataflow__ref(usage, lhs->decl, type, lhs->src);
+			break;
+
+		case OFC_SEMA_LHS_ARRAY_INDEX:
+			if (lhs->index)
+			{
+				unsigned i;
+				for (i = 0; i < lhs->index->dimensions; i++)
+					ofc_sema_dataflow__expr(usage, lhs->index->index[i]);
+			}
+			ofc_sema_dataflow__lhs(usage, lhs->parent, parent_type);
+			break;
+
+		case OFC_SEMA_LHS_ARRAY_SLICE:
+			if (lhs->slice.slice)
+			{
+				unsigned i;
+				for (i = 0; i < lhs->slice.slice->dimensions; i++)
+				{
+					const ofc_sema_array_segment_t* segment
+						= &lhs->slice.slice->segment[i];
+					ofc_sema_dataflow__expr(usage, segment->first);
+					ofc_sema_dataflow__expr(usage, segment->last);
+					ofc_sema_dataflow__expr(usage, segment->stride);
+				}
+			}
+			ofc_sema_dataflow__lhs(usage, lhs->parent, parent_type);
+			break;
+
+		case OFC_SEMA_LHS_SUBSTRING:
+			ofc_sema_dataflow__expr(usage, lhs->substring.first);
+			ofc_sema_dataflow__expr(usage, lhs->substring.last);
+			ofc_sema_dataflow__lhs(usage, lhs->parent, parent_type);
+			break;
+
+		case OFC_SEMA_LHS_STRUCTURE_MEMBER:
+			ofc_sema_dataflow__lhs(usage, lhs->parent, parent_type);
+			break;
+
+		case OFC_SEMA_LHS_IMPLICIT_DO:
+			ofc_sema_dataflow__expr(usage, lhs->implicit_do.init);
+			ofc_sema_dataflow__expr(usage, lhs->implicit_do.last);
+			ofc_sema_dataflow__expr(usage, lhs->implicit_do.step);
+			ofc_sema_dataflow__ref(usage, lhs->implicit_do.iter,
+				OFC_SEMA_DATAFLOW__ARG, lhs->src);
+			if (lhs->implicit_do.lhs)
+			{
+				unsigned i;
+				for (i = 0; i < lhs->implicit_do.lhs->count; i++)
+				{
+					ofc_sema_dataflow__lhs(usage,
+						lhs->implicit_do.lhs->lhs[i], type);
+				}
+			}
+			break;
+
+		default:
+			break;
+	}
+}
+
+static void ofc_sema_dataflow__args(
+	ofc_sema_dataflow__usage_t* usage,
+	const ofc_sema_expr_list_t* args)
+{
+	if (!args)
+		return;
+
+	unsigned i;
+	for (i = 0; i < args->count; i++)
+	{
+		const ofc_sema_expr_t* arg = args->expr[i];
+		if (arg && (arg->type == OFC_SEMA_EXPR_LHS))
+			ofc_sema_dataflow__lhs(usage, arg->lhs,
+				OFC_SEMA_DATAFLOW__ARG);
+		else
+			ofc_sema_dataflow__expr(usage, arg);
+	}
+}
+
+static void ofc_sema_dataflow__expr(
+	ofc_sema_dataflow__usage_t* usage,
+	const ofc_sema_expr_t* expr)
+{
+	if (!expr)
+		return;
+
+	switch (expr->type)
+	{
+		case OFC_SEMA_EXPR_CONSTANT:
+			break;
+
+		case OFC_SEMA_EXPR_LHS:
+			ofc_sema_dataflow__lhs(usage, expr->lhs,
+				OFC_SEMA_DATAFLOW__USE);
+			break;
+
+		case OFC_SEMA_EXPR_CAST:
+			ofc_sema_dataflow__expr(usage, expr->cast.expr);
+			break;
+
+		case OFC_SEMA_EXPR_INTRINSIC:
+			ofc_sema_dataflow__expr_list(usage, expr->args);
+			break;
+
+		case OFC_SEMA_EXPR_FUNCTION:
+			/* A statement function reads the host variables in its body. */
+			if (ofc_sema_decl_is_stmt_func(expr->function))
+			{
+				ofc_sema_dataflow__expr_list(usage, expr->args);
+				if (expr->function->func)
+					ofc_sema_dataflow__expr(usage, expr->function->func->expr);
+			}
+			else
+			{
+				ofc_sema_dataflow__args(usage, expr->args);
+			}
+			break;
+
+		case OFC_SEMA_EXPR_IMPLICIT_DO:
+			ofc_sema_dataflow__expr(usage, expr->implicit_do.init);
+			ofc_sema_dataflow__expr(usage, expr->implicit_do.last);
+			ofc_sema_dataflow__expr(usage, expr->implicit_do.step);
+			ofc_sema_dataflow__ref(usage, expr->implicit_do.iter,
+				OFC_SEMA_DATAFLOW__ARG, expr->src);
+			ofc_sema_dataflow__expr_list(usage, expr->implicit_do.expr);
+			break;
+
+		default:
+			ofc_sema_dataflow__expr(usage, expr->a);
+			ofc_sema_dataflow__expr(usage, expr->b);
+			break;
+	}
+}
+
+static void ofc_sema_dataflow__expr_def(
+	ofc_sema_dataflow__usage_t* usage,
+	const ofc_sema_expr_t* expr)
+{
+	if (expr && (expr->type == OFC_SEMA_EXPR_LHS))
+		ofc_sema_dataflow__lhs(usage, expr->lhs,
+			OFC_SEMA_DATAFLOW__DEF);
+	else
+		ofc_sema_dataflow__expr(usage, expr);
+}
+
+/* Finds the references made by a statement itself, the statements
+   nested in it have their own place in the graph. */
+static bool ofc_sema_dataflow__stmt(
+	ofc_sema_dataflow__usage_t* usage,
+	const ofc_sema_stmt_t* stmt)
+{
+	usage->ref_count = 0;
+
+	switch (stmt->type)
+	{
+		case OFC_SEMA_STMT_ASSIGNMENT:
+			ofc_sema_dataflow__expr(usage, stmt->assignment.expr);
+			ofc_sema_dataflow__lhs(usage, stmt->assignment.dest,
+				OFC_SEMA_DATAFLOW__DEF);
+			break;
+
+		case OFC_SEMA_STMT_ASSIGN:
+			ofc_sema_dataflow__ref(usage, stmt->assign.dest,
+				OFC_SEMA_DATAFLOW__DEF, stmt->src);
+			break;
+
+		case OFC_SEMA_STMT_IO_WRITE:
+			ofc_sema_dataflow__expr(usage, stmt->io_write.unit);
+			ofc_sema_dataflow__expr(usage, stmt->io_write.format);
+			ofc_sema_dataflow__expr(usage, stmt->io_write.rec);
+			ofc_sema_dataflow__expr(usage, stmt->io_write.advance);
+			ofc_sema_dataflow__expr_list(usage, stmt->io_write.iolist);
+			ofc_sema_dataflow__expr_def(usage, stmt->io_write.iostat);
+			break;
+
+		case OFC_SEMA_STMT_IO_READ:
+			ofc_sema_dataflow__expr(usage, stmt->io_read.unit);
+			ofc_sema_dataflow__expr(usage, stmt->io_read.format);
+			ofc_sema_dataflow__expr(usage, stmt->io_read.rec);
+			ofc_sema_dataflow__expr(usage, stmt->io_read.advance);
+			if (stmt->io_read.iolist)
+			{
+				unsigned i;
+				for (i = 0; i < stmt->io_read.iolist->count; i++)
+				{
+					ofc_sema_dataflow__lhs(usage,
+						stmt->io_read.iolist->lhs[i],
+						OFC_SEMA_DATAFLOW__DEF);
+				}
+			}
+			ofc_sema_dataflow__expr_def(usage, stmt->io_read.iostat);
+			ofc_sema_dataflow__expr_def(usage, stmt->io_read.size);
+			break;
+
+		case OFC_SEMA_STMT_IO_PRINT:
+			ofc_sema_dataflow__expr(usage, stmt->io_print.format);
+			ofc_sema_dataflow__expr_list(usage, stmt->io_print.iolist);
+			break;
+
+		case OFC_SEMA_STMT_IO_REWIND:
+		case OFC_SEMA_STMT_IO_END_FILE:
+		case OFC_SEMA_STMT_IO_BACKSPACE:
+			ofc_sema_dataflow__expr(usage, stmt->io_position.unit);
+			ofc_sema_dataflow__expr_def(usage, stmt->io_position.iostat);
+			break;
+
+		case OFC_SEMA_STMT_IO_OPEN:
+			ofc_sema_dataflow__expr(usage, stmt->io_open.unit);
+			ofc_sema_dataflow__expr(usage, stmt->io_open.recl);
+			ofc_sema_dataflow__expr(usage, stmt->io_open.access);
+			ofc_sema_dataflow__expr(usage, stmt->io_open.action);
+			ofc_sema_dataflow__expr(usage, stmt->io_open.blank);
+			ofc_sema_dataflow__expr(usage, stmt->io_open.delim);
+			ofc_sema_dataflow__expr(usage, stmt->io_open.file);
+			ofc_sema_dataflow__expr(usage, stmt->io_open.form);
+			ofc_sema_dataflow__expr(usage, stmt->io_open.pad);
+			ofc_sema_dataflow__expr(usage, stmt->io_open.position);
+			ofc_sema_dataflow__expr(usage, stmt->io_open.status);
+			ofc_sema_dataflow__expr_def(usage, stmt->io_open.iostat);
+			break;
+
+		case OFC_SEMA_STMT_IO_CLOSE:
+			ofc_sema_dataflow__expr(usage, stmt->io_close.unit);
+			ofc_sema_dataflow__expr(usage, stmt->io_close.status);
+			ofc_sema_dataflow__expr_def(usage, stmt->io_close.iostat);
+			break;
+
+		case OFC_SEMA_STMT_IO_INQUIRE:
+		{
+			ofc_sema_dataflow__expr(usage, stmt->io_inquire.unit);
+			ofc_sema_dataflow__expr(usage, stmt->io_inquire.file);
+
+			const ofc_sema_lhs_t* lhs[] =
+			{
+				stmt->io_inquire.access, stmt->io_inquire.action,
+				stmt->io_inquire.blank, stmt->io_inquire.delim,
+				stmt->io_inquire.direct, stmt->io_inquire.exist,
+				stmt->io_inquire.form, stmt->io_inquire.formatted,
+				stmt->io_inquire.iostat, stmt->io_inquire.name,
+				stmt->io_inquire.named, stmt->io_inquire.nextrec,
+				stmt->io_inquire.number, stmt->io_inquire.opened,
+				stmt->io_inquire.pad, stmt->io_inquire.position,
+				stmt->io_inquire.read, stmt->io_inquire.readwrite,
+				stmt->io_inquire.recl, stmt->io_inquire.sequential,
+				stmt->io_inquire.unformatted, stmt->io_inquire.write,
+			};
+			unsigned i;
+			for (i = 0; i < (sizeof(lhs) / sizeof(lhs[0])); i++)
+				ofc_sema_dataflow__lhs(usage, lhs[i], OFC_SEMA_DATAFLOW__DEF);
+			break;
+		}
+
+		case OFC_SEMA_STMT_IF_COMPUTED:
+			ofc_sema_dataflow__expr(usage, stmt->if_comp.cond);
+			break;
+		case OFC_SEMA_STMT_IF_STATEMENT:
+			ofc_sema_dataflow__expr(usage, stmt->if_stmt.cond);
+			break;
+		case OFC_SEMA_STMT_IF_THEN:
+			ofc_sema_dataflow__expr(usage, stmt->if_then.cond);
+			break;
+
+		case OFC_SEMA_STMT_STOP:
+		case OFC_SEMA_STMT_PAUSE:
+			ofc_sema_dataflow__expr(usage, stmt->stop_pause.str);
+			break;
+
+		case OFC_SEMA_STMT_GO_TO:
+			/* Reads the variable of an assigned GO TO. */
+			ofc_sema_dataflow__expr(usage, stmt->go_to.label);
+			break;
+		case OFC_SEMA_STMT_GO_TO_COMPUTED:
+			ofc_sema_dataflow__expr(usage, stmt->go_to_comp.cond);
+			break;
+
+		/* The loop header runs on every iteration, so it both reads
+		   and sets the iteration variable. */
+		case OFC_SEMA_STMT_DO_LABEL:
+			ofc_sema_dataflow__expr(usage, stmt->do_label.init);
+			ofc_sema_dataflow__expr(usage, stmt->do_label.last);
+			ofc_sema_dataflow__expr(usage, stmt->do_label.step);
+			ofc_sema_dataflow__lhs(usage, stmt->do_label.iter,
+				OFC_SEMA_DATAFLOW__ARG);
+			break;
+		case OFC_SEMA_STMT_DO_BLOCK:
+			ofc_sema_dataflow__expr(usage, stmt->do_block.init);
+			ofc_sema_dataflow__expr(usage, stmt->do_block.last);
+			ofc_sema_dataflow__expr(usage, stmt->do_block.step);
+			ofc_sema_dataflow__lhs(usage, stmt->do_block.iter,
+				OFC_SEMA_DATAFLOW__ARG);
+			break;
+		case OFC_SEMA_STMT_DO_WHILE:
+			ofc_sema_dataflow__expr(usage, stmt->do_while.cond);
+			break;
+		case OFC_SEMA_STMT_DO_WHILE_BLOCK:
+			ofc_sema_dataflow__expr(usage, stmt->do_while_block.cond);
+			break;
+
+		case OFC_SEMA_STMT_CALL:
+			ofc_sema_dataflow__args(usage, stmt->call.args);
+			break;
+
+		case OFC_SEMA_STMT_RETURN:
+			ofc_sema_dataflow__expr(usage, stmt->alt_return);
+			break;
+
+		default:
+			break;
+	}
+
+	return !usage->failed;
+}
+
+/* A variable may be unset while the entry definition reaches it,
+   anything which could set it kills that definition. */
+static bool ofc_sema_dataflow__unset_effect(
+	const ofc_sema_stmt_t* stmt,
+	ofc_sema_dataflow_effect_t* effect,
+	void* param)
+{
+	ofc_sema_dataflow__usage_t* usage
+		= (ofc_sema_dataflow__usage_t*)param;
+	if (!ofc_sema_dataflow__stmt(usage, stmt))
+		return false;
+
+	uint32_t i;
+	for (i = 0; i < usage->ref_count; i++)
+	{
+		if ((usage->ref[i].type != OFC_SEMA_DATAFLOW__USE)
+			&& !ofc_sema_dataflow_effect_kill(effect, usage->ref[i].bit))
+			return false;
+	}
+	return true;
+}
+
+static bool ofc_sema_dataflow__live_effect(
+	const ofc_sema_stmt_t* stmt,
+	ofc_sema_dataflow_effect_t* effect,
+	void* param)
+{
+	ofc_sema_dataflow__usage_t* usage
+		= (ofc_sema_dataflow__usage_t*)param;
+	if (!ofc_sema_dataflow__stmt(usage, stmt))
+		return false;
+
+	uint32_t i;
+	for (i = 0; i < usage->ref_count; i++)
+	{
+		bool success = true;
+		switch (usage->ref[i].type)
+		{
+			case OFC_SEMA_DATAFLOW__USE:
+			case OFC_SEMA_DATAFLOW__ARG:
+				success = ofc_sema_dataflow_effect_gen(
+					effect, usage->ref[i].bit);
+				break;
+			case OFC_SEMA_DATAFLOW__DEF:
+				success = ofc_sema_dataflow_effect_kill(
+					effect, usage->ref[i].bit);
+				break;
+			default:
+				break;
+		}
+		if (!success) return false;
+	}
+	return true;
+}
+
+static bool ofc_sema_dataflow__warning_add(
+	ofc_sema_dataflow__warning_t** warning,
+	uint32_t* count, uint32_t* max,
+	ofc_sparse_loc_t src, const ofc_sema_decl_t* decl, bool unset)
+{
+	if (*count >= *max)
+	{
+		uint32_t nmax = (*max > 0 ? (*max * 2) : 16);
+		ofc_sema_dataflow__warning_t* nwarning
+			= (ofc_sema_dataflow__warning_t*)realloc(*warning,
+				(nmax * sizeof(ofc_sema_dataflow__warning_t)));
+		if (!nwarning) return false;
+		*warning = nwarning;
+		*max     = nmax;
+	}
+
+	(*warning)[*count].src   = src;
+	(*warning)[*count].decl  = decl;
+	(*warning)[*count].unset = unset;
+	(*count)++;
+	return true;
+}
+
+static int ofc_sema_dataflow__warning_compare(
+	const void* a, const void* b)
+{
+	uint32_t pa = ((const ofc_sema_dataflow__warning_t*)a)->src.pos;
+	uint32_t pb = ((const ofc_sema_dataflow__warning_t*)b)->src.pos;
+	return (pa < pb ? -1 : (pa > pb));
+}
+
+/* COMMON storage is visible to other units, and we can't tell what
+   an entry of unknown size overlaps. Other EQUIVALENCE storage is
+   tracked through the names which overlap it. */
+static bool ofc_sema_dataflow__shared(
+	const ofc_sema_storage_t* storage,
+	const ofc_sema_decl_t* decl)
+{
+	const ofc_sema_storage_entry_t* entry
+		= ofc_sema_storage_find(storage, decl);
+	return (entry && ((entry->size == 0)
+		|| storage->class[entry->class].common));
+}
+
+bool ofc_sema_dataflow_warn(
+	const ofc_sema_scope_t* scope)
+{
+	if (!scope || scope->save || !scope->decl)
+		return true;
+
+	switch (scope->type)
+	{
+		case OFC_SEMA_SCOPE_GLOBAL:
+		case OFC_SEMA_SCOPE_PROGRAM:
+		case OFC_SEMA_SCOPE_SUBROUTINE:
+		case OFC_SEMA_SCOPE_FUNCTION:
+			break;
+		default:
+			return true;
+	}
+
+	/* Contained procedures can see the variables of their host,
+	   the procedures of a file are children of the global scope
+	   but can't. */
+	if (scope->child && (scope->type != OFC_SEMA_SCOPE_GLOBAL))
+	{
+		unsigned i;
+		for (i = 0; i < scope->child->count; i++)
+		{
+			if (scope->child->scope[i]
+				&& (scope->child->scope[i]->type != OFC_SEMA_SCOPE_STMT_FUNC))
+				return true;
+		}
+	}
+
+	/* Variables which share storage can be read or changed through
+	   another name. */
+	ofc_sema_storage_t* storage = NULL;
+	if (scope->equiv && (scope->equiv->count > 0))
+	{
+		storage = ofc_sema_storage_create(scope);
+		if (!storage) return true;
+	}
+
+	ofc_sema_dataflow__usage_t usage;
+	memset(&usage, 0x00, sizeof(usage));
+
+	usage.var = (ofc_sema_dataflow__var_t*)malloc(
+		(scope->decl->count > 0 ? scope->decl->count : 1)
+			* sizeof(ofc_sema_dataflow__var_t));
+	if (!usage.var)
+	{
+		ofc_sema_storage_delete(storage);
+		return false;
+	}
+
+	unsigned i;
+	for (i = 0; i < scope->decl->count; i++)
+	{
+		const ofc_sema_decl_t* decl = scope->decl->decl_ref[i];
+		if (!ofc_sema_dataflow__tracked(decl)
+			|| ofc_sema_dataflow__shared(storage, decl))
+			continue;
+		usage.var[usage.var_count].decl = decl;
+		usage.var[usage.var_count].bit  = usage.var_count;
+		usage.var_count++;
+	}
+
+	if (usage.var_count == 0)
+	{
+		ofc_sema_storage_delete(storage);
+		free(usage.var);
+		return true;
+	}
+	usage.storage = storage;
+
+	/* Bits were numbered in declaration order, keep that for reporting. */
+	const ofc_sema_decl_t** decl = (const ofc_sema_decl_t**)malloc(
+		usage.var_count * sizeof(const ofc_sema_decl_t*));
+	if (!decl)
+	{
+		ofc_sema_storage_delete(storage);
+		free(usage.var);
+		return false;
+	}
+	for (i = 0; i < usage.var_count; i++)
+		decl[i] = usage.var[i].decl;
+
+	qsort(usage.var, usage.var_count,
+		sizeof(ofc_sema_dataflow__var_t),
+		ofc_sema_dataflow__var_compare);
+
+	uint32_t words = OFC_SEMA_BITSET_WORDS(usage.var_count);
+	uint64_t* set = (uint64_t*)malloc(words * sizeof(uint64_t));
+	bool* reported = (bool*)calloc(usage.var_count, sizeof(bool));
+
+	ofc_sema_cfg_t* cfg = ofc_sema_cfg_create(scope);
+	ofc_sema_dataflow_t* unset = NULL;
+	ofc_sema_dataflow_t* live  = NULL;
+
+	bool success = (set && reported && cfg);
+	if (success)
+	{
+		/* Every variable is unset on entry. */
+		ofc_sema_dataflow__fill(set, words, usage.var_count, true);
+		unset = ofc_sema_dataflow_create(cfg, usage.var_count,
+			true, false, set, ofc_sema_dataflow__unset_effect, &usage);
+		live = ofc_sema_dataflow_create(cfg, usage.var_count,
+			false, false, NULL, ofc_sema_dataflow__live_effect, &usage);
+		success = (unset && live);
+	}
+
+	ofc_sema_dataflow__warning_t* warning = NULL;
+	uint32_t warning_count = 0, warning_max = 0;
+
+	uint32_t b;
+	for (b = 0; success && (b < cfg->block_count); b++)
+	{
+		if (!ofc_sema_cfg_reachable(cfg, b))
+			continue;
+
+		uint32_t s_first = cfg->stmt_first[b];
+		uint32_t s_last  = cfg->stmt_first[b + 1];
+
+		/* Uses reached by the entry definition, once per variable. */
+		ofc_sema_dataflow_in(unset, b, set);
+		uint32_t s;
+		for (s = s_first; success && (s < s_last); s++)
+		{
+			success = ofc_sema_dataflow__stmt(&usage, cfg->stmt[s]);
+
+			uint32_t r;
+			for (r = 0; success && (r < usage.ref_count); r++)
+			{
+				const ofc_sema_dataflow__ref_t* ref = &usage.ref[r];
+				if (ref->type == OFC_SEMA_DATAFLOW__USE)
+				{
+					if (!reported[ref->bit]
+						&& ofc_sema_bitset_test(set, ref->bit))
+					{
+						reported[ref->bit] = true;
+						success = ofc_sema_dataflow__warning_add(
+							&warning, &warning_count, &warning_max,
+							ref->src, decl[ref->bit], true);
+					}
+				}
+				else
+				{
+					ofc_sema_bitset_clear(set, ref->bit);
+				}
+			}
+		}
+
+		/* Assignments whose value isn't live afterwards. */
+		ofc_sema_dataflow_in(live, b, set);
+		for (s = s_last; success && (s-- > s_first);)
+		{
+			const ofc_sema_stmt_t* stmt = cfg->stmt[s];
+			success = ofc_sema_dataflow__stmt(&usage, stmt);
+			if (!success) break;
+
+			if ((stmt->type == OFC_SEMA_STMT_ASSIGNMENT)
+				&& (usage.ref_count > 0))
+			{
+				const ofc_sema_dataflow__ref_t* ref
+					= &usage.ref[usage.ref_count - 1];
+				if ((ref->type == OFC_SEMA_DATAFLOW__DEF)
+					&& !ofc_sema_bitset_test(set, ref->bit))
+				{
+					success = ofc_sema_dataflow__warning_add(
+						&warning, &warning_count, &warning_max,
+						stmt->src, decl[ref->bit], false);
+				}
+			}
+
+			uint32_t r;
+			for (r = 0; r < usage.ref_count; r++)
+			{
+				if (usage.ref[r].type == OFC_SEMA_DATAFLOW__DEF)
+					ofc_sema_bitset_clear(set, usage.ref[r].bit);
+			}
+			for (r = 0; r < usage.ref_count; r++)
+			{
+				if ((usage.ref[r].type == OFC_SEMA_DATAFLOW__USE)
+					|| (usage.ref[r].type == OFC_SEMA_DATAFLOW__ARG))
+					ofc_sema_bitset_set(set, usage.ref[r].bit);
+			}
+		}
+	}
+
+	if (success && (warning_count > 0))
+	{
+		qsort(warning, warning_count,
+			sizeof(ofc_sema_dataflow__warning_t),
+			ofc_sema_dataflow__warning_compare);
+
+		uint32_t w;
+		for (w = 0; w < warning_count; w++)
+		{
+			ofc_str_ref_t name = warning[w].decl->name.string;
+			if (warning[w].unset)
+			{
+				ofc_sparse_loc_warning(warning[w].src,
+					"Variable '%.*s' may be used before it is set",
+					name.size, name.base);
+			}
+			else
+			{
+				ofc_sparse_loc_warning(warning[w].src,
+					"Value assigned to '%.*s' is never used",
+					name.size, name.base);
+			}
+		}
+	}
+
+	free(warning);
+	ofc_sema_dataflow_delete(live);
+	ofc_sema_dataflow_delete(unset);
+	ofc_sema_cfg_delete(cfg);
+	free(reported);
+	free(set);
+	free(usage.ref);
+	free(decl);
+	free(usage.var);
+	ofc_sema_storage_delete(storage);
+	return success;
+}
@@ -13,6 +13,8 @@
  * limitations under the License.
  */
 
+#include <limits.h>
+
 #include "ofc/sema.h"
 
 
@@ -261,7 +263,7 @@ bool ofc_sema_decl_type_set(
 bool ofc_sema_decl_array_set(
 	ofc_sema_decl_t*  decl,
 	ofc_sema_array_t* array,
-	ofc_sparse_ref_t  err_pos)
+	ofc_sparse_loc_t  err_pos)
 {
 	if (!decl || !array)
 		return false;
@@ -271,12 +273,12 @@ bool ofc_sema_decl_array_set(
 		if (!ofc_sema_array_compare(
 			decl->array, array))
 		{
-			ofc_sparse_ref_error(err_pos,
+			ofc_sparse_loc_error(err_pos,
 				"Conflicting array dimensions specified");
 			return false;
 		}
 
-		ofc_sparse_ref_warning(err_pos,
+		ofc_sparse_loc_warning(err_pos,
 			"Redundant array dimension specification");
 		ofc_sema_array_delete(array);
 		return true;
@@ -284,7 +286,7 @@ bool ofc_sema_decl_array_set(
 
 	if (ofc_sema_decl_is_final(decl))
 	{
-		ofc_sparse_ref_error(err_pos,
+		ofc_sparse_loc_error(err_pos,
 			"Can't modify dimensions of declaration after use");
 		return false;
 	}
@@ -343,7 +345,7 @@ static bool ofc_sema_decl__elem(
 
 	if (decl->is_intrinsic)
 	{
-		ofc_sparse_ref_error(lhs->src,
+		ofc_sparse_loc_error(lhs->src,
 			"Invalid declaration of an INTRINSIC");
 		return false;
 	}
@@ -367,7 +369,7 @@ static bool ofc_sema_decl__elem(
 	{
 		if (!type)
 		{
-			ofc_sparse_ref_error(lhs->src,
+			ofc_sparse_loc_error(lhs->src,
 				"Can't specify a star LEN/KIND for an undefined type");
 			ofc_sema_array_delete(array);
 			return false;
@@ -377,7 +379,7 @@ static bool ofc_sema_decl__elem(
 		{
 			if (!ofc_sema_type_is_character(type))
 			{
-				ofc_sparse_ref_error(lhs->src,
+				ofc_sparse_loc_error(lhs->src,
 					"Only CHARACTER types may have an assumed length");
 				ofc_sema_array_delete(array);
 				return false;
@@ -385,7 +387,7 @@ static bool ofc_sema_decl__elem(
 
 			if (type && (type->len != 0))
 			{
-				ofc_sparse_ref_warning(lhs->src,
+				ofc_sparse_loc_warning(lhs->src,
 					"Overriding specified star length in decl list");
 			}
 
@@ -415,7 +417,7 @@ static bool ofc_sema_decl__elem(
 
 			if (!resolved)
 			{
-				ofc_sparse_ref_error(lhs->src,
+				ofc_sparse_loc_error(lhs->src,
 					"Star length must be a positive whole integer");
 				ofc_sema_array_delete(array);
 				return false;
@@ -426,7 +428,7 @@ static bool ofc_sema_decl__elem(
 				if (type && (type->len != 0)
 					&& (type->len != star_len))
 				{
-					ofc_sparse_ref_warning(lhs->src,
+					ofc_sparse_loc_warning(lhs->src,
 						"Overriding specified LEN in decl list");
 				}
 
@@ -444,7 +446,7 @@ static bool ofc_sema_decl__elem(
 			{
 				if (star_len == 0)
 				{
-					ofc_sparse_ref_error(lhs->src,
+					ofc_sparse_loc_error(lhs->src,
 						"Star KIND must be non-zero");
 					ofc_sema_array_delete(array);
 					return false;
@@ -453,7 +455,7 @@ static bool ofc_sema_decl__elem(
 				if (type && (type->kind != OFC_SEMA_KIND_NONE)
 					&& (type->kind != star_len))
 				{
-					ofc_sparse_ref_warning(lhs->src,
+					ofc_sparse_loc_warning(lhs->src,
 						"Overriding specified KIND in decl list");
 				}
 
@@ -565,7 +567,7 @@ static bool ofc_sema_decl__elem(
 	{
 		if (array)
 		{
-			ofc_sparse_ref_error(lhs->src,
+			ofc_sparse_loc_error(lhs->src,
 				"Multiple definition of array dimensions");
 			ofc_sema_array_delete(array);
 			return false;
@@ -594,7 +596,7 @@ static bool ofc_sema_decl__elem(
 		if ((structure || !ofc_sema_scope_is_procedure(scope))
 			&& !ofc_sema_array_total(array, NULL))
 		{
-			ofc_sparse_ref_error(lhs->src,
+			ofc_sparse_loc_error(lhs->src,
 				"Dynamically sized arrays are only valid in procedures");
 			ofc_sema_array_delete(array);
 			return false;
@@ -605,12 +607,12 @@ static bool ofc_sema_decl__elem(
 			if (!ofc_sema_array_compare(
 				decl->array, array))
 			{
-				ofc_sparse_ref_error(lhs->src,
+				ofc_sparse_loc_error(lhs->src,
 					"Multiple incompatible definitions of array dimensions");
 				ofc_sema_array_delete(array);
 				return false;
 			}
-			ofc_sparse_ref_warning(lhs->src,
+			ofc_sparse_loc_warning(lhs->src,
 				"Redefinition of array dimensions");
 			ofc_sema_array_delete(array);
 		}
@@ -941,7 +943,7 @@ bool ofc_sema_decl_init(
 	if (decl->was_written
 		|| decl->was_read)
 	{
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Can't initialize declaration after use");
 		return false;
 	}
@@ -951,7 +953,7 @@ bool ofc_sema_decl_init(
 
 	if (!ofc_sema_expr_is_constant(init))
 	{
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Initializer element not constant");
 		return false;
 	}
@@ -959,7 +961,7 @@ bool ofc_sema_decl_init(
 	if (ofc_sema_decl_is_composite(decl))
 	{
 		/* TODO - Support F90 "(/ 0, 1 /)" array initializers. */
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Can't initialize non-scalar declaration with expression");
 		return false;
 	}
@@ -984,7 +986,7 @@ bool ofc_sema_decl_init(
 
 		if (len == 0)
 		{
-			ofc_sparse_ref_error(init->src,
+			ofc_sparse_loc_error(init->src,
 				"Can't initialize variable length CHARACTER PARAMETER"
 				" with empty string");
 			return false;
@@ -1009,7 +1011,7 @@ bool ofc_sema_decl_init(
 				expr, type);
 		if (!cast)
 		{
-			ofc_sparse_ref_error(init->src,
+			ofc_sparse_loc_error(init->src,
 				"Incompatible types in initializer");
 			ofc_sema_expr_delete(expr);
 			return false;
@@ -1019,7 +1021,7 @@ bool ofc_sema_decl_init(
 
 	if (decl->init.is_substring)
 	{
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Conflicting initializaters");
 		ofc_sema_expr_delete(expr);
 		return false;
@@ -1032,12 +1034,12 @@ bool ofc_sema_decl_init(
 
 		if (redecl)
 		{
-			ofc_sparse_ref_warning(init->src,
+			ofc_sparse_loc_warning(init->src,
 				"Duplicate initialization");
 		}
 		else
 		{
-			ofc_sparse_ref_error(init->src,
+			ofc_sparse_loc_error(init->src,
 				"Conflicting initializaters");
 			return false;
 		}
@@ -1064,7 +1066,7 @@ bool ofc_sema_decl_init_offset(
 	if (decl->was_written
 		|| decl->was_read)
 	{
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Can't initialize declaration after use");
 		return false;
 	}
@@ -1087,14 +1089,14 @@ bool ofc_sema_decl_init_offset(
 	if (!ofc_sema_decl_elem_count(
 		decl, &elem_count))
 	{
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Can't initialize element in array of unknown size");
 		return false;
 	}
 
 	if (offset >= elem_count)
 	{
-		ofc_sparse_ref_warning(init->src,
+		ofc_sparse_loc_warning(init->src,
 			"Initializer destination out-of-bounds");
 		return false;
 	}
@@ -1115,7 +1117,7 @@ bool ofc_sema_decl_init_offset(
 
 	if (!ofc_sema_expr_is_constant(init))
 	{
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Array initializer element not constant.");
 		return false;
 	}
@@ -1153,7 +1155,7 @@ bool ofc_sema_decl_init_offset(
 				expr, dtype);
 		if (!cast)
 		{
-			ofc_sparse_ref_error(init->src,
+			ofc_sparse_loc_error(init->src,
 				"Incompatible types in initializer");
 			ofc_sema_expr_delete(expr);
 			return false;
@@ -1163,7 +1165,7 @@ bool ofc_sema_decl_init_offset(
 
 	if (decl->init_array[offset].is_substring)
 	{
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Conflicting initializer types for array element");
 		ofc_sema_expr_delete(expr);
 		return false;
@@ -1176,13 +1178,13 @@ bool ofc_sema_decl_init_offset(
 
 		if (!equal)
 		{
-			ofc_sparse_ref_error(init->src,
+			ofc_sparse_loc_error(init->src,
 				"Re-initialization of array element"
 				" with different value");
 			return false;
 		}
 
-		ofc_sparse_ref_warning(init->src,
+		ofc_sparse_loc_warning(init->src,
 			"Re-initialization of array element");
 	}
 	else
@@ -1210,7 +1212,7 @@ bool ofc_sema_decl_init_array(
 	if (decl->was_written
 		|| decl->was_read)
 	{
-		ofc_sparse_ref_error(init[0]->src,
+		ofc_sparse_loc_error(init[0]->src,
 			"Can't initialize declaration after use");
 		return false;
 	}
@@ -1231,7 +1233,7 @@ bool ofc_sema_decl_init_array(
 
 	if (decl->init_array)
 	{
-		ofc_sparse_ref_warning(init[0]->src,
+		ofc_sparse_loc_warning(init[0]->src,
 			"Initializing arrays in multiple statements.");
 	}
 
@@ -1239,7 +1241,7 @@ bool ofc_sema_decl_init_array(
 	if (!ofc_sema_decl_elem_count(
 		decl, &elem_count))
 	{
-		ofc_sparse_ref_error(init[0]->src,
+		ofc_sparse_loc_error(init[0]->src,
 			"Can't initialize array of unknown size");
 		return false;
 	}
@@ -1263,7 +1265,7 @@ bool ofc_sema_decl_init_array(
 	{
 		if (count > elem_count)
 		{
-			ofc_sparse_ref_warning(init[0]->src,
+			ofc_sparse_loc_warning(init[0]->src,
 				"Array initializer too large, truncating.");
 			count = elem_count;
 		}
@@ -1273,7 +1275,7 @@ bool ofc_sema_decl_init_array(
 		{
 			if (!ofc_sema_expr_is_constant(init[i]))
 			{
-				ofc_sparse_ref_error(init[i]->src,
+				ofc_sparse_loc_error(init[i]->src,
 					"Array initializer element not constant.");
 				return false;
 			}
@@ -1290,7 +1292,7 @@ bool ofc_sema_decl_init_array(
 						expr, decl->type);
 				if (!cast)
 				{
-					ofc_sparse_ref_error(init[i]->src,
+					ofc_sparse_loc_error(init[i]->src,
 						"Incompatible types in initializer");
 					ofc_sema_expr_delete(expr);
 					return false;
@@ -1300,7 +1302,7 @@ bool ofc_sema_decl_init_array(
 
 			if (decl->init_array[i].is_substring)
 			{
-				ofc_sparse_ref_error(init[i]->src,
+				ofc_sparse_loc_error(init[i]->src,
 					"Conflicting initializer types for array element");
 				ofc_sema_expr_delete(expr);
 				return false;
@@ -1313,13 +1315,13 @@ bool ofc_sema_decl_init_array(
 
 				if (!equal)
 				{
-					ofc_sparse_ref_error(init[i]->src,
+					ofc_sparse_loc_error(init[i]->src,
 						"Re-initialization of array element"
 						" with different value");
 					return false;
 				}
 
-				ofc_sparse_ref_warning(init[i]->src,
+				ofc_sparse_loc_warning(init[i]->src,
 					"Re-initialization of array element");
 			}
 			else
@@ -1351,7 +1353,7 @@ bool ofc_sema_decl_init_substring(
 	if (decl->was_written
 		|| decl->was_read)
 	{
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Can't initialize declaration after use");
 		return false;
 	}
@@ -1364,21 +1366,21 @@ bool ofc_sema_decl_init_substring(
 		/* TODO - Check if substring initializer is the same as
 		          existing initializer contents and just warn. */
 
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Destination already has complete initializer");
 		return false;
 	}
 
 	if (!ofc_sema_type_is_character(type))
 	{
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Substring of non-CHARACTER type isn't supported");
 		return false;
 	}
 
 	if (type->len_var)
 	{
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Substring of variable length CHARACTER type isn't supported");
 		return false;
 	}
@@ -1392,7 +1394,7 @@ bool ofc_sema_decl_init_substring(
     unsigned ufirst = 1;
 	if (first && !ofc_sema_expr_resolve_uint(first, &ufirst))
 	{
-		ofc_sparse_ref_error(first->src,
+		ofc_sparse_loc_error(first->src,
 			"Failed to resolve substring first index");
 		return false;
 	}
@@ -1400,7 +1402,7 @@ bool ofc_sema_decl_init_substring(
 	unsigned ulast = type->len;
 	if (last && !ofc_sema_expr_resolve_uint(last, &ulast))
 	{
-		ofc_sparse_ref_error(last->src,
+		ofc_sparse_loc_error(last->src,
 			"Failed to resolve substring last index");
 		return false;
 	}
@@ -1412,7 +1414,7 @@ bool ofc_sema_decl_init_substring(
 
 	if (ufirst > ulast)
 	{
-		ofc_sparse_ref_error(first->src,
+		ofc_sparse_loc_error(first->src,
 			"Substring indices are reversed in initializer");
 		/* TODO - Reverse the string and initialize with it? */
 		return false;
@@ -1420,7 +1422,7 @@ bool ofc_sema_decl_init_substring(
 
 	if (ufirst == 0)
 	{
-		ofc_sparse_ref_error(first->src,
+		ofc_sparse_loc_error(first->src,
 			"Substring indices are 1-based"
 			", index zero is out-of-bounds");
 		return false;
@@ -1428,14 +1430,14 @@ bool ofc_sema_decl_init_substring(
 
 	if (ulast > type->len)
 	{
-		ofc_sparse_ref_error(last->src,
+		ofc_sparse_loc_error(last->src,
 			"Substring initializer out-of-bounds");
 		return false;
 	}
 
 	if (ufirst == ulast)
 	{
-		ofc_sparse_ref_warning(first->src,
+		ofc_sparse_loc_warning(first->src,
 			"Initializing a zero-length substring has no effect");
 		return true;
 	}
@@ -1444,14 +1446,14 @@ bool ofc_sema_decl_init_substring(
 		= ofc_sema_expr_constant(init);
 	if (!tv)
 	{
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Can't resolve substring initializer as constant");
 		return false;
 	}
 
 	if (!ofc_sema_type_is_character(tv->type))
 	{
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Substring initializer must be of type CHARACTER");
 		return false;
 	}
@@ -1461,12 +1463,12 @@ bool ofc_sema_decl_init_substring(
 
 	if (tv->type->len > len)
 	{
-		ofc_sparse_ref_warning(init->src,
+		ofc_sparse_loc_warning(init->src,
 			"Substring initializer too long");
 	}
 	else if (tv->type->len < len)
 	{
-		ofc_sparse_ref_warning(init->src,
+		ofc_sparse_loc_warning(init->src,
 			"Substring initializer too short");
 	}
 
@@ -1474,7 +1476,7 @@ bool ofc_sema_decl_init_substring(
 		= ofc_sema_typeval_cast(tv, type);
 	if (!ctv)
 	{
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Failed to cast substring initializer to destination KIND");
 		return false;
 	}
@@ -1525,7 +1527,7 @@ bool ofc_sema_decl_init_substring(
 			if (memcmp(&decl->init.substring.string[i * tcsize],
 				&ctv->character[j * tcsize], tcsize) != 0)
 			{
-				ofc_sparse_ref_error(init->src,
+				ofc_sparse_loc_error(init->src,
 					"Re-initialization of substring,"
 					" with different value at offset %u", (i + 1));
 				ofc_sema_typeval_delete(ctv);
@@ -1546,7 +1548,7 @@ bool ofc_sema_decl_init_substring(
 
 	if (overlap)
 	{
-		ofc_sparse_ref_warning(init->src,
+		ofc_sparse_loc_warning(init->src,
 			"Overlapping initialization of substring");
 	}
 
@@ -1568,7 +1570,7 @@ bool ofc_sema_decl_init_substring_offset(
 	if (decl->was_written
 		|| decl->was_read)
 	{
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Can't initialize declaration after use");
 		return false;
 	}
@@ -1591,21 +1593,21 @@ bool ofc_sema_decl_init_substring_offset(
 	if (!ofc_sema_decl_elem_count(
 		decl, &elem_count))
 	{
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Can't initialize element in array of unknown size");
 		return false;
 	}
 
 	if (offset >= elem_count)
 	{
-		ofc_sparse_ref_warning(init->src,
+		ofc_sparse_loc_warning(init->src,
 			"Initializer destination out-of-bounds");
 		return false;
 	}
 
 	if (!ofc_sema_expr_is_constant(init))
 	{
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Array initializer element not constant.");
 		return false;
 	}
@@ -1629,7 +1631,7 @@ bool ofc_sema_decl_init_substring_offset(
 		/* TODO - Check if substring initializer is the same as
 		          existing initializer contents and just warn. */
 
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Destination already has complete initializer");
 		return false;
 	}
@@ -1638,14 +1640,14 @@ bool ofc_sema_decl_init_substring_offset(
 		= ofc_sema_decl_type(decl);
 	if (!ofc_sema_type_is_character(type))
 	{
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Substring of non-CHARACTER type isn't supported");
 		return false;
 	}
 
 	if (type->len_var)
 	{
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Substring of variable length CHARACTER type isn't supported");
 		return false;
 	}
@@ -1653,7 +1655,7 @@ bool ofc_sema_decl_init_substring_offset(
     unsigned ufirst = 1;
 	if (first && !ofc_sema_expr_resolve_uint(first, &ufirst))
 	{
-		ofc_sparse_ref_error(first->src,
+		ofc_sparse_loc_error(first->src,
 			"Failed to resolve substring first index");
 		return false;
 	}
@@ -1661,7 +1663,7 @@ bool ofc_sema_decl_init_substring_offset(
 	unsigned ulast = type->len;
 	if (last && !ofc_sema_expr_resolve_uint(last, &ulast))
 	{
-		ofc_sparse_ref_error(last->src,
+		ofc_sparse_loc_error(last->src,
 			"Failed to resolve substring last index");
 		return false;
 	}
@@ -1673,7 +1675,7 @@ bool ofc_sema_decl_init_substring_offset(
 
 	if (ufirst > ulast)
 	{
-		ofc_sparse_ref_error(first->src,
+		ofc_sparse_loc_error(first->src,
 			"Substring indices are reversed in initializer");
 		/* TODO - Reverse the string and initialize with it? */
 		return false;
@@ -1681,7 +1683,7 @@ bool ofc_sema_decl_init_substring_offset(
 
 	if (ufirst == 0)
 	{
-		ofc_sparse_ref_error(first->src,
+		ofc_sparse_loc_error(first->src,
 			"Substring indices are 1-based"
 			", index zero is out-of-bounds");
 		return false;
@@ -1689,14 +1691,14 @@ bool ofc_sema_decl_init_substring_offset(
 
 	if (ulast > type->len)
 	{
-		ofc_sparse_ref_error(last->src,
+		ofc_sparse_loc_error(last->src,
 			"Substring initializer out-of-bounds");
 		return false;
 	}
 
 	if (ufirst == ulast)
 	{
-		ofc_sparse_ref_warning(first->src,
+		ofc_sparse_loc_warning(first->src,
 			"Initializing a zero-length substring has no effect");
 		return true;
 	}
@@ -1705,14 +1707,14 @@ bool ofc_sema_decl_init_substring_offset(
 		= ofc_sema_expr_constant(init);
 	if (!tv)
 	{
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Can't resolve substring initializer as constant");
 		return false;
 	}
 
 	if (!ofc_sema_type_is_character(tv->type))
 	{
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Substring initializer must be of type CHARACTER");
 		return false;
 	}
@@ -1722,12 +1724,12 @@ bool ofc_sema_decl_init_substring_offset(
 
 	if (tv->type->len > len)
 	{
-		ofc_sparse_ref_warning(init->src,
+		ofc_sparse_loc_warning(init->src,
 			"Substring initializer too long");
 	}
 	else if (tv->type->len < len)
 	{
-		ofc_sparse_ref_warning(init->src,
+		ofc_sparse_loc_warning(init->src,
 			"Substring initializer too short");
 	}
 
@@ -1735,7 +1737,7 @@ bool ofc_sema_decl_init_substring_offset(
 		= ofc_sema_typeval_cast(tv, type);
 	if (!ctv)
 	{
-		ofc_sparse_ref_error(init->src,
+		ofc_sparse_loc_error(init->src,
 			"Failed to cast substring initializer to destination KIND");
 		return false;
 	}
@@ -1786,7 +1788,7 @@ bool ofc_sema_decl_init_substring_offset(
 			if (memcmp(&decl->init_array[offset].substring.string[i * tcsize],
 				&ctv->character[j * tcsize], tcsize) != 0)
 			{
-				ofc_sparse_ref_error(init->src,
+				ofc_sparse_loc_error(init->src,
 					"Re-initialization of substring,"
 					" with different value at offset %u", (i + 1));
 				ofc_sema_typeval_delete(ctv);
@@ -1807,7 +1809,7 @@ bool ofc_sema_decl_init_substring_offset(
 
 	if (overlap)
 	{
-		ofc_sparse_ref_warning(init->src,
+		ofc_sparse_loc_warning(init->src,
 			"Overlapping initialization of substring");
 	}
 
@@ -2647,6 +2649,8 @@ static bool ofc_sema_decl_print_data_init__ssc(
 		cs, '\"', &string[base], size);
 }
 
+#define OFC_SEMA_DECL__INDEX_CHUNK 64
+
 bool ofc_sema_decl_print_data_init(ofc_colstr_t* cs,
 	unsigned indent,
 	const ofc_sema_decl_t* decl)
@@ -2687,6 +2691,12 @@ bool ofc_sema_decl_print_data_init(ofc_colstr_t* cs,
 
 		/* TODO - Group by nlist in slices for a cleaner print. */
 
+		/* Indices are generated a chunk at a time rather than
+		   for the whole array up front. */
+		unsigned dims = decl->array->dimensions;
+		int idx[dims * OFC_SEMA_DECL__INDEX_CHUNK];
+		unsigned chunk = UINT_MAX;
+
 		bool first;
 		unsigned i;
 		for (i = 0, first = true; i < count; i++)
@@ -2695,6 +2705,19 @@ bool ofc_sema_decl_print_data_init(ofc_colstr_t* cs,
 				&& !decl->init_array[i].expr)
 				continue;
 
+			if ((i / OFC_SEMA_DECL__INDEX_CHUNK) != chunk)
+			{
+				chunk = (i / OFC_SEMA_DECL__INDEX_CHUNK);
+				unsigned cbase = (chunk * OFC_SEMA_DECL__INDEX_CHUNK);
+				unsigned ccount = (count - cbase);
+				if (ccount > OFC_SEMA_DECL__INDEX_CHUNK)
+					ccount = OFC_SEMA_DECL__INDEX_CHUNK;
+
+				if (!ofc_sema_array_index_range(
+					decl->array, cbase, ccount, idx))
+					return false;
+			}
+
 			if (!first)
 			{
 				if (!ofc_colstr_atomic_writef(cs, ",")
@@ -2704,7 +2727,8 @@ bool ofc_sema_decl_print_data_init(ofc_colstr_t* cs,
 			first = false;
 
 			ofc_sema_array_index_t* index
-				= ofc_sema_array_index_from_offset(decl, i);
+				= ofc_sema_array_index_from_int(dims,
+					&idx[(i % OFC_SEMA_DECL__INDEX_CHUNK) * dims]);
 			if (!index) return false;
 
 			bool success = (ofc_sema_decl_print_name(cs, decl)
@@ -2950,6 +2974,35 @@ bool ofc_sema_decl_list_stmt_func_print(
 	return true;
 }
 
+bool ofc_sema_decl_procedure_print(
+	ofc_colstr_t* cs, unsigned indent,
+	const ofc_sema_decl_t* decl)
+{
+	if (!cs)
+		return false;
+
+	if (decl && decl->func)
+	{
+		if (decl->func->type == OFC_SEMA_SCOPE_SUBROUTINE)
+		{
+			if (!ofc_colstr_newline(cs, indent, NULL)
+				|| !ofc_sema_scope_print(cs, indent, decl->func))
+				return false;
+		}
+		else if (decl->func->type == OFC_SEMA_SCOPE_FUNCTION)
+		{
+			if (!ofc_colstr_newline(cs, indent, NULL)
+				|| !ofc_colstr_newline(cs, indent, NULL)
+				|| !ofc_sema_type_print(cs, decl->type->subtype)
+				|| !ofc_colstr_atomic_writef(cs, " ")
+				|| !ofc_sema_scope_print(cs, indent, decl->func))
+				return false;
+		}
+	}
+
+	return true;
+}
+
 bool ofc_sema_decl_list_procedure_print(
 	ofc_colstr_t* cs, unsigned indent,
 	const ofc_sema_decl_list_t* decl_list)
@@ -2960,25 +3013,9 @@ bool ofc_sema_decl_list_procedure_print(
 	unsigned i;
 	for (i = 0; i < decl_list->size; i++)
 	{
-		ofc_sema_decl_t* decl = decl_list->decl[i];
-		if (decl && decl->func)
-		{
-			if (decl->func->type == OFC_SEMA_SCOPE_SUBROUTINE)
-			{
-				if (!ofc_colstr_newline(cs, indent, NULL)
-					|| !ofc_sema_scope_print(cs, indent, decl->func))
-					return false;
-			}
-			else if (decl->func->type == OFC_SEMA_SCOPE_FUNCTION)
-			{
-				if (!ofc_colstr_newline(cs, indent, NULL)
-					|| !ofc_colstr_newline(cs, indent, NULL)
-					|| !ofc_sema_type_print(cs, decl->type->subtype)
-					|| !ofc_colstr_atomic_writef(cs, " ")
-					|| !ofc_sema_scope_print(cs, indent, decl->func))
-					return false;
-			}
-		}
+		if (!ofc_sema_decl_procedure_print(
+			cs, indent, decl_list->decl[i]))
+			return false;
 	}
 
 	return true;
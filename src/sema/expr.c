@@ -198,7 +198,7 @@ static ofc_sema_expr_t* ofc_sema_expr__create(
 
 	expr->type = type;
 
-	expr->src = OFC_SPARSE_REF_EMPTY;
+	expr->src = OFC_SPARSE_LOC_EMPTY;
 
 	expr->constant = NULL;
 	expr->label    = NULL;
@@ -211,6 +211,9 @@ static ofc_sema_expr_t* ofc_sema_expr__create(
 	expr->is_label      = false;
 	expr->is_format     = false;
 
+	expr->elem_count_valid = false;
+	expr->elem_count       = 0;
+
 	switch (type)
 	{
 		case OFC_SEMA_EXPR_CONSTANT:
@@ -458,7 +461,7 @@ ofc_sema_expr_t* ofc_sema_expr_cast(
 	else if (!ofc_sema_type_cast_is_lossless(
 		ofc_sema_expr_type(expr), type))
 	{
-		ofc_sparse_ref_warning(expr->src,
+		ofc_sparse_loc_warning(expr->src,
 			"Implicit cast may be lossy.");
 	}
 
@@ -531,7 +534,7 @@ ofc_sema_expr_t* ofc_sema_expr_integer(
 	if (!expr) return NULL;
 
 	expr->constant = ofc_sema_typeval_create_integer(
-		value, kind, OFC_SPARSE_REF_EMPTY);
+		value, kind, OFC_SPARSE_LOC_EMPTY);
 	if (!expr->constant)
 	{
 		ofc_sema_expr_delete(expr);
@@ -569,7 +572,7 @@ static ofc_sema_expr_t* ofc_sema_expr__binary(
 		= ofc_sema_expr_type_allowed(type, at);
 	if (err == OFC_SEMA_EXPR__OP_TYPE_INVALID)
 	{
-		ofc_sparse_ref_error(a->src,
+		ofc_sparse_loc_error(a->src,
 			"Can't use type %s in operator '%s'",
 			ofc_sema_type_str_rep(at),
 			ofc_parse_operator_str_rep(op));
@@ -578,7 +581,7 @@ static ofc_sema_expr_t* ofc_sema_expr__binary(
 	}
 	else if (err == OFC_SEMA_EXPR__OP_TYPE_WARN)
 	{
-		ofc_sparse_ref_warning(a->src,
+		ofc_sparse_loc_warning(a->src,
 			"Using type %s in operator '%s'",
 			ofc_sema_type_str_rep(at),
 			ofc_parse_operator_str_rep(op));
@@ -604,7 +607,7 @@ static ofc_sema_expr_t* ofc_sema_expr__binary(
 	err = ofc_sema_expr_type_allowed(type, bt);
 	if (err == OFC_SEMA_EXPR__OP_TYPE_INVALID)
 	{
-		ofc_sparse_ref_error(a->src,
+		ofc_sparse_loc_error(a->src,
 			"Can't use type %s in operator '%s'",
 			ofc_sema_type_str_rep(bt),
 			ofc_parse_operator_str_rep(op));
@@ -614,7 +617,7 @@ static ofc_sema_expr_t* ofc_sema_expr__binary(
 	}
 	else if (err == OFC_SEMA_EXPR__OP_TYPE_WARN)
 	{
-		ofc_sparse_ref_warning(a->src,
+		ofc_sparse_loc_warning(a->src,
 			"Using type %s in operator '%s'",
 			ofc_sema_type_str_rep(bt),
 			ofc_parse_operator_str_rep(op));
@@ -720,7 +723,7 @@ static ofc_sema_expr_t* ofc_sema_expr__binary(
 					= ofc_sema_type_promote(at, bt);
 				if (!ptype)
 				{
-					ofc_sparse_ref_error(a->src,
+					ofc_sparse_loc_error(a->src,
 						"Incompatible types (%s, %s) in operator %s",
 						ofc_sema_type_str_rep(at),
 						ofc_sema_type_str_rep(bt),
@@ -779,8 +782,8 @@ static ofc_sema_expr_t* ofc_sema_expr__binary(
 	expr->a = as;
 	expr->b = bs;
 
-	expr->src = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	expr->src = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		as->src, bs->src, &expr->src);
 
 	return expr;
@@ -818,7 +821,7 @@ static ofc_sema_expr_t* ofc_sema_expr__unary(
 		= ofc_sema_expr_type_allowed(type, at);
 	if (err == OFC_SEMA_EXPR__OP_TYPE_INVALID)
 	{
-		ofc_sparse_ref_error(a->src,
+		ofc_sparse_loc_error(a->src,
 			"Can't use type %s in operator '%s'",
 			ofc_sema_type_str_rep(at),
 			ofc_parse_operator_str_rep(op));
@@ -827,7 +830,7 @@ static ofc_sema_expr_t* ofc_sema_expr__unary(
 	}
 	else if (err == OFC_SEMA_EXPR__OP_TYPE_WARN)
 	{
-		ofc_sparse_ref_warning(a->src,
+		ofc_sparse_loc_warning(a->src,
 			"Using type %s in operator '%s'",
 			ofc_sema_type_str_rep(at),
 			ofc_parse_operator_str_rep(op));
@@ -886,7 +889,7 @@ static ofc_sema_expr_t* ofc_sema_expr__literal(
 	}
 
 	expr->constant = tv;
-	expr->src = literal->src;
+	expr->src = ofc_sparse_ref_loc(literal->src);
 	return expr;
 }
 
@@ -904,7 +907,7 @@ static ofc_sema_expr_t* ofc_sema_expr__intrinsic(
 		|| !name->parent
 		|| (name->parent->type != OFC_PARSE_LHS_VARIABLE))
 	{
-		ofc_sparse_ref_error(name->src,
+		ofc_sparse_loc_error(name->src,
 			"Invalid invocation of INTRINSIC function.");
 		return NULL;
 	}
@@ -969,8 +972,8 @@ static ofc_sema_expr_t* ofc_sema_expr__intrinsic(
 	expr->constant = ofc_sema_intrinsic_constant(
 		intrinsic, args);
 
-	expr->src = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	expr->src = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		name->parent->src, name->src,
 		&expr->src);
 
@@ -1003,7 +1006,7 @@ static ofc_sema_expr_t* ofc_sema_expr__function(
 			? (acount != fscope->args->count)
 			: (acount != 0))
 		{
-			ofc_sparse_ref_error(name->src,
+			ofc_sparse_loc_error(name->src,
 				"Incorrect number of arguments in function call.");
 			return NULL;
 		}
@@ -1064,8 +1067,8 @@ static ofc_sema_expr_t* ofc_sema_expr__function(
 	expr->function = decl;
 	expr->args     = args;
 
-	expr->src = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	expr->src = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		name->parent->src, name->src, &expr->src);
 
 	return expr;
@@ -1184,14 +1187,14 @@ static ofc_sema_expr_t* ofc_sema_expr__variable(
 					scope, base_name, false);
 			if (!fdecl)
 			{
-				ofc_sparse_ref_error(name->parent->src,
+				ofc_sparse_loc_error(name->parent->src,
 					"No complete IMPLICIT rule or specifier for function");
 				return NULL;
 			}
 
 			if (!ofc_sema_decl_function(fdecl))
 			{
-				ofc_sparse_ref_error(name->src,
+				ofc_sparse_loc_error(name->src,
 					"Declaration cannot be used as a function");
 				return NULL;
 			}
@@ -1200,12 +1203,12 @@ static ofc_sema_expr_t* ofc_sema_expr__variable(
 				scope, name, fdecl);
 			if (!expr)
 			{
-				ofc_sparse_ref_error(name->src,
+				ofc_sparse_loc_error(name->src,
 					"Invalid invocation of function");
 			}
 			else if (!decl)
 			{
-				ofc_sparse_ref_warning(name->src,
+				ofc_sparse_loc_warning(name->src,
 					"Implicit function declaration");
 			}
 		}
@@ -1338,9 +1341,10 @@ ofc_sema_expr_t* ofc_sema_expr_dummy_arg(
 				{
 					if (!ofc_sema_intrinsic_is_specific(decl->intrinsic))
 					{
-						ofc_sparse_ref_error(e->src,
+						ofc_sparse_ref_t src = ofc_sparse_loc_ref(e->src);
+						ofc_sparse_ref_error(src,
 							"Generic intrinsic function '%.*s' can't be passed as an argument",
-							e->src.string.size, e->src.string.base);
+							src.string.size, src.string.base);
 						ofc_sema_expr_delete(e);
 						return NULL;
 					}
@@ -1366,7 +1370,7 @@ ofc_sema_expr_t* ofc_sema_expr_label(
 		= ofc_sema_expr_type(label);
 	if (!ofc_sema_type_is_integer(type))
 	{
-		ofc_sparse_ref_warning(label->src,
+		ofc_sparse_loc_warning(label->src,
 			"Label must be an INTEGER expression");
 		ofc_sema_expr_delete(label);
 		return NULL;
@@ -1380,7 +1384,7 @@ ofc_sema_expr_t* ofc_sema_expr_label(
 		bool has_val = ofc_sema_typeval_get_integer(tv, &v);
 		if (has_val && (v <= 0))
 		{
-			ofc_sparse_ref_warning(label->src,
+			ofc_sparse_loc_warning(label->src,
 				"Label expression must be greater than zero");
 			ofc_sema_expr_delete(label);
 			return NULL;
@@ -1404,7 +1408,7 @@ ofc_sema_expr_t* ofc_sema_expr_alt_return(
 
 static ofc_sema_expr_t* ofc_sema_expr__implicit_do(
 	ofc_sema_scope_t* scope,
-	ofc_sparse_ref_t src,
+	ofc_sparse_loc_t src,
 	const ofc_parse_expr_implicit_do_t* id)
 {
 	if (!id || !id->init)
@@ -1434,7 +1438,7 @@ static ofc_sema_expr_t* ofc_sema_expr__implicit_do(
 
 	if (iter_lhs->type != OFC_SEMA_LHS_DECL)
 	{
-		ofc_sparse_ref_error(id->iter->src,
+		ofc_sparse_loc_error(id->iter->src,
 			"Implicit do loop iterator must be a variable");
 		ofc_sema_lhs_delete(iter_lhs);
 		ofc_sema_expr_delete(expr);
@@ -1461,7 +1465,7 @@ static ofc_sema_expr_t* ofc_sema_expr__implicit_do(
 
 	if (!ofc_sema_type_is_scalar(iter_type))
 	{
-		ofc_sparse_ref_error(id->iter->src,
+		ofc_sparse_loc_error(id->iter->src,
 			"Implicit do loop iterator must be a scalar type");
 		ofc_sema_expr_delete(expr);
 		return NULL;
@@ -1469,7 +1473,7 @@ static ofc_sema_expr_t* ofc_sema_expr__implicit_do(
 
 	if (!ofc_sema_type_is_integer(iter_type))
 	{
-		ofc_sparse_ref_warning(id->iter->src,
+		ofc_sparse_loc_warning(id->iter->src,
 			"Using REAL in implicit do loop iterator");
 	}
 
@@ -1526,7 +1530,7 @@ static ofc_sema_expr_t* ofc_sema_expr__implicit_do(
 				expr->implicit_do.last, iter_type);
 		if (!cast)
 		{
-			ofc_sparse_ref_error(id->limit->src,
+			ofc_sparse_loc_error(id->limit->src,
 				"Expression type '%s' doesn't match iterator type '%s'",
 				ofc_sema_type_str_rep(last_type),
 				ofc_sema_type_str_rep(iter_type));
@@ -1562,7 +1566,7 @@ static ofc_sema_expr_t* ofc_sema_expr__implicit_do(
 					expr->implicit_do.step, iter_type);
 			if (!cast)
 			{
-				ofc_sparse_ref_error(id->step->src,
+				ofc_sparse_loc_error(id->step->src,
 					"Expression type '%s' doesn't match iterator type '%s'",
 					ofc_sema_type_str_rep(step_type),
 					ofc_sema_type_str_rep(iter_type));
@@ -1608,7 +1612,7 @@ static ofc_sema_expr_t* ofc_sema_expr__implicit_do(
 		long double dcount = floor((last - first) / step);
 		if (dcount < 0.0)
 		{
-			ofc_sparse_ref_error(src,
+			ofc_sparse_loc_error(src,
 				"Loop iterates away from limit");
 			ofc_sema_expr_delete(expr);
 			return NULL;
@@ -1745,6 +1749,12 @@ bool ofc_sema_expr_elem_count(
 	if (!expr)
 		return false;
 
+	if (expr->elem_count_valid)
+	{
+		if (count) *count = expr->elem_count;
+		return true;
+	}
+
 	unsigned ecount = 1;
 	if (expr->type == OFC_SEMA_EXPR_IMPLICIT_DO)
 	{
@@ -1782,16 +1792,41 @@ bool ofc_sema_expr_elem_count(
 		ecount *= scount;
 	}
 
+	/* The count only depends on the node itself, which is never
+	   modified once built, copy/replace always creates a new node. */
+	ofc_sema_expr_t* mexpr = (ofc_sema_expr_t*)expr;
+	mexpr->elem_count       = ecount;
+	mexpr->elem_count_valid = true;
+
 	if (count) *count = ecount;
 	return true;
 }
 
-ofc_sema_expr_t* ofc_sema_expr_elem_get(
-	const ofc_sema_expr_t* expr, unsigned offset)
+static bool ofc_sema_expr_list__elem_find(
+	const ofc_sema_expr_list_t* list, unsigned offset,
+	unsigned* index, unsigned* sub_offset);
+
+ofc_sema_expr_t* ofc_sema_expr_elem_get_bind(
+	const ofc_sema_expr_t* expr, unsigned offset,
+	const ofc_sema_expr_bind_t* bind)
 {
 	if (!expr)
 		return NULL;
 
+	/* Only implicit DO loops can be indexed without applying the bindings,
+	   this is cheap for references to array elements. */
+	if (bind && (expr->type != OFC_SEMA_EXPR_IMPLICIT_DO))
+	{
+		ofc_sema_expr_t* body
+			= ofc_sema_expr_copy_bind(expr, bind);
+		if (!body) return NULL;
+
+		ofc_sema_expr_t* elem
+			= ofc_sema_expr_elem_get(body, offset);
+		ofc_sema_expr_delete(body);
+		return elem;
+	}
+
 	switch (expr->type)
 	{
 		case OFC_SEMA_EXPR_LHS:
@@ -1846,9 +1881,56 @@ ofc_sema_expr_t* ofc_sema_expr_elem_get(
 			if (sub_elem_count == 0)
 				return NULL;
 
-			unsigned sub_offset
-				= (offset % sub_elem_count);
-			offset /= sub_elem_count;
+			unsigned i, e;
+			if (!ofc_sema_expr_list__elem_find(
+				expr->implicit_do.expr,
+				(offset % sub_elem_count), &i, &e))
+				return NULL;
+
+			ofc_sema_expr_t* body
+				= expr->implicit_do.expr->expr[i];
+
+			unsigned elem_count;
+			if (!ofc_sema_expr_elem_count(body, &elem_count)
+				|| (elem_count == 0))
+				return NULL;
+			e %= elem_count;
+
+			unsigned iteration
+				= (offset / sub_elem_count);
+
+			/* Integer iterators are bound to the value of this iteration
+			   and the body is evaluated lazily. */
+			int first, step = 1;
+			if (ofc_sema_type_is_integer(expr->implicit_do.iter->type)
+				&& ofc_sema_expr_resolve_int(expr->implicit_do.init, &first)
+				&& (!expr->implicit_do.step
+					|| ofc_sema_expr_resolve_int(expr->implicit_do.step, &step)))
+			{
+				int64_t value = first + ((int64_t)iteration * step);
+
+				ofc_sema_expr_bind_t ibind;
+				ibind.iter  = expr->implicit_do.iter;
+				ibind.value = value;
+				ibind.next  = bind;
+				if (ibind.value != value)
+					return NULL;
+
+				return ofc_sema_expr_elem_get_bind(
+					body, e, &ibind);
+			}
+
+			if (bind)
+			{
+				ofc_sema_expr_t* copy
+					= ofc_sema_expr_copy_bind(expr, bind);
+				if (!copy) return NULL;
+
+				ofc_sema_expr_t* elem
+					= ofc_sema_expr_elem_get(copy, offset);
+				ofc_sema_expr_delete(copy);
+				return elem;
+			}
 
 			const ofc_sema_typeval_t* ctv[2];
 			ctv[0] = ofc_sema_expr_constant(
@@ -1856,19 +1938,19 @@ ofc_sema_expr_t* ofc_sema_expr_elem_get(
 			ctv[1] = ofc_sema_expr_constant(
 					expr->implicit_do.step);
 
-			long double first, step = 1.0;
-			if (!ofc_sema_typeval_get_real(ctv[0], &first))
+			long double rfirst, rstep = 1.0;
+			if (!ofc_sema_typeval_get_real(ctv[0], &rfirst))
 				return NULL;
-			if (ctv[1] && !ofc_sema_typeval_get_real(ctv[1], &step))
+			if (ctv[1] && !ofc_sema_typeval_get_real(ctv[1], &rstep))
 				return NULL;
 
 			long double doffset
-				= first + ((long double)offset * step);
+				= rfirst + ((long double)iteration * rstep);
 
 			ofc_sema_typeval_t* dinit
 				= ofc_sema_typeval_create_real(
 					doffset, OFC_SEMA_KIND_NONE,
-					OFC_SPARSE_REF_EMPTY);
+					OFC_SPARSE_LOC_EMPTY);
 			if (!dinit) return NULL;
 
 			ofc_sema_typeval_t* init
@@ -1885,44 +1967,14 @@ ofc_sema_expr_t* ofc_sema_expr_elem_get(
 				return NULL;
 			}
 
-			ofc_sema_expr_t* rval = NULL;
-			unsigned e = sub_offset;
-			unsigned i;
-			for (i = 0; i < expr->implicit_do.expr->count; i++)
-			{
-				ofc_sema_expr_t* expr_dummy
-					= expr->implicit_do.expr->expr[i];
-
-				unsigned elem_count;
-				if (!ofc_sema_expr_elem_count(
-					expr_dummy, &elem_count))
-					return NULL;
-
-				unsigned elem_total = elem_count;
-				if (expr_dummy->repeat > 1)
-					elem_total *= expr_dummy->repeat;
-
-				if (e < elem_total)
-				{
-
-					ofc_sema_expr_t* body
-						= ofc_sema_expr_copy_replace(
-							expr_dummy, expr->implicit_do.iter, iter_expr);
-					if (!body) return NULL;
-
-					rval = ofc_sema_expr_elem_get(
-						body, sub_offset);
-
-					ofc_sema_expr_delete(body);
-				}
-				else
-				{
-					e -= elem_total;
-				}
-			}
-
+			ofc_sema_expr_t* copy
+				= ofc_sema_expr_copy_replace(
+					body, expr->implicit_do.iter, iter_expr);
 			ofc_sema_expr_delete(iter_expr);
 
+			ofc_sema_expr_t* rval
+				= ofc_sema_expr_elem_get(copy, e);
+			ofc_sema_expr_delete(copy);
 			return rval;
 		}
 
@@ -1936,6 +1988,13 @@ ofc_sema_expr_t* ofc_sema_expr_elem_get(
 	return ofc_sema_expr_copy(expr);
 }
 
+ofc_sema_expr_t* ofc_sema_expr_elem_get(
+	const ofc_sema_expr_t* expr, unsigned offset)
+{
+	return ofc_sema_expr_elem_get_bind(
+		expr, offset, NULL);
+}
+
 
 bool ofc_sema_expr_compare(
 	const ofc_sema_expr_t* a,
@@ -2098,18 +2157,27 @@ const ofc_sema_type_t* ofc_sema_expr_type(
 			break;
 	}
 
-	if (expr->type >= OFC_SEMA_EXPR_COUNT)
+	return ofc_sema_expr_type_operator(expr->type,
+		ofc_sema_expr_type(expr->a),
+		ofc_sema_expr_type(expr->b));
+}
+
+const ofc_sema_type_t* ofc_sema_expr_type_operator(
+	ofc_sema_expr_e op,
+	const ofc_sema_type_t* a,
+	const ofc_sema_type_t* b)
+{
+	if ((op < OFC_SEMA_EXPR_POWER)
+		|| (op >= OFC_SEMA_EXPR_COUNT))
 		return NULL;
 
 	ofc_sema_expr__rule_t rule
-		= ofc_sema_expr__rule[expr->type];
+		= ofc_sema_expr__rule[op];
 
 	if (rule.rtype)
-		return rule.rtype(
-			ofc_sema_expr_type(expr->a),
-			ofc_sema_expr_type(expr->b));
+		return rule.rtype(a, b);
 
-	return ofc_sema_expr_type(expr->a);
+	return a;
 }
 
 bool ofc_sema_expr_type_is_character(
@@ -2194,6 +2262,184 @@ bool ofc_sema_expr_resolve_int(
 	return true;
 }
 
+const ofc_sema_expr_bind_t* ofc_sema_expr_bind_find(
+	const ofc_sema_expr_bind_t* bind,
+	const ofc_sema_decl_t* iter)
+{
+	for (; bind; bind = bind->next)
+	{
+		if (bind->iter == iter)
+			return bind;
+	}
+	return NULL;
+}
+
+ofc_sema_expr_t* ofc_sema_expr_bind_value(
+	const ofc_sema_expr_bind_t* bind)
+{
+	if (!bind || !bind->iter)
+		return NULL;
+
+	ofc_sema_typeval_t* ivalue
+		= ofc_sema_typeval_create_integer(
+			bind->value, OFC_SEMA_KIND_NONE,
+			OFC_SPARSE_LOC_EMPTY);
+	if (!ivalue) return NULL;
+
+	ofc_sema_typeval_t* value
+		= ofc_sema_typeval_cast(
+			ivalue, bind->iter->type);
+	ofc_sema_typeval_delete(ivalue);
+	if (!value) return NULL;
+
+	ofc_sema_expr_t* expr
+		= ofc_sema_expr_typeval(value);
+	if (!expr)
+	{
+		ofc_sema_typeval_delete(value);
+		return NULL;
+	}
+
+	return expr;
+}
+
+bool ofc_sema_expr_resolve_int_bind(
+	const ofc_sema_expr_t* expr,
+	const ofc_sema_expr_bind_t* bind,
+	int* value)
+{
+	if (!expr)
+		return false;
+
+	if (expr->constant)
+		return ofc_sema_expr_resolve_int(expr, value);
+
+	if (!ofc_sema_expr_type_is_integer(expr))
+		return false;
+
+	int a, b;
+	int64_t r;
+	switch (expr->type)
+	{
+		case OFC_SEMA_EXPR_LHS:
+		{
+			if (expr->lhs->type != OFC_SEMA_LHS_DECL)
+				return false;
+
+			const ofc_sema_expr_bind_t* ibind
+				= ofc_sema_expr_bind_find(bind, expr->lhs->decl);
+			if (!ibind) return false;
+
+			r = ibind->value;
+			break;
+		}
+
+		case OFC_SEMA_EXPR_CAST:
+			if (!ofc_sema_expr_resolve_int_bind(
+				expr->cast.expr, bind, &a))
+				return false;
+			r = a;
+			break;
+
+		case OFC_SEMA_EXPR_NEGATE:
+			if (!ofc_sema_expr_resolve_int_bind(
+				expr->a, bind, &a))
+				return false;
+			r = -(int64_t)a;
+			break;
+
+		case OFC_SEMA_EXPR_ADD:
+		case OFC_SEMA_EXPR_SUBTRACT:
+		case OFC_SEMA_EXPR_MULTIPLY:
+		case OFC_SEMA_EXPR_DIVIDE:
+			if (!ofc_sema_expr_resolve_int_bind(expr->a, bind, &a)
+				|| !ofc_sema_expr_resolve_int_bind(expr->b, bind, &b))
+				return false;
+
+			switch (expr->type)
+			{
+				case OFC_SEMA_EXPR_ADD:
+					r = (int64_t)a + b;
+					break;
+				case OFC_SEMA_EXPR_SUBTRACT:
+					r = (int64_t)a - b;
+					break;
+				case OFC_SEMA_EXPR_MULTIPLY:
+					r = (int64_t)a * b;
+					break;
+				default:
+					if (b == 0) return false;
+					r = (int64_t)a / b;
+					break;
+			}
+			break;
+
+		default:
+			return false;
+	}
+
+	int d = r;
+	if (r != d)
+		return false;
+
+	if (value) *value = d;
+	return true;
+}
+
+ofc_sema_expr_t* ofc_sema_expr_copy_bind(
+	const ofc_sema_expr_t* expr,
+	const ofc_sema_expr_bind_t* bind)
+{
+	if (!expr)
+		return NULL;
+
+	if (!bind)
+		return ofc_sema_expr_copy(expr);
+
+	if (expr->type == OFC_SEMA_EXPR_LHS)
+	{
+		if (expr->lhs->type == OFC_SEMA_LHS_DECL)
+		{
+			const ofc_sema_expr_bind_t* ibind
+				= ofc_sema_expr_bind_find(bind, expr->lhs->decl);
+			if (ibind) return ofc_sema_expr_bind_value(ibind);
+		}
+
+		ofc_sema_lhs_t* lhs
+			= ofc_sema_lhs_copy_bind(expr->lhs, bind);
+		if (!lhs) return NULL;
+
+		ofc_sema_expr_t* copy
+			= ofc_sema_expr_copy(expr);
+		if (!copy)
+		{
+			ofc_sema_lhs_delete(lhs);
+			return NULL;
+		}
+
+		ofc_sema_lhs_delete(copy->lhs);
+		copy->lhs = lhs;
+		return copy;
+	}
+
+	ofc_sema_expr_t* with
+		= ofc_sema_expr_bind_value(bind);
+	if (!with) return NULL;
+
+	ofc_sema_expr_t* copy
+		= ofc_sema_expr_copy_replace(
+			expr, bind->iter, with);
+	ofc_sema_expr_delete(with);
+	if (!copy || !bind->next)
+		return copy;
+
+	ofc_sema_expr_t* rcopy
+		= ofc_sema_expr_copy_bind(
+			copy, bind->next);
+	ofc_sema_expr_delete(copy);
+	return rcopy;
+}
+
 
 
 static ofc_sema_expr_list_t* ofc_sema_expr__list(
@@ -2296,8 +2542,9 @@ ofc_sema_expr_list_t* ofc_sema_expr_list_create(void)
 			sizeof(ofc_sema_expr_list_t));
 	if (!list) return NULL;
 
-	list->count = 0;
-	list->expr  = NULL;
+	list->count       = 0;
+	list->expr        = NULL;
+	list->elem_offset = NULL;
 	return list;
 }
 
@@ -2311,6 +2558,7 @@ void ofc_sema_expr_list_delete(
 	for (i = 0; i < list->count; i++)
 		ofc_sema_expr_delete(list->expr[i]);
 	free(list->expr);
+	free(list->elem_offset);
 
 	free(list);
 }
@@ -2335,7 +2583,8 @@ ofc_sema_expr_list_t* ofc_sema_expr_list_copy_replace(
 		return NULL;
 	}
 
-	copy->count = list->count;
+	copy->count       = list->count;
+	copy->elem_offset = NULL;
 
 	bool fail = false;
 	unsigned i;
@@ -2378,6 +2627,9 @@ bool ofc_sema_expr_list_add(
 
 	list->expr = nexpr;
 	list->expr[list->count++] = expr;
+
+	free(list->elem_offset);
+	list->elem_offset = NULL;
 	return true;
 }
 
@@ -2387,12 +2639,20 @@ unsigned ofc_sema_expr_list_count(
 	return (list ? list->count : 0);
 }
 
-bool ofc_sema_expr_list_elem_count(
-	const ofc_sema_expr_list_t* list, unsigned* count)
+static const unsigned* ofc_sema_expr_list__elem_offset(
+	const ofc_sema_expr_list_t* list)
 {
-	if (!list) return false;
+	if (!list) return NULL;
+
+	if (list->elem_offset)
+		return list->elem_offset;
+
+	unsigned* offset = (unsigned*)malloc(
+		sizeof(unsigned) * (list->count + 1));
+	if (!offset) return NULL;
+
+	offset[0] = 0;
 
-	unsigned len = 0;
 	unsigned i;
 	for (i = 0; i < list->count; i++)
 	{
@@ -2402,55 +2662,83 @@ bool ofc_sema_expr_list_elem_count(
 		unsigned elem_count;
 		if (!ofc_sema_expr_elem_count(
 			expr, &elem_count))
-			return false;
+		{
+			free(offset);
+			return NULL;
+		}
 
 		if (expr->repeat > 1)
 			elem_count *= expr->repeat;
 
-		len += elem_count;
+		offset[i + 1] = offset[i] + elem_count;
+	}
+
+	ofc_sema_expr_list_t* mlist
+		= (ofc_sema_expr_list_t*)list;
+	mlist->elem_offset = offset;
+	return offset;
+}
+
+/* Finds the entry containing element offset, and the offset within it. */
+static bool ofc_sema_expr_list__elem_find(
+	const ofc_sema_expr_list_t* list, unsigned offset,
+	unsigned* index, unsigned* sub_offset)
+{
+	const unsigned* elem_offset
+		= ofc_sema_expr_list__elem_offset(list);
+	if (!elem_offset
+		|| (offset >= elem_offset[list->count]))
+		return false;
+
+	/* Find the last entry which starts at or before offset,
+	   skipping over any empty entries. */
+	unsigned lo = 0, hi = list->count;
+	while ((hi - lo) > 1)
+	{
+		unsigned mid = lo + ((hi - lo) / 2);
+		if (elem_offset[mid] <= offset)
+			lo = mid;
+		else
+			hi = mid;
 	}
 
-	if (count) *count = len;
+	if (index) *index = lo;
+	if (sub_offset) *sub_offset = (offset - elem_offset[lo]);
+	return true;
+}
+
+bool ofc_sema_expr_list_elem_count(
+	const ofc_sema_expr_list_t* list, unsigned* count)
+{
+	const unsigned* elem_offset
+		= ofc_sema_expr_list__elem_offset(list);
+	if (!elem_offset) return false;
+
+	if (count) *count = elem_offset[list->count];
 	return true;
 }
 
 ofc_sema_expr_t* ofc_sema_expr_list_elem_get(
 	const ofc_sema_expr_list_t* list, unsigned offset)
 {
-	if (!list)
+	unsigned i, e;
+	if (!ofc_sema_expr_list__elem_find(
+		list, offset, &i, &e))
 		return NULL;
 
-	unsigned e = offset;
-	unsigned i;
-	for (i = 0; i < list->count; i++)
-	{
-		ofc_sema_expr_t* expr
-			= list->expr[i];
-
-		unsigned elem_count;
-		if (!ofc_sema_expr_elem_count(
-			expr, &elem_count))
-			return NULL;
+	ofc_sema_expr_t* expr
+		= list->expr[i];
 
-		unsigned elem_total = elem_count;
-		if (expr->repeat > 1)
-			elem_total *= expr->repeat;
+	unsigned elem_count;
+	if (!ofc_sema_expr_elem_count(
+		expr, &elem_count))
+		return NULL;
 
-		if (e < elem_total)
-		{
-			if (elem_count == 1)
-				return ofc_sema_expr_copy(expr);
+	if (elem_count == 1)
+		return ofc_sema_expr_copy(expr);
 
-			return ofc_sema_expr_elem_get(
-				expr, (e % elem_count));
-		}
-		else
-		{
-			e -= elem_total;
-		}
-	}
-
-	return NULL;
+	return ofc_sema_expr_elem_get(
+		expr, (e % elem_count));
 }
 
 bool ofc_sema_expr_list_compare(
@@ -13,6 +13,9 @@
  * limitations under the License.
  */
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "ofc/sema.h"
 
 static bool ofc_sema__type_rule[][9] =
@@ -583,3 +586,356 @@ const ofc_sema_type_t* ofc_sema_format_desc_type(
 
 	return NULL;
 }
+
+
+typedef struct
+{
+	bool                    input;
+	unsigned                count;
+	const ofc_sema_type_t** type;
+} ofc_sema_format__check_t;
+
+struct ofc_sema_format_intern_s
+{
+	ofc_parse_format_desc_list_t* format;
+
+	unsigned ref;
+	bool     clean;
+
+	/* Type signatures of IO lists which have passed validation
+	   against this list without any diagnostics. */
+	unsigned                  check_count;
+	ofc_sema_format__check_t* check;
+};
+
+static ofc_hashmap_t* ofc_sema_format__intern_map   = NULL;
+static unsigned       ofc_sema_format__intern_count = 0;
+
+
+static bool ofc_sema_format__list_equal(
+	const ofc_parse_format_desc_list_t* a,
+	const ofc_parse_format_desc_list_t* b);
+
+/* Unlike ofc_parse_format_desc_compare this checks every field,
+   since validation depends on which values were given. */
+static bool ofc_sema_format__desc_equal(
+	const ofc_parse_format_desc_t* a,
+	const ofc_parse_format_desc_t* b)
+{
+	if ((a->type != b->type)
+		|| (a->neg != b->neg)
+		|| (a->n_set != b->n_set)
+		|| (a->n != b->n))
+		return false;
+
+	switch (a->type)
+	{
+		case OFC_PARSE_FORMAT_DESC_HOLLERITH:
+		case OFC_PARSE_FORMAT_DESC_STRING:
+			if (!a->string || !b->string)
+				return (a->string == b->string);
+			return ofc_string_equal(*a->string, *b->string);
+
+		case OFC_PARSE_FORMAT_DESC_REPEAT:
+			return ofc_sema_format__list_equal(
+				a->repeat, b->repeat);
+
+		default:
+			break;
+	}
+
+	return ((a->w_set == b->w_set)
+		&& (a->d_set == b->d_set)
+		&& (a->e_set == b->e_set)
+		&& (a->w == b->w)
+		&& (a->d == b->d)
+		&& (a->e == b->e));
+}
+
+static bool ofc_sema_format__list_equal(
+	const ofc_parse_format_desc_list_t* a,
+	const ofc_parse_format_desc_list_t* b)
+{
+	if (!a || !b)
+		return (a == b);
+
+	if (a->count != b->count)
+		return false;
+
+	unsigned i;
+	for (i = 0; i < a->count; i++)
+	{
+		if (!ofc_sema_format__desc_equal(
+			a->desc[i], b->desc[i]))
+			return false;
+	}
+
+	return true;
+}
+
+static uint8_t ofc_sema_format__list_hash(
+	const ofc_parse_format_desc_list_t* list)
+{
+	if (!list) return 0;
+
+	uint8_t h = list->count;
+	unsigned i;
+	for (i = 0; i < list->count; i++)
+	{
+		const ofc_parse_format_desc_t* desc
+			= list->desc[i];
+
+		h = (h * 31) + desc->type + desc->n;
+		switch (desc->type)
+		{
+			case OFC_PARSE_FORMAT_DESC_HOLLERITH:
+			case OFC_PARSE_FORMAT_DESC_STRING:
+				if (desc->string)
+				{
+					unsigned j;
+					for (j = 0; j < desc->string->size; j++)
+						h += desc->string->base[j];
+				}
+				break;
+
+			case OFC_PARSE_FORMAT_DESC_REPEAT:
+				h += ofc_sema_format__list_hash(desc->repeat);
+				break;
+
+			default:
+				h += desc->w + desc->d + desc->e;
+				break;
+		}
+	}
+
+	return h;
+}
+
+static const ofc_parse_format_desc_list_t* ofc_sema_format__intern_key(
+	const ofc_sema_format_intern_t* intern)
+{
+	return intern->format;
+}
+
+static void ofc_sema_format__intern_free(
+	ofc_sema_format_intern_t* intern)
+{
+	if (!intern)
+		return;
+
+	unsigned i;
+	for (i = 0; i < intern->check_count; i++)
+		free(intern->check[i].type);
+	free(intern->check);
+
+	ofc_parse_format_desc_list_delete(intern->format);
+	free(intern);
+}
+
+/* The interned copy may outlive the source it was parsed from,
+   so it mustn't borrow any strings. */
+static bool ofc_sema_format__list_own(
+	ofc_parse_format_desc_list_t* list)
+{
+	if (!list)
+		return true;
+
+	unsigned i;
+	for (i = 0; i < list->count; i++)
+	{
+		ofc_parse_format_desc_t* desc = list->desc[i];
+		switch (desc->type)
+		{
+			case OFC_PARSE_FORMAT_DESC_HOLLERITH:
+			case OFC_PARSE_FORMAT_DESC_STRING:
+				if (desc->string && desc->string->borrowed)
+				{
+					ofc_string_t* string = ofc_string_create(
+						desc->string->base, desc->string->size);
+					if (!string) return false;
+					ofc_string_delete(desc->string);
+					desc->string = string;
+				}
+				break;
+
+			case OFC_PARSE_FORMAT_DESC_REPEAT:
+				if (!ofc_sema_format__list_own(desc->repeat))
+					return false;
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	return true;
+}
+
+ofc_sema_format_intern_t* ofc_sema_format_intern(
+	const ofc_parse_format_desc_list_t* format)
+{
+	if (!format)
+		return NULL;
+
+	ofc_sema_format_intern_t* intern = NULL;
+	if (ofc_sema_format__intern_map)
+	{
+		intern = ofc_hashmap_find_modify(
+			ofc_sema_format__intern_map, format);
+	}
+
+	/* A list which was clean the first time will be clean again,
+	   otherwise we validate this copy so that the diagnostics point
+	   at this statement. */
+	if (!intern || !intern->clean)
+	{
+		unsigned diagnostics = ofc_file_diagnostic_count();
+
+		unsigned i;
+		for (i = 0; i < format->count; i++)
+		{
+			if (!ofc_sema_format_desc(format->desc[i]))
+				return NULL;
+		}
+
+		if (!intern)
+		{
+			intern = (ofc_sema_format_intern_t*)malloc(
+				sizeof(ofc_sema_format_intern_t));
+			if (!intern) return NULL;
+
+			intern->format      = ofc_parse_format_desc_list_copy(format);
+			intern->ref         = 0;
+			intern->clean       = (ofc_file_diagnostic_count() == diagnostics);
+			intern->check_count = 0;
+			intern->check       = NULL;
+
+			if (!intern->format
+				|| !ofc_sema_format__list_own(intern->format))
+			{
+				ofc_sema_format__intern_free(intern);
+				return NULL;
+			}
+
+			if (!ofc_sema_format__intern_map)
+			{
+				ofc_sema_format__intern_map = ofc_hashmap_create(
+					(void*)ofc_sema_format__list_hash,
+					(void*)ofc_sema_format__list_equal,
+					(void*)ofc_sema_format__intern_key,
+					(void*)ofc_sema_format__intern_free);
+				if (!ofc_sema_format__intern_map)
+				{
+					ofc_sema_format__intern_free(intern);
+					return NULL;
+				}
+			}
+
+			if (!ofc_hashmap_add(
+				ofc_sema_format__intern_map, intern))
+			{
+				ofc_sema_format__intern_free(intern);
+				return NULL;
+			}
+
+			ofc_sema_format__intern_count++;
+			return intern;
+		}
+	}
+
+	intern->ref++;
+	return intern;
+}
+
+void ofc_sema_format_release(
+	ofc_sema_format_intern_t* intern)
+{
+	if (!intern)
+		return;
+
+	if (intern->ref > 0)
+	{
+		intern->ref--;
+		return;
+	}
+
+	ofc_hashmap_remove(
+		ofc_sema_format__intern_map, intern);
+	ofc_sema_format__intern_free(intern);
+
+	if (--ofc_sema_format__intern_count == 0)
+	{
+		ofc_hashmap_delete(ofc_sema_format__intern_map);
+		ofc_sema_format__intern_map = NULL;
+	}
+}
+
+const ofc_parse_format_desc_list_t* ofc_sema_format_intern_list(
+	const ofc_sema_format_intern_t* intern)
+{
+	return (intern ? intern->format : NULL);
+}
+
+
+static const ofc_sema_format__check_t* ofc_sema_format__check_find(
+	const ofc_sema_format_intern_t* intern, bool input,
+	const ofc_sema_type_t** type, unsigned count)
+{
+	unsigned i;
+	for (i = 0; i < intern->check_count; i++)
+	{
+		const ofc_sema_format__check_t* check
+			= &intern->check[i];
+
+		if ((check->input == input)
+			&& (check->count == count)
+			&& (memcmp(check->type, type,
+				(sizeof(const ofc_sema_type_t*) * count)) == 0))
+			return check;
+	}
+
+	return NULL;
+}
+
+bool ofc_sema_format_intern_checked(
+	const ofc_sema_format_intern_t* intern, bool input,
+	const ofc_sema_type_t** type, unsigned count)
+{
+	if (!intern || (!type && (count > 0)))
+		return false;
+
+	return (ofc_sema_format__check_find(
+		intern, input, type, count) != NULL);
+}
+
+void ofc_sema_format_intern_check_add(
+	ofc_sema_format_intern_t* intern, bool input,
+	const ofc_sema_type_t** type, unsigned count)
+{
+	if (!intern || (!type && (count > 0))
+		|| ofc_sema_format__check_find(
+			intern, input, type, count))
+		return;
+
+	ofc_sema_format__check_t* ncheck
+		= (ofc_sema_format__check_t*)realloc(intern->check,
+			(sizeof(ofc_sema_format__check_t) * (intern->check_count + 1)));
+	if (!ncheck) return;
+	intern->check = ncheck;
+
+	const ofc_sema_type_t** ntype = NULL;
+	if (count > 0)
+	{
+		ntype = (const ofc_sema_type_t**)malloc(
+			sizeof(const ofc_sema_type_t*) * count);
+		if (!ntype) return;
+		memcpy(ntype, type,
+			(sizeof(const ofc_sema_type_t*) * count));
+	}
+
+	ofc_sema_format__check_t* check
+		= &intern->check[intern->check_count++];
+	check->input = input;
+	check->count = count;
+	check->type  = ntype;
+}
@@ -251,13 +251,13 @@ static ofc_sema_typeval_t* ofc_sema_intrinsic_op__constant_iand(
 		= ofc_sema_type_promote(ctv[0]->type, ctv[1]->type);
 	if (!type) return NULL;
 
-	ofc_sparse_ref_t ref = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	ofc_sparse_loc_t loc = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		args->expr[0]->src,
-		args->expr[1]->src, &ref);
+		args->expr[1]->src, &loc);
 
 	ofc_sema_typeval_t* tv
-		= ofc_sema_typeval_create_integer(0, type->kind, ref);
+		= ofc_sema_typeval_create_integer(0, type->kind, loc);
 	if (!tv) return NULL;
 	tv->integer = ctv[0]->integer & ctv[1]->integer;
 	return tv;
@@ -284,13 +284,13 @@ static ofc_sema_typeval_t* ofc_sema_intrinsic_op__constant_ieor(
 		= ofc_sema_type_promote(ctv[0]->type, ctv[1]->type);
 	if (!type) return NULL;
 
-	ofc_sparse_ref_t ref = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	ofc_sparse_loc_t loc = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		args->expr[0]->src,
-		args->expr[1]->src, &ref);
+		args->expr[1]->src, &loc);
 
 	ofc_sema_typeval_t* tv
-		= ofc_sema_typeval_create_integer(0, type->kind, ref);
+		= ofc_sema_typeval_create_integer(0, type->kind, loc);
 	if (!tv) return NULL;
 	tv->integer = ctv[0]->integer ^ ctv[1]->integer;
 	return tv;
@@ -317,13 +317,13 @@ static ofc_sema_typeval_t* ofc_sema_intrinsic_op__constant_ior(
 		= ofc_sema_type_promote(ctv[0]->type, ctv[1]->type);
 	if (!type) return NULL;
 
-	ofc_sparse_ref_t ref = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	ofc_sparse_loc_t loc = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		args->expr[0]->src,
-		args->expr[1]->src, &ref);
+		args->expr[1]->src, &loc);
 
 	ofc_sema_typeval_t* tv
-		= ofc_sema_typeval_create_integer(0, type->kind, ref);
+		= ofc_sema_typeval_create_integer(0, type->kind, loc);
 	if (!tv) return NULL;
 	tv->integer = ctv[0]->integer | ctv[1]->integer;
 	return tv;
@@ -713,7 +713,7 @@ static ofc_sema_typeval_t* ofc_sema_intrinsic__char_tv(
 
 	if (ic < 0)
 	{
-		ofc_sparse_ref_warning(args->expr[0]->src,
+		ofc_sparse_loc_warning(args->expr[0]->src,
 			"Can't convert negative INTEGER to CHARACTER");
 		return NULL;
 	}
@@ -724,7 +724,7 @@ static ofc_sema_typeval_t* ofc_sema_intrinsic__char_tv(
 
 	if ((nts < 8) && ((uint64_t)ic >= (1ULL << (nts * 8U))))
 	{
-		ofc_sparse_ref_warning(args->expr[0]->src,
+		ofc_sparse_loc_warning(args->expr[0]->src,
 			"INTEGER too large to convert to CHARACTER of kind %u", kind);
 		return NULL;
 	}
@@ -788,7 +788,7 @@ static ofc_sema_typeval_t* ofc_sema_intrinsic__ichar_tv(
 
 	if (cts > nts)
 	{
-		ofc_sparse_ref_warning(args->expr[0]->src,
+		ofc_sparse_loc_warning(args->expr[0]->src,
 			"CHARACTER too large to fit in INTEGER of kind %u", kind);
 		return NULL;
 	}
@@ -813,7 +813,7 @@ static const ofc_sema_type_t* ofc_sema_intrinsic__transfer_rt(
 	if (args->count >= 3)
 	{
 		/* TODO - INTRINSIC - Use 3rd parameter as array size if present. */
-		ofc_sparse_ref_error(args->expr[2]->src,
+		ofc_sparse_loc_error(args->expr[2]->src,
 			"TRANSFER SIZE argument not yet supported");
 		return NULL;
 	}
@@ -937,13 +937,13 @@ static ofc_sema_typeval_t* ofc_sema_intrinsic__transfer_tv(
 	ofc_sema_typeval_t* rtv
 		= ofc_sema_typeval_create_integer(
 			0, OFC_SEMA_KIND_DEFAULT,
-			OFC_SPARSE_REF_EMPTY);
+			OFC_SPARSE_LOC_EMPTY);
 	if (!rtv) return NULL;
 	rtv->type = rtype;
 
 	if (ofc_sema_type_is_character(rtype))
 	{
-		rtv->character = (char*)malloc(rsize);
+		rtv->character = ofc_sema_typeval_character_alloc(rsize);
 		if (!rtv->character)
 		{
 			ofc_sema_typeval_delete(rtv);
@@ -1332,6 +1332,7 @@ static ofc_sema_intrinsic_t* ofc_sema_intrinsic__create_op(
 	if (!intrinsic) return NULL;
 
 	intrinsic->name = ofc_str_ref_from_strz(op->name);
+	intrinsic->name.atom = ofc_str_ref_atom(intrinsic->name);
 	intrinsic->type = OFC_SEMA_INTRINSIC_OP;
 	intrinsic->op = op;
 
@@ -1350,6 +1351,7 @@ static ofc_sema_intrinsic_t* ofc_sema_intrinsic__create_func(
 	if (!intrinsic) return NULL;
 
 	intrinsic->name = ofc_str_ref_from_strz(func->name);
+	intrinsic->name.atom = ofc_str_ref_atom(intrinsic->name);
 	intrinsic->type = OFC_SEMA_INTRINSIC_FUNC;
 	intrinsic->func = func;
 
@@ -1373,207 +1375,161 @@ static const ofc_str_ref_t* ofc_sema_intrinsic__key(
 	return &intrinsic->name;
 }
 
-static ofc_hashmap_t* ofc_sema_intrinsic__op_map          = NULL;
-static ofc_hashmap_t* ofc_sema_intrinsic__op_override_map = NULL;
-static ofc_hashmap_t* ofc_sema_intrinsic__func_map        = NULL;
-static ofc_hashmap_t* ofc_sema_intrinsic__subr_map        = NULL;
-
-static void ofc_sema_intrinsic__term(void)
+/* The lookup maps are built once and never modified after they're
+   published, so lookups can run on any number of threads without
+   taking a lock. */
+typedef struct
 {
-	ofc_hashmap_delete(ofc_sema_intrinsic__op_map);
-	ofc_hashmap_delete(ofc_sema_intrinsic__op_override_map);
-	ofc_hashmap_delete(ofc_sema_intrinsic__func_map);
-	ofc_hashmap_delete(ofc_sema_intrinsic__subr_map);
-}
+	ofc_hashmap_t* op;
+	ofc_hashmap_t* op_override;
+	ofc_hashmap_t* func;
+	ofc_hashmap_t* subr;
+} ofc_sema_intrinsic__table_t;
 
-static bool ofc_sema_intrinsic__op_map_init(void)
-{
-	ofc_sema_intrinsic__op_map = ofc_hashmap_create(
-		(void*)ofc_str_ref_ptr_hash_ci,
-		(void*)ofc_str_ref_ptr_equal_ci,
-		(void*)ofc_sema_intrinsic__key,
-		(void*)ofc_sema_intrinsic__delete);
-	if (!ofc_sema_intrinsic__op_map)
-		return false;
+static ofc_sema_intrinsic__table_t* ofc_sema_intrinsic__table = NULL;
 
-	unsigned i;
-	for (i = 0; ofc_sema_intrinsic__op_list[i].name; i++)
-	{
-		ofc_sema_intrinsic_t* intrinsic
-			= ofc_sema_intrinsic__create_op(
-				&ofc_sema_intrinsic__op_list[i]);
-		if (!intrinsic)
-		{
-			ofc_hashmap_delete(
-				ofc_sema_intrinsic__op_map);
-			ofc_sema_intrinsic__op_map = NULL;
-			return false;
-		}
+static void ofc_sema_intrinsic__table_delete(
+	ofc_sema_intrinsic__table_t* table)
+{
+	if (!table)
+		return;
 
-		if (!ofc_hashmap_add(
-			ofc_sema_intrinsic__op_map,
-			intrinsic))
-		{
-			ofc_sema_intrinsic__delete(intrinsic);
-			ofc_hashmap_delete(
-				ofc_sema_intrinsic__op_map);
-			ofc_sema_intrinsic__op_map = NULL;
-			return false;
-		}
-	}
+	ofc_hashmap_delete(table->op);
+	ofc_hashmap_delete(table->op_override);
+	ofc_hashmap_delete(table->func);
+	ofc_hashmap_delete(table->subr);
+	free(table);
+}
 
-	return true;
+static void ofc_sema_intrinsic__term(void)
+{
+	ofc_sema_intrinsic__table_delete(
+		ofc_sema_intrinsic__table);
+	ofc_sema_intrinsic__table = NULL;
 }
 
-static bool ofc_sema_intrinsic__op_override_map_init(void)
+static ofc_hashmap_t* ofc_sema_intrinsic__map_create(void)
 {
-	ofc_sema_intrinsic__op_override_map = ofc_hashmap_create(
+	return ofc_hashmap_create(
 		(void*)ofc_str_ref_ptr_hash_ci,
 		(void*)ofc_str_ref_ptr_equal_ci,
 		(void*)ofc_sema_intrinsic__key,
 		(void*)ofc_sema_intrinsic__delete);
-	if (!ofc_sema_intrinsic__op_override_map)
-		return false;
-
-	unsigned i;
-	for (i = 0; ofc_sema_intrinsic__op_list_override[i].name; i++)
-	{
-		ofc_sema_intrinsic_t* intrinsic
-			= ofc_sema_intrinsic__create_op(
-				&ofc_sema_intrinsic__op_list_override[i]);
-		if (!intrinsic)
-		{
-			ofc_hashmap_delete(
-				ofc_sema_intrinsic__op_override_map);
-			ofc_sema_intrinsic__op_override_map = NULL;
-			return false;
-		}
-
-		if (!ofc_hashmap_add(
-			ofc_sema_intrinsic__op_override_map,
-			intrinsic))
-		{
-			ofc_sema_intrinsic__delete(intrinsic);
-			ofc_hashmap_delete(
-				ofc_sema_intrinsic__op_override_map);
-			ofc_sema_intrinsic__op_override_map = NULL;
-			return false;
-		}
-	}
-
-	return true;
 }
 
-static bool ofc_sema_intrinsic__func_map_init(void)
+static ofc_hashmap_t* ofc_sema_intrinsic__op_map_create(
+	const ofc_sema_intrinsic_op_t* list)
 {
-	ofc_sema_intrinsic__func_map = ofc_hashmap_create(
-		(void*)ofc_str_ref_ptr_hash_ci,
-		(void*)ofc_str_ref_ptr_equal_ci,
-		(void*)ofc_sema_intrinsic__key,
-		(void*)ofc_sema_intrinsic__delete);
-	if (!ofc_sema_intrinsic__func_map)
-		return false;
+	ofc_hashmap_t* map
+		= ofc_sema_intrinsic__map_create();
+	if (!map) return NULL;
 
 	unsigned i;
-	for (i = 0; ofc_sema_intrinsic__func_list[i].name; i++)
+	for (i = 0; list[i].name; i++)
 	{
 		ofc_sema_intrinsic_t* intrinsic
-			= ofc_sema_intrinsic__create_func(
-				&ofc_sema_intrinsic__func_list[i]);
+			= ofc_sema_intrinsic__create_op(&list[i]);
 		if (!intrinsic)
 		{
-			ofc_hashmap_delete(
-				ofc_sema_intrinsic__func_map);
-			ofc_sema_intrinsic__func_map = NULL;
-			return false;
+			ofc_hashmap_delete(map);
+			return NULL;
 		}
 
-		if (!ofc_hashmap_add(
-			ofc_sema_intrinsic__func_map,
-			intrinsic))
+		if (!ofc_hashmap_add(map, intrinsic))
 		{
 			ofc_sema_intrinsic__delete(intrinsic);
-			ofc_hashmap_delete(
-				ofc_sema_intrinsic__func_map);
-			ofc_sema_intrinsic__func_map = NULL;
-			return false;
+			ofc_hashmap_delete(map);
+			return NULL;
 		}
 	}
 
-	return true;
+	return map;
 }
 
-static bool ofc_sema_intrinsic__subr_map_init(void)
+static ofc_hashmap_t* ofc_sema_intrinsic__func_map_create(
+	const ofc_sema_intrinsic_func_t* list)
 {
-	ofc_sema_intrinsic__subr_map = ofc_hashmap_create(
-		(void*)ofc_str_ref_ptr_hash_ci,
-		(void*)ofc_str_ref_ptr_equal_ci,
-		(void*)ofc_sema_intrinsic__key,
-		(void*)ofc_sema_intrinsic__delete);
-	if (!ofc_sema_intrinsic__subr_map)
-		return false;
+	ofc_hashmap_t* map
+		= ofc_sema_intrinsic__map_create();
+	if (!map) return NULL;
 
 	unsigned i;
-	for (i = 0; ofc_sema_intrinsic__subr_list[i].name; i++)
+	for (i = 0; list[i].name; i++)
 	{
 		ofc_sema_intrinsic_t* intrinsic
-			= ofc_sema_intrinsic__create_func(
-				&ofc_sema_intrinsic__subr_list[i]);
+			= ofc_sema_intrinsic__create_func(&list[i]);
 		if (!intrinsic)
 		{
-			ofc_hashmap_delete(
-				ofc_sema_intrinsic__subr_map);
-			ofc_sema_intrinsic__subr_map = NULL;
-			return false;
+			ofc_hashmap_delete(map);
+			return NULL;
 		}
 
-		if (!ofc_hashmap_add(
-			ofc_sema_intrinsic__subr_map,
-			intrinsic))
+		if (!ofc_hashmap_add(map, intrinsic))
 		{
 			ofc_sema_intrinsic__delete(intrinsic);
-			ofc_hashmap_delete(
-				ofc_sema_intrinsic__subr_map);
-			ofc_sema_intrinsic__subr_map = NULL;
-			return false;
+			ofc_hashmap_delete(map);
+			return NULL;
 		}
 	}
 
-	return true;
+	return map;
 }
 
-static bool ofc_sema_intrinsic__init(void)
+static const ofc_sema_intrinsic__table_t* ofc_sema_intrinsic__init(void)
 {
-	if (ofc_sema_intrinsic__op_map
-		&& ofc_sema_intrinsic__op_override_map
-		&& ofc_sema_intrinsic__func_map
-		&& ofc_sema_intrinsic__subr_map)
-		return true;
+	ofc_sema_intrinsic__table_t* table
+		= __atomic_load_n(&ofc_sema_intrinsic__table, __ATOMIC_ACQUIRE);
+	if (table) return table;
+
+	table = (ofc_sema_intrinsic__table_t*)malloc(
+		sizeof(ofc_sema_intrinsic__table_t));
+	if (!table) return NULL;
 
 	/* TODO - Set case sensitivity based on lang_opts? */
-	if (!ofc_sema_intrinsic__op_map_init()
-		|| !ofc_sema_intrinsic__op_override_map_init()
-		|| !ofc_sema_intrinsic__func_map_init()
-		|| !ofc_sema_intrinsic__subr_map_init())
-		return false;
+	table->op          = ofc_sema_intrinsic__op_map_create(
+		ofc_sema_intrinsic__op_list);
+	table->op_override = ofc_sema_intrinsic__op_map_create(
+		ofc_sema_intrinsic__op_list_override);
+	table->func        = ofc_sema_intrinsic__func_map_create(
+		ofc_sema_intrinsic__func_list);
+	table->subr        = ofc_sema_intrinsic__func_map_create(
+		ofc_sema_intrinsic__subr_list);
+
+	if (!table->op || !table->op_override
+		|| !table->func || !table->subr)
+	{
+		ofc_sema_intrinsic__table_delete(table);
+		return NULL;
+	}
+
+	/* If another thread published a table first, use theirs. */
+	ofc_sema_intrinsic__table_t* expected = NULL;
+	if (!__atomic_compare_exchange_n(
+		&ofc_sema_intrinsic__table, &expected, table, false,
+		__ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+	{
+		ofc_sema_intrinsic__table_delete(table);
+		return expected;
+	}
 
 	atexit(ofc_sema_intrinsic__term);
-	return true;
+	return table;
 }
 
 
 const ofc_sema_intrinsic_t* ofc_sema_intrinsic(
 	ofc_str_ref_t name, bool case_sensitive)
 {
-	if (!ofc_sema_intrinsic__init())
-		return NULL;
+	const ofc_sema_intrinsic__table_t* table
+		= ofc_sema_intrinsic__init();
+	if (!table) return NULL;
 
 	const ofc_sema_intrinsic_t* func = ofc_hashmap_find(
-		ofc_sema_intrinsic__op_map, &name);
+		table->op, &name);
 	if (!func)
 	{
 		func = ofc_hashmap_find(
-			ofc_sema_intrinsic__func_map, &name);
+			table->func, &name);
 		if (!func) return NULL;
 	}
 
@@ -1608,8 +1564,9 @@ bool ofc_sema_stmt_intrinsic(
 		|| (stmt->type != OFC_PARSE_STMT_DECL_ATTR_INTRINSIC))
 		return false;
 
-	if (!ofc_sema_intrinsic__init())
-		return NULL;
+	const ofc_sema_intrinsic__table_t* table
+		= ofc_sema_intrinsic__init();
+	if (!table) return false;
 
 	unsigned i;
 	for (i = 0; i < stmt->decl_attr.count; i++)
@@ -1617,17 +1574,17 @@ bool ofc_sema_stmt_intrinsic(
 		ofc_sparse_ref_t decl_name = *stmt->decl_attr.name[i];
 
 		const ofc_sema_intrinsic_t* func = ofc_hashmap_find(
-			ofc_sema_intrinsic__op_override_map, &decl_name.string);
+			table->op_override, &decl_name.string);
 		if (!func)
 		{
 			func = ofc_hashmap_find(
-				ofc_sema_intrinsic__op_map, &decl_name.string);
+				table->op, &decl_name.string);
 		}
 
 		if (!func)
 		{
 			func = ofc_hashmap_find(
-				ofc_sema_intrinsic__func_map, &decl_name.string);
+				table->func, &decl_name.string);
 		}
 
 		if (!func)
@@ -1794,7 +1751,7 @@ static ofc_sema_expr_t* ofc_sema_intrinsic__param_cast(
 }
 
 static ofc_sema_expr_list_t* ofc_sema_intrinsic_cast__op(
-	ofc_sparse_ref_t src,
+	ofc_sparse_loc_t src,
 	const ofc_sema_intrinsic_t* intrinsic,
 	const ofc_sema_expr_list_t* args)
 {
@@ -1805,14 +1762,14 @@ static ofc_sema_expr_list_t* ofc_sema_intrinsic_cast__op(
 
 	if (args->count < intrinsic->op->arg_min)
 	{
-		ofc_sparse_ref_error(src,
+		ofc_sparse_loc_error(src,
 			"Not enough arguments for intrinsic function.");
 		return NULL;
 	}
 	if ((intrinsic->op->arg_max != 0)
 		&& (args->count > intrinsic->op->arg_max))
 	{
-		ofc_sparse_ref_error(src,
+		ofc_sparse_loc_error(src,
 			"Too many arguments for intrinsic function.");
 		return NULL;
 	}
@@ -1828,7 +1785,7 @@ static ofc_sema_expr_list_t* ofc_sema_intrinsic_cast__op(
 
 		if (!valid)
 		{
-			ofc_sparse_ref_warning(args->expr[i]->src,
+			ofc_sparse_loc_warning(args->expr[i]->src,
 				"Incorrect argument type for intrinsic.");
 		}
 
@@ -1862,7 +1819,7 @@ static ofc_sema_expr_list_t* ofc_sema_intrinsic_cast__op(
 				= ofc_sema_expr_cast(carg, ctype);
 			if (!cast)
 			{
-				ofc_sparse_ref_error(carg->src,
+				ofc_sparse_loc_error(carg->src,
 					"Incompatible argument type for intrinsic.");
 				ofc_sema_expr_delete(carg);
 				ofc_sema_expr_list_delete(cargs);
@@ -1883,7 +1840,7 @@ static ofc_sema_expr_list_t* ofc_sema_intrinsic_cast__op(
 }
 
 static ofc_sema_expr_list_t* ofc_sema_intrinsic_cast__func(
-	ofc_sparse_ref_t src,
+	ofc_sparse_loc_t src,
 	const ofc_sema_intrinsic_t* intrinsic,
 	const ofc_sema_expr_list_t* args)
 {
@@ -1899,14 +1856,14 @@ static ofc_sema_expr_list_t* ofc_sema_intrinsic_cast__func(
 
 	if (args->count < intrinsic->func->arg_min)
 	{
-		ofc_sparse_ref_error(src,
+		ofc_sparse_loc_error(src,
 			"Not enough arguments for intrinsic function.");
 		return NULL;
 	}
 	if ((intrinsic->func->arg_max != 0)
 		&& (args->count > intrinsic->func->arg_max))
 	{
-		ofc_sparse_ref_error(src,
+		ofc_sparse_loc_error(src,
 			"Too many arguments for intrinsic function.");
 		return NULL;
 	}
@@ -1932,7 +1889,7 @@ static ofc_sema_expr_list_t* ofc_sema_intrinsic_cast__func(
 
 		if (!valid)
 		{
-			ofc_sparse_ref_warning(carg->src,
+			ofc_sparse_loc_warning(carg->src,
 				"Incorrect argument type for intrinsic.");
 		}
 
@@ -1948,7 +1905,7 @@ static ofc_sema_expr_list_t* ofc_sema_intrinsic_cast__func(
 }
 
 ofc_sema_expr_list_t* ofc_sema_intrinsic_cast(
-	ofc_sparse_ref_t src,
+	ofc_sparse_loc_t src,
 	const ofc_sema_intrinsic_t* intrinsic,
 	const ofc_sema_expr_list_t* args)
 {
@@ -32,7 +32,7 @@ bool ofc_sema_io_compare_types(
 	{
 		if (!expr)
 		{
-			ofc_sparse_ref_warning(lhs->src,
+			ofc_sparse_loc_warning(lhs->src,
 				"Trying to format a %s output  with a %s FORMAT descriptor",
 				ofc_sema_format_str_rep(desc->type),
 				ofc_sema_type_str_rep(type));
@@ -46,7 +46,7 @@ bool ofc_sema_io_compare_types(
 				= ofc_sema_expr_cast(*expr, dtype);
 			if (!cast)
 			{
-				ofc_sparse_ref_warning((*expr)->src,
+				ofc_sparse_loc_warning((*expr)->src,
 					"Trying to format a %s output  with a %s FORMAT descriptor",
 					ofc_sema_format_str_rep(desc->type),
 					ofc_sema_type_str_rep(type));
@@ -63,8 +63,8 @@ bool ofc_sema_io_compare_types(
 		if (!ofc_sema_type_base_size(type, &csize)
 			|| (csize != 1))
 		{
-			ofc_sparse_ref_t src = (lhs ? lhs->src : (*expr)->src);
-			ofc_sparse_ref_error(src,
+			ofc_sparse_loc_t src = (lhs ? lhs->src : (*expr)->src);
+			ofc_sparse_loc_error(src,
 				"CHARACTER type KIND not supported in %s",
 				(stmt->type == OFC_SEMA_STMT_IO_WRITE ? "WRITE" : "PRINT"));
 		}
@@ -726,6 +726,39 @@ bool ofc_sema_io_format_input_list_compare(
 
 
 
+/* The type of each IO list element as seen by the list compare. */
+static bool ofc_sema_io__list_types(
+	ofc_sema_lhs_list_t* ilist,
+	ofc_sema_expr_list_t* olist,
+	const ofc_sema_type_t** type)
+{
+	unsigned i;
+	if (ilist)
+	{
+		for (i = 0; i < ilist->count; i++)
+		{
+			ofc_sema_lhs_t* lhs
+				= ofc_sema_lhs_list_elem_get(ilist, i);
+			type[i] = ofc_sema_lhs_type(lhs);
+			ofc_sema_lhs_delete(lhs);
+			if (!type[i]) return false;
+		}
+	}
+	else
+	{
+		for (i = 0; i < olist->count; i++)
+		{
+			ofc_sema_expr_t* expr
+				= ofc_sema_expr_list_elem_get(olist, i);
+			type[i] = ofc_sema_expr_type(expr);
+			ofc_sema_expr_delete(expr);
+			if (!type[i]) return false;
+		}
+	}
+
+	return true;
+}
+
 bool ofc_sema_stmt_io_format_validate(
 	ofc_sema_stmt_t* stmt)
 {
@@ -776,7 +809,7 @@ bool ofc_sema_stmt_io_format_validate(
 		|| !label->stmt
 		|| (label->stmt->type != OFC_SEMA_STMT_IO_FORMAT))
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"FORMAT label must point to a FORMAT statement");
 		return false;
 	}
@@ -801,7 +834,7 @@ bool ofc_sema_stmt_io_format_validate(
 	{
 		if (data_desc_count > 0)
 		{
-			ofc_sparse_ref_warning(format_expr->src,
+			ofc_sparse_loc_warning(format_expr->src,
 				"No IO list in formatted IO statement");
 		}
 
@@ -820,7 +853,7 @@ bool ofc_sema_stmt_io_format_validate(
 	{
 		if (iolist_len > 0)
 		{
-			ofc_sparse_ref_warning(format_expr->src,
+			ofc_sparse_loc_warning(format_expr->src,
 				"No data edit descriptors in FORMAT list");
 		}
 
@@ -830,16 +863,34 @@ bool ofc_sema_stmt_io_format_validate(
 
 	if (iolist_len < data_desc_count)
 	{
-		ofc_sparse_ref_warning(format_expr->src,
+		ofc_sparse_loc_warning(format_expr->src,
 			"IO list shorter than FORMAT list,"
 			" last FORMAT data descriptors will be ignored");
 	}
 	else if ((iolist_len % data_desc_count) != 0)
 	{
-		ofc_sparse_ref_warning(format_expr->src,
+		ofc_sparse_loc_warning(format_expr->src,
 			"IO list length is not a multiple of FORMAT list length");
 	}
 
+	/* An interned list only needs to be compared once against
+	   each IO list signature which doesn't produce diagnostics. */
+	ofc_sema_format_intern_t* intern
+		= (format == label->stmt->io_format.src
+			? label->stmt->io_format.intern : NULL);
+
+	unsigned type_count = (ilist ? ilist->count : olist->count);
+	const ofc_sema_type_t* type[type_count + 1];
+	if (intern && !ofc_sema_io__list_types(
+		ilist, olist, type))
+		intern = NULL;
+
+	if (intern && ofc_sema_format_intern_checked(
+		intern, (ilist != NULL), type, type_count))
+		return true;
+
+	unsigned diagnostics = ofc_file_diagnostic_count();
+
 	/* Compare iolist with format */
 	bool success;
 	if (ilist)
@@ -854,8 +905,15 @@ bool ofc_sema_stmt_io_format_validate(
 	}
 
 	if (!success)
-		ofc_sparse_ref_error(stmt->src,
+	{
+		ofc_sparse_loc_error(stmt->src,
 			"FORMAT validation failed");
+	}
+	else if (intern && (ofc_file_diagnostic_count() == diagnostics))
+	{
+		ofc_sema_format_intern_check_add(
+			intern, (ilist != NULL), type, type_count);
+	}
 
 	return success;
 }
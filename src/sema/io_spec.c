@@ -0,0 +1,352 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <ctype.h>
+
+#include "ofc/sema.h"
+
+#define OFC_SEMA_IO__OPEN      (1U << OFC_SEMA_IO_STMT_OPEN)
+#define OFC_SEMA_IO__CLOSE     (1U << OFC_SEMA_IO_STMT_CLOSE)
+#define OFC_SEMA_IO__INQUIRE   (1U << OFC_SEMA_IO_STMT_INQUIRE)
+#define OFC_SEMA_IO__READ      (1U << OFC_SEMA_IO_STMT_READ)
+#define OFC_SEMA_IO__WRITE     (1U << OFC_SEMA_IO_STMT_WRITE)
+#define OFC_SEMA_IO__REWIND    (1U << OFC_SEMA_IO_STMT_REWIND)
+#define OFC_SEMA_IO__END_FILE  (1U << OFC_SEMA_IO_STMT_END_FILE)
+#define OFC_SEMA_IO__BACKSPACE (1U << OFC_SEMA_IO_STMT_BACKSPACE)
+
+#define OFC_SEMA_IO__DATA (OFC_SEMA_IO__READ | OFC_SEMA_IO__WRITE)
+#define OFC_SEMA_IO__FILE (OFC_SEMA_IO__OPEN | OFC_SEMA_IO__INQUIRE)
+#define OFC_SEMA_IO__ALL  ((1U << OFC_SEMA_IO_STMT_COUNT) - 1)
+
+static const char* ofc_sema_io__stmt_name[] =
+{
+	"OPEN",
+	"CLOSE",
+	"INQUIRE",
+	"READ",
+	"WRITE",
+	"REWIND",
+	"ENDFILE",
+	"BACKSPACE",
+};
+
+typedef struct
+{
+	const char* name;
+	unsigned    stmt;
+} ofc_sema_io__spec_t;
+
+static const ofc_sema_io__spec_t ofc_sema_io__spec[] =
+{
+	{ "UNIT"       , OFC_SEMA_IO__ALL     },
+	{ "FMT"        , OFC_SEMA_IO__DATA    },
+	{ "REC"        , OFC_SEMA_IO__DATA    },
+	{ "ERR"        , OFC_SEMA_IO__ALL     },
+	{ "END"        , OFC_SEMA_IO__READ    },
+	{ "EOR"        , OFC_SEMA_IO__READ    },
+	{ "IOSTAT"     , OFC_SEMA_IO__ALL     },
+	{ "ADVANCE"    , OFC_SEMA_IO__DATA    },
+	{ "SIZE"       , OFC_SEMA_IO__READ    },
+	{ "FILE"       , OFC_SEMA_IO__FILE    },
+	{ "ACCESS"     , OFC_SEMA_IO__FILE    },
+	{ "ACTION"     , OFC_SEMA_IO__FILE    },
+	{ "BLANK"      , OFC_SEMA_IO__FILE    },
+	{ "DELIM"      , OFC_SEMA_IO__FILE    },
+	{ "FORM"       , OFC_SEMA_IO__FILE    },
+	{ "PAD"        , OFC_SEMA_IO__FILE    },
+	{ "POSITION"   , OFC_SEMA_IO__FILE    },
+	{ "RECL"       , OFC_SEMA_IO__FILE    },
+	{ "STATUS"     , (OFC_SEMA_IO__OPEN | OFC_SEMA_IO__CLOSE) },
+	{ "DIRECT"     , OFC_SEMA_IO__INQUIRE },
+	{ "EXIST"      , OFC_SEMA_IO__INQUIRE },
+	{ "FORMATTED"  , OFC_SEMA_IO__INQUIRE },
+	{ "NAME"       , OFC_SEMA_IO__INQUIRE },
+	{ "NAMED"      , OFC_SEMA_IO__INQUIRE },
+	{ "NEXTREC"    , OFC_SEMA_IO__INQUIRE },
+	{ "NUMBER"     , OFC_SEMA_IO__INQUIRE },
+	{ "OPENED"     , OFC_SEMA_IO__INQUIRE },
+	{ "READ"       , OFC_SEMA_IO__INQUIRE },
+	{ "READWRITE"  , OFC_SEMA_IO__INQUIRE },
+	{ "SEQUENTIAL" , OFC_SEMA_IO__INQUIRE },
+	{ "UNFORMATTED", OFC_SEMA_IO__INQUIRE },
+	{ "WRITE"      , OFC_SEMA_IO__INQUIRE },
+};
+
+/* Perfect hash of the specifier names, generated by searching for
+   multipliers which give every name in the table a distinct slot.
+   This must be regenerated when a specifier is added. */
+#define OFC_SEMA_IO__HASH_SIZE 64
+
+static unsigned ofc_sema_io__hash(ofc_str_ref_t name)
+{
+	unsigned len = name.size;
+	return ((len * 31)
+		+ toupper((unsigned char)name.base[0])
+		+ (toupper((unsigned char)name.base[1]) * 21)
+		+ (toupper((unsigned char)name.base[len - 1]) * 30))
+		& (OFC_SEMA_IO__HASH_SIZE - 1);
+}
+
+static const ofc_sema_io_spec_e ofc_sema_io__hash_table[OFC_SEMA_IO__HASH_SIZE] =
+{
+	OFC_SEMA_IO_SPEC_END,         OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_WRITE,       OFC_SEMA_IO_SPEC_FORM,
+	OFC_SEMA_IO_SPEC_ADVANCE,     OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_COUNT,
+	OFC_SEMA_IO_SPEC_UNFORMATTED, OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_COUNT,
+	OFC_SEMA_IO_SPEC_FMT,         OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_DELIM,       OFC_SEMA_IO_SPEC_UNIT,
+	OFC_SEMA_IO_SPEC_FORMATTED,   OFC_SEMA_IO_SPEC_OPENED,      OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_DIRECT,
+	OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_FILE,        OFC_SEMA_IO_SPEC_IOSTAT,      OFC_SEMA_IO_SPEC_COUNT,
+	OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_SEQUENTIAL,  OFC_SEMA_IO_SPEC_COUNT,
+	OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_NUMBER,      OFC_SEMA_IO_SPEC_ACTION,      OFC_SEMA_IO_SPEC_RECL,
+	OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_SIZE,        OFC_SEMA_IO_SPEC_BLANK,
+	OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_POSITION,
+	OFC_SEMA_IO_SPEC_READWRITE,   OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_NEXTREC,     OFC_SEMA_IO_SPEC_STATUS,
+	OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_READ,
+	OFC_SEMA_IO_SPEC_EXIST,       OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_REC,         OFC_SEMA_IO_SPEC_COUNT,
+	OFC_SEMA_IO_SPEC_ACCESS,      OFC_SEMA_IO_SPEC_NAME,        OFC_SEMA_IO_SPEC_NAMED,       OFC_SEMA_IO_SPEC_COUNT,
+	OFC_SEMA_IO_SPEC_ERR,         OFC_SEMA_IO_SPEC_EOR,         OFC_SEMA_IO_SPEC_PAD,         OFC_SEMA_IO_SPEC_COUNT,
+	OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_COUNT,       OFC_SEMA_IO_SPEC_COUNT,
+};
+
+/* Values allowed for constant CHARACTER specifiers, in the
+   order they're listed when an invalid value is reported. */
+typedef struct
+{
+	ofc_sema_io_spec_e  spec;
+	unsigned            stmt;
+	ofc_sema_call_arg_e value;
+	const char*         name;
+} ofc_sema_io__value_t;
+
+static const ofc_sema_io__value_t ofc_sema_io__value[] =
+{
+	{ OFC_SEMA_IO_SPEC_ACCESS  , OFC_SEMA_IO__OPEN , OFC_SEMA_CALL_ARG_SEQUENTIAL      , "SEQUENTIAL"  },
+	{ OFC_SEMA_IO_SPEC_ACCESS  , OFC_SEMA_IO__OPEN , OFC_SEMA_CALL_ARG_DIRECT          , "DIRECT"      },
+	{ OFC_SEMA_IO_SPEC_ACTION  , OFC_SEMA_IO__OPEN , OFC_SEMA_CALL_ARG_READ            , "READ"        },
+	{ OFC_SEMA_IO_SPEC_ACTION  , OFC_SEMA_IO__OPEN , OFC_SEMA_CALL_ARG_WRITE           , "WRITE"       },
+	{ OFC_SEMA_IO_SPEC_ACTION  , OFC_SEMA_IO__OPEN , OFC_SEMA_CALL_ARG_READWRITE       , "READWRITE"   },
+	{ OFC_SEMA_IO_SPEC_BLANK   , OFC_SEMA_IO__OPEN , OFC_SEMA_CALL_ARG_BLANK_NULL      , "NULL"        },
+	{ OFC_SEMA_IO_SPEC_BLANK   , OFC_SEMA_IO__OPEN , OFC_SEMA_CALL_ARG_BLANK_ZERO      , "ZERO"        },
+	{ OFC_SEMA_IO_SPEC_DELIM   , OFC_SEMA_IO__OPEN , OFC_SEMA_CALL_ARG_DELIM_APOSTROPHE, "APOSTROPHE"  },
+	{ OFC_SEMA_IO_SPEC_DELIM   , OFC_SEMA_IO__OPEN , OFC_SEMA_CALL_ARG_DELIM_QUOTE     , "QUOTE"       },
+	{ OFC_SEMA_IO_SPEC_DELIM   , OFC_SEMA_IO__OPEN , OFC_SEMA_CALL_ARG_DELIM_NONE      , "NONE"        },
+	{ OFC_SEMA_IO_SPEC_FORM    , OFC_SEMA_IO__OPEN , OFC_SEMA_CALL_ARG_FORMATTED       , "FORMATTED"   },
+	{ OFC_SEMA_IO_SPEC_FORM    , OFC_SEMA_IO__OPEN , OFC_SEMA_CALL_ARG_UNFORMATTED     , "UNFORMATTED" },
+	{ OFC_SEMA_IO_SPEC_PAD     , OFC_SEMA_IO__OPEN , OFC_SEMA_CALL_ARG_PAD_YES         , "YES"         },
+	{ OFC_SEMA_IO_SPEC_PAD     , OFC_SEMA_IO__OPEN , OFC_SEMA_CALL_ARG_PAD_NO          , "NO"          },
+	{ OFC_SEMA_IO_SPEC_POSITION, OFC_SEMA_IO__OPEN , OFC_SEMA_CALL_ARG_REWIND          , "REWIND"      },
+	{ OFC_SEMA_IO_SPEC_POSITION, OFC_SEMA_IO__OPEN , OFC_SEMA_CALL_ARG_APPEND          , "APPEND"      },
+	{ OFC_SEMA_IO_SPEC_POSITION, OFC_SEMA_IO__OPEN , OFC_SEMA_CALL_ARG_ASIS            , "ASIS"        },
+	{ OFC_SEMA_IO_SPEC_STATUS  , OFC_SEMA_IO__OPEN , OFC_SEMA_CALL_ARG_UNKNOWN         , "UNKNOWN"     },
+	{ OFC_SEMA_IO_SPEC_STATUS  , OFC_SEMA_IO__OPEN , OFC_SEMA_CALL_ARG_REPLACE         , "REPLACE"     },
+	{ OFC_SEMA_IO_SPEC_STATUS  , OFC_SEMA_IO__OPEN , OFC_SEMA_CALL_ARG_OLD             , "OLD"         },
+	{ OFC_SEMA_IO_SPEC_STATUS  , OFC_SEMA_IO__OPEN , OFC_SEMA_CALL_ARG_NEW             , "NEW"         },
+	{ OFC_SEMA_IO_SPEC_STATUS  , OFC_SEMA_IO__OPEN , OFC_SEMA_CALL_ARG_SCRATCH         , "SCRATCH"     },
+	{ OFC_SEMA_IO_SPEC_STATUS  , OFC_SEMA_IO__CLOSE, OFC_SEMA_CALL_ARG_DELETE          , "DELETE"      },
+	{ OFC_SEMA_IO_SPEC_STATUS  , OFC_SEMA_IO__CLOSE, OFC_SEMA_CALL_ARG_KEEP            , "KEEP"        },
+	{ OFC_SEMA_IO_SPEC_ADVANCE , OFC_SEMA_IO__DATA , OFC_SEMA_CALL_ARG_ADVANCE_YES     , "YES"         },
+	{ OFC_SEMA_IO_SPEC_ADVANCE , OFC_SEMA_IO__DATA , OFC_SEMA_CALL_ARG_ADVANCE_NO      , "NO"          },
+};
+
+
+const char* ofc_sema_io_stmt_name(
+	ofc_sema_io_stmt_e stmt)
+{
+	if (stmt >= OFC_SEMA_IO_STMT_COUNT)
+		return NULL;
+	return ofc_sema_io__stmt_name[stmt];
+}
+
+const char* ofc_sema_io_spec_name(
+	ofc_sema_io_spec_e spec)
+{
+	if (spec >= OFC_SEMA_IO_SPEC_COUNT)
+		return NULL;
+	return ofc_sema_io__spec[spec].name;
+}
+
+ofc_sema_io_spec_e ofc_sema_io_spec_lookup(
+	ofc_str_ref_t name)
+{
+	/* Every specifier name is at least three characters. */
+	if (!name.base || (name.size < 3))
+		return OFC_SEMA_IO_SPEC_COUNT;
+
+	ofc_sema_io_spec_e spec
+		= ofc_sema_io__hash_table[ofc_sema_io__hash(name)];
+	if ((spec == OFC_SEMA_IO_SPEC_COUNT)
+		|| !ofc_str_ref_equal_strz_ci(name, ofc_sema_io__spec[spec].name))
+		return OFC_SEMA_IO_SPEC_COUNT;
+
+	return spec;
+}
+
+
+bool ofc_sema_io_spec_resolve(
+	ofc_sema_io_stmt_e stmt,
+	const ofc_parse_call_arg_list_t* params,
+	const ofc_parse_call_arg_t* arg[OFC_SEMA_IO_SPEC_COUNT])
+{
+	if (!params || !arg
+		|| (stmt >= OFC_SEMA_IO_STMT_COUNT))
+		return false;
+
+	const char* name = ofc_sema_io__stmt_name[stmt];
+
+	/* READ and WRITE may give the format as the second un-named parameter. */
+	unsigned positional = ((((1U << stmt) & OFC_SEMA_IO__DATA) != 0) ? 2 : 1);
+
+	unsigned i;
+	for (i = 0; i < OFC_SEMA_IO_SPEC_COUNT; i++)
+		arg[i] = NULL;
+
+	for (i = 0; i < params->count; i++)
+	{
+		const ofc_parse_call_arg_t* param
+			= params->call_arg[i];
+		if (!param) continue;
+
+		ofc_sema_io_spec_e spec;
+		if (ofc_sparse_ref_empty(param->name))
+		{
+			if (i >= positional)
+			{
+				ofc_sparse_ref_error(param->src,
+					"Un-named parameter %u has no meaning in %s.", i, name);
+				return false;
+			}
+
+			if (i == 0)
+			{
+				spec = OFC_SEMA_IO_SPEC_UNIT;
+			}
+			else
+			{
+				if (!arg[OFC_SEMA_IO_SPEC_UNIT])
+				{
+					ofc_sparse_ref_error(param->src,
+						"Un-named format parameter only valid after UNIT in %s.", name);
+					return false;
+				}
+
+				spec = OFC_SEMA_IO_SPEC_FMT;
+			}
+		}
+		else
+		{
+			spec = ofc_sema_io_spec_lookup(param->name.string);
+			if (spec == OFC_SEMA_IO_SPEC_COUNT)
+			{
+				ofc_sparse_ref_error(param->src,
+					"Unrecognized parameter %u name '%.*s' in %s.",
+					i, param->name.string.size, param->name.string.base, name);
+				return false;
+			}
+
+			if ((ofc_sema_io__spec[spec].stmt & (1U << stmt)) == 0)
+			{
+				ofc_sparse_ref_error(param->src,
+					"%s has no meaning in %s.",
+					ofc_sema_io__spec[spec].name, name);
+				return false;
+			}
+		}
+
+		if (arg[spec])
+		{
+			ofc_sparse_ref_error(param->src,
+				"Re-definition of %s in %s.",
+				ofc_sema_io__spec[spec].name, name);
+			return false;
+		}
+
+		arg[spec] = param;
+	}
+
+	return true;
+}
+
+bool ofc_sema_io_spec_value(
+	ofc_sema_io_stmt_e stmt,
+	ofc_sema_io_spec_e spec,
+	ofc_sparse_loc_t src,
+	const ofc_sema_expr_t* expr,
+	ofc_sema_call_arg_e* value)
+{
+	if (!expr
+		|| (stmt >= OFC_SEMA_IO_STMT_COUNT)
+		|| (spec >= OFC_SEMA_IO_SPEC_COUNT))
+		return false;
+
+	const char* name = ofc_sema_io__stmt_name[stmt];
+	const char* spec_name = ofc_sema_io__spec[spec].name;
+
+	const ofc_sema_type_t* etype
+		= ofc_sema_expr_type(expr);
+	if (!etype) return false;
+
+	if (etype->type != OFC_SEMA_TYPE_CHARACTER)
+	{
+		ofc_sparse_loc_error(src,
+			"%s must be a CHARACTER expression in %s",
+			spec_name, name);
+		return false;
+	}
+
+	const ofc_sema_typeval_t* constant
+		= ofc_sema_expr_constant(expr);
+	if (!constant)
+	{
+		if (value) *value = OFC_SEMA_CALL_ARG_RUNTIME;
+		return true;
+	}
+
+	char allowed[128];
+	unsigned len = 0;
+
+	unsigned i;
+	for (i = 0; i < (sizeof(ofc_sema_io__value) / sizeof(ofc_sema_io__value[0])); i++)
+	{
+		const ofc_sema_io__value_t* v = &ofc_sema_io__value[i];
+		if ((v->spec != spec)
+			|| ((v->stmt & (1U << stmt)) == 0))
+			continue;
+
+		if (ofc_typeval_character_equal_strz_ci(constant, v->name))
+		{
+			if (value) *value = v->value;
+			return true;
+		}
+
+		if (len < sizeof(allowed))
+		{
+			len += snprintf(&allowed[len], (sizeof(allowed) - len),
+				"%s%s", (len > 0 ? "/" : ""), v->name);
+		}
+	}
+
+	/* Specifiers without a list of values can take any string. */
+	if (len == 0)
+	{
+		if (value) *value = OFC_SEMA_CALL_ARG_RUNTIME;
+		return true;
+	}
+
+	ofc_sparse_loc_error(src,
+		"%s must be %s in %s",
+		spec_name, allowed, name);
+	return false;
+}
@@ -0,0 +1,486 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ofc/sema.h"
+
+
+ofc_sema_ir_t* ofc_sema_ir_create(void)
+{
+	ofc_sema_ir_t* ir
+		= (ofc_sema_ir_t*)malloc(
+			sizeof(ofc_sema_ir_t));
+	if (!ir) return NULL;
+
+	ir->count = 0;
+	ir->max   = 0;
+
+	ir->op    = NULL;
+	ir->flags = NULL;
+	ir->type  = NULL;
+	ir->first = NULL;
+
+	ir->child_first = NULL;
+	ir->child_count = NULL;
+	ir->child_total = 0;
+	ir->child_max   = 0;
+	ir->child       = NULL;
+
+	ir->src      = NULL;
+	ir->constant = NULL;
+	ir->expr     = NULL;
+
+	return ir;
+}
+
+void ofc_sema_ir_delete(ofc_sema_ir_t* ir)
+{
+	if (!ir)
+		return;
+
+	free(ir->op);
+	free(ir->flags);
+	free(ir->type);
+	free(ir->first);
+	free(ir->child_first);
+	free(ir->child_count);
+	free(ir->child);
+	free(ir->src);
+	free(ir->constant);
+	free(ir->expr);
+	free(ir);
+}
+
+
+static bool ofc_sema_ir__column(
+	void** column, size_t size, unsigned max)
+{
+	void* ncolumn = realloc(*column, (size * max));
+	if (!ncolumn) return false;
+	*column = ncolumn;
+	return true;
+}
+
+static bool ofc_sema_ir__reserve(
+	ofc_sema_ir_t* ir, unsigned children)
+{
+	if ((ir->child_total + children) > ir->child_max)
+	{
+		unsigned max = (ir->child_max > 0
+			? (ir->child_max * 2) : 64);
+		while (max < (ir->child_total + children))
+			max *= 2;
+
+		if (!ofc_sema_ir__column((void**)&ir->child,
+			sizeof(ofc_sema_ir_id_t), max))
+			return false;
+		ir->child_max = max;
+	}
+
+	if (ir->count < ir->max)
+		return true;
+
+	unsigned max = (ir->max > 0
+		? (ir->max * 2) : 64);
+
+	/* Each column keeps its new allocation even if a later one
+	   fails, so the table is still consistent at the old size. */
+	if (!ofc_sema_ir__column((void**)&ir->op,
+			sizeof(uint8_t), max)
+		|| !ofc_sema_ir__column((void**)&ir->flags,
+			sizeof(uint8_t), max)
+		|| !ofc_sema_ir__column((void**)&ir->type,
+			sizeof(const ofc_sema_type_t*), max)
+		|| !ofc_sema_ir__column((void**)&ir->first,
+			sizeof(ofc_sema_ir_id_t), max)
+		|| !ofc_sema_ir__column((void**)&ir->child_first,
+			sizeof(unsigned), max)
+		|| !ofc_sema_ir__column((void**)&ir->child_count,
+			sizeof(unsigned), max)
+		|| !ofc_sema_ir__column((void**)&ir->src,
+			sizeof(ofc_sparse_loc_t), max)
+		|| !ofc_sema_ir__column((void**)&ir->constant,
+			sizeof(const ofc_sema_typeval_t*), max)
+		|| !ofc_sema_ir__column((void**)&ir->expr,
+			sizeof(ofc_sema_expr_t*), max))
+		return false;
+
+	ir->max = max;
+	return true;
+}
+
+
+static unsigned ofc_sema_ir__operand_count(
+	const ofc_sema_expr_t* expr)
+{
+	switch (expr->type)
+	{
+		case OFC_SEMA_EXPR_CONSTANT:
+		case OFC_SEMA_EXPR_LHS:
+			return 0;
+
+		case OFC_SEMA_EXPR_CAST:
+			return 1;
+
+		case OFC_SEMA_EXPR_INTRINSIC:
+		case OFC_SEMA_EXPR_FUNCTION:
+			return ofc_sema_expr_list_count(expr->args);
+
+		case OFC_SEMA_EXPR_IMPLICIT_DO:
+			return 3 + ofc_sema_expr_list_count(
+				expr->implicit_do.expr);
+
+		default:
+			break;
+	}
+
+	return (expr->b ? 2 : 1);
+}
+
+static ofc_sema_expr_t* ofc_sema_ir__operand(
+	const ofc_sema_expr_t* expr, unsigned index)
+{
+	switch (expr->type)
+	{
+		case OFC_SEMA_EXPR_CAST:
+			return expr->cast.expr;
+
+		case OFC_SEMA_EXPR_INTRINSIC:
+		case OFC_SEMA_EXPR_FUNCTION:
+			return expr->args->expr[index];
+
+		case OFC_SEMA_EXPR_IMPLICIT_DO:
+			switch (index)
+			{
+				case 0:
+					return expr->implicit_do.init;
+				case 1:
+					return expr->implicit_do.last;
+				case 2:
+					return expr->implicit_do.step;
+				default:
+					break;
+			}
+			return expr->implicit_do.expr->expr[index - 3];
+
+		default:
+			break;
+	}
+
+	return (index == 0 ? expr->a : expr->b);
+}
+
+
+static void ofc_sema_ir__load(
+	ofc_sema_ir_t* ir, ofc_sema_ir_id_t id)
+{
+	const ofc_sema_expr_t* expr = ir->expr[id];
+
+	uint8_t flags = (ir->flags[id] & OFC_SEMA_IR_REWRITTEN);
+	if (expr->constant     ) flags |= OFC_SEMA_IR_CONSTANT;
+	if (expr->brackets     ) flags |= OFC_SEMA_IR_BRACKETS;
+	if (expr->is_label     ) flags |= OFC_SEMA_IR_LABEL;
+	if (expr->is_format    ) flags |= OFC_SEMA_IR_FORMAT;
+	if (expr->is_alt_return) flags |= OFC_SEMA_IR_ALT_RETURN;
+
+	ir->op[id]       = expr->type;
+	ir->flags[id]    = flags;
+	ir->src[id]      = expr->src;
+	ir->constant[id] = expr->constant;
+
+	/* Operators are typed from the operand columns so that long chains
+	   don't walk their whole subtree once per node. */
+	if ((expr->type >= OFC_SEMA_EXPR_POWER)
+		&& !(flags & OFC_SEMA_IR_REWRITTEN))
+	{
+		ofc_sema_ir_id_t a = ofc_sema_ir_child(ir, id, 0);
+		ofc_sema_ir_id_t b = ofc_sema_ir_child(ir, id, 1);
+		ir->type[id] = ofc_sema_expr_type_operator(expr->type,
+			(a != OFC_SEMA_IR_NONE ? ir->type[a] : NULL),
+			(b != OFC_SEMA_IR_NONE ? ir->type[b] : NULL));
+	}
+	else
+	{
+		ir->type[id] = ofc_sema_expr_type(expr);
+	}
+}
+
+bool ofc_sema_ir_add(
+	ofc_sema_ir_t* ir,
+	ofc_sema_expr_t* expr,
+	ofc_sema_ir_id_t* id)
+{
+	if (!ir || !expr)
+		return false;
+
+	ofc_sema_ir_id_t first = ir->count;
+
+	unsigned count = ofc_sema_ir__operand_count(expr);
+	unsigned i;
+	for (i = 0; i < count; i++)
+	{
+		ofc_sema_expr_t* operand
+			= ofc_sema_ir__operand(expr, i);
+		if (operand && !ofc_sema_ir_add(
+			ir, operand, NULL))
+			return false;
+	}
+
+	if (!ofc_sema_ir__reserve(ir, count))
+		return false;
+
+	ofc_sema_ir_id_t nid = ir->count++;
+	ir->first[nid]       = first;
+	ir->flags[nid]       = 0;
+	ir->expr[nid]        = expr;
+	ir->child_first[nid] = ir->child_total;
+	ir->child_count[nid] = count;
+
+	/* The operands are the subtrees laid out just before this node,
+	   so they're found by walking back through the first column. */
+	ofc_sema_ir_id_t* child
+		= &ir->child[ir->child_total];
+	ir->child_total += count;
+
+	ofc_sema_ir_id_t next = nid;
+	for (i = count; i-- > 0;)
+	{
+		if (!ofc_sema_ir__operand(expr, i))
+		{
+			child[i] = OFC_SEMA_IR_NONE;
+			continue;
+		}
+
+		child[i] = (next - 1);
+		next = ir->first[child[i]];
+	}
+
+	ofc_sema_ir__load(ir, nid);
+
+	if (id) *id = nid;
+	return true;
+}
+
+
+typedef struct
+{
+	unsigned          count, max;
+	ofc_sema_expr_t** expr;
+
+	unsigned                set_size;
+	const ofc_sema_expr_t** set;
+} ofc_sema_ir__visit_t;
+
+static bool ofc_sema_ir__visit(
+	ofc_sema_expr_t* expr, void* param)
+{
+	ofc_sema_ir__visit_t* visit
+		= (ofc_sema_ir__visit_t*)param;
+
+	if (visit->count >= visit->max)
+	{
+		unsigned max = (visit->max > 0
+			? (visit->max * 2) : 64);
+		ofc_sema_expr_t** nexpr
+			= (ofc_sema_expr_t**)realloc(visit->expr,
+				sizeof(ofc_sema_expr_t*) * max);
+		if (!nexpr) return false;
+		visit->expr = nexpr;
+		visit->max  = max;
+	}
+
+	visit->expr[visit->count++] = expr;
+	return true;
+}
+
+/* Returns true if expr was already in the set. */
+static bool ofc_sema_ir__visit_mark(
+	ofc_sema_ir__visit_t* visit,
+	const ofc_sema_expr_t* expr)
+{
+	uintptr_t h = (uintptr_t)expr;
+	h ^= (h >> 16);
+	h *= 0x45D9F3B;
+	h ^= (h >> 16);
+
+	unsigned mask = (visit->set_size - 1);
+	unsigned s;
+	for (s = (h & mask); visit->set[s]; s = ((s + 1) & mask))
+	{
+		if (visit->set[s] == expr)
+			return true;
+	}
+
+	visit->set[s] = expr;
+	return false;
+}
+
+ofc_sema_ir_t* ofc_sema_ir_create_scope(
+	ofc_sema_scope_t* scope)
+{
+	if (!scope)
+		return NULL;
+
+	ofc_sema_ir__visit_t visit;
+	visit.count    = 0;
+	visit.max      = 0;
+	visit.expr     = NULL;
+	visit.set_size = 0;
+	visit.set      = NULL;
+
+	/* The scope walk reports the direct operands of each expression
+	   before it, so the roots are the ones which aren't an operand of
+	   anything else we were given. */
+	if (!ofc_sema_scope_foreach_expr(
+		scope, &visit, ofc_sema_ir__visit))
+	{
+		free(visit.expr);
+		return NULL;
+	}
+
+	unsigned operands = 0;
+	unsigned i;
+	for (i = 0; i < visit.count; i++)
+		operands += ofc_sema_ir__operand_count(visit.expr[i]);
+
+	for (visit.set_size = 16; visit.set_size < ((operands + visit.count) * 2);
+		visit.set_size <<= 1);
+	visit.set = (const ofc_sema_expr_t**)calloc(
+		visit.set_size, sizeof(const ofc_sema_expr_t*));
+	if (!visit.set)
+	{
+		free(visit.expr);
+		return NULL;
+	}
+
+	for (i = 0; i < visit.count; i++)
+	{
+		unsigned count = ofc_sema_ir__operand_count(visit.expr[i]);
+		unsigned j;
+		for (j = 0; j < count; j++)
+		{
+			const ofc_sema_expr_t* operand
+				= ofc_sema_ir__operand(visit.expr[i], j);
+			if (operand) ofc_sema_ir__visit_mark(&visit, operand);
+		}
+	}
+
+	ofc_sema_ir_t* ir = ofc_sema_ir_create();
+	bool success = (ir != NULL);
+	for (i = 0; success && (i < visit.count); i++)
+	{
+		if (!ofc_sema_ir__visit_mark(&visit, visit.expr[i]))
+			success = ofc_sema_ir_add(ir, visit.expr[i], NULL);
+	}
+
+	free(visit.set);
+	free(visit.expr);
+
+	if (!success)
+	{
+		ofc_sema_ir_delete(ir);
+		return NULL;
+	}
+
+	return ir;
+}
+
+
+void ofc_sema_ir_refresh(
+	ofc_sema_ir_t* ir, ofc_sema_ir_id_t id)
+{
+	if (!ir || (id >= ir->count)
+		|| !ir->expr[id])
+		return;
+
+	ir->flags[id] |= OFC_SEMA_IR_REWRITTEN;
+	ofc_sema_ir__load(ir, id);
+}
+
+void ofc_sema_ir_remove(
+	ofc_sema_ir_t* ir, ofc_sema_ir_id_t id)
+{
+	if (!ir || (id >= ir->count))
+		return;
+
+	ir->flags[id]    = OFC_SEMA_IR_DELETED;
+	ir->expr[id]     = NULL;
+	ir->constant[id] = NULL;
+}
+
+
+bool ofc_sema_ir_foreach(
+	ofc_sema_ir_t* ir, void* param,
+	bool (*func)(ofc_sema_ir_t* ir, ofc_sema_ir_id_t id, void* param))
+{
+	if (!ir || !func)
+		return false;
+
+	ofc_sema_ir_id_t id;
+	for (id = 0; id < ir->count; id++)
+	{
+		if (ir->flags[id] & OFC_SEMA_IR_DELETED)
+			continue;
+
+		if (!func(ir, id, param))
+			return false;
+	}
+
+	return true;
+}
+
+bool ofc_sema_ir_foreach_reverse(
+	ofc_sema_ir_t* ir, void* param,
+	bool (*func)(ofc_sema_ir_t* ir, ofc_sema_ir_id_t id, void* param))
+{
+	if (!ir || !func)
+		return false;
+
+	ofc_sema_ir_id_t id;
+	for (id = ir->count; id-- > 0;)
+	{
+		if (ir->flags[id] & OFC_SEMA_IR_DELETED)
+			continue;
+
+		if (!func(ir, id, param))
+			return false;
+	}
+
+	return true;
+}
+
+bool ofc_sema_ir_foreach_op(
+	ofc_sema_ir_t* ir, ofc_sema_expr_e op, void* param,
+	bool (*func)(ofc_sema_ir_t* ir, ofc_sema_ir_id_t id, void* param))
+{
+	if (!ir || !func)
+		return false;
+
+	ofc_sema_ir_id_t id;
+	for (id = 0; id < ir->count; id++)
+	{
+		if ((ir->op[id] != op)
+			|| (ir->flags[id] & OFC_SEMA_IR_DELETED))
+			continue;
+
+		if (!func(ir, id, param))
+			return false;
+	}
+
+	return true;
+}
@@ -16,11 +16,11 @@
 #include "ofc/sema.h"
 
 
-ofc_sparse_ref_t ofc_sema_label_src(
+ofc_sparse_loc_t ofc_sema_label_src(
 	const ofc_sema_label_t* label)
 {
 	if (!label)
-		return OFC_SPARSE_REF_EMPTY;
+		return OFC_SPARSE_LOC_EMPTY;
 
 	switch (label->type)
 	{
@@ -39,7 +39,7 @@ ofc_sparse_ref_t ofc_sema_label_src(
 			break;
 	}
 
-	return OFC_SPARSE_REF_EMPTY;
+	return OFC_SPARSE_LOC_EMPTY;
 }
 
 
@@ -217,20 +217,20 @@ void ofc_sema_label_map_delete(
 static bool ofc_smea_label_map__add_stmt(
 	ofc_sema_label_map_t* map, unsigned label,
 	ofc_sema_label_t* l,
-	const ofc_sparse_ref_t src)
+	const ofc_sparse_loc_t src)
 {
 	const ofc_sema_label_t* duplicate
 		= ofc_hashmap_find(map->map, &label);
 	if (duplicate)
 	{
-		ofc_sparse_ref_error(src,
+		ofc_sparse_loc_error(src,
 			"Re-definition of label %d", label);
 		return false;
 	}
 
 	if (label == 0)
 	{
-		ofc_sparse_ref_warning(src,
+		ofc_sparse_loc_warning(src,
 			"Label zero isn't supported in standard Fortran");
 	}
 
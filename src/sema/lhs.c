@@ -43,6 +43,8 @@ static ofc_sema_lhs_t* ofc_sema_lhs_index(
 	alhs->data_type = lhs->data_type;
 	alhs->refcnt    = 0;
 
+	alhs->elem_count_valid = false;
+
 	return alhs;
 }
 
@@ -84,6 +86,8 @@ static ofc_sema_lhs_t* ofc_sema_lhs_slice(
 	alhs->data_type   = lhs->data_type;
 	alhs->refcnt      = 0;
 
+	alhs->elem_count_valid = false;
+
 	alhs->slice.slice = slice;
 	alhs->slice.dims  = array;
 
@@ -181,7 +185,7 @@ static ofc_sema_lhs_t* ofc_sema_lhs_substring(
 
 		if (ifirst < 0)
 		{
-			ofc_sparse_ref_error(lhs->src,
+			ofc_sparse_loc_error(lhs->src,
 				"First index in character substring must be 1 or greater");
 
 			ofc_sema_lhs_delete(lhs);
@@ -193,7 +197,7 @@ static ofc_sema_lhs_t* ofc_sema_lhs_substring(
 
 		if (ilast < ifirst)
 		{
-			ofc_sparse_ref_error(lhs->src,
+			ofc_sparse_loc_error(lhs->src,
 				"Last index in character substring must be greater than first");
 
 			ofc_sema_lhs_delete(lhs);
@@ -206,7 +210,7 @@ static ofc_sema_lhs_t* ofc_sema_lhs_substring(
 		if ((lhs->data_type->len > 0)
 			&& (ilast > lhs->data_type->len))
 		{
-			ofc_sparse_ref_warning(lhs->src,
+			ofc_sparse_loc_warning(lhs->src,
 				"Last index in character substring out-of-bounds");
 		}
 
@@ -255,6 +259,8 @@ static ofc_sema_lhs_t* ofc_sema_lhs_substring(
 	alhs->data_type       = type;
 	alhs->refcnt          = 0;
 
+	alhs->elem_count_valid = false;
+
 	return alhs;
 }
 
@@ -295,6 +301,9 @@ static ofc_sema_lhs_t* ofc_sema_lhs_member(
 	alhs->data_type = ofc_sema_decl_type(member);
 	alhs->refcnt    = 0;
 	alhs->member    = member;
+
+	alhs->elem_count_valid = false;
+
 	return alhs;
 }
 
@@ -311,13 +320,13 @@ static ofc_sema_lhs_t* ofc_sema__lhs(
 	switch (lhs->type)
 	{
 		case OFC_PARSE_LHS_IMPLICIT_DO:
-			ofc_sparse_ref_error(lhs->src,
+			ofc_sparse_loc_error(lhs->src,
 				"Can't resolve implicit do to single %s.",
 				(is_expr ? "primary expression": "LHS"));
 			return NULL;
 
 		case OFC_PARSE_LHS_STAR_LEN:
-			ofc_sparse_ref_error(lhs->src,
+			ofc_sparse_loc_error(lhs->src,
 				"Can't resolve star length to %s.",
 				(is_expr ? "primary expression": "LHS"));
 			return NULL;
@@ -333,7 +342,7 @@ static ofc_sema_lhs_t* ofc_sema__lhs(
 					= ofc_sema_lhs_structure(parent);
 				if (!structure)
 				{
-					ofc_sparse_ref_error(lhs->src,
+					ofc_sparse_loc_error(lhs->src,
 						"Attempting to dereference member of a variable"
 						" that's not a structure.");
 					ofc_sema_lhs_delete(parent);
@@ -343,13 +352,13 @@ static ofc_sema_lhs_t* ofc_sema__lhs(
 				if ((lhs->type == OFC_PARSE_LHS_MEMBER_TYPE)
 					&& !ofc_sema_structure_is_derived_type(structure))
 				{
-					ofc_sparse_ref_warning(lhs->src,
+					ofc_sparse_loc_warning(lhs->src,
 						"Dereferencing member of a VAX struct using F90 syntax");
 				}
 				else if ((lhs->type == OFC_PARSE_LHS_MEMBER_STRUCTURE)
 					&& ofc_sema_structure_is_derived_type(structure))
 				{
-					ofc_sparse_ref_warning(lhs->src,
+					ofc_sparse_loc_warning(lhs->src,
 						"Dereferencing member of an F90 TYPE using VAX syntax");
 				}
 
@@ -358,7 +367,7 @@ static ofc_sema_lhs_t* ofc_sema__lhs(
 						structure, lhs->member.name.string);
 				if (!member)
 				{
-					ofc_sparse_ref_error(lhs->src,
+					ofc_sparse_loc_error(lhs->src,
 						"Dereferencing undefined structure member");
 					ofc_sema_lhs_delete(parent);
 					return NULL;
@@ -382,7 +391,7 @@ static ofc_sema_lhs_t* ofc_sema__lhs(
 					if (!ofc_sema_type_is_character(
 						parent->data_type))
 					{
-						ofc_sparse_ref_error(lhs->src,
+						ofc_sparse_loc_error(lhs->src,
 							"Attempting to index a variable that's not an array");
 						ofc_sema_lhs_delete(parent);
 						return NULL;
@@ -447,7 +456,7 @@ static ofc_sema_lhs_t* ofc_sema__lhs(
 			scope, lhs->variable, force_local);
 	if (!decl)
 	{
-		ofc_sparse_ref_error(lhs->src,
+		ofc_sparse_loc_error(lhs->src,
 			"No declaration for '%.*s' and no valid IMPLICIT rule.",
 			lhs->variable.string.size, lhs->variable.string.base);
 		return NULL;
@@ -457,7 +466,7 @@ static ofc_sema_lhs_t* ofc_sema__lhs(
 		&& ofc_sema_decl_is_parameter(decl))
 	{
 		/* TODO - Throw this error for PARAMETER arrays, etc. too. */
-		ofc_sparse_ref_error(lhs->src,
+		ofc_sparse_loc_error(lhs->src,
 			"Assignment to PARAMETER declaration");
 		return NULL;
 	}
@@ -478,6 +487,8 @@ static ofc_sema_lhs_t* ofc_sema__lhs(
 	slhs->decl      = decl;
 	slhs->refcnt    = 0;
 
+	slhs->elem_count_valid = false;
+
 	if (is_expr || is_dummy_arg)
 	{
 		if (!is_dummy_arg
@@ -517,7 +528,7 @@ ofc_sema_lhs_t* ofc_sema_lhs_from_expr(
 
 	if (expr->type != OFC_PARSE_EXPR_VARIABLE)
 	{
-		ofc_sparse_ref_error(expr->src,
+		ofc_sparse_loc_error(expr->src,
 			"Attempting to convert to lhs and expression that is not an lhs");
 		return NULL;
 	}
@@ -552,7 +563,7 @@ ofc_sema_lhs_t* ofc_sema_lhs_local(
 
 static ofc_sema_lhs_t* ofc_sema_lhs__implicit_do(
 	ofc_sema_scope_t* scope,
-	ofc_sparse_ref_t src,
+	ofc_sparse_loc_t src,
 	const ofc_parse_lhs_implicit_do_t* id)
 {
 	if (!id || !id->init)
@@ -578,6 +589,8 @@ static ofc_sema_lhs_t* ofc_sema_lhs__implicit_do(
 	lhs->data_type = NULL;
 	lhs->refcnt = 0;
 
+	lhs->elem_count_valid = false;
+
 	ofc_sema_lhs_t* iter_lhs = ofc_sema_lhs_from_expr(
 		scope, id->iter);
 	if (!iter_lhs)
@@ -595,7 +608,7 @@ static ofc_sema_lhs_t* ofc_sema_lhs__implicit_do(
 
 	if (iter_lhs->type != OFC_SEMA_LHS_DECL)
 	{
-		ofc_sparse_ref_error(id->iter->src,
+		ofc_sparse_loc_error(id->iter->src,
 			"Implicit do loop iterator must be a variable");
 		ofc_sema_lhs_delete(iter_lhs);
 		ofc_sema_lhs_delete(lhs);
@@ -622,7 +635,7 @@ static ofc_sema_lhs_t* ofc_sema_lhs__implicit_do(
 
 	if (!ofc_sema_type_is_scalar(iter_type))
 	{
-		ofc_sparse_ref_error(id->iter->src,
+		ofc_sparse_loc_error(id->iter->src,
 			"Implicit do loop iterator must be a scalar type");
 		ofc_sema_lhs_delete(lhs);
 		return NULL;
@@ -630,7 +643,7 @@ static ofc_sema_lhs_t* ofc_sema_lhs__implicit_do(
 
 	if (!ofc_sema_type_is_integer(iter_type))
 	{
-		ofc_sparse_ref_warning(id->iter->src,
+		ofc_sparse_loc_warning(id->iter->src,
 			"Using REAL in implicit do loop iterator");
 	}
 
@@ -687,7 +700,7 @@ static ofc_sema_lhs_t* ofc_sema_lhs__implicit_do(
 				lhs->implicit_do.last, iter_type);
 		if (!cast)
 		{
-			ofc_sparse_ref_error(id->limit->src,
+			ofc_sparse_loc_error(id->limit->src,
 				"Expression type '%s' doesn't match iterator type '%s'",
 				ofc_sema_type_str_rep(last_type),
 				ofc_sema_type_str_rep(iter_type));
@@ -723,7 +736,7 @@ static ofc_sema_lhs_t* ofc_sema_lhs__implicit_do(
 					lhs->implicit_do.step, iter_type);
 			if (!cast)
 			{
-				ofc_sparse_ref_error(id->step->src,
+				ofc_sparse_loc_error(id->step->src,
 					"Expression type '%s' doesn't match iterator type '%s'",
 					ofc_sema_type_str_rep(step_type),
 					ofc_sema_type_str_rep(iter_type));
@@ -767,7 +780,7 @@ static ofc_sema_lhs_t* ofc_sema_lhs__implicit_do(
 		long double dcount = floor((last - first) / step);
 		if (dcount < 0.0)
 		{
-			ofc_sparse_ref_error(src,
+			ofc_sparse_loc_error(src,
 				"Loop iterates away from limit");
 			ofc_sema_lhs_delete(lhs);
 			return NULL;
@@ -792,12 +805,31 @@ static ofc_sema_lhs_t* ofc_sema_lhs__implicit_do(
 }
 
 
-ofc_sema_lhs_t* ofc_sema_lhs_elem_get(
-	ofc_sema_lhs_t* lhs, unsigned offset)
+static bool ofc_sema_lhs_list__elem_find(
+	const ofc_sema_lhs_list_t* list, unsigned offset,
+	unsigned* index, unsigned* sub_offset);
+
+ofc_sema_lhs_t* ofc_sema_lhs_elem_get_bind(
+	ofc_sema_lhs_t* lhs, unsigned offset,
+	const ofc_sema_expr_bind_t* bind)
 {
 	if (!lhs)
 		return NULL;
 
+	/* Only implicit DO loops can be indexed without applying the bindings,
+	   this is cheap for references to array elements. */
+	if (bind && (lhs->type != OFC_SEMA_LHS_IMPLICIT_DO))
+	{
+		ofc_sema_lhs_t* body
+			= ofc_sema_lhs_copy_bind(lhs, bind);
+		if (!body) return NULL;
+
+		ofc_sema_lhs_t* elem
+			= ofc_sema_lhs_elem_get(body, offset);
+		ofc_sema_lhs_delete(body);
+		return elem;
+	}
+
 	switch (lhs->type)
 	{
 		case OFC_SEMA_LHS_DECL:
@@ -937,9 +969,50 @@ ofc_sema_lhs_t* ofc_sema_lhs_elem_get(
 			if (sub_elem_count == 0)
 				return NULL;
 
-			unsigned sub_offset
-				= (offset % sub_elem_count);
-			offset /= sub_elem_count;
+			unsigned i, e;
+			if (!ofc_sema_lhs_list__elem_find(
+				lhs->implicit_do.lhs,
+				(offset % sub_elem_count), &i, &e))
+				return NULL;
+
+			ofc_sema_lhs_t* body
+				= lhs->implicit_do.lhs->lhs[i];
+
+			unsigned iteration
+				= (offset / sub_elem_count);
+
+			/* Integer iterators are bound to the value of this iteration
+			   and the body is evaluated lazily. */
+			int first, step = 1;
+			if (ofc_sema_type_is_integer(lhs->implicit_do.iter->type)
+				&& ofc_sema_expr_resolve_int(lhs->implicit_do.init, &first)
+				&& (!lhs->implicit_do.step
+					|| ofc_sema_expr_resolve_int(lhs->implicit_do.step, &step)))
+			{
+				int64_t value = first + ((int64_t)iteration * step);
+
+				ofc_sema_expr_bind_t ibind;
+				ibind.iter  = lhs->implicit_do.iter;
+				ibind.value = value;
+				ibind.next  = bind;
+				if (ibind.value != value)
+					return NULL;
+
+				return ofc_sema_lhs_elem_get_bind(
+					body, e, &ibind);
+			}
+
+			if (bind)
+			{
+				ofc_sema_lhs_t* copy
+					= ofc_sema_lhs_copy_bind(lhs, bind);
+				if (!copy) return NULL;
+
+				ofc_sema_lhs_t* elem
+					= ofc_sema_lhs_elem_get(copy, offset);
+				ofc_sema_lhs_delete(copy);
+				return elem;
+			}
 
 			const ofc_sema_typeval_t* ctv[2];
 			ctv[0] = ofc_sema_expr_constant(
@@ -947,19 +1020,19 @@ ofc_sema_lhs_t* ofc_sema_lhs_elem_get(
 			ctv[1] = ofc_sema_expr_constant(
 					lhs->implicit_do.step);
 
-			long double first, step = 1.0;
-			if (!ofc_sema_typeval_get_real(ctv[0], &first))
+			long double rfirst, rstep = 1.0;
+			if (!ofc_sema_typeval_get_real(ctv[0], &rfirst))
 				return NULL;
-			if (ctv[1] && !ofc_sema_typeval_get_real(ctv[1], &step))
+			if (ctv[1] && !ofc_sema_typeval_get_real(ctv[1], &rstep))
 				return NULL;
 
 			long double doffset
-				= first + ((long double)offset * step);
+				= rfirst + ((long double)iteration * rstep);
 
 			ofc_sema_typeval_t* dinit
 				= ofc_sema_typeval_create_real(
 					doffset, OFC_SEMA_KIND_NONE,
-					OFC_SPARSE_REF_EMPTY);
+					OFC_SPARSE_LOC_EMPTY);
 			if (!dinit) return NULL;
 
 			ofc_sema_typeval_t* init
@@ -976,40 +1049,14 @@ ofc_sema_lhs_t* ofc_sema_lhs_elem_get(
 				return NULL;
 			}
 
-			ofc_sema_lhs_t* rval = NULL;
-			unsigned e = sub_offset;
-			unsigned i;
-			for (i = 0; i < lhs->implicit_do.lhs->count; i++)
-			{
-				ofc_sema_lhs_t* lhs_dummy
-					= lhs->implicit_do.lhs->lhs[i];
-
-				unsigned elem_count;
-				if (!ofc_sema_lhs_elem_count(
-					lhs_dummy, &elem_count))
-					return NULL;
-
-				if (e < elem_count)
-				{
-
-					ofc_sema_lhs_t* body
-						= ofc_sema_lhs_copy_replace(
-							lhs_dummy, lhs->implicit_do.iter, iter_expr);
-					if (!body) return NULL;
-
-					rval = ofc_sema_lhs_elem_get(
-						body, sub_offset);
-
-					ofc_sema_lhs_delete(body);
-				}
-				else
-				{
-					e -= elem_count;
-				}
-			}
-
+			ofc_sema_lhs_t* copy
+				= ofc_sema_lhs_copy_replace(
+					body, lhs->implicit_do.iter, iter_expr);
 			ofc_sema_expr_delete(iter_expr);
 
+			ofc_sema_lhs_t* rval
+				= ofc_sema_lhs_elem_get(copy, e);
+			ofc_sema_lhs_delete(copy);
 			return rval;
 		}
 
@@ -1020,6 +1067,13 @@ ofc_sema_lhs_t* ofc_sema_lhs_elem_get(
 	return NULL;
 }
 
+ofc_sema_lhs_t* ofc_sema_lhs_elem_get(
+	ofc_sema_lhs_t* lhs, unsigned offset)
+{
+	return ofc_sema_lhs_elem_get_bind(
+		lhs, offset, NULL);
+}
+
 
 
 ofc_sema_lhs_t* ofc_sema_lhs_copy_replace(
@@ -1036,6 +1090,7 @@ ofc_sema_lhs_t* ofc_sema_lhs_copy_replace(
 	if (!copy) return NULL;
 
 	*copy = *lhs;
+	copy->elem_count_valid = false;
 
 	if (lhs->type == OFC_SEMA_LHS_DECL)
 	{
@@ -1160,6 +1215,70 @@ ofc_sema_lhs_t* ofc_sema_lhs_copy(
 		lhs, NULL, NULL);
 }
 
+ofc_sema_lhs_t* ofc_sema_lhs_copy_bind(
+	const ofc_sema_lhs_t* lhs,
+	const ofc_sema_expr_bind_t* bind)
+{
+	if (!lhs)
+		return NULL;
+
+	if (!bind)
+		return ofc_sema_lhs_copy(lhs);
+
+	/* Resolve array element references directly, since most implicit DO
+	   bodies are of the form A(I, J) this avoids copying the indices. */
+	if ((lhs->type == OFC_SEMA_LHS_ARRAY_INDEX)
+		&& (lhs->parent->type == OFC_SEMA_LHS_DECL)
+		&& (lhs->index->dimensions > 0))
+	{
+		unsigned dims = lhs->index->dimensions;
+		int idx[dims];
+
+		unsigned i;
+		for (i = 0; i < dims; i++)
+		{
+			if (!ofc_sema_expr_resolve_int_bind(
+				lhs->index->index[i], bind, &idx[i]))
+				break;
+		}
+
+		if (i >= dims)
+		{
+			ofc_sema_array_index_t* index
+				= ofc_sema_array_index_from_int(dims, idx);
+			if (!index) return NULL;
+
+			ofc_sema_lhs_t* alhs
+				= ofc_sema_lhs_index(lhs->parent, index);
+			if (!alhs)
+			{
+				ofc_sema_array_index_delete(index);
+				return NULL;
+			}
+
+			alhs->src = lhs->src;
+			return alhs;
+		}
+	}
+
+	ofc_sema_expr_t* with
+		= ofc_sema_expr_bind_value(bind);
+	if (!with) return NULL;
+
+	ofc_sema_lhs_t* copy
+		= ofc_sema_lhs_copy_replace(
+			lhs, bind->iter, with);
+	ofc_sema_expr_delete(with);
+	if (!copy || !bind->next)
+		return copy;
+
+	ofc_sema_lhs_t* rcopy
+		= ofc_sema_lhs_copy_bind(
+			copy, bind->next);
+	ofc_sema_lhs_delete(copy);
+	return rcopy;
+}
+
 bool ofc_sema_lhs_reference(
 	ofc_sema_lhs_t* lhs)
 {
@@ -1680,6 +1799,12 @@ bool ofc_sema_lhs_elem_count(
 {
 	if (!lhs) return false;
 
+	if (lhs->elem_count_valid)
+	{
+		if (count) *count = lhs->elem_count;
+		return true;
+	}
+
 	unsigned ecount = 1;
 	if (lhs->type == OFC_SEMA_LHS_IMPLICIT_DO)
 	{
@@ -1717,6 +1842,12 @@ bool ofc_sema_lhs_elem_count(
 		ecount *= scount;
 	}
 
+	/* The count only depends on the node itself, which is never
+	   modified once built, copy/replace always creates a new node. */
+	ofc_sema_lhs_t* mlhs = (ofc_sema_lhs_t*)lhs;
+	mlhs->elem_count       = ecount;
+	mlhs->elem_count_valid = true;
+
 	if (count) *count = ecount;
 	return true;
 }
@@ -1841,6 +1972,7 @@ static ofc_sema_lhs_list_t* ofc_sema_lhs__list(
 	if (!list) return NULL;
 
 	list->count = 0;
+	list->elem_offset = NULL;
 	list->lhs = (ofc_sema_lhs_t**)malloc(
 		plist->count * sizeof(ofc_sema_lhs_t*));
 	if (!list->lhs)
@@ -1906,8 +2038,9 @@ ofc_sema_lhs_list_t* ofc_sema_lhs_list_create(void)
 			sizeof(ofc_sema_lhs_list_t));
 	if (!list) return NULL;
 
-	list->count = 0;
-	list->lhs   = NULL;
+	list->count       = 0;
+	list->lhs         = NULL;
+	list->elem_offset = NULL;
 	return list;
 }
 
@@ -1920,6 +2053,7 @@ void ofc_sema_lhs_list_delete(ofc_sema_lhs_list_t* list)
 	for (i = 0; i < list->count; i++)
 		ofc_sema_lhs_delete(list->lhs[i]);
 	free(list->lhs);
+	free(list->elem_offset);
 
 	free(list);
 }
@@ -1944,7 +2078,8 @@ ofc_sema_lhs_list_t* ofc_sema_lhs_list_copy_replace(
 		return NULL;
 	}
 
-	copy->count = list->count;
+	copy->count       = list->count;
+	copy->elem_offset = NULL;
 
 	bool fail = false;
 	unsigned i;
@@ -1980,51 +2115,94 @@ bool ofc_sema_lhs_list_add(
 	list->lhs = nlhs;
 
 	list->lhs[list->count++] = lhs;
+
+	free(list->elem_offset);
+	list->elem_offset = NULL;
 	return true;
 }
 
-bool ofc_sema_lhs_list_elem_count(
-	const ofc_sema_lhs_list_t* list, unsigned* count)
+static const unsigned* ofc_sema_lhs_list__elem_offset(
+	const ofc_sema_lhs_list_t* list)
 {
-	if (!list)
-		return false;
+	if (!list) return NULL;
 
-	unsigned i, c;
-	for (i = 0, c = 0; i < list->count; i++)
+	if (list->elem_offset)
+		return list->elem_offset;
+
+	unsigned* offset = (unsigned*)malloc(
+		sizeof(unsigned) * (list->count + 1));
+	if (!offset) return NULL;
+
+	offset[0] = 0;
+
+	unsigned i;
+	for (i = 0; i < list->count; i++)
 	{
 		unsigned e;
 		if (!ofc_sema_lhs_elem_count(list->lhs[i], &e))
-			return false;
-		c += e;
+		{
+			free(offset);
+			return NULL;
+		}
+
+		offset[i + 1] = offset[i] + e;
 	}
 
-	if (count) *count = c;
-	return true;
+	ofc_sema_lhs_list_t* mlist
+		= (ofc_sema_lhs_list_t*)list;
+	mlist->elem_offset = offset;
+	return offset;
 }
 
-ofc_sema_lhs_t* ofc_sema_lhs_list_elem_get(
-	const ofc_sema_lhs_list_t* list, unsigned offset)
+/* Finds the entry containing element offset, and the offset within it. */
+static bool ofc_sema_lhs_list__elem_find(
+	const ofc_sema_lhs_list_t* list, unsigned offset,
+	unsigned* index, unsigned* sub_offset)
 {
-	if (!list)
-		return NULL;
+	const unsigned* elem_offset
+		= ofc_sema_lhs_list__elem_offset(list);
+	if (!elem_offset
+		|| (offset >= elem_offset[list->count]))
+		return false;
 
-	unsigned i, o;
-	for (i = 0, o = offset; (i < list->count) && (o <= offset); i++)
+	/* Find the last entry which starts at or before offset,
+	   skipping over any empty entries. */
+	unsigned lo = 0, hi = list->count;
+	while ((hi - lo) > 1)
 	{
-		unsigned e;
-		if (!ofc_sema_lhs_elem_count(list->lhs[i], &e))
-			return NULL;
+		unsigned mid = lo + ((hi - lo) / 2);
+		if (elem_offset[mid] <= offset)
+			lo = mid;
+		else
+			hi = mid;
+	}
 
-		if (o < e)
-		{
-			return ofc_sema_lhs_elem_get(
-				list->lhs[i], o);
-		}
+	if (index) *index = lo;
+	if (sub_offset) *sub_offset = (offset - elem_offset[lo]);
+	return true;
+}
 
-		o -= e;
-	}
+bool ofc_sema_lhs_list_elem_count(
+	const ofc_sema_lhs_list_t* list, unsigned* count)
+{
+	const unsigned* elem_offset
+		= ofc_sema_lhs_list__elem_offset(list);
+	if (!elem_offset) return false;
 
-	return NULL;
+	if (count) *count = elem_offset[list->count];
+	return true;
+}
+
+ofc_sema_lhs_t* ofc_sema_lhs_list_elem_get(
+	const ofc_sema_lhs_list_t* list, unsigned offset)
+{
+	unsigned i, e;
+	if (!ofc_sema_lhs_list__elem_find(
+		list, offset, &i, &e))
+		return NULL;
+
+	return ofc_sema_lhs_elem_get(
+		list->lhs[i], e);
 }
 
 
@@ -2062,7 +2240,7 @@ bool ofc_sema_lhs_list_init(
 		if (!success)
 		{
 			/* TODO - Fail atomically? */
-			ofc_sparse_ref_error(init_elem->src,
+			ofc_sparse_loc_error(init_elem->src,
 				"Invalid initializer");
 			ofc_sema_expr_delete(init_elem);
 			return false;
@@ -0,0 +1,179 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ofc/sema.h"
+
+
+static ofc_sema_name_t* ofc_sema_name__create(
+	ofc_str_ref_t name)
+{
+	ofc_sema_name_t* entry
+		= (ofc_sema_name_t*)malloc(
+			sizeof(ofc_sema_name_t));
+	if (!entry) return NULL;
+
+	char* name_str = strndup(name.base, name.size);
+	if (!name_str)
+	{
+		free(entry);
+		return NULL;
+	}
+
+	entry->name     = name;
+	entry->keyword  = ofc_str_ref_begins_with_keyword(name);
+	entry->reserved = ofc_sema_intrinsic_name_reserved(name_str);
+	free(name_str);
+
+	entry->unit_count  = 0;
+	entry->unit_parent = NULL;
+	return entry;
+}
+
+static void ofc_sema_name__delete(
+	ofc_sema_name_t* entry)
+{
+	if (!entry)
+		return;
+
+	free(entry->unit_parent);
+	free(entry);
+}
+
+static const ofc_str_ref_t* ofc_sema_name__key(
+	const ofc_sema_name_t* entry)
+{
+	return (entry ? &entry->name : NULL);
+}
+
+
+ofc_sema_name_index_t* ofc_sema_name_index_create(void)
+{
+	ofc_sema_name_index_t* index
+		= (ofc_sema_name_index_t*)malloc(
+			sizeof(ofc_sema_name_index_t));
+	if (!index) return NULL;
+
+	index->map = ofc_hashmap_create(
+		(void*)(global_opts.case_sensitive
+			? ofc_str_ref_ptr_hash
+			: ofc_str_ref_ptr_hash_ci),
+		(void*)(global_opts.case_sensitive
+			? ofc_str_ref_ptr_equal
+			: ofc_str_ref_ptr_equal_ci),
+		(void*)ofc_sema_name__key,
+		(void*)ofc_sema_name__delete);
+	if (!index->map)
+	{
+		free(index);
+		return NULL;
+	}
+
+	return index;
+}
+
+void ofc_sema_name_index_delete(
+	ofc_sema_name_index_t* index)
+{
+	if (!index)
+		return;
+
+	ofc_hashmap_delete(index->map);
+	free(index);
+}
+
+
+const ofc_sema_name_t* ofc_sema_name_index_find(
+	const ofc_sema_name_index_t* index,
+	ofc_str_ref_t name)
+{
+	if (!index)
+		return NULL;
+
+	return ofc_hashmap_find(
+		index->map, &name);
+}
+
+static ofc_sema_name_t* ofc_sema_name_index__find_create(
+	ofc_sema_name_index_t* index,
+	ofc_str_ref_t name)
+{
+	if (!index)
+		return NULL;
+
+	ofc_sema_name_t* entry
+		= ofc_hashmap_find_modify(
+			index->map, &name);
+	if (entry) return entry;
+
+	entry = ofc_sema_name__create(name);
+	if (!entry) return NULL;
+
+	if (!ofc_hashmap_add(
+		index->map, entry))
+	{
+		ofc_sema_name__delete(entry);
+		return NULL;
+	}
+
+	return entry;
+}
+
+const ofc_sema_name_t* ofc_sema_name_index_find_create(
+	ofc_sema_name_index_t* index,
+	ofc_str_ref_t name)
+{
+	return ofc_sema_name_index__find_create(
+		index, name);
+}
+
+bool ofc_sema_name_index_add_unit(
+	ofc_sema_name_index_t* index,
+	ofc_str_ref_t name,
+	const ofc_sema_scope_t* parent)
+{
+	ofc_sema_name_t* entry
+		= ofc_sema_name_index__find_create(
+			index, name);
+	if (!entry) return false;
+
+	if (ofc_sema_name_is_unit(entry, parent))
+		return true;
+
+	const ofc_sema_scope_t** nparent
+		= (const ofc_sema_scope_t**)realloc(entry->unit_parent,
+			(sizeof(const ofc_sema_scope_t*) * (entry->unit_count + 1)));
+	if (!nparent) return false;
+	entry->unit_parent = nparent;
+
+	entry->unit_parent[entry->unit_count++] = parent;
+	return true;
+}
+
+bool ofc_sema_name_is_unit(
+	const ofc_sema_name_t* entry,
+	const ofc_sema_scope_t* parent)
+{
+	if (!entry)
+		return false;
+
+	unsigned i;
+	for (i = 0; i < entry->unit_count; i++)
+	{
+		if (entry->unit_parent[i] == parent)
+			return true;
+	}
+
+	return false;
+}
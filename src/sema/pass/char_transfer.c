@@ -17,24 +17,21 @@
 
 
 static bool ofc_sema_pass_char_transfer__expr(
-	ofc_sema_expr_t* expr, void* param)
+	ofc_sema_ir_t* ir, ofc_sema_ir_id_t id, void* param)
 {
 	(void)param;
 
-	if (!expr)
-		return false;
-
-	if ((expr->type != OFC_SEMA_EXPR_CAST)
-		|| !ofc_sema_expr_type_is_character(expr->cast.expr)
-		|| ofc_sema_expr_type_is_character(expr))
+	ofc_sema_ir_id_t operand
+		= ofc_sema_ir_child(ir, id, 0);
+	if ((operand == OFC_SEMA_IR_NONE)
+		|| !ofc_sema_type_is_character(ir->type[operand])
+		|| ofc_sema_type_is_character(ir->type[id]))
 		return true;
 
-	const ofc_sema_type_t* type
-		= ofc_sema_expr_type(expr->cast.expr);
-	if (!type) return false;
+	ofc_sema_expr_t* expr = ir->expr[id];
 
-	const ofc_sema_type_t* ctype
-		= ofc_sema_expr_type(expr);
+	const ofc_sema_type_t* type = ir->type[operand];
+	const ofc_sema_type_t* ctype = ir->type[id];
 	if (!ctype) return false;
 
 	ofc_sema_expr_t* mold = NULL;
@@ -48,7 +45,7 @@ static bool ofc_sema_pass_char_transfer__expr(
 		{
 			ofc_sema_typeval_t* tv
 				= ofc_sema_typeval_create_logical(
-					true, ctype->kind, OFC_SPARSE_REF_EMPTY);
+					true, ctype->kind, OFC_SPARSE_LOC_EMPTY);
 			if (tv)
 			{
 				mold = ofc_sema_expr_typeval(tv);
@@ -81,7 +78,7 @@ static bool ofc_sema_pass_char_transfer__expr(
 		{
 			ofc_sema_typeval_t* tv
 				= ofc_sema_typeval_create_real(
-					1.0, ctype->kind, OFC_SPARSE_REF_EMPTY);
+					1.0, ctype->kind, OFC_SPARSE_LOC_EMPTY);
 			if (tv)
 			{
 				mold = ofc_sema_expr_typeval(tv);
@@ -94,7 +91,7 @@ static bool ofc_sema_pass_char_transfer__expr(
 		{
 			ofc_sema_typeval_t* tv
 				= ofc_sema_typeval_create_complex(
-					1.0, 0.0, ctype->kind, OFC_SPARSE_REF_EMPTY);
+					1.0, 0.0, ctype->kind, OFC_SPARSE_LOC_EMPTY);
 			if (tv)
 			{
 				mold = ofc_sema_expr_typeval(tv);
@@ -109,7 +106,7 @@ static bool ofc_sema_pass_char_transfer__expr(
 
 	if (!mold)
 	{
-		ofc_sparse_ref_warning(expr->src,
+		ofc_sparse_loc_warning(expr->src,
 			"No way to convert this string cast to a TRANSFER"
 			", as there's no safe MOLD for destination type");
 		return true;
@@ -201,6 +198,7 @@ static bool ofc_sema_pass_char_transfer__expr(
 	expr->intrinsic = intrinsic;
 	expr->args = args;
 
+	ofc_sema_ir_refresh(ir, id);
 	return true;
 }
 
@@ -212,8 +210,14 @@ static bool ofc_sema_pass_char_transfer__scope(
 	if (!scope)
 		return false;
 
-	return ofc_sema_scope_foreach_expr(
-		scope, NULL, ofc_sema_pass_char_transfer__expr);
+	ofc_sema_ir_t* ir = ofc_sema_ir_create_scope(scope);
+	if (!ir) return false;
+
+	bool success = ofc_sema_ir_foreach_op(
+		ir, OFC_SEMA_EXPR_CAST, NULL,
+		ofc_sema_pass_char_transfer__expr);
+	ofc_sema_ir_delete(ir);
+	return success;
 }
 
 bool ofc_sema_pass_char_transfer(
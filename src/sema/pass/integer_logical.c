@@ -16,16 +16,24 @@
 #include "ofc/sema.h"
 
 static bool ofc_sema_pass_integer_logical__is_logical_cast(
-	ofc_sema_expr_t* expr)
+	const ofc_sema_ir_t* ir, ofc_sema_ir_id_t id)
 {
-	return (expr->type == OFC_SEMA_EXPR_CAST)
-		&& (expr->cast.type->type == OFC_SEMA_TYPE_LOGICAL
-		&& ofc_sema_expr_type_is_integer(expr->cast.expr));
+	if ((id == OFC_SEMA_IR_NONE)
+		|| (ir->op[id] != OFC_SEMA_EXPR_CAST)
+		|| !ir->type[id]
+		|| (ir->type[id]->type != OFC_SEMA_TYPE_LOGICAL))
+		return false;
+
+	ofc_sema_ir_id_t operand
+		= ofc_sema_ir_child(ir, id, 0);
+	return ((operand != OFC_SEMA_IR_NONE)
+		&& ofc_sema_type_is_integer(ir->type[operand]));
 }
 
 static bool ofc_sema_pass_integer_logical__expand(
-	ofc_sema_expr_t* expr)
+	ofc_sema_ir_t* ir, ofc_sema_ir_id_t id)
 {
+	ofc_sema_expr_t* expr = ir->expr[id];
 	ofc_sema_expr_t* a = expr->cast.expr;
 	ofc_sema_expr_t* b = ofc_sema_expr_integer(0, OFC_SEMA_KIND_DEFAULT);
 	/* TODO - Work out side a kind and use the same for side b*/
@@ -36,35 +44,44 @@ static bool ofc_sema_pass_integer_logical__expand(
 	expr->a = a;
 	expr->b = b;
 
+	ofc_sema_ir_refresh(ir, id);
 	return true;
 }
 
 static bool ofc_sema_pass_integer_logical__expr(
-	ofc_sema_expr_t* expr, void* param)
+	ofc_sema_ir_t* ir, ofc_sema_ir_id_t id, void* param)
 {
 	(void)param;
 
-	if (!expr) return false;
-
-	if (expr->type == OFC_SEMA_EXPR_NOT)
+	if (ir->op[id] == OFC_SEMA_EXPR_NOT)
 	{
-		ofc_sema_expr_t* sub_expr = expr->a;
+		ofc_sema_ir_id_t sub_id
+			= ofc_sema_ir_child(ir, id, 0);
 
-		if (ofc_sema_pass_integer_logical__is_logical_cast(sub_expr))
+		if (ofc_sema_pass_integer_logical__is_logical_cast(ir, sub_id))
 		{
-			if (!ofc_sema_pass_integer_logical__expand(sub_expr))
+			if (!ofc_sema_pass_integer_logical__expand(ir, sub_id))
 				return false;
 
+			ofc_sema_expr_t* expr = ir->expr[id];
+			ofc_sema_expr_t* sub_expr = ir->expr[sub_id];
+
+			/* Take the operands rather than copying them. */
 			expr->type = OFC_SEMA_EXPR_EQ;
-			expr->a = ofc_sema_expr_copy(sub_expr->a);
-			expr->b = ofc_sema_expr_copy(sub_expr->b);
+			expr->a = sub_expr->a;
+			expr->b = sub_expr->b;
 
+			sub_expr->a = NULL;
+			sub_expr->b = NULL;
 			ofc_sema_expr_delete(sub_expr);
+
+			ofc_sema_ir_remove(ir, sub_id);
+			ofc_sema_ir_refresh(ir, id);
 		}
 	}
-	else if (ofc_sema_pass_integer_logical__is_logical_cast(expr))
+	else if (ofc_sema_pass_integer_logical__is_logical_cast(ir, id))
 	{
-		if (!ofc_sema_pass_integer_logical__expand(expr))
+		if (!ofc_sema_pass_integer_logical__expand(ir, id))
 			return false;
 	}
 
@@ -78,8 +95,14 @@ static bool ofc_sema_pass_integer_logical__scope(
 
 	if (!scope) return false;
 
-	return ofc_sema_scope_foreach_expr(
-		scope, NULL, ofc_sema_pass_integer_logical__expr);
+	ofc_sema_ir_t* ir = ofc_sema_ir_create_scope(scope);
+	if (!ir) return false;
+
+	/* Visit a NOT before its operand so that it can absorb the cast. */
+	bool success = ofc_sema_ir_foreach_reverse(
+		ir, NULL, ofc_sema_pass_integer_logical__expr);
+	ofc_sema_ir_delete(ir);
+	return success;
 }
 
 bool ofc_sema_pass_integer_logical(
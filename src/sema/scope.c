@@ -43,6 +43,8 @@ void ofc_sema_scope_delete(
 
 	ofc_sema_module_list_delete(scope->module);
 
+	ofc_sema_name_index_delete(scope->names);
+
 	switch (scope->type)
 	{
 		case OFC_SEMA_SCOPE_SUPER:
@@ -63,6 +65,18 @@ void ofc_sema_scope_delete(
 	free(scope);
 }
 
+static ofc_sema_name_index_t* ofc_sema_scope__names(
+	const ofc_sema_scope_t* scope)
+{
+	for (; scope; scope = scope->parent)
+	{
+		if (scope->names)
+			return scope->names;
+	}
+
+	return NULL;
+}
+
 static bool ofc_sema_scope__add_child(
 	ofc_sema_scope_t* scope,
 	ofc_sema_scope_t* child)
@@ -80,8 +94,14 @@ static bool ofc_sema_scope__add_child(
 		if (!scope->child) return false;
 	}
 
-	return ofc_sema_scope_list_add(
-		scope->child, child);
+	if (!ofc_sema_scope_list_add(
+		scope->child, child))
+		return false;
+
+	return (ofc_str_ref_empty(child->name)
+		|| ofc_sema_name_index_add_unit(
+			ofc_sema_scope__names(scope),
+			child->name, scope));
 }
 
 
@@ -95,7 +115,7 @@ static ofc_sema_scope_t* ofc_sema_scope__create(
 	if (!scope) return NULL;
 
 	scope->file = NULL;
-	scope->src  = OFC_SPARSE_REF_EMPTY;
+	scope->src  = OFC_SPARSE_LOC_EMPTY;
 
 	scope->parent = parent;
 	scope->child  = NULL;
@@ -122,6 +142,18 @@ static ofc_sema_scope_t* ofc_sema_scope__create(
 
 	scope->label = NULL;
 
+	scope->names = NULL;
+	if ((scope->type == OFC_SEMA_SCOPE_SUPER)
+		|| (scope->type == OFC_SEMA_SCOPE_GLOBAL))
+	{
+		scope->names = ofc_sema_name_index_create();
+		if (!scope->names)
+		{
+			free(scope);
+			return NULL;
+		}
+	}
+
 	if (scope->type == OFC_SEMA_SCOPE_SUPER)
 		return scope;
 
@@ -199,7 +231,7 @@ static bool ofc_sema_scope__body_label_resolve(
 		if (!ofc_sema_expr_resolve_uint(
 			expr, &ulabel))
 		{
-			ofc_sparse_ref_error(expr->src,
+			ofc_sparse_loc_error(expr->src,
 				"Invalid label constant");
 			return false;
 		}
@@ -209,7 +241,7 @@ static bool ofc_sema_scope__body_label_resolve(
 				scope, ulabel);
 		if (!label)
 		{
-			ofc_sparse_ref_error(expr->src,
+			ofc_sparse_loc_error(expr->src,
 				"Label does not exist in current scope");
 			return false;
 		}
@@ -218,7 +250,7 @@ static bool ofc_sema_scope__body_label_resolve(
 			&& label->stmt && !expr->is_format
 			&& (label->stmt->type == OFC_SEMA_STMT_IO_FORMAT))
 		{
-			ofc_sparse_ref_warning(expr->src,
+			ofc_sparse_loc_warning(expr->src,
 				"Jumping to a FORMAT statement");
 		}
 
@@ -392,6 +424,10 @@ bool ofc_sema_scope__body_decl_finalize(
 	return ofc_sema_decl_type_finalize(decl);
 }
 
+static bool ofc_sema_scope__body_finish(
+	ofc_sema_scope_t* scope,
+	const ofc_parse_stmt_list_t* body);
+
 static bool ofc_sema_scope__body(
 	ofc_sema_scope_t* scope,
 	const ofc_parse_stmt_list_t* body)
@@ -409,6 +445,15 @@ static bool ofc_sema_scope__body(
 	if (!scope->stmt)
 		return false;
 
+	return ofc_sema_scope__body_finish(scope, body);
+}
+
+/* Completes a scope once all of its statements have been analysed,
+   EQUIVALENCE statements are handled here when body is given. */
+static bool ofc_sema_scope__body_finish(
+	ofc_sema_scope_t* scope,
+	const ofc_parse_stmt_list_t* body)
+{
 	/* Finalize declarations. */
 	if (!ofc_sema_scope_foreach_decl(scope, NULL,
 		(void*)ofc_sema_scope__body_decl_finalize))
@@ -432,7 +477,7 @@ static bool ofc_sema_scope__body(
 			if (!label->used)
 			{
 				/* TODO - Get position of actual label. */
-				ofc_sparse_ref_warning(ofc_sema_label_src(label),
+				ofc_sparse_loc_warning(ofc_sema_label_src(label),
 					"Label %u is defined but not used", label->number);
 			}
 		}
@@ -468,7 +513,7 @@ static bool ofc_sema_scope__body(
 	}
 
 	/* Handle EQUIVALENCE statements */
-	if (!ofc_parse_stmt_list_foreach(body, scope,
+	if (body && !ofc_parse_stmt_list_foreach(body, scope,
 		(void*)ofc_sema_scope__body_sema_equivalence))
 		return false;
 
@@ -482,10 +527,15 @@ bool ofc_sema_scope__check_namespace_collision(
 	if (!scope)
 		return false;
 
+	const ofc_sema_name_t* entry
+		= ofc_sema_name_index_find_create(
+			ofc_sema_scope__names(scope), ref.string);
+	if (!entry) return false;
+
 	bool collision = false;
 
 	if ((!global_opts.no_warn_name_keyword)
-		&& ofc_str_ref_begins_with_keyword(ref.string))
+		&& entry->keyword)
 	{
 		ofc_sparse_ref_warning(ref,
 			"Symbol name begins with langauge keyword");
@@ -503,7 +553,7 @@ bool ofc_sema_scope__check_namespace_collision(
 		collision = true;
 	}
 
-	if (ofc_sema_scope_block_data_name_exists(scope, ref.string))
+	if (scope->child && ofc_sema_name_is_unit(entry, scope))
 	{
 		if (!global_opts.no_warn_namespace_col)
 		{
@@ -539,9 +589,7 @@ bool ofc_sema_scope__check_namespace_collision(
 		collision = true;
 	}
 
-	char* name_str = strndup(ref.string.base, ref.string.size);
-
-	if (ofc_sema_intrinsic_name_reserved(name_str))
+	if (entry->reserved)
 	{
 		if (!global_opts.no_warn_namespace_col)
 		{
@@ -553,7 +601,6 @@ bool ofc_sema_scope__check_namespace_collision(
 		collision = true;
 	}
 
-	free (name_str);
 	return collision;
 }
 
@@ -576,7 +623,7 @@ bool ofc_sema_scope_subroutine(
 
 	if (!ofc_sema_decl_subroutine(decl))
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"Can't redefine declaration as SUBROUTINE");
 		return false;
 	}
@@ -729,7 +776,7 @@ bool ofc_sema_scope_function(
 
 	if (!ofc_sema_decl_type_finalize(rdecl))
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"No IMPLICIT type matches FUNCTION name");
 		ofc_sema_scope_delete(func_scope);
 		return false;
@@ -747,7 +794,7 @@ bool ofc_sema_scope_function(
 	if (!ofc_sema_decl_type_set(
 		fdecl, rdecl->type, name))
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"Conflicting definitions of FUNCTION return type");
 		ofc_sema_scope_delete(func_scope);
 		return false;
@@ -755,7 +802,7 @@ bool ofc_sema_scope_function(
 
 	if (!ofc_sema_decl_function(fdecl))
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"Can't redeclare used variable as FUNCTION");
 		ofc_sema_scope_delete(func_scope);
 		return false;
@@ -811,7 +858,7 @@ ofc_sema_scope_t* ofc_sema_scope_global(
 		}
 		else if (list->stmt[list->count - 1])
 		{
-			ofc_sparse_ref_bridge(
+			ofc_sparse_loc_bridge(
 				list->stmt[0]->src,
 				list->stmt[list->count - 1]->src,
 				&scope->src);
@@ -822,6 +869,81 @@ ofc_sema_scope_t* ofc_sema_scope_global(
 	return scope;
 }
 
+ofc_sema_scope_t* ofc_sema_scope_global_stream(
+	ofc_sema_scope_t* super,
+	ofc_parse_file_t* file)
+{
+	if (!file)
+		return NULL;
+
+	ofc_sema_scope_t* scope
+		= ofc_sema_scope__create(
+			super, OFC_SEMA_SCOPE_GLOBAL);
+	if (!scope) return NULL;
+
+	scope->stmt = ofc_sema_stmt_list_create();
+	if (!scope->stmt
+		|| (super && !ofc_sema_scope__add_child(super, scope)))
+	{
+		ofc_sema_scope_delete(scope);
+		return NULL;
+	}
+
+	scope->file = file;
+	return scope;
+}
+
+bool ofc_sema_scope_global_add(
+	ofc_sema_scope_t* scope,
+	const ofc_parse_stmt_t* stmt,
+	ofc_sema_scope_t** unit)
+{
+	if (!scope || !stmt || !scope->stmt
+		|| (scope->type != OFC_SEMA_SCOPE_GLOBAL))
+		return false;
+
+	unsigned child_count = (scope->child
+		? scope->child->count : 0);
+
+	ofc_parse_stmt_t* pstmt = (ofc_parse_stmt_t*)stmt;
+	ofc_parse_stmt_list_t body = { 1, 1, &pstmt };
+	if (!ofc_sema_stmt_list_append(
+		scope, NULL, scope->stmt, &body)
+		|| !ofc_sema_scope__body_sema_equivalence(stmt, scope))
+		return false;
+
+	/* Units are either children or the procedure of a declaration. */
+	ofc_sema_scope_t* uscope = NULL;
+	if (scope->child && (scope->child->count > child_count))
+	{
+		uscope = scope->child->scope[scope->child->count - 1];
+	}
+	else if ((stmt->type == OFC_PARSE_STMT_SUBROUTINE)
+		|| (stmt->type == OFC_PARSE_STMT_FUNCTION))
+	{
+		const ofc_sema_decl_t* decl
+			= ofc_sema_scope_decl_find(
+				scope, stmt->program.name.string, true);
+		if (decl) uscope = decl->func;
+	}
+
+	if (ofc_sparse_loc_empty(scope->src))
+		scope->src = stmt->src;
+	else
+		ofc_sparse_loc_bridge(scope->src, stmt->src, &scope->src);
+
+	if (unit) *unit = uscope;
+	return true;
+}
+
+bool ofc_sema_scope_global_end(
+	ofc_sema_scope_t* scope)
+{
+	if (!scope || (scope->type != OFC_SEMA_SCOPE_GLOBAL))
+		return false;
+	return ofc_sema_scope__body_finish(scope, NULL);
+}
+
 ofc_sema_scope_t* ofc_sema_scope_program(
 	ofc_sema_scope_t* scope,
 	const ofc_parse_stmt_t* stmt)
@@ -916,7 +1038,7 @@ ofc_sema_scope_t* ofc_sema_scope_stmt_func(
 	}
 	if (!rdecl || !rdecl->type)
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"No IMPLICIT rule matches statement function name");
 		ofc_sema_scope_delete(func);
 		return NULL;
@@ -1068,11 +1190,10 @@ bool ofc_sema_scope_block_data_name_exists(
 	if (!scope || !scope->child)
 		return false;
 
-	ofc_sema_scope_t* block_data
-		= ofc_sema_scope_list_find_name(
-			scope->child, name);
-
-	return (block_data != NULL);
+	return ofc_sema_name_is_unit(
+		ofc_sema_name_index_find(
+			ofc_sema_scope__names(scope), name),
+		scope);
 }
 
 ofc_sema_scope_t* ofc_sema_scope_block_data(
@@ -1085,7 +1206,7 @@ ofc_sema_scope_t* ofc_sema_scope_block_data(
 
 	if (stmt->program.end_has_label)
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"END BLOCK DATA can't have label");
 		return NULL;
 	}
@@ -1106,7 +1227,7 @@ ofc_sema_scope_t* ofc_sema_scope_block_data(
 	}
 
 	ofc_sema_scope__check_namespace_collision(
-		scope, "Block Data", stmt->src);
+		scope, "Block Data", ofc_sparse_loc_ref(stmt->src));
 
 	if (!ofc_sema_scope__add_child(scope, block_data))
 	{
@@ -1690,27 +1811,32 @@ bool ofc_sema_scope_print(
 	return true;
 }
 
-ofc_sema_scope_t* ofc_sema_scope_list_find_name(
-	ofc_sema_scope_list_t* list,
-	ofc_str_ref_t name)
+bool ofc_sema_scope_unit_print(
+	ofc_colstr_t* cs, unsigned indent,
+	const ofc_sema_scope_t* scope)
 {
-    if (!list)
-		return NULL;
+	if (!scope)
+		return false;
 
-	unsigned i;
-	for (i = 0; i < list->count; i++)
+	switch (scope->type)
 	{
-		/* TODO - Handle case sensitivity flag */
+		/* Procedures are printed through their declaration,
+		   which provides a FUNCTION's return type. */
+		case OFC_SEMA_SCOPE_SUBROUTINE:
+		case OFC_SEMA_SCOPE_FUNCTION:
+			return ofc_sema_decl_procedure_print(cs, indent,
+				ofc_sema_scope_decl_find(scope->parent, scope->name, true));
 
-        if (ofc_str_ref_equal_ci(
-			list->scope[i]->name, name))
-				return list->scope[i];
+		default:
+			break;
 	}
 
-	return NULL;
+	return ofc_sema_scope_print(cs, indent, scope);
 }
 
-static ofc_sema_scope_t* ofc_sema_scope_list__find_type_name(
+/* Finds the first scope named name, of any type if type is
+   OFC_SEMA_SCOPE_COUNT, using the atom index where possible. */
+static ofc_sema_scope_t* ofc_sema_scope_list__find(
 	ofc_sema_scope_list_t* list,
 	ofc_sema_scope_e type,
 	ofc_str_ref_t name)
@@ -1718,17 +1844,59 @@ static ofc_sema_scope_t* ofc_sema_scope_list__find_type_name(
 	if (!list)
 		return NULL;
 
-	unsigned i;
-	for (i = 0; i < list->count; i++)
+	if ((name.atom == OFC_ATOM_NONE)
+		|| !list->map)
 	{
-		if (ofc_str_ref_equal_ci(list->scope[i]->name, name)
-			&& (list->scope[i]->type == type))
-				return list->scope[i];
+		unsigned i;
+		for (i = 0; i < list->count; i++)
+		{
+			ofc_sema_scope_t* scope = list->scope[i];
+			if (((type == OFC_SEMA_SCOPE_COUNT)
+				|| (scope->type == type))
+				&& (global_opts.case_sensitive
+					? ofc_str_ref_equal(scope->name, name)
+					: ofc_str_ref_equal_ci(scope->name, name)))
+				return scope;
+		}
+		return NULL;
+	}
+
+	/* Atoms ignore case, so names which only differ in case share
+	   an atom and need comparing when we're case sensitive. */
+
+	unsigned mask = (list->map_size - 1);
+	unsigned m = ((name.atom * 2654435761U) & mask);
+	for (; list->map[m] != 0; m = ((m + 1) & mask))
+	{
+		ofc_sema_scope_t* scope
+			= list->scope[list->map[m] - 1];
+		if ((scope->name.atom == name.atom)
+			&& ((type == OFC_SEMA_SCOPE_COUNT)
+				|| (scope->type == type))
+			&& (!global_opts.case_sensitive
+				|| ofc_str_ref_equal(scope->name, name)))
+			return scope;
 	}
 
 	return NULL;
 }
 
+ofc_sema_scope_t* ofc_sema_scope_list_find_name(
+	ofc_sema_scope_list_t* list,
+	ofc_str_ref_t name)
+{
+	return ofc_sema_scope_list__find(
+		list, OFC_SEMA_SCOPE_COUNT, name);
+}
+
+static ofc_sema_scope_t* ofc_sema_scope_list__find_type_name(
+	ofc_sema_scope_list_t* list,
+	ofc_sema_scope_e type,
+	ofc_str_ref_t name)
+{
+	return ofc_sema_scope_list__find(
+		list, type, name);
+}
 
 ofc_sema_scope_t* ofc_sema_scope_find_type_name(
 	ofc_sema_scope_t* scope,
@@ -1781,22 +1949,62 @@ ofc_sema_scope_list_t* ofc_sema_scope_list_create(void)
 	list->scope = NULL;
 	list->count = 0;
 
+	list->map_size = 0;
+	list->map      = NULL;
+
 	return list;
 }
 
+static void ofc_sema_scope_list__map_insert(
+	ofc_sema_scope_list_t* list, unsigned index)
+{
+	ofc_atom_t atom = list->scope[index]->name.atom;
+	if (atom == OFC_ATOM_NONE)
+		return;
+
+	unsigned mask = (list->map_size - 1);
+	unsigned m = ((atom * 2654435761U) & mask);
+	while (list->map[m] != 0)
+		m = ((m + 1) & mask);
+	list->map[m] = (index + 1);
+}
+
 bool ofc_sema_scope_list_add(
 	ofc_sema_scope_list_t* list,
 	ofc_sema_scope_t* scope)
 {
 	if (!list || !scope) return false;
 
+	/* Names are interned here so lookups can use the atom index. */
+	if ((scope->name.atom == OFC_ATOM_NONE)
+		&& (scope->name.size > 0))
+		scope->name.atom = ofc_str_ref_atom(scope->name);
+
+	if (((list->count + 1) * 2) > list->map_size)
+	{
+		unsigned size = (list->map_size > 0
+			? (list->map_size * 2) : 16);
+		unsigned* map = (unsigned*)calloc(size, sizeof(unsigned));
+		if (!map) return false;
+
+		free(list->map);
+		list->map      = map;
+		list->map_size = size;
+
+		unsigned i;
+		for (i = 0; i < list->count; i++)
+			ofc_sema_scope_list__map_insert(list, i);
+	}
+
 	ofc_sema_scope_t** nscope
 		= (ofc_sema_scope_t**)realloc(list->scope,
 			(sizeof(ofc_sema_scope_t*) * (list->count + 1)));
 	if (!nscope) return false;
 	list->scope = nscope;
 
-	list->scope[list->count++] = scope;
+	list->scope[list->count] = scope;
+	ofc_sema_scope_list__map_insert(list, list->count);
+	list->count++;
 	return true;
 }
 
@@ -1827,6 +2035,7 @@ void ofc_sema_scope_list_delete(
 	for (i = 0; i < list->count; i++)
 		ofc_sema_scope_delete(list->scope[i]);
 
+	free(list->map);
 	free(list->scope);
 	free(list);
 }
@@ -1870,6 +2079,32 @@ bool ofc_sema_scope_foreach_scope(
 	return func(scope, param);
 }
 
+static bool ofc_sema_scope_release_stmt__scope(
+	ofc_sema_scope_t* scope, void* param)
+{
+	(void)param;
+
+	if (!scope)
+		return false;
+
+	/* Statement function scopes hold an expression instead. */
+	if (scope->type == OFC_SEMA_SCOPE_STMT_FUNC)
+		return true;
+
+	ofc_sema_label_map_delete(scope->label);
+	scope->label = NULL;
+	ofc_sema_stmt_list_delete(scope->stmt);
+	scope->stmt = NULL;
+	return true;
+}
+
+bool ofc_sema_scope_release_stmt(
+	ofc_sema_scope_t* scope)
+{
+	return ofc_sema_scope_foreach_scope(
+		scope, NULL, ofc_sema_scope_release_stmt__scope);
+}
+
 bool ofc_sema_scope_foreach_decl(
 	ofc_sema_scope_t* scope, void* param,
 	bool (*func)(ofc_sema_decl_t* decl, void* param))
@@ -1993,9 +2228,99 @@ static bool ofc_sema_scope_common_usage_print__scope(
 void ofc_sema_scope_common_usage_print(
 	const ofc_sema_scope_t* scope)
 {
-	ofc_sema_scope_common_usage_print__scope(
-		(ofc_sema_scope_t*)scope, NULL);
 	ofc_sema_scope_foreach_scope(
 		(ofc_sema_scope_t*)scope, NULL,
 		ofc_sema_scope_common_usage_print__scope);
 }
+
+static bool ofc_sema_scope_storage_print__scope(
+	ofc_sema_scope_t* scope, void* param)
+{
+	(void)param;
+
+	if (!scope)
+		return false;
+
+	if ((!scope->common || (scope->common->count == 0))
+		&& (!scope->equiv || (scope->equiv->count == 0)))
+		return true;
+
+	ofc_sema_storage_t* storage
+		= ofc_sema_storage_create(scope);
+	if (!storage) return false;
+
+	printf("%.*s:\n", scope->name.size, scope->name.base);
+	bool success = ofc_sema_storage_print(storage);
+	ofc_sema_storage_delete(storage);
+	return success;
+}
+
+bool ofc_sema_scope_storage_print(
+	const ofc_sema_scope_t* scope)
+{
+	return ofc_sema_scope_foreach_scope(
+		(ofc_sema_scope_t*)scope, NULL,
+		ofc_sema_scope_storage_print__scope);
+}
+
+static bool ofc_sema_scope_cfg_print__scope(
+	ofc_sema_scope_t* scope, void* param)
+{
+	(void)param;
+
+	if (!scope)
+		return false;
+
+	switch (scope->type)
+	{
+		case OFC_SEMA_SCOPE_GLOBAL:
+		case OFC_SEMA_SCOPE_PROGRAM:
+		case OFC_SEMA_SCOPE_SUBROUTINE:
+		case OFC_SEMA_SCOPE_FUNCTION:
+			break;
+		default:
+			return true;
+	}
+
+	if (ofc_sema_stmt_list_count(scope->stmt) == 0)
+		return true;
+
+	ofc_sema_cfg_t* cfg
+		= ofc_sema_cfg_create(scope);
+	if (!cfg) return false;
+
+	printf("%.*s:\n", scope->name.size, scope->name.base);
+	bool success = ofc_sema_cfg_print(cfg);
+	ofc_sema_cfg_delete(cfg);
+	return success;
+}
+
+bool ofc_sema_scope_cfg_print(
+	const ofc_sema_scope_t* scope)
+{
+	return ofc_sema_scope_foreach_scope(
+		(ofc_sema_scope_t*)scope, NULL,
+		ofc_sema_scope_cfg_print__scope);
+}
+
+static bool ofc_sema_scope_dataflow_warn__scope(
+	ofc_sema_scope_t* scope, void* param)
+{
+	(void)param;
+
+	if (!scope)
+		return false;
+
+	if (ofc_sema_stmt_list_count(scope->stmt) == 0)
+		return true;
+
+	return ofc_sema_dataflow_warn(scope);
+}
+
+bool ofc_sema_scope_dataflow_warn(
+	const ofc_sema_scope_t* scope)
+{
+	return ofc_sema_scope_foreach_scope(
+		(ofc_sema_scope_t*)scope, NULL,
+		ofc_sema_scope_dataflow_warn__scope);
+}
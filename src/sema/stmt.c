@@ -206,12 +206,12 @@ ofc_sema_stmt_t* ofc_sema_stmt(
 			break;
 
 		case OFC_PARSE_STMT_SEQUENCE:
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"SEQUENCE only valid inside TYPE");
 			break;
 
 		default:
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"Unsuported statement");
 			break;
 	}
@@ -239,6 +239,8 @@ void ofc_sema_stmt_delete(
 				stmt->assign.label);
 			break;
 		case OFC_SEMA_STMT_IO_FORMAT:
+			ofc_sema_format_release(
+				stmt->io_format.intern);
 			ofc_parse_format_desc_list_delete(
 				stmt->io_format.format);
 			break;
@@ -616,7 +618,7 @@ static bool ofc_sema_stmt_list__entry(
 
 		case OFC_PARSE_STMT_NAMELIST:
 		case OFC_PARSE_STMT_POINTER:
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"Unsupported statement");
 			/* TODO - Support these statements. */
 			return false;
@@ -632,7 +634,7 @@ static bool ofc_sema_stmt_list__entry(
 	{
 		case OFC_SEMA_SCOPE_GLOBAL:
 		case OFC_SEMA_SCOPE_BLOCK_DATA:
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"Unexpected executable statement in scope.");
 			return false;
 		default:
@@ -644,7 +646,7 @@ static bool ofc_sema_stmt_list__entry(
 		if (ofc_sema_label_map_find(
 			scope->label, stmt->label))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"Duplicate label definition");
 			return false;
 		}
@@ -660,7 +662,7 @@ static bool ofc_sema_stmt_list__entry(
 	if ((s->type == OFC_SEMA_STMT_CONTINUE)
 		&& (stmt->label == 0))
 	{
-		ofc_sparse_ref_warning(stmt->src,
+		ofc_sparse_loc_warning(stmt->src,
 			"Unlabelled CONTINUE statement has no effect");
 	}
 
@@ -681,32 +683,28 @@ static bool ofc_sema_stmt_list__entry(
 	return true;
 }
 
-ofc_sema_stmt_list_t* ofc_sema_stmt_list(
+bool ofc_sema_stmt_list_append(
 	ofc_sema_scope_t* scope,
 	ofc_sema_stmt_t*  block,
+	ofc_sema_stmt_list_t* list,
 	const ofc_parse_stmt_list_t* body)
 {
-	if (!body)
-		return NULL;
+	if (!list || !body)
+		return false;
 
-	ofc_sema_stmt_list_t* list
-		= ofc_sema_stmt_list_create();;
-	if (!list) return NULL;
+	unsigned base = list->count;
 
 	unsigned i;
 	for (i = 0; i < body->count; i++)
 	{
 		if (!ofc_sema_stmt_list__entry(
 			scope, list, body->stmt[i]))
-		{
-			ofc_sema_stmt_list_delete(list);
-			return NULL;
-		}
+			return false;
 	}
 
 	/* Add labels from non-executable statements. */
 	unsigned j;
-	for (i = 0, j = 0; i < body->count; i++)
+	for (i = 0, j = base; i < body->count; i++)
 	{
 		const ofc_parse_stmt_t* stmt
 			= body->stmt[i];
@@ -740,15 +738,34 @@ ofc_sema_stmt_list_t* ofc_sema_stmt_list(
 		}
 
 		if (!success)
-		{
-			ofc_sema_stmt_list_delete(list);
-			return NULL;
-		}
+			return false;
 
-		ofc_sparse_ref_warning(stmt->src,
+		ofc_sparse_loc_warning(stmt->src,
 			"Label %u points to non-executable statement", stmt->label);
 	}
 
+	return true;
+}
+
+ofc_sema_stmt_list_t* ofc_sema_stmt_list(
+	ofc_sema_scope_t* scope,
+	ofc_sema_stmt_t*  block,
+	const ofc_parse_stmt_list_t* body)
+{
+	if (!body)
+		return NULL;
+
+	ofc_sema_stmt_list_t* list
+		= ofc_sema_stmt_list_create();;
+	if (!list) return NULL;
+
+	if (!ofc_sema_stmt_list_append(
+		scope, block, list, body))
+	{
+		ofc_sema_stmt_list_delete(list);
+		return NULL;
+	}
+
 	return list;
 }
 
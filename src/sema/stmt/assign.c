@@ -41,7 +41,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_assign(
 		if (!ofc_sema_decl_type_set(
 			dest, ptype, stmt->assign.variable))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"ASSIGN destination must be of type INTEGER.");
 			return NULL;
 		}
@@ -108,7 +108,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_assignment(
 		{
 			const ofc_sema_type_t* expr_type =
 				ofc_sema_expr_type(s.assignment.expr);
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"Expression type %s doesn't match lhs type %s",
 				ofc_sema_type_str_rep(expr_type),
 				ofc_sema_type_str_rep(dtype));
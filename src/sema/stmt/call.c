@@ -34,7 +34,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_call(
 	if (!ofc_sema_decl_is_subroutine(subroutine)
 		&& !ofc_sema_decl_subroutine(subroutine))
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"CALL target must be a valid SUBROUTINE");
 		return NULL;
 	}
@@ -63,7 +63,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_call(
 
 			if (!ofc_sparse_ref_empty(arg->name))
 			{
-				ofc_sparse_ref_error(stmt->src,
+				ofc_sparse_loc_error(stmt->src,
 					"CALL arguments musn't be named");
 				ofc_sema_expr_list_delete(s.call.args);
 				return NULL;
@@ -75,7 +75,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_call(
 				case OFC_PARSE_CALL_ARG_RETURN:
 					break;
 				default:
-					ofc_sparse_ref_error(stmt->src,
+					ofc_sparse_loc_error(stmt->src,
 						"CALL arguments must be an expression or return label");
 					ofc_sema_expr_list_delete(s.call.args);
 					return NULL;
@@ -35,93 +35,25 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_close(
 
 	ofc_sema_stmt_t s;
 	s.type = OFC_SEMA_STMT_IO_CLOSE;
-	s.io_close.unit   = NULL;
-	s.io_close.iostat = NULL;
-	s.io_close.err    = NULL;
-	s.io_close.status = NULL;
-
-	ofc_parse_call_arg_t* ca_unit   = NULL;
-	ofc_parse_call_arg_t* ca_iostat = NULL;
-	ofc_parse_call_arg_t* ca_err    = NULL;
-	ofc_parse_call_arg_t* ca_status = NULL;
-
-	unsigned i;
-	for (i = 0; i < stmt->io.params->count; i++)
-	{
-		ofc_parse_call_arg_t* param
-			= stmt->io.params->call_arg[i];
-		if (!param) continue;
-
-		if (ofc_sparse_ref_empty(param->name))
-		{
-			if (i >= 1)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Un-named parameter %u has no meaning in CLOSE.", i);
-				return NULL;
-			}
-
-			if (i == 0)
-			{
-				ca_unit = param;
-			}
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "UNIT"))
-		{
-			if (ca_unit)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of UNIT in CLOSE.");
-				return NULL;
-			}
-
-			ca_unit = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "IOSTAT"))
-		{
-			if (ca_iostat)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of IOSTAT in CLOSE.");
-				return NULL;
-			}
-
-			ca_iostat = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "ERR"))
-		{
-			if (ca_err)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of ERR in CLOSE.");
-				return NULL;
-			}
-
-			ca_err = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "STATUS"))
-		{
-			if (ca_status)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of STATUS in CLOSE.");
-				return NULL;
-			}
+	s.io_close.unit        = NULL;
+	s.io_close.iostat      = NULL;
+	s.io_close.err         = NULL;
+	s.io_close.status      = NULL;
+	s.io_close.status_type = OFC_SEMA_CALL_ARG_RUNTIME;
+
+	const ofc_parse_call_arg_t* ca[OFC_SEMA_IO_SPEC_COUNT];
+	if (!ofc_sema_io_spec_resolve(
+		OFC_SEMA_IO_STMT_CLOSE, stmt->io.params, ca))
+		return NULL;
 
-			ca_status = param;
-		}
-		else
-		{
-			ofc_sparse_ref_error(param->src,
-				"Unrecognized paramater %u name '%.*s' in CLOSE.",
-				i, param->name.string.size, param->name.string.base);
-			return NULL;
-		}
-	}
+	const ofc_parse_call_arg_t* ca_unit   = ca[OFC_SEMA_IO_SPEC_UNIT];
+	const ofc_parse_call_arg_t* ca_iostat = ca[OFC_SEMA_IO_SPEC_IOSTAT];
+	const ofc_parse_call_arg_t* ca_err    = ca[OFC_SEMA_IO_SPEC_ERR];
+	const ofc_parse_call_arg_t* ca_status = ca[OFC_SEMA_IO_SPEC_STATUS];
 
 	if (!ca_unit)
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"No UNIT defined in CLOSE.");
 		return NULL;
 	}
@@ -142,7 +74,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_close(
 
 		if (!ofc_sema_type_is_integer(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"UNIT must be of type INTEGER in CLOSE");
 			ofc_sema_stmt_io_close__cleanup(s);
 			return NULL;
@@ -150,7 +82,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_close(
 
 		if (!ofc_sema_expr_validate_uint(s.io_close.unit))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"UNIT must be a positive INTEGER in CLOSE");
 			ofc_sema_stmt_io_close__cleanup(s);
 			return NULL;
@@ -158,7 +90,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_close(
 	}
 	else
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"UNIT must be an INTEGER expression in CLOSE");
 		return NULL;
 	}
@@ -175,7 +107,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_close(
 
 		if (s.io_close.iostat->type != OFC_SEMA_EXPR_LHS)
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"IOSTAT must be of a variable in CLOSE");
 			ofc_sema_stmt_io_close__cleanup(s);
 			return NULL;
@@ -191,7 +123,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_close(
 
 		if (!ofc_sema_type_is_integer(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"IOSTAT must be of type INTEGER in CLOSE");
 			ofc_sema_stmt_io_close__cleanup(s);
 			return NULL;
@@ -220,36 +152,13 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_close(
 			return NULL;
 		}
 
-		const ofc_sema_type_t* etype
-			= ofc_sema_expr_type(s.io_close.status);
-		if (!etype)
-		{
-			ofc_sema_stmt_io_close__cleanup(s);
-			return NULL;
-		}
-
-		if (etype->type != OFC_SEMA_TYPE_CHARACTER)
+		if (!ofc_sema_io_spec_value(
+			OFC_SEMA_IO_STMT_CLOSE, OFC_SEMA_IO_SPEC_STATUS,
+			stmt->src, s.io_close.status, &s.io_close.status_type))
 		{
-			ofc_sparse_ref_error(stmt->src,
-				"STATUS must be a CHARACTER expression in CLOSE");
 			ofc_sema_stmt_io_close__cleanup(s);
 			return NULL;
 		}
-		else
-		{
-			const ofc_sema_typeval_t* constant
-				= ofc_sema_expr_constant(s.io_close.status);
-
-			if (constant
-				&& !ofc_typeval_character_equal_strz_ci(constant, "DELETE")
-				&& !ofc_typeval_character_equal_strz_ci(constant, "KEEP"))
-			{
-				ofc_sparse_ref_error(stmt->src,
-					"STATUS must be DELETE/KEEP in CLOSE");
-				ofc_sema_stmt_io_close__cleanup(s);
-				return NULL;
-			}
-		}
 	}
 
 	ofc_sema_stmt_t* as
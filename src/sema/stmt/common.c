@@ -57,7 +57,7 @@ bool ofc_sema_stmt_common(
 					scope, lhs->array.index);
 				if (!array)
 				{
-					ofc_sparse_ref_error(lhs->src,
+					ofc_sparse_loc_error(lhs->src,
 						"Invalid array index in COMMON list");
 					return false;
 				}
@@ -72,7 +72,7 @@ bool ofc_sema_stmt_common(
 
 			if (lhs->type != OFC_PARSE_LHS_VARIABLE)
 			{
-				ofc_sparse_ref_error(lhs->src,
+				ofc_sparse_loc_error(lhs->src,
 					"Invalid entry in COMMON list");
 				ofc_sema_array_delete(array);
 				return false;
@@ -90,7 +90,7 @@ bool ofc_sema_stmt_common(
 			if (decl->common
 				&& (decl->common != common))
 			{
-				ofc_sparse_ref_error(lhs->src,
+				ofc_sparse_loc_error(lhs->src,
 					"Declaration used in multiple COMMON blocks");
 				ofc_sema_array_delete(array);
 				return false;
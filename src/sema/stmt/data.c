@@ -38,12 +38,12 @@ static bool ofc_sema_stmt__data(
 
 	if (expr_count < lhs_count)
 	{
-		ofc_sparse_ref_warning(nlist->lhs[0]->src,
+		ofc_sparse_loc_warning(nlist->lhs[0]->src,
 			"Not enough initializer elements in DATA statement");
 	}
 	else if (expr_count > lhs_count)
 	{
-		ofc_sparse_ref_warning(clist->expr[0]->src,
+		ofc_sparse_loc_warning(clist->expr[0]->src,
 			"Too many initializer elements in DATA statement, ignoring excess");
 	}
 
@@ -38,14 +38,14 @@ bool ofc_sema_stmt_decl_attr(
 			case OFC_PARSE_STMT_DECL_ATTR_AUTOMATIC:
 				if (decl->is_static)
 				{
-					ofc_sparse_ref_error(stmt->src,
+					ofc_sparse_loc_error(stmt->src,
 						"Specifying '%.*s' as STATIC and AUTOMATIC",
 						decl_name.string.size, decl_name.string.base);
 					return false;
 				}
 				if (decl->is_automatic)
 				{
-					ofc_sparse_ref_warning(stmt->src,
+					ofc_sparse_loc_warning(stmt->src,
 						"Re-declaring '%.*s' as AUTOMATIC",
 						decl_name.string.size, decl_name.string.base);
 				}
@@ -54,14 +54,14 @@ bool ofc_sema_stmt_decl_attr(
 			case OFC_PARSE_STMT_DECL_ATTR_STATIC:
 				if (decl->is_automatic)
 				{
-					ofc_sparse_ref_error(stmt->src,
+					ofc_sparse_loc_error(stmt->src,
 						"Specifying '%.*s' as AUTOMATIC and STATIC",
 						decl_name.string.size, decl_name.string.base);
 					return false;
 				}
 				if (decl->is_static)
 				{
-					ofc_sparse_ref_warning(stmt->src,
+					ofc_sparse_loc_warning(stmt->src,
 						"Re-declaring '%.*s' as STATIC",
 						decl_name.string.size, decl_name.string.base);
 				}
@@ -70,7 +70,7 @@ bool ofc_sema_stmt_decl_attr(
 			case OFC_PARSE_STMT_DECL_ATTR_VOLATILE:
 				if (decl->is_volatile)
 				{
-					ofc_sparse_ref_warning(stmt->src,
+					ofc_sparse_loc_warning(stmt->src,
 						"Re-declaring '%.*s' as VOLATILE",
 						decl_name.string.size, decl_name.string.base);
 				}
@@ -79,14 +79,14 @@ bool ofc_sema_stmt_decl_attr(
 			case OFC_PARSE_STMT_DECL_ATTR_EXTERNAL:
 				if (decl->is_intrinsic)
 				{
-					ofc_sparse_ref_error(stmt->src,
+					ofc_sparse_loc_error(stmt->src,
 						"Specifying '%.*s' as INTRINSIC and EXTERNAL",
 						decl_name.string.size, decl_name.string.base);
 					return false;
 				}
 				if (decl->is_external)
 				{
-					ofc_sparse_ref_warning(stmt->src,
+					ofc_sparse_loc_warning(stmt->src,
 						"Re-declaring '%.*s' as EXTERNAL",
 						decl_name.string.size, decl_name.string.base);
 				}
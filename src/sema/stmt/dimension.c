@@ -34,7 +34,7 @@ bool ofc_sema_stmt_dimension(
 
 		if (lhs->type != OFC_PARSE_LHS_ARRAY)
 		{
-			ofc_sparse_ref_error(lhs->src,
+			ofc_sparse_loc_error(lhs->src,
 				"DIMENSION entry must contain array dimensions.");
 			return false;
 		}
@@ -42,7 +42,7 @@ bool ofc_sema_stmt_dimension(
 		if (!lhs->parent
 			|| (lhs->parent->type != OFC_PARSE_LHS_VARIABLE))
 		{
-			ofc_sparse_ref_error(lhs->src,
+			ofc_sparse_loc_error(lhs->src,
 				"Invalid array layout in DIMENSION");
 			return false;
 		}
@@ -57,7 +57,7 @@ bool ofc_sema_stmt_dimension(
 				scope, base_name, true);
 		if (!decl)
 		{
-			ofc_sparse_ref_error(lhs->src,
+			ofc_sparse_loc_error(lhs->src,
 				"No declaration for '%.*s' and no valid IMPLICIT rule.",
 				base_name.string.size, base_name.string.base);
 			return false;
@@ -56,7 +56,7 @@ static bool ofc_sema_stmt__loop_control(
 		= ofc_sema_lhs_type(*sema_iter);
 	if (!ofc_sema_type_is_scalar(dtype))
 	{
-		ofc_sparse_ref_error(parse_init->name->src,
+		ofc_sparse_loc_error(parse_init->name->src,
 			"DO loop iterator must be a scalar type.");
 		ofc_sema_lhs_delete(*sema_iter);
 		return false;
@@ -64,7 +64,7 @@ static bool ofc_sema_stmt__loop_control(
 
 	if (!ofc_sema_type_is_integer(dtype))
 	{
-		ofc_sparse_ref_warning(parse_init->name->src,
+		ofc_sparse_loc_warning(parse_init->name->src,
 			"Using REAL in DO loop iterator.");
 	}
 
@@ -85,7 +85,7 @@ static bool ofc_sema_stmt__loop_control(
 		{
 			const ofc_sema_type_t* expr_type
 				= ofc_sema_expr_type(*sema_init);
-			ofc_sparse_ref_error(parse_init->init->src,
+			ofc_sparse_loc_error(parse_init->init->src,
 				"Expression type %s doesn't match lhs type %s",
 				ofc_sema_type_str_rep(expr_type),
 				ofc_sema_type_str_rep(dtype));
@@ -114,7 +114,7 @@ static bool ofc_sema_stmt__loop_control(
 		{
 			const ofc_sema_type_t* expr_type =
 				ofc_sema_expr_type(*sema_last);
-			ofc_sparse_ref_error(parse_last->src,
+			ofc_sparse_loc_error(parse_last->src,
 				"Expression type %s doesn't match lhs type %s",
 				ofc_sema_type_str_rep(expr_type),
 				ofc_sema_type_str_rep(dtype));
@@ -148,7 +148,7 @@ static bool ofc_sema_stmt__loop_control(
 			{
 				const ofc_sema_type_t* expr_type =
 					ofc_sema_expr_type(*sema_step);
-				ofc_sparse_ref_error(parse_step->src,
+				ofc_sparse_loc_error(parse_step->src,
 					"Expression type %s doesn't match lhs type %s",
 					ofc_sema_type_str_rep(expr_type),
 					ofc_sema_type_str_rep(dtype));
@@ -294,7 +294,7 @@ static ofc_sema_stmt_t* ofc_sema_stmt_do_while__label(
 		= ofc_sema_expr_type(s.do_while.cond);
 	if (!ofc_sema_type_is_logical(type))
 	{
-		ofc_sparse_ref_error(stmt->do_while.cond->src,
+		ofc_sparse_loc_error(stmt->do_while.cond->src,
 			"IF condition type must be LOGICAL.");
 
 		ofc_sema_expr_delete(s.do_while.cond);
@@ -333,7 +333,7 @@ static ofc_sema_stmt_t* ofc_sema_stmt_do_while__block(
 		= ofc_sema_expr_type(s.do_while_block.cond);
 	if (!ofc_sema_type_is_logical(type))
 	{
-		ofc_sparse_ref_error(stmt->do_while_block.cond->src,
+		ofc_sparse_loc_error(stmt->do_while_block.cond->src,
 			"IF condition type must be LOGICAL.");
 
 		ofc_sema_expr_delete(s.do_while_block.cond);
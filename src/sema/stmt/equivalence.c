@@ -27,7 +27,7 @@ bool ofc_sema_stmt_equivalence(
 
 	if (stmt->label != 0)
 	{
-		ofc_sparse_ref_warning(stmt->src,
+		ofc_sparse_loc_warning(stmt->src,
 			"EQUIVALENCE statements can't be labelled, ignoring.");
 	}
 
@@ -43,7 +43,7 @@ bool ofc_sema_stmt_equivalence(
 			= ofc_sema_lhs(scope, list->lhs[0]);
 		if (!base)
 		{
-			ofc_sparse_ref_error(list->lhs[0]->src,
+			ofc_sparse_loc_error(list->lhs[0]->src,
 				"Invalid EQUIVALENCE element");
 			return false;
 		}
@@ -58,7 +58,7 @@ bool ofc_sema_stmt_equivalence(
 
 		if (list->count < 2)
 		{
-			ofc_sparse_ref_warning(base->src,
+			ofc_sparse_loc_warning(base->src,
 				"EQUIVALENCE groups should contain more than 1 entry.");
 			ofc_sema_lhs_delete(base);
 			continue;
@@ -86,7 +86,7 @@ bool ofc_sema_stmt_equivalence(
 				= ofc_sema_lhs(scope, list->lhs[i]);
 			if (!elhs)
 			{
-				ofc_sparse_ref_error(list->lhs[i]->src,
+				ofc_sparse_loc_error(list->lhs[i]->src,
 					"Invalid EQUIVALENCE element");
 				ofc_sema_equiv_delete(equiv);
 				return false;
@@ -107,7 +107,7 @@ bool ofc_sema_stmt_equivalence(
 			{
 				if (!global_opts.no_warn_equiv_type)
 				{
-					ofc_sparse_ref_warning(elhs->src,
+					ofc_sparse_loc_warning(elhs->src,
 						"EQUIVALENCE types don't match.");
 				}
 			}
@@ -115,7 +115,7 @@ bool ofc_sema_stmt_equivalence(
 			if (!ofc_sema_equiv_add(equiv, elhs))
 			{
 				/* TODO - Better error messages for this in 'sema/equiv.c'. */
-				ofc_sparse_ref_warning(base->src,
+				ofc_sparse_loc_warning(base->src,
 					"EQUIVALENCE statement causes collision.");
 
 				ofc_sema_lhs_delete(elhs);
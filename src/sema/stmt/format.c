@@ -25,30 +25,34 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_format(
 
 	if (stmt->label == 0)
 	{
-		ofc_sparse_ref_warning(stmt->src,
+		ofc_sparse_loc_warning(stmt->src,
 			"FORMAT statement without a label has no effect");
 	}
 
-	if (stmt->format)
-	{
-		unsigned i;
-		for (i = 0; i < stmt->format->count; i++)
-		{
-			if (!ofc_sema_format_desc(
-				stmt->format->desc[i]))
-				return false;
-		}
-	}
-
 	ofc_sema_stmt_t s;
 	s.type = OFC_SEMA_STMT_IO_FORMAT;
-	s.io_format.src = stmt->format;
+	s.io_format.intern = NULL;
+	s.io_format.src = NULL;
 	s.io_format.format = NULL;
 	s.io_format.is_default_possible = true;
 
+	if (stmt->format)
+	{
+		s.io_format.intern = ofc_sema_format_intern(
+			stmt->format);
+		if (!s.io_format.intern) return NULL;
+
+		s.io_format.src = ofc_sema_format_intern_list(
+			s.io_format.intern);
+	}
+
 	ofc_sema_stmt_t* as
 		= ofc_sema_stmt_alloc(s);
-	if (!as) return NULL;
+	if (!as)
+	{
+		ofc_sema_format_release(s.io_format.intern);
+		return NULL;
+	}
 	return as;
 }
 
@@ -42,7 +42,7 @@ static ofc_sema_stmt_t* ofc_sema_stmt_go_to__assigned(
 
 		if (!ofc_sema_expr_is_constant(expr))
 		{
-			ofc_sparse_ref_error(expr->src,
+			ofc_sparse_loc_error(expr->src,
 				"Assigned GO TO allow list entries must be constant");
 			ofc_sema_expr_list_delete(s.go_to.allow);
 			ofc_sema_expr_delete(s.go_to.label);
@@ -73,14 +73,14 @@ static ofc_sema_stmt_t* ofc_sema_stmt_go_to__assigned(
 
 		if (!match)
 		{
-			ofc_sparse_ref_error(s.go_to.label->src,
+			ofc_sparse_loc_error(s.go_to.label->src,
 				"Assigned GO TO target not in allow list");
 			ofc_sema_expr_list_delete(s.go_to.allow);
 			ofc_sema_expr_delete(s.go_to.label);
 			return NULL;
 		}
 
-		ofc_sparse_ref_warning(s.go_to.label->src,
+		ofc_sparse_loc_warning(s.go_to.label->src,
 			"Using assigned GO TO for a constant label makes little sense");
 	}
 
@@ -110,7 +110,7 @@ static ofc_sema_stmt_t* ofc_sema_stmt_go_to__computed(
 		= ofc_sema_expr_type(s.go_to_comp.cond);
 	if (!ofc_sema_type_is_scalar(type))
 	{
-		ofc_sparse_ref_error(s.go_to_comp.cond->src,
+		ofc_sparse_loc_error(s.go_to_comp.cond->src,
 			"Computed GO TO value must be scalar");
 		ofc_sema_expr_delete(s.go_to_comp.cond);
 		return NULL;
@@ -145,14 +145,14 @@ static ofc_sema_stmt_t* ofc_sema_stmt_go_to__computed(
 
 		if (!ofc_sema_expr_is_constant(expr))
 		{
-			ofc_sparse_ref_warning(expr->src,
+			ofc_sparse_loc_warning(expr->src,
 				"Computed GO TO label list entry should be constant");
 		}
 	}
 
 	if (ofc_sema_expr_is_constant(s.go_to_comp.cond))
 	{
-		ofc_sparse_ref_warning(s.go_to_comp.cond->src,
+		ofc_sparse_loc_warning(s.go_to_comp.cond->src,
 			"Using computed GO TO for a constant value makes little sense");
 	}
 
@@ -196,7 +196,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_go_to(
 
 	if (!ofc_sema_expr_is_constant(s.go_to.label))
 	{
-		ofc_sparse_ref_warning(s.go_to.label->src,
+		ofc_sparse_loc_warning(s.go_to.label->src,
 			"Should use assigned GO TO when target isn't a constant label");
 	}
 
@@ -27,13 +27,13 @@ static ofc_sema_stmt_t* ofc_sema_stmt_if__computed(
 	if (!stmt->if_comp.label
 		|| (stmt->if_comp.label->count < 3))
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"Not enough targets in arithmetic IF statement.");
 		return NULL;
 	}
 	else if (stmt->if_comp.label->count > 3)
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"Too many targets in arithmetic IF statement.");
 		return NULL;
 	}
@@ -51,7 +51,7 @@ static ofc_sema_stmt_t* ofc_sema_stmt_if__computed(
 
 	if (!ofc_sema_type_is_scalar(type))
 	{
-		ofc_sparse_ref_error(stmt->if_stmt.cond->src,
+		ofc_sparse_loc_error(stmt->if_stmt.cond->src,
 			"IF condition must be a scalar type.");
 
 		ofc_sema_expr_delete(s.if_comp.cond);
@@ -120,7 +120,7 @@ static ofc_sema_stmt_t* ofc_sema_stmt_if__statement(
 
 		if (!cast)
 		{
-			ofc_sparse_ref_error(stmt->if_stmt.cond->src,
+			ofc_sparse_loc_error(stmt->if_stmt.cond->src,
 				"IF condition type must be LOGICAL.");
 
 			ofc_sema_expr_delete(s.if_stmt.cond);
@@ -175,7 +175,7 @@ static ofc_sema_stmt_t* ofc_sema_stmt_if__then(
 
 		if (!cast)
 		{
-			ofc_sparse_ref_error(stmt->if_then.cond->src,
+			ofc_sparse_loc_error(stmt->if_then.cond->src,
 				"IF condition type must be LOGICAL.");
 
 			ofc_sema_expr_delete(s.if_then.cond);
@@ -217,7 +217,7 @@ static ofc_sema_stmt_t* ofc_sema_stmt_if__then(
 	}
 	else
 	{
-		ofc_sparse_ref_warning(stmt->src,
+		ofc_sparse_loc_warning(stmt->src,
 			"Empty IF THEN block");
 	}
 
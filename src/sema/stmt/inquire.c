@@ -83,346 +83,46 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 	s.io_inquire.unformatted   = NULL;
 	s.io_inquire.write         = NULL;
 
-	ofc_parse_call_arg_t* ca_unit        = NULL;
-	ofc_parse_call_arg_t* ca_access      = NULL;
-	ofc_parse_call_arg_t* ca_action      = NULL;
-	ofc_parse_call_arg_t* ca_blank       = NULL;
-	ofc_parse_call_arg_t* ca_delim       = NULL;
-	ofc_parse_call_arg_t* ca_direct      = NULL;
-	ofc_parse_call_arg_t* ca_err         = NULL;
-	ofc_parse_call_arg_t* ca_exist       = NULL;
-	ofc_parse_call_arg_t* ca_file        = NULL;
-	ofc_parse_call_arg_t* ca_form        = NULL;
-	ofc_parse_call_arg_t* ca_formatted   = NULL;
-	ofc_parse_call_arg_t* ca_iostat      = NULL;
-	ofc_parse_call_arg_t* ca_name        = NULL;
-	ofc_parse_call_arg_t* ca_named       = NULL;
-	ofc_parse_call_arg_t* ca_nextrec     = NULL;
-	ofc_parse_call_arg_t* ca_number      = NULL;
-	ofc_parse_call_arg_t* ca_opened      = NULL;
-	ofc_parse_call_arg_t* ca_pad         = NULL;
-	ofc_parse_call_arg_t* ca_position    = NULL;
-	ofc_parse_call_arg_t* ca_read        = NULL;
-	ofc_parse_call_arg_t* ca_readwrite   = NULL;
-	ofc_parse_call_arg_t* ca_recl        = NULL;
-	ofc_parse_call_arg_t* ca_sequential  = NULL;
-	ofc_parse_call_arg_t* ca_unformatted = NULL;
-	ofc_parse_call_arg_t* ca_write       = NULL;
-
-	unsigned i;
-	for (i = 0; i < stmt->io.params->count; i++)
-	{
-		ofc_parse_call_arg_t* param
-			= stmt->io.params->call_arg[i];
-		if (!param) continue;
-
-		if (ofc_sparse_ref_empty(param->name))
-		{
-			if (i >= 1)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Un-named parameter %u has no meaning in INQUIRE.", i);
-				return NULL;
-			}
-
-			if (i == 0)
-			{
-				ca_unit = param;
-			}
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "UNIT"))
-		{
-			if (ca_unit)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of UNIT in INQUIRE.");
-				return NULL;
-			}
-
-			ca_unit = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "ACCESS"))
-		{
-			if (ca_access)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of ACCESS in INQUIRE.");
-				return NULL;
-			}
-
-			ca_access = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "ACTION"))
-		{
-			if (ca_action)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of ACTION in INQUIRE.");
-				return NULL;
-			}
-
-			ca_action = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "BLANK"))
-		{
-			if (ca_blank)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of BLANK in INQUIRE.");
-				return NULL;
-			}
-
-			ca_blank = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "DELIM"))
-		{
-			if (ca_delim)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of DELIM in INQUIRE.");
-				return NULL;
-			}
-
-			ca_delim = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "DIRECT"))
-		{
-			if (ca_direct)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of DIRECT in INQUIRE.");
-				return NULL;
-			}
-
-			ca_direct = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "ERR"))
-		{
-			if (ca_err)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of ERR in INQUIRE.");
-				return NULL;
-			}
-
-			ca_err = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "EXIST"))
-		{
-			if (ca_exist)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of EXIST in INQUIRE.");
-				return NULL;
-			}
-
-			ca_exist = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "FILE"))
-		{
-			if (ca_file)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of FILE in INQUIRE.");
-				return NULL;
-			}
-
-			ca_file = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "FORM"))
-		{
-			if (ca_form)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of FORM in INQUIRE.");
-				return NULL;
-			}
-
-			ca_form = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "FORMATTED"))
-		{
-			if (ca_formatted)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of FORMATTED in INQUIRE.");
-				return NULL;
-			}
-
-			ca_formatted = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "IOSTAT"))
-		{
-			if (ca_iostat)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of IOSTAT in INQUIRE.");
-				return NULL;
-			}
-
-			ca_iostat = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "NAME"))
-		{
-			if (ca_name)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of NAME in INQUIRE.");
-				return NULL;
-			}
-
-			ca_name = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "NAMED"))
-		{
-			if (ca_named)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of NAMED in INQUIRE.");
-				return NULL;
-			}
-
-			ca_named = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "NEXTREC"))
-		{
-			if (ca_nextrec)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of NEXTREC in INQUIRE.");
-				return NULL;
-			}
-
-			ca_nextrec = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "NUMBER"))
-		{
-			if (ca_number)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of NUMBER in INQUIRE.");
-				return NULL;
-			}
-
-			ca_number = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "OPENED"))
-		{
-			if (ca_opened)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of OPENED in INQUIRE.");
-				return NULL;
-			}
-
-			ca_opened = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "PAD"))
-		{
-			if (ca_pad)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of PAD in INQUIRE.");
-				return NULL;
-			}
-
-			ca_pad = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "POSITION"))
-		{
-			if (ca_position)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of POSITION in INQUIRE.");
-				return NULL;
-			}
-
-			ca_position = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "READ"))
-		{
-			if (ca_read)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of READ in INQUIRE.");
-				return NULL;
-			}
-
-			ca_read = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "READWRITE"))
-		{
-			if (ca_readwrite)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of READWRITE in INQUIRE.");
-				return NULL;
-			}
-
-			ca_readwrite = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "RECL"))
-		{
-			if (ca_recl)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of RECL in INQUIRE.");
-				return NULL;
-			}
-
-			ca_recl = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "SEQUENTIAL"))
-		{
-			if (ca_sequential)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of SEQUENTIAL in INQUIRE.");
-				return NULL;
-			}
-
-			ca_sequential = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "UNFORMATTED"))
-		{
-			if (ca_unformatted)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of UNFORMATTED in INQUIRE.");
-				return NULL;
-			}
-
-			ca_unformatted = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "WRITE"))
-		{
-			if (ca_write)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of WRITE in INQUIRE.");
-				return NULL;
-			}
+	const ofc_parse_call_arg_t* ca[OFC_SEMA_IO_SPEC_COUNT];
+	if (!ofc_sema_io_spec_resolve(
+		OFC_SEMA_IO_STMT_INQUIRE, stmt->io.params, ca))
+		return NULL;
 
-			ca_write = param;
-		}
-		else
-		{
-			ofc_sparse_ref_error(param->src,
-				"Unrecognized paramater %u name '%.*s' in INQUIRE.",
-				i, param->name.string.size, param->name.string.base);
-			return NULL;
-		}
-	}
+	const ofc_parse_call_arg_t* ca_unit        = ca[OFC_SEMA_IO_SPEC_UNIT];
+	const ofc_parse_call_arg_t* ca_access      = ca[OFC_SEMA_IO_SPEC_ACCESS];
+	const ofc_parse_call_arg_t* ca_action      = ca[OFC_SEMA_IO_SPEC_ACTION];
+	const ofc_parse_call_arg_t* ca_blank       = ca[OFC_SEMA_IO_SPEC_BLANK];
+	const ofc_parse_call_arg_t* ca_delim       = ca[OFC_SEMA_IO_SPEC_DELIM];
+	const ofc_parse_call_arg_t* ca_direct      = ca[OFC_SEMA_IO_SPEC_DIRECT];
+	const ofc_parse_call_arg_t* ca_err         = ca[OFC_SEMA_IO_SPEC_ERR];
+	const ofc_parse_call_arg_t* ca_exist       = ca[OFC_SEMA_IO_SPEC_EXIST];
+	const ofc_parse_call_arg_t* ca_file        = ca[OFC_SEMA_IO_SPEC_FILE];
+	const ofc_parse_call_arg_t* ca_form        = ca[OFC_SEMA_IO_SPEC_FORM];
+	const ofc_parse_call_arg_t* ca_formatted   = ca[OFC_SEMA_IO_SPEC_FORMATTED];
+	const ofc_parse_call_arg_t* ca_iostat      = ca[OFC_SEMA_IO_SPEC_IOSTAT];
+	const ofc_parse_call_arg_t* ca_name        = ca[OFC_SEMA_IO_SPEC_NAME];
+	const ofc_parse_call_arg_t* ca_named       = ca[OFC_SEMA_IO_SPEC_NAMED];
+	const ofc_parse_call_arg_t* ca_nextrec     = ca[OFC_SEMA_IO_SPEC_NEXTREC];
+	const ofc_parse_call_arg_t* ca_number      = ca[OFC_SEMA_IO_SPEC_NUMBER];
+	const ofc_parse_call_arg_t* ca_opened      = ca[OFC_SEMA_IO_SPEC_OPENED];
+	const ofc_parse_call_arg_t* ca_pad         = ca[OFC_SEMA_IO_SPEC_PAD];
+	const ofc_parse_call_arg_t* ca_position    = ca[OFC_SEMA_IO_SPEC_POSITION];
+	const ofc_parse_call_arg_t* ca_read        = ca[OFC_SEMA_IO_SPEC_READ];
+	const ofc_parse_call_arg_t* ca_readwrite   = ca[OFC_SEMA_IO_SPEC_READWRITE];
+	const ofc_parse_call_arg_t* ca_recl        = ca[OFC_SEMA_IO_SPEC_RECL];
+	const ofc_parse_call_arg_t* ca_sequential  = ca[OFC_SEMA_IO_SPEC_SEQUENTIAL];
+	const ofc_parse_call_arg_t* ca_unformatted = ca[OFC_SEMA_IO_SPEC_UNFORMATTED];
+	const ofc_parse_call_arg_t* ca_write       = ca[OFC_SEMA_IO_SPEC_WRITE];
 
 	if (!ca_unit && !ca_file)
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"No UNIT or FILE defined in INQUIRE.");
 		return NULL;
 	}
 	else if (ca_unit && ca_file)
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"UNIT and FILE can't be specified at the same time in INQUIRE.");
 		return NULL;
 	}
@@ -443,7 +143,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_integer(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"UNIT must be of type INTEGER in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -451,7 +151,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_expr_validate_uint(s.io_inquire.unit))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 			   "UNIT must be a positive INTEGER in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -459,7 +159,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 	}
 	else if (ca_unit)
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"UNIT must be an INTEGER expression in INQUIRE");
 		return NULL;
 	}
@@ -484,7 +184,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_character(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"ACCESS must be a CHARACTER variable in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -511,7 +211,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_character(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"ACTION must be a CHARACTER variable in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -538,7 +238,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_character(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"BLANK must be a CHARACTER variable in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -565,7 +265,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_character(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"DELIM must be a CHARACTER variable in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -592,7 +292,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_character(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"DIRECT must be a CHARACTER variable in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -629,7 +329,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 		}
 		if (!ofc_sema_type_is_logical(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"EXIST must be a LOGICAL variable in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -656,7 +356,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_character(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"FILE must be a CHARACTER expression in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -683,7 +383,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_character(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"FORM must be a CHARACTER variable in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -710,7 +410,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_character(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"FORMATTED must be a CHARACTER variable in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -737,7 +437,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_integer(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"IOSTAT must be of type INTEGER in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -764,7 +464,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_character(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"NAME must be a CHARACTER variable in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -791,7 +491,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_logical(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"NAMED must be a LOGICAL variable in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -818,7 +518,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_integer(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"NEXTREC must be of type INTEGER in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -845,7 +545,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_integer(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"NUMBER must be an INTEGER variable in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -872,7 +572,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_logical(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"OPENED must be a LOGICAL variable in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -899,7 +599,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_character(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"PAD must be a CHARACTER variable in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -926,7 +626,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_character(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"POSITION must be a CHARACTER variable in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -953,7 +653,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_character(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"READ must be a CHARACTER variable in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -980,7 +680,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_character(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"READWRITE must be a CHARACTER variable in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -1007,7 +707,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_integer(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"RECL must be an INTEGER variable in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -1034,7 +734,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_character(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"SEQUENTIAL must be a CHARACTER variable in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -1061,7 +761,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_character(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"UNFORMATTED must be a CHARACTER variable in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -1088,7 +788,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_inquire(
 
 		if (!ofc_sema_type_is_character(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"WRITE must be a CHARACTER variable in INQUIRE");
 			ofc_sema_stmt_io_inquire__cleanup(s);
 			return NULL;
@@ -23,22 +23,22 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_position(
 		|| !stmt->io.params)
 		return NULL;
 
-	const char* name;
+	ofc_sema_io_stmt_e io_stmt;
 	ofc_sema_stmt_t s;
 
 	switch (stmt->type)
 	{
 		case OFC_PARSE_STMT_IO_REWIND:
 			s.type = OFC_SEMA_STMT_IO_REWIND;
-			name = "REWIND";
+			io_stmt = OFC_SEMA_IO_STMT_REWIND;
 			break;
 		case OFC_PARSE_STMT_IO_END_FILE:
 			s.type = OFC_SEMA_STMT_IO_END_FILE;
-			name = "ENDFILE";
+			io_stmt = OFC_SEMA_IO_STMT_END_FILE;
 			break;
 		case OFC_PARSE_STMT_IO_BACKSPACE:
 			s.type = OFC_SEMA_STMT_IO_BACKSPACE;
-			name = "BACKSPACE";
+			io_stmt = OFC_SEMA_IO_STMT_BACKSPACE;
 			break;
 		default:
 			return NULL;
@@ -48,76 +48,20 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_position(
 	s.io_position.iostat      = NULL;
 	s.io_position.err         = NULL;
 
-	ofc_parse_call_arg_t* ca_unit   = NULL;
-	ofc_parse_call_arg_t* ca_iostat = NULL;
-	ofc_parse_call_arg_t* ca_err    = NULL;
-
-	unsigned i;
-	for (i = 0; i < stmt->io.params->count; i++)
-	{
-		ofc_parse_call_arg_t* param
-			= stmt->io.params->call_arg[i];
-		if (!param) continue;
-
-		if (ofc_sparse_ref_empty(param->name))
-		{
-			if (i >= 1)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Un-named parameter %u has no meaning in %s.", i, name);
-				return NULL;
-			}
-
-			if (i == 0)
-			{
-				ca_unit = param;
-			}
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "UNIT"))
-		{
-			if (ca_unit)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of UNIT in %s.", name);
-				return NULL;
-			}
-
-			ca_unit = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "IOSTAT"))
-		{
-			if (ca_iostat)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of IOSTAT in %s.", name);
-				return NULL;
-			}
+	const ofc_parse_call_arg_t* ca[OFC_SEMA_IO_SPEC_COUNT];
+	if (!ofc_sema_io_spec_resolve(
+		io_stmt, stmt->io.params, ca))
+		return NULL;
 
-			ca_iostat = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "ERR"))
-		{
-			if (ca_err)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of ERR in %s.", name);
-				return NULL;
-			}
+	const char* name = ofc_sema_io_stmt_name(io_stmt);
 
-			ca_err = param;
-		}
-		else
-		{
-			ofc_sparse_ref_error(param->src,
-				"Unrecognized paramater %u name '%.*s' in %s.",
-				i, param->name.string.size, param->name.string.base, name);
-			return NULL;
-		}
-	}
+	const ofc_parse_call_arg_t* ca_unit   = ca[OFC_SEMA_IO_SPEC_UNIT];
+	const ofc_parse_call_arg_t* ca_iostat = ca[OFC_SEMA_IO_SPEC_IOSTAT];
+	const ofc_parse_call_arg_t* ca_err    = ca[OFC_SEMA_IO_SPEC_ERR];
 
 	if (!ca_unit)
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"No UNIT defined in %s.", name);
 		return NULL;
 	}
@@ -134,7 +78,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_position(
 
 		if (!ofc_sema_type_is_integer(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"UNIT must be of type INTEGER in %s", name);
 			ofc_sema_expr_delete(s.io_position.unit);
 			return NULL;
@@ -142,7 +86,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_position(
 
 		if (!ofc_sema_expr_validate_uint(s.io_position.unit))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				   "UNIT must be a positive INTEGER in %s", name);
 			ofc_sema_expr_delete(s.io_position.unit);
 			return NULL;
@@ -150,7 +94,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_position(
 	}
 	else
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"UNIT must be an INTEGER expression in %s", name);
 		return NULL;
 	}
@@ -167,7 +111,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_position(
 
 		if (s.io_position.iostat->type != OFC_SEMA_EXPR_LHS)
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"IOSTAT must be of a variable in %s", name);
 			ofc_sema_expr_delete(s.io_position.unit);
 			ofc_sema_expr_delete(s.io_position.iostat);
@@ -185,7 +129,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_position(
 
 		if (!ofc_sema_type_is_integer(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"IOSTAT must be of type INTEGER in %s", name);
 			ofc_sema_expr_delete(s.io_position.unit);
 			ofc_sema_expr_delete(s.io_position.iostat);
@@ -58,196 +58,28 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_open(
 	s.io_open.recl          = NULL;
 	s.io_open.status        = NULL;
 
-	ofc_parse_call_arg_t* ca_unit     = NULL;
-	ofc_parse_call_arg_t* ca_access   = NULL;
-	ofc_parse_call_arg_t* ca_action   = NULL;
-	ofc_parse_call_arg_t* ca_blank    = NULL;
-	ofc_parse_call_arg_t* ca_delim    = NULL;
-	ofc_parse_call_arg_t* ca_err      = NULL;
-	ofc_parse_call_arg_t* ca_file     = NULL;
-	ofc_parse_call_arg_t* ca_form     = NULL;
-	ofc_parse_call_arg_t* ca_iostat   = NULL;
-	ofc_parse_call_arg_t* ca_pad      = NULL;
-	ofc_parse_call_arg_t* ca_position = NULL;
-	ofc_parse_call_arg_t* ca_recl     = NULL;
-	ofc_parse_call_arg_t* ca_status   = NULL;
-
-	unsigned i;
-	for (i = 0; i < stmt->io.params->count; i++)
-	{
-		ofc_parse_call_arg_t* param
-			= stmt->io.params->call_arg[i];
-		if (!param) continue;
-
-		if (ofc_sparse_ref_empty(param->name))
-		{
-			if (i >= 1)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Un-named parameter %u has no meaning in OPEN.", i);
-				return NULL;
-			}
-
-			if (i == 0)
-			{
-				ca_unit = param;
-			}
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "UNIT"))
-		{
-			if (ca_unit)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of UNIT in OPEN.");
-				return NULL;
-			}
-
-			ca_unit = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "ACCESS"))
-		{
-			if (ca_access)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of ACCESS in OPEN.");
-				return NULL;
-			}
-
-			ca_access = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "ACTION"))
-		{
-			if (ca_action)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of ACTION in OPEN.");
-				return NULL;
-			}
-
-			ca_action = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "BLANK"))
-		{
-			if (ca_blank)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of BLANK in OPEN.");
-				return NULL;
-			}
-
-			ca_blank = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "DELIM"))
-		{
-			if (ca_delim)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of DELIM in OPEN.");
-				return NULL;
-			}
-
-			ca_delim = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "ERR"))
-		{
-			if (ca_err)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of ERR in OPEN.");
-				return NULL;
-			}
-
-			ca_err = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "FILE"))
-		{
-			if (ca_file)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of FILE in OPEN.");
-				return NULL;
-			}
-
-			ca_file = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "FORM"))
-		{
-			if (ca_form)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of FORM in OPEN.");
-				return NULL;
-			}
-
-			ca_form = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "IOSTAT"))
-		{
-			if (ca_iostat)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of IOSTAT in OPEN.");
-				return NULL;
-			}
-
-			ca_iostat = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "PAD"))
-		{
-			if (ca_pad)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of PAD in OPEN.");
-				return NULL;
-			}
-
-			ca_pad = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "POSITION"))
-		{
-			if (ca_position)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of POSITION in OPEN.");
-				return NULL;
-			}
-
-			ca_position = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "RECL"))
-		{
-			if (ca_recl)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of RECL in OPEN.");
-				return NULL;
-			}
+	const ofc_parse_call_arg_t* ca[OFC_SEMA_IO_SPEC_COUNT];
+	if (!ofc_sema_io_spec_resolve(
+		OFC_SEMA_IO_STMT_OPEN, stmt->io.params, ca))
+		return NULL;
 
-			ca_recl = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "STATUS"))
-		{
-			if (ca_status)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of STATUS in OPEN.");
-				return NULL;
-			}
-
-			ca_status = param;
-		}
-		else
-		{
-			ofc_sparse_ref_error(param->src,
-				"Unrecognized paramater %u name '%.*s' in OPEN.",
-				i, param->name.string.size, param->name.string.base);
-			return NULL;
-		}
-	}
+	const ofc_parse_call_arg_t* ca_unit     = ca[OFC_SEMA_IO_SPEC_UNIT];
+	const ofc_parse_call_arg_t* ca_access   = ca[OFC_SEMA_IO_SPEC_ACCESS];
+	const ofc_parse_call_arg_t* ca_action   = ca[OFC_SEMA_IO_SPEC_ACTION];
+	const ofc_parse_call_arg_t* ca_blank    = ca[OFC_SEMA_IO_SPEC_BLANK];
+	const ofc_parse_call_arg_t* ca_delim    = ca[OFC_SEMA_IO_SPEC_DELIM];
+	const ofc_parse_call_arg_t* ca_err      = ca[OFC_SEMA_IO_SPEC_ERR];
+	const ofc_parse_call_arg_t* ca_file     = ca[OFC_SEMA_IO_SPEC_FILE];
+	const ofc_parse_call_arg_t* ca_form     = ca[OFC_SEMA_IO_SPEC_FORM];
+	const ofc_parse_call_arg_t* ca_iostat   = ca[OFC_SEMA_IO_SPEC_IOSTAT];
+	const ofc_parse_call_arg_t* ca_pad      = ca[OFC_SEMA_IO_SPEC_PAD];
+	const ofc_parse_call_arg_t* ca_position = ca[OFC_SEMA_IO_SPEC_POSITION];
+	const ofc_parse_call_arg_t* ca_recl     = ca[OFC_SEMA_IO_SPEC_RECL];
+	const ofc_parse_call_arg_t* ca_status   = ca[OFC_SEMA_IO_SPEC_STATUS];
 
 	if (!ca_unit)
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"No UNIT defined in OPEN.");
 		return NULL;
 	}
@@ -268,7 +100,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_open(
 
 		if (!ofc_sema_type_is_integer(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"UNIT must be of type INTEGER in OPEN");
 			ofc_sema_stmt_io_open__cleanup(s);
 			return NULL;
@@ -276,7 +108,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_open(
 
 		if (!ofc_sema_expr_validate_uint(s.io_open.unit))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				   "UNIT must be a positive INTEGER in OPEN");
 			ofc_sema_stmt_io_open__cleanup(s);
 			return NULL;
@@ -284,7 +116,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_open(
 	}
 	else
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"UNIT must be an INTEGER expression in OPEN");
 		return NULL;
 	}
@@ -301,49 +133,28 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_open(
 			return NULL;
 		}
 
-		const ofc_sema_type_t* etype
-			= ofc_sema_expr_type(s.io_open.access);
-		if (!etype)
+		ofc_sema_call_arg_e value;
+		if (!ofc_sema_io_spec_value(
+			OFC_SEMA_IO_STMT_OPEN, OFC_SEMA_IO_SPEC_ACCESS,
+			stmt->src, s.io_open.access, &value))
 		{
 			ofc_sema_stmt_io_open__cleanup(s);
 			return NULL;
 		}
 
-		if (etype->type != OFC_SEMA_TYPE_CHARACTER)
-		{
-			ofc_sparse_ref_error(stmt->src,
-				"ACCESS must be a CHARACTER expression in OPEN");
-			ofc_sema_stmt_io_open__cleanup(s);
-			return NULL;
-		}
-		else
+		access_type_direct = (value == OFC_SEMA_CALL_ARG_DIRECT);
+		if (access_type_direct)
 		{
-			const ofc_sema_typeval_t* constant
-				= ofc_sema_expr_constant(s.io_open.access);
+			/* Change default format */
+			format_type_unformatted = true;
 
-			access_type_direct = (constant
-				&& ofc_typeval_character_equal_strz_ci(constant, "DIRECT"));
-			if (constant && !access_type_direct
-				&& !ofc_typeval_character_equal_strz_ci(constant, "SEQUENTIAL"))
+			if (!ca_recl)
 			{
-				ofc_sparse_ref_error(stmt->src,
-					"ACCESS must be SEQUENTIAL/DIRECT in OPEN");
+				ofc_sparse_loc_error(stmt->src,
+					"Direct ACCESS must have a RECL specifier in OPEN");
 				ofc_sema_stmt_io_open__cleanup(s);
 				return NULL;
 			}
-			else if (access_type_direct)
-			{
-				/* Change default format */
-				format_type_unformatted = true;
-
-				if (!ca_recl)
-				{
-					ofc_sparse_ref_error(stmt->src,
-						"Direct ACCESS must have a RECL specifier in OPEN");
-					ofc_sema_stmt_io_open__cleanup(s);
-					return NULL;
-				}
-			}
 		}
 	}
 
@@ -357,37 +168,13 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_open(
 			return NULL;
 		}
 
-		const ofc_sema_type_t* etype
-			= ofc_sema_expr_type(s.io_open.action);
-		if (!etype)
-		{
-			ofc_sema_stmt_io_open__cleanup(s);
-			return NULL;
-		}
-
-		if (etype->type != OFC_SEMA_TYPE_CHARACTER)
+		if (!ofc_sema_io_spec_value(
+			OFC_SEMA_IO_STMT_OPEN, OFC_SEMA_IO_SPEC_ACTION,
+			stmt->src, s.io_open.action, NULL))
 		{
-			ofc_sparse_ref_error(stmt->src,
-				"ACTION must be a CHARACTER expression in OPEN");
 			ofc_sema_stmt_io_open__cleanup(s);
 			return NULL;
 		}
-		else
-		{
-			const ofc_sema_typeval_t* constant
-				= ofc_sema_expr_constant(s.io_open.action);
-
-			if (constant
-				&& !ofc_typeval_character_equal_strz_ci(constant, "READWRITE")
-				&& !ofc_typeval_character_equal_strz_ci(constant, "WRITE")
-				&& !ofc_typeval_character_equal_strz_ci(constant, "READ"))
-			{
-				ofc_sparse_ref_error(stmt->src,
-					"ACTION must be 'READ', 'WRITE' or 'READWRITE' in OPEN");
-				ofc_sema_stmt_io_open__cleanup(s);
-				return NULL;
-			}
-		}
 	}
 
 	if (ca_form)
@@ -400,42 +187,21 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_open(
 			return NULL;
 		}
 
-		const ofc_sema_type_t* etype
-			= ofc_sema_expr_type(s.io_open.form);
-		if (!etype)
+		ofc_sema_call_arg_e value;
+		if (!ofc_sema_io_spec_value(
+			OFC_SEMA_IO_STMT_OPEN, OFC_SEMA_IO_SPEC_FORM,
+			stmt->src, s.io_open.form, &value))
 		{
 			ofc_sema_stmt_io_open__cleanup(s);
 			return NULL;
 		}
 
-		if (etype->type != OFC_SEMA_TYPE_CHARACTER)
-		{
-			ofc_sparse_ref_error(stmt->src,
-				"FORM must be a CHARACTER expression in OPEN");
-			ofc_sema_stmt_io_open__cleanup(s);
-			return NULL;
-		}
-		else
-		{
-			const ofc_sema_typeval_t* constant
-				= ofc_sema_expr_constant(s.io_open.form);
-
-			format_type_unformatted = (constant
-				&& ofc_typeval_character_equal_strz_ci(constant, "UNFORMATTED"));
-			if (constant && !format_type_unformatted
-				&& !ofc_typeval_character_equal_strz_ci(constant, "FORMATTED"))
-			{
-				ofc_sparse_ref_error(stmt->src,
-					"FORM must be FORMATTED/UNFORMATTED in OPEN");
-				ofc_sema_stmt_io_open__cleanup(s);
-				return NULL;
-			}
-		}
+		format_type_unformatted = (value == OFC_SEMA_CALL_ARG_UNFORMATTED);
 	}
 
 	if (ca_blank && format_type_unformatted)
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"BLANK can only be specified for formatted I/O in OPEN");
 		ofc_sema_stmt_io_open__cleanup(s);
 		return NULL;
@@ -450,41 +216,18 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_open(
 			return NULL;
 		}
 
-		const ofc_sema_type_t* etype
-			= ofc_sema_expr_type(s.io_open.blank);
-		if (!etype)
+		if (!ofc_sema_io_spec_value(
+			OFC_SEMA_IO_STMT_OPEN, OFC_SEMA_IO_SPEC_BLANK,
+			stmt->src, s.io_open.blank, NULL))
 		{
 			ofc_sema_stmt_io_open__cleanup(s);
 			return NULL;
 		}
-
-		if (etype->type != OFC_SEMA_TYPE_CHARACTER)
-		{
-			ofc_sparse_ref_error(stmt->src,
-				"BLANK must be a CHARACTER expression in OPEN");
-			ofc_sema_stmt_io_open__cleanup(s);
-			return NULL;
-		}
-		else
-		{
-			const ofc_sema_typeval_t* constant
-				= ofc_sema_expr_constant(s.io_open.blank);
-
-			if (constant
-				&& !ofc_typeval_character_equal_strz_ci(constant, "ZERO")
-				&& !ofc_typeval_character_equal_strz_ci(constant, "NULL"))
-			{
-				ofc_sparse_ref_error(stmt->src,
-					"BLANK must be NULL/ZERO in OPEN");
-				ofc_sema_stmt_io_open__cleanup(s);
-				return NULL;
-			}
-		}
 	}
 
 	if (ca_delim && format_type_unformatted)
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"DELIM can only be specified for formatted I/O in OPEN");
 		ofc_sema_stmt_io_open__cleanup(s);
 		return NULL;
@@ -499,37 +242,13 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_open(
 			return NULL;
 		}
 
-		const ofc_sema_type_t* etype
-			= ofc_sema_expr_type(s.io_open.delim);
-		if (!etype)
-		{
-			ofc_sema_stmt_io_open__cleanup(s);
-			return NULL;
-		}
-
-		if (etype->type != OFC_SEMA_TYPE_CHARACTER)
+		if (!ofc_sema_io_spec_value(
+			OFC_SEMA_IO_STMT_OPEN, OFC_SEMA_IO_SPEC_DELIM,
+			stmt->src, s.io_open.delim, NULL))
 		{
-			ofc_sparse_ref_error(stmt->src,
-				"DELIM must be a CHARACTER expression in OPEN");
 			ofc_sema_stmt_io_open__cleanup(s);
 			return NULL;
 		}
-		else
-		{
-			const ofc_sema_typeval_t* constant
-				= ofc_sema_expr_constant(s.io_open.delim);
-
-			if (constant
-				&& !ofc_typeval_character_equal_strz_ci(constant, "APOSTROPHE")
-				&& !ofc_typeval_character_equal_strz_ci(constant, "QUOTE")
-				&& !ofc_typeval_character_equal_strz_ci(constant, "NONE"))
-			{
-				ofc_sparse_ref_error(stmt->src,
-					"DELIM must be APOSTROPHE/QUOTE/NONE in OPEN");
-				ofc_sema_stmt_io_open__cleanup(s);
-				return NULL;
-			}
-		}
 	}
 
 	if (ca_err)
@@ -554,44 +273,21 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_open(
 			return NULL;
 		}
 
-		const ofc_sema_type_t* etype
-			= ofc_sema_expr_type(s.io_open.status);
-		if (!etype)
+		ofc_sema_call_arg_e value;
+		if (!ofc_sema_io_spec_value(
+			OFC_SEMA_IO_STMT_OPEN, OFC_SEMA_IO_SPEC_STATUS,
+			stmt->src, s.io_open.status, &value))
 		{
 			ofc_sema_stmt_io_open__cleanup(s);
 			return NULL;
 		}
 
-		if (etype->type != OFC_SEMA_TYPE_CHARACTER)
-		{
-			ofc_sparse_ref_error(stmt->src,
-				"STATUS must be a CHARACTER expression in OPEN");
-			ofc_sema_stmt_io_open__cleanup(s);
-			return NULL;
-		}
-		else
-		{
-			const ofc_sema_typeval_t* constant
-				= ofc_sema_expr_constant(s.io_open.status);
-			is_scratch = (constant &&
-				ofc_typeval_character_equal_strz_ci(constant, "SCRATCH"));
-			if (constant && !is_scratch
-				&& !ofc_typeval_character_equal_strz_ci(constant, "UNKNOWN")
-				&& !ofc_typeval_character_equal_strz_ci(constant, "REPLACE")
-				&& !ofc_typeval_character_equal_strz_ci(constant, "OLD")
-				&& !ofc_typeval_character_equal_strz_ci(constant, "NEW"))
-			{
-				ofc_sparse_ref_error(stmt->src,
-					"STATUS must be UNKNOWN/REPLACE/OLD/NEW/SCRATCH in OPEN");
-				ofc_sema_stmt_io_open__cleanup(s);
-				return NULL;
-			}
-		}
+		is_scratch = (value == OFC_SEMA_CALL_ARG_SCRATCH);
 	}
 
 	if (ca_file && is_scratch)
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"FILE can only be specified for non scratch files in OPEN");
 		ofc_sema_stmt_io_open__cleanup(s);
 		return NULL;
@@ -606,21 +302,13 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_open(
 			return NULL;
 		}
 
-		const ofc_sema_type_t* etype
-			= ofc_sema_expr_type(s.io_open.file);
-		if (!etype)
+		if (!ofc_sema_io_spec_value(
+			OFC_SEMA_IO_STMT_OPEN, OFC_SEMA_IO_SPEC_FILE,
+			stmt->src, s.io_open.file, NULL))
 		{
 			ofc_sema_stmt_io_open__cleanup(s);
 			return NULL;
 		}
-
-		if (etype->type != OFC_SEMA_TYPE_CHARACTER)
-		{
-			ofc_sparse_ref_error(stmt->src,
-				"FILE must be a CHARACTER expression in OPEN");
-			ofc_sema_stmt_io_open__cleanup(s);
-			return NULL;
-		}
 	}
 
 	if (ca_iostat)
@@ -635,7 +323,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_open(
 
 		if (s.io_open.iostat->type != OFC_SEMA_EXPR_LHS)
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"IOSTAT must be a variable in OPEN");
 			ofc_sema_stmt_io_open__cleanup(s);
 			return NULL;
@@ -651,7 +339,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_open(
 
 		if (!ofc_sema_type_is_integer(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"IOSTAT must be of type INTEGER in OPEN");
 			ofc_sema_stmt_io_open__cleanup(s);
 			return NULL;
@@ -660,7 +348,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_open(
 
 	if (ca_pad && format_type_unformatted)
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"PAD can only be specified for formatted I/O in OPEN");
 		ofc_sema_stmt_io_open__cleanup(s);
 		return NULL;
@@ -675,41 +363,18 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_open(
 			return NULL;
 		}
 
-		const ofc_sema_type_t* etype
-			= ofc_sema_expr_type(s.io_open.pad);
-		if (!etype)
+		if (!ofc_sema_io_spec_value(
+			OFC_SEMA_IO_STMT_OPEN, OFC_SEMA_IO_SPEC_PAD,
+			stmt->src, s.io_open.pad, NULL))
 		{
 			ofc_sema_stmt_io_open__cleanup(s);
 			return NULL;
 		}
-
-		if (etype->type != OFC_SEMA_TYPE_CHARACTER)
-		{
-			ofc_sparse_ref_error(stmt->src,
-				"PAD must be a CHARACTER expression in OPEN");
-			ofc_sema_stmt_io_open__cleanup(s);
-			return NULL;
-		}
-		else
-		{
-			const ofc_sema_typeval_t* constant
-				= ofc_sema_expr_constant(s.io_open.pad);
-
-			if (constant
-				&& !ofc_typeval_character_equal_strz_ci(constant, "NO")
-				&& !ofc_typeval_character_equal_strz_ci(constant, "YES"))
-			{
-				ofc_sparse_ref_error(stmt->src,
-					"PAD must be YES/NO in OPEN");
-				ofc_sema_stmt_io_open__cleanup(s);
-				return NULL;
-			}
-		}
 	}
 
 	if (ca_position && access_type_direct)
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"POSITION can only be specified for files with sequential access in OPEN");
 		ofc_sema_stmt_io_open__cleanup(s);
 		return NULL;
@@ -724,37 +389,13 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_open(
 			return NULL;
 		}
 
-		const ofc_sema_type_t* etype
-			= ofc_sema_expr_type(s.io_open.position);
-		if (!etype)
+		if (!ofc_sema_io_spec_value(
+			OFC_SEMA_IO_STMT_OPEN, OFC_SEMA_IO_SPEC_POSITION,
+			stmt->src, s.io_open.position, NULL))
 		{
 			ofc_sema_stmt_io_open__cleanup(s);
 			return NULL;
 		}
-
-		if (etype->type != OFC_SEMA_TYPE_CHARACTER)
-		{
-			ofc_sparse_ref_error(stmt->src,
-				"POSITION must be a CHARACTER expression in OPEN");
-			ofc_sema_stmt_io_open__cleanup(s);
-			return NULL;
-		}
-		else
-		{
-			const ofc_sema_typeval_t* constant
-				= ofc_sema_expr_constant(s.io_open.position);
-
-			if (constant
-				&& !ofc_typeval_character_equal_strz_ci(constant, "REWIND")
-				&& !ofc_typeval_character_equal_strz_ci(constant, "APPEND")
-				&& !ofc_typeval_character_equal_strz_ci(constant, "ASIS"))
-			{
-				ofc_sparse_ref_error(stmt->src,
-					"POSITION must be REWIND/APPEND/ASIS in OPEN");
-				ofc_sema_stmt_io_open__cleanup(s);
-				return NULL;
-			}
-		}
 	}
 
 	if (ca_recl)
@@ -773,7 +414,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_open(
 
 		if (!ofc_sema_type_is_integer(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"RECL must be of type INTEGER in OPEN");
 			ofc_sema_stmt_io_open__cleanup(s);
 			return NULL;
@@ -791,7 +432,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_open(
 			{
 				if (evalue64 < 0)
 				{
-					ofc_sparse_ref_error(stmt->src,
+					ofc_sparse_loc_error(stmt->src,
 						"RECL must be a positive INTEGER in OPEN");
 					ofc_sema_stmt_io_open__cleanup(s);
 					return NULL;
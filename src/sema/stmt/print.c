@@ -54,7 +54,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_print(
 		{
 			/* TODO - Support INTEGER array formats. */
 
-			ofc_sparse_ref_error(s.io_print.format->src,
+			ofc_sparse_loc_error(s.io_print.format->src,
 				"Format (FMT) must be a label or character string in PRINT");
 			ofc_sema_expr_delete(s.io_print.format);
 			return NULL;
@@ -56,159 +56,38 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_read(
 	s.io_read.eor          = NULL;
 	s.io_read.size         = NULL;
 
-	ofc_parse_call_arg_t* ca_unit    = NULL;
-	ofc_parse_call_arg_t* ca_format  = NULL;
-	ofc_parse_call_arg_t* ca_iostat  = NULL;
-	ofc_parse_call_arg_t* ca_rec     = NULL;
-	ofc_parse_call_arg_t* ca_err     = NULL;
-	ofc_parse_call_arg_t* ca_advance = NULL;
-	ofc_parse_call_arg_t* ca_end     = NULL;
-	ofc_parse_call_arg_t* ca_eor     = NULL;
-	ofc_parse_call_arg_t* ca_size    = NULL;
-
+	const ofc_parse_call_arg_t* ca[OFC_SEMA_IO_SPEC_COUNT];
 	if (stmt->io_read.has_brakets)
 	{
-		unsigned i;
-		for (i = 0; i < stmt->io_read.params->count; i++)
-		{
-			ofc_parse_call_arg_t* param
-				= stmt->io_read.params->call_arg[i];
-			if (!param) continue;
-
-			if (ofc_sparse_ref_empty(param->name))
-			{
-				if (i >= 2)
-				{
-					ofc_sparse_ref_error(param->src,
-						"Un-named parameter %u has no meaning in READ.", i);
-					return NULL;
-				}
-
-				if (i == 0)
-				{
-					ca_unit = param;
-				}
-				else
-				{
-					if (!ca_unit)
-					{
-						ofc_sparse_ref_error(param->src,
-							"Un-named format parameter only valid after UNIT in READ.");
-						return NULL;
-					}
-
-					ca_format = param;
-				}
-			}
-			else if (ofc_str_ref_equal_strz_ci(param->name.string, "UNIT"))
-			{
-				if (ca_unit)
-				{
-					ofc_sparse_ref_error(param->src,
-						"Re-definition of UNIT in READ.");
-					return NULL;
-				}
-
-				ca_unit = param;
-			}
-			else if (ofc_str_ref_equal_strz_ci(param->name.string, "FMT"))
-			{
-				if (ca_format)
-				{
-					ofc_sparse_ref_error(param->src,
-						"Re-definition of FMT in READ.");
-					return NULL;
-				}
-
-				ca_format = param;
-			}
-			else if (ofc_str_ref_equal_strz_ci(param->name.string, "IOSTAT"))
-			{
-				if (ca_iostat)
-				{
-					ofc_sparse_ref_error(param->src,
-						"Re-definition of IOSTAT in READ.");
-					return NULL;
-				}
-
-				ca_iostat = param;
-			}
-			else if (ofc_str_ref_equal_strz_ci(param->name.string, "REC"))
-			{
-				if (ca_rec)
-				{
-					ofc_sparse_ref_error(param->src,
-						"Re-definition of REC in READ.");
-					return NULL;
-				}
-
-				ca_rec = param;
-			}
-			else if (ofc_str_ref_equal_strz_ci(param->name.string, "ERR"))
-			{
-				if (ca_err)
-				{
-					ofc_sparse_ref_error(param->src,
-						"Re-definition of ERR in READ.");
-					return NULL;
-				}
-
-				ca_err = param;
-			}
-			else if (ofc_str_ref_equal_strz_ci(param->name.string, "ADVANCE"))
-			{
-				if (ca_advance)
-				{
-					ofc_sparse_ref_error(param->src,
-						"Re-definition of ADVANCE in READ.");
-					return NULL;
-				}
-
-				ca_advance = param;
-			}
-			else if (ofc_str_ref_equal_strz_ci(param->name.string, "END"))
-			{
-				if (ca_end)
-				{
-					ofc_sparse_ref_error(param->src,
-						"Re-definition of END in READ.");
-					return NULL;
-				}
-
-				ca_end = param;
-			}
-			else if (ofc_str_ref_equal_strz_ci(param->name.string, "SIZE"))
-			{
-				if (ca_size)
-				{
-					ofc_sparse_ref_error(param->src,
-						"Re-definition of SIZE in READ.");
-					return NULL;
-				}
-
-				ca_size = param;
-			}
-			else
-			{
-				ofc_sparse_ref_error(param->src,
-					"Unrecognized paramater %u name '%.*s' in READ.",
-					i, param->name.string.size, param->name.string.base);
-				return NULL;
-			}
-		}
+		if (!ofc_sema_io_spec_resolve(
+			OFC_SEMA_IO_STMT_READ, stmt->io_read.params, ca))
+			return NULL;
 
-		if (!ca_unit)
+		if (!ca[OFC_SEMA_IO_SPEC_UNIT])
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"No UNIT defined in READ.");
 			return NULL;
 		}
 	}
 	else
 	{
-		ca_format = stmt->io_read.params->call_arg[0];
+		unsigned i;
+		for (i = 0; i < OFC_SEMA_IO_SPEC_COUNT; i++)
+			ca[i] = NULL;
+		ca[OFC_SEMA_IO_SPEC_FMT] = stmt->io_read.params->call_arg[0];
 	}
 
+	const ofc_parse_call_arg_t* ca_unit    = ca[OFC_SEMA_IO_SPEC_UNIT];
+	const ofc_parse_call_arg_t* ca_format  = ca[OFC_SEMA_IO_SPEC_FMT];
+	const ofc_parse_call_arg_t* ca_iostat  = ca[OFC_SEMA_IO_SPEC_IOSTAT];
+	const ofc_parse_call_arg_t* ca_rec     = ca[OFC_SEMA_IO_SPEC_REC];
+	const ofc_parse_call_arg_t* ca_err     = ca[OFC_SEMA_IO_SPEC_ERR];
+	const ofc_parse_call_arg_t* ca_advance = ca[OFC_SEMA_IO_SPEC_ADVANCE];
+	const ofc_parse_call_arg_t* ca_end     = ca[OFC_SEMA_IO_SPEC_END];
+	const ofc_parse_call_arg_t* ca_eor     = ca[OFC_SEMA_IO_SPEC_EOR];
+	const ofc_parse_call_arg_t* ca_size    = ca[OFC_SEMA_IO_SPEC_SIZE];
+
 	if (ca_unit && (ca_unit->type == OFC_PARSE_CALL_ARG_ASTERISK))
 	{
 		s.io_read.stdin = true;
@@ -231,7 +110,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_read(
 			&& (!ofc_sema_type_is_integer(etype)
 				|| !ofc_sema_expr_validate_uint(s.io_read.unit)))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				   "UNIT must be a positive INTEGER "
 				   "or a CHARACTER expression in READ");
 			ofc_sema_stmt_io_read__cleanup(s);
@@ -240,7 +119,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_read(
 	}
 	else if (ca_unit)
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"UNIT must be an INTEGER or CHARACTER "
 			"expression, or asterisk in READ");
 		return NULL;
@@ -284,7 +163,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_read(
 		{
 			/* TODO - Support INTEGER array formats. */
 
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"Format (FMT) must be a label or character string in READ");
 			ofc_sema_stmt_io_read__cleanup(s);
 			return NULL;
@@ -292,7 +171,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_read(
 	}
 	else if (ca_format)
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"Format (FMT) must be an INTEGER expression or asterisk in READ");
 		ofc_sema_stmt_io_read__cleanup(s);
 		return NULL;
@@ -301,14 +180,14 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_read(
 	bool is_nonadvance = false;
 	if (ca_advance && s.io_read.stdin)
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"ADVANCE specifier can only be used with an external UNIT in READ");
 		ofc_sema_stmt_io_read__cleanup(s);
 		return NULL;
 	}
 	else if (ca_advance && (!ca_format || s.io_read.format_ldio))
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"ADVANCE specifier can only be used with a formatted input in READ");
 		ofc_sema_stmt_io_read__cleanup(s);
 		return NULL;
@@ -323,37 +202,16 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_read(
 			return NULL;
 		}
 
-		const ofc_sema_type_t* etype
-			= ofc_sema_expr_type(s.io_read.advance);
-		if (!etype)
+		ofc_sema_call_arg_e value;
+		if (!ofc_sema_io_spec_value(
+			OFC_SEMA_IO_STMT_READ, OFC_SEMA_IO_SPEC_ADVANCE,
+			stmt->src, s.io_read.advance, &value))
 		{
 			ofc_sema_stmt_io_read__cleanup(s);
 			return NULL;
 		}
 
-		if (etype->type != OFC_SEMA_TYPE_CHARACTER)
-		{
-			ofc_sparse_ref_error(stmt->src,
-				"ADVANCE must be a CHARACTER expression in READ");
-			ofc_sema_stmt_io_read__cleanup(s);
-			return NULL;
-		}
-		else
-		{
-			const ofc_sema_typeval_t* constant
-				= ofc_sema_expr_constant(s.io_read.advance);
-
-			is_nonadvance = (constant
-				&& ofc_typeval_character_equal_strz_ci(constant, "NO"));
-			if (constant && !is_nonadvance
-				&& !ofc_typeval_character_equal_strz_ci(constant, "YES"))
-			{
-				ofc_sparse_ref_error(stmt->src,
-					"ADVANCE must be YES/NO in WRITE");
-				ofc_sema_stmt_io_read__cleanup(s);
-				return NULL;
-			}
-		}
+		is_nonadvance = (value == OFC_SEMA_CALL_ARG_ADVANCE_NO);
 	}
 
 	if (ca_end)
@@ -401,7 +259,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_read(
 
 		if (s.io_read.iostat->type != OFC_SEMA_EXPR_LHS)
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"IOSTAT must be a variable in READ");
 			ofc_sema_stmt_io_read__cleanup(s);
 			return NULL;
@@ -417,7 +275,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_read(
 
 		if (!ofc_sema_type_is_integer(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"IOSTAT must be of type INTEGER in READ");
 			ofc_sema_stmt_io_read__cleanup(s);
 			return NULL;
@@ -426,7 +284,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_read(
 
 	if (ca_rec && (s.io_read.format_ldio || ca_end))
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"REC specifier not compatible with END,"
 			" NML or list-directed data transfer in READ");
 		ofc_sema_stmt_io_read__cleanup(s);
@@ -452,7 +310,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_read(
 
 		if (!ofc_sema_type_is_integer(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"REC must be of type INTEGER in READ");
 			ofc_sema_stmt_io_read__cleanup(s);
 			return NULL;
@@ -461,7 +319,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_read(
 
 	if (ca_size && !is_nonadvance)
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"SIZE not compatible with advancing formatted "
 			"sequential data transfer in READ");
 		ofc_sema_stmt_io_read__cleanup(s);
@@ -469,9 +327,17 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_read(
 	}
 	else if (ca_size)
 	{
+		s.io_read.size = ofc_sema_expr(
+			scope, ca_size->expr);
+		if (!s.io_read.size)
+		{
+			ofc_sema_stmt_io_read__cleanup(s);
+			return NULL;
+		}
+
 		if (s.io_read.size->type != OFC_SEMA_EXPR_LHS)
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"SIZE must be a variable in READ");
 			ofc_sema_stmt_io_read__cleanup(s);
 			return NULL;
@@ -491,7 +357,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_read(
 
 		if (!ofc_sema_type_is_integer(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"SIZE must be of type INTEGER in READ");
 			ofc_sema_stmt_io_read__cleanup(s);
 			return NULL;
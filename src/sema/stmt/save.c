@@ -28,7 +28,7 @@ bool ofc_sema_stmt_save(
 	{
 		if (scope->save)
 		{
-			ofc_sparse_ref_warning(stmt->src,
+			ofc_sparse_loc_warning(stmt->src,
 				"Scope already marked as SAVE");
 		}
 
@@ -71,14 +71,14 @@ bool ofc_sema_stmt_save(
 
 			if (decl->is_automatic)
 			{
-				ofc_sparse_ref_error(save->lhs->src,
+				ofc_sparse_loc_error(save->lhs->src,
 					"Can't SAVE an AUTOMATIC declaration");
 				return false;
 			}
 
 			if (decl->is_static)
 			{
-				ofc_sparse_ref_warning(save->lhs->src,
+				ofc_sparse_loc_warning(save->lhs->src,
 					"Redundant definition of SAVE/STATIC attribute");
 			}
 
@@ -51,123 +51,21 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_write(
 	s.io_write.rec          = NULL;
 	s.io_write.iolist       = NULL;
 
-	ofc_parse_call_arg_t* ca_unit    = NULL;
-	ofc_parse_call_arg_t* ca_format  = NULL;
-	ofc_parse_call_arg_t* ca_iostat  = NULL;
-	ofc_parse_call_arg_t* ca_rec     = NULL;
-	ofc_parse_call_arg_t* ca_err     = NULL;
-	ofc_parse_call_arg_t* ca_advance = NULL;
-
-	unsigned i;
-	for (i = 0; i < stmt->io.params->count; i++)
-	{
-		ofc_parse_call_arg_t* param
-			= stmt->io.params->call_arg[i];
-		if (!param) continue;
+	const ofc_parse_call_arg_t* ca[OFC_SEMA_IO_SPEC_COUNT];
+	if (!ofc_sema_io_spec_resolve(
+		OFC_SEMA_IO_STMT_WRITE, stmt->io.params, ca))
+		return NULL;
 
-		if (ofc_sparse_ref_empty(param->name))
-		{
-			if (i >= 2)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Un-named parameter %u has no meaning in WRITE.", i);
-				return NULL;
-			}
-
-			if (i == 0)
-			{
-				ca_unit = param;
-			}
-			else
-			{
-				if (!ca_unit)
-				{
-					ofc_sparse_ref_error(param->src,
-						"Un-named format parameter only valid after UNIT in WRITE.");
-					return NULL;
-				}
-
-				ca_format = param;
-			}
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "UNIT"))
-		{
-			if (ca_unit)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of UNIT in WRITE.");
-				return NULL;
-			}
-
-			ca_unit = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "FMT"))
-		{
-			if (ca_format)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of FMT in WRITE.");
-				return NULL;
-			}
-
-			ca_format = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "IOSTAT"))
-		{
-			if (ca_iostat)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of IOSTAT in WRITE.");
-				return NULL;
-			}
-
-			ca_iostat = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "REC"))
-		{
-			if (ca_rec)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of REC in WRITE.");
-				return NULL;
-			}
-
-			ca_rec = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "ERR"))
-		{
-			if (ca_err)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of ERR in WRITE.");
-				return NULL;
-			}
-
-			ca_err = param;
-		}
-		else if (ofc_str_ref_equal_strz_ci(param->name.string, "ADVANCE"))
-		{
-			if (ca_advance)
-			{
-				ofc_sparse_ref_error(param->src,
-					"Re-definition of ADVANCE in WRITE.");
-				return NULL;
-			}
-
-			ca_advance = param;
-		}
-		else
-		{
-			ofc_sparse_ref_error(param->src,
-				"Unrecognized paramater %u name '%.*s' in WRITE.",
-				i, param->name.string.size, param->name.string.base);
-			return NULL;
-		}
-	}
+	const ofc_parse_call_arg_t* ca_unit    = ca[OFC_SEMA_IO_SPEC_UNIT];
+	const ofc_parse_call_arg_t* ca_format  = ca[OFC_SEMA_IO_SPEC_FMT];
+	const ofc_parse_call_arg_t* ca_iostat  = ca[OFC_SEMA_IO_SPEC_IOSTAT];
+	const ofc_parse_call_arg_t* ca_rec     = ca[OFC_SEMA_IO_SPEC_REC];
+	const ofc_parse_call_arg_t* ca_err     = ca[OFC_SEMA_IO_SPEC_ERR];
+	const ofc_parse_call_arg_t* ca_advance = ca[OFC_SEMA_IO_SPEC_ADVANCE];
 
 	if (!ca_unit)
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"No UNIT defined in WRITE.");
 		return NULL;
 	}
@@ -194,7 +92,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_write(
 			&& (!ofc_sema_type_is_integer(etype)
 				|| !ofc_sema_expr_validate_uint(s.io_write.unit)))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				   "UNIT must be a positive INTEGER "
 				   "or a CHARACTER expression in WRITE");
 			ofc_sema_stmt_io_write__cleanup(s);
@@ -203,7 +101,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_write(
 	}
 	else
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"UNIT must be an INTEGER or CHARACTER "
 			"expression, or asterisk in WRITE");
 		return NULL;
@@ -243,7 +141,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_write(
 		{
 			/* TODO - Support INTEGER array formats. */
 
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"Format (FMT) must be a label or character string in WRITE");
 			ofc_sema_stmt_io_write__cleanup(s);
 			return NULL;
@@ -251,7 +149,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_write(
 	}
 	else if (ca_format)
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"Format (FMT) must be an INTEGER expression or asterisk in WRITE");
 		ofc_sema_stmt_io_write__cleanup(s);
 		return NULL;
@@ -259,14 +157,14 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_write(
 
 	if (ca_advance && s.io_write.stdout)
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"ADVANCE specifier can only be used with an external UNIT in WRITE");
 		ofc_sema_stmt_io_write__cleanup(s);
 		return NULL;
 	}
 	else if (ca_advance && (!ca_format || s.io_write.format_ldio))
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"ADVANCE specifier can only be used with a formatted input in WRITE");
 		ofc_sema_stmt_io_write__cleanup(s);
 		return NULL;
@@ -281,36 +179,13 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_write(
 			return NULL;
 		}
 
-		const ofc_sema_type_t* etype
-			= ofc_sema_expr_type(s.io_write.advance);
-		if (!etype)
-		{
-			ofc_sema_stmt_io_write__cleanup(s);
-			return NULL;
-		}
-
-		if (etype->type != OFC_SEMA_TYPE_CHARACTER)
+		if (!ofc_sema_io_spec_value(
+			OFC_SEMA_IO_STMT_WRITE, OFC_SEMA_IO_SPEC_ADVANCE,
+			stmt->src, s.io_write.advance, NULL))
 		{
-			ofc_sparse_ref_error(stmt->src,
-				"ADVANCE must be a CHARACTER expression in WRITE");
 			ofc_sema_stmt_io_write__cleanup(s);
 			return NULL;
 		}
-		else
-		{
-			const ofc_sema_typeval_t* constant
-				= ofc_sema_expr_constant(s.io_write.advance);
-
-			if (constant
-				&& !ofc_typeval_character_equal_strz_ci(constant, "NO")
-				&& !ofc_typeval_character_equal_strz_ci(constant, "YES"))
-			{
-				ofc_sparse_ref_error(stmt->src,
-					"ADVANCE must be YES/NO in WRITE");
-				ofc_sema_stmt_io_write__cleanup(s);
-				return NULL;
-			}
-		}
 	}
 
 	if (ca_iostat)
@@ -325,7 +200,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_write(
 
 		if (s.io_write.iostat->type != OFC_SEMA_EXPR_LHS)
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"IOSTAT must be a variable in WRITE");
 			ofc_sema_stmt_io_write__cleanup(s);
 			return NULL;
@@ -341,7 +216,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_write(
 
 		if (!ofc_sema_type_is_integer(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"IOSTAT must be of type INTEGER in WRITE");
 			ofc_sema_stmt_io_write__cleanup(s);
 			return NULL;
@@ -350,7 +225,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_write(
 
 	if (ca_rec && s.io_write.format_ldio)
 	{
-		ofc_sparse_ref_error(stmt->src,
+		ofc_sparse_loc_error(stmt->src,
 			"REC specifier not compatible with namelist"
 			" or list-directed data transfer in WRITE");
 		ofc_sema_stmt_io_write__cleanup(s);
@@ -376,7 +251,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_io_write(
 
 		if (!ofc_sema_type_is_integer(etype))
 		{
-			ofc_sparse_ref_error(stmt->src,
+			ofc_sparse_loc_error(stmt->src,
 				"REC must be of type INTEGER in WRITE");
 			ofc_sema_stmt_io_write__cleanup(s);
 			return NULL;
@@ -0,0 +1,759 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+
+#include "ofc/sema.h"
+
+
+/* Union-find node, delta is the offset of this node's storage relative
+   to its parent. COMMON blocks get a node with no decl as an anchor. */
+typedef struct
+{
+	const ofc_sema_decl_t*   decl;
+	const ofc_sema_common_t* common;
+
+	unsigned parent;
+	unsigned rank;
+	int64_t  delta;
+
+	bool     sized;
+	unsigned size;
+} ofc_sema_storage__node_t;
+
+typedef struct
+{
+	unsigned                  count, max_count;
+	ofc_sema_storage__node_t* node;
+
+	unsigned                 map_size;
+	ofc_sema_storage_slot_t* map;
+} ofc_sema_storage__build_t;
+
+
+static ofc_sema_storage_slot_t* ofc_sema_storage__map_create(
+	unsigned count, unsigned* size)
+{
+	unsigned map_size;
+	for (map_size = 16; map_size < (count * 2); map_size <<= 1);
+
+	ofc_sema_storage_slot_t* map
+		= (ofc_sema_storage_slot_t*)malloc(
+			sizeof(ofc_sema_storage_slot_t) * map_size);
+	if (!map) return NULL;
+
+	unsigned i;
+	for (i = 0; i < map_size; i++)
+	{
+		map[i].decl  = NULL;
+		map[i].index = 0;
+	}
+
+	*size = map_size;
+	return map;
+}
+
+/* Returns the slot for decl, which is either empty or holds its index. */
+static ofc_sema_storage_slot_t* ofc_sema_storage__map_slot(
+	ofc_sema_storage_slot_t* map, unsigned map_size,
+	const ofc_sema_decl_t* decl)
+{
+	uint64_t h = (uintptr_t)decl;
+	h ^= (h >> 33);
+	h *= 0xFF51AFD7ED558CCDULL;
+	h ^= (h >> 33);
+
+	unsigned i;
+	for (i = (h & (map_size - 1)); map[i].decl && (map[i].decl != decl);
+		i = ((i + 1) & (map_size - 1)));
+	return &map[i];
+}
+
+
+static bool ofc_sema_storage__node_add(
+	ofc_sema_storage__build_t* build,
+	const ofc_sema_decl_t* decl,
+	const ofc_sema_common_t* common,
+	unsigned* index)
+{
+	ofc_sema_storage_slot_t* slot = NULL;
+	if (decl)
+	{
+		slot = ofc_sema_storage__map_slot(
+			build->map, build->map_size, decl);
+		if (slot->decl)
+		{
+			*index = slot->index;
+			return true;
+		}
+	}
+
+	if (build->count >= build->max_count)
+		return false;
+
+	ofc_sema_storage__node_t* node
+		= &build->node[build->count];
+
+	node->decl   = decl;
+	node->common = common;
+	node->parent = build->count;
+	node->rank   = 0;
+	node->delta  = 0;
+
+	node->sized = (!decl || ofc_sema_decl_size(decl, &node->size));
+	if (!node->sized || !decl) node->size = 0;
+
+	if (slot)
+	{
+		slot->decl  = decl;
+		slot->index = build->count;
+	}
+
+	*index = build->count++;
+	return true;
+}
+
+static unsigned ofc_sema_storage__find(
+	ofc_sema_storage__build_t* build, unsigned n, int64_t* offset)
+{
+	int64_t  o = 0;
+	unsigned r;
+	for (r = n; build->node[r].parent != r; r = build->node[r].parent)
+		o += build->node[r].delta;
+
+	/* Compress the path so every node points directly at the root. */
+	int64_t remain = o;
+	while (build->node[n].parent != r)
+	{
+		unsigned next  = build->node[n].parent;
+		int64_t  delta = build->node[n].delta;
+
+		build->node[n].parent = r;
+		build->node[n].delta  = remain;
+
+		remain -= delta;
+		n = next;
+	}
+
+	if (offset) *offset = o;
+	return r;
+}
+
+/* Associates b so its storage starts delta bytes after a,
+   returns false if that conflicts with an existing association. */
+static bool ofc_sema_storage__union(
+	ofc_sema_storage__build_t* build,
+	unsigned a, unsigned b, int64_t delta)
+{
+	int64_t oa, ob;
+	unsigned ra = ofc_sema_storage__find(build, a, &oa);
+	unsigned rb = ofc_sema_storage__find(build, b, &ob);
+
+	int64_t d = delta + oa - ob;
+	if (ra == rb)
+		return (d == 0);
+
+	if (build->node[ra].rank < build->node[rb].rank)
+	{
+		build->node[ra].parent = rb;
+		build->node[ra].delta  = -d;
+	}
+	else
+	{
+		build->node[rb].parent = ra;
+		build->node[rb].delta  = d;
+		if (build->node[ra].rank == build->node[rb].rank)
+			build->node[ra].rank++;
+	}
+
+	return true;
+}
+
+
+static bool ofc_sema_storage__lhs_offset(
+	const ofc_sema_lhs_t* lhs, unsigned* offset)
+{
+	if (!lhs)
+		return false;
+
+	switch (lhs->type)
+	{
+		case OFC_SEMA_LHS_DECL:
+			*offset = 0;
+			return true;
+
+		case OFC_SEMA_LHS_ARRAY_INDEX:
+		{
+			if (!lhs->parent
+				|| (lhs->parent->type != OFC_SEMA_LHS_DECL)
+				|| !lhs->index)
+				return false;
+
+			const ofc_sema_decl_t* decl = lhs->parent->decl;
+
+			unsigned i;
+			for (i = 0; i < lhs->index->dimensions; i++)
+			{
+				if (!ofc_sema_expr_constant(
+					lhs->index->index[i]))
+					return false;
+			}
+
+			unsigned elem, esize;
+			if (!ofc_sema_array_index_offset(
+				decl, lhs->index, &elem)
+				|| !ofc_sema_type_size(decl->type, &esize))
+				return false;
+
+			*offset = (elem * esize);
+			return true;
+		}
+
+		case OFC_SEMA_LHS_SUBSTRING:
+		{
+			unsigned poff;
+			if (!ofc_sema_storage__lhs_offset(
+				lhs->parent, &poff))
+				return false;
+
+			int first = 1;
+			if (lhs->substring.first
+				&& !ofc_sema_expr_resolve_int(
+					lhs->substring.first, &first))
+				return false;
+			if (first < 1)
+				return false;
+
+			unsigned csize;
+			if (!ofc_sema_type_base_size(
+				ofc_sema_lhs_type(lhs->parent), &csize))
+				return false;
+
+			*offset = poff + ((first - 1) * csize);
+			return true;
+		}
+
+		default:
+			break;
+	}
+
+	return false;
+}
+
+
+static bool ofc_sema_storage__layout(
+	ofc_sema_storage__build_t* build,
+	const ofc_sema_scope_t* scope)
+{
+	unsigned i;
+	for (i = 0; scope->common && (i < scope->common->count); i++)
+	{
+		const ofc_sema_common_t* common
+			= scope->common->common[i];
+		if (!common) continue;
+
+		unsigned anchor;
+		if (!ofc_sema_storage__node_add(
+			build, NULL, common, &anchor))
+			return false;
+
+		unsigned j, offset;
+		for (j = 0, offset = 0; j < common->count; j++)
+		{
+			unsigned n;
+			if (!ofc_sema_storage__node_add(
+				build, common->decl[j], NULL, &n))
+				return false;
+
+			if (!ofc_sema_storage__union(
+				build, anchor, n, offset))
+			{
+				ofc_sparse_ref_warning(common->decl[j]->name,
+					"COMMON member conflicts with existing storage association");
+			}
+
+			/* We can't place anything after a member of unknown size. */
+			if (!build->node[n].sized)
+				break;
+			offset += build->node[n].size;
+		}
+	}
+
+	for (i = 0; scope->equiv && (i < scope->equiv->count); i++)
+	{
+		const ofc_sema_equiv_t* equiv
+			= scope->equiv->equiv[i];
+		if (!equiv) continue;
+
+		bool     has_base = false;
+		unsigned base, base_off = 0;
+
+		unsigned j;
+		for (j = 0; j < equiv->count; j++)
+		{
+			ofc_sema_lhs_t* lhs = equiv->lhs[j];
+
+			const ofc_sema_decl_t* decl
+				= ofc_sema_lhs_decl(lhs);
+			unsigned offset;
+			if (!decl || !ofc_sema_storage__lhs_offset(lhs, &offset))
+			{
+				ofc_sparse_loc_warning(lhs->src,
+					"Can't resolve storage of EQUIVALENCE element");
+				continue;
+			}
+
+			unsigned n;
+			if (!ofc_sema_storage__node_add(
+				build, decl, NULL, &n))
+				return false;
+
+			if (!has_base)
+			{
+				has_base = true;
+				base     = n;
+				base_off = offset;
+			}
+			else if (!ofc_sema_storage__union(build, base, n,
+				((int64_t)base_off - (int64_t)offset)))
+			{
+				ofc_sparse_loc_warning(lhs->src,
+					"EQUIVALENCE conflicts with existing storage association");
+			}
+		}
+	}
+
+	return true;
+}
+
+static unsigned ofc_sema_storage__max_nodes(
+	const ofc_sema_scope_t* scope)
+{
+	unsigned count = 0;
+
+	unsigned i;
+	for (i = 0; scope->common && (i < scope->common->count); i++)
+	{
+		const ofc_sema_common_t* common
+			= scope->common->common[i];
+		if (common) count += (common->count + 1);
+	}
+
+	for (i = 0; scope->equiv && (i < scope->equiv->count); i++)
+	{
+		const ofc_sema_equiv_t* equiv
+			= scope->equiv->equiv[i];
+		if (equiv) count += equiv->count;
+	}
+
+	return count;
+}
+
+
+static int ofc_sema_storage__entry_compare(
+	const void* a, const void* b)
+{
+	const ofc_sema_storage_entry_t* ea = a;
+	const ofc_sema_storage_entry_t* eb = b;
+
+	if (ea->class != eb->class)
+		return (ea->class < eb->class ? -1 : 1);
+	if (ea->offset != eb->offset)
+		return (ea->offset < eb->offset ? -1 : 1);
+	if (ea->size != eb->size)
+		return (ea->size < eb->size ? -1 : 1);
+
+	/* Keep the order stable by falling back to source position. */
+	uintptr_t pa = (uintptr_t)ea->decl->name.string.base;
+	uintptr_t pb = (uintptr_t)eb->decl->name.string.base;
+	if (pa != pb)
+		return (pa < pb ? -1 : 1);
+	return 0;
+}
+
+static unsigned ofc_sema_storage__tree_build(
+	ofc_sema_storage_t* storage,
+	unsigned lo, unsigned hi)
+{
+	if (lo >= hi)
+		return 0;
+
+	unsigned mid = lo + ((hi - lo) / 2);
+
+	unsigned max = storage->entry[mid].offset
+		+ storage->entry[mid].size;
+
+	unsigned l = ofc_sema_storage__tree_build(storage, lo, mid);
+	unsigned r = ofc_sema_storage__tree_build(storage, (mid + 1), hi);
+	if (l > max) max = l;
+	if (r > max) max = r;
+
+	storage->max_end[mid] = max;
+	return max;
+}
+
+static bool ofc_sema_storage__index(
+	ofc_sema_storage_t* storage)
+{
+	qsort(storage->entry, storage->count,
+		sizeof(ofc_sema_storage_entry_t),
+		ofc_sema_storage__entry_compare);
+
+	storage->max_end = (unsigned*)malloc(
+		sizeof(unsigned) * (storage->count + 1));
+	storage->map = ofc_sema_storage__map_create(
+		storage->count, &storage->map_size);
+	if (!storage->max_end || !storage->map)
+		return false;
+
+	unsigned i;
+	for (i = 0; i < storage->count; i++)
+	{
+		ofc_sema_storage_class_t* class
+			= &storage->class[storage->entry[i].class];
+		if (class->count == 0)
+			class->first = i;
+		class->count++;
+
+		ofc_sema_storage_slot_t* slot
+			= ofc_sema_storage__map_slot(
+				storage->map, storage->map_size,
+				storage->entry[i].decl);
+		slot->decl  = storage->entry[i].decl;
+		slot->index = i;
+	}
+
+	for (i = 0; i < storage->class_count; i++)
+	{
+		const ofc_sema_storage_class_t* class
+			= &storage->class[i];
+		ofc_sema_storage__tree_build(storage,
+			class->first, (class->first + class->count));
+	}
+
+	return true;
+}
+
+static bool ofc_sema_storage__classify(
+	ofc_sema_storage_t* storage,
+	ofc_sema_storage__build_t* build)
+{
+	unsigned* class_id = (unsigned*)malloc(
+		sizeof(unsigned) * (build->count + 1));
+	int64_t*  class_base = (int64_t*)malloc(
+		sizeof(int64_t) * (build->count + 1));
+	int64_t*  node_off = (int64_t*)malloc(
+		sizeof(int64_t) * (build->count + 1));
+	storage->class = (ofc_sema_storage_class_t*)malloc(
+		sizeof(ofc_sema_storage_class_t) * (build->count + 1));
+	storage->entry = (ofc_sema_storage_entry_t*)malloc(
+		sizeof(ofc_sema_storage_entry_t) * (build->count + 1));
+
+	if (!class_id || !class_base || !node_off
+		|| !storage->class || !storage->entry)
+	{
+		free(node_off);
+		free(class_base);
+		free(class_id);
+		return false;
+	}
+
+	unsigned i;
+	for (i = 0; i < build->count; i++)
+		class_id[i] = build->count;
+
+	/* Number classes in the order they're first seen, a class is based
+	   at its COMMON block or otherwise at its lowest offset. */
+	for (i = 0; i < build->count; i++)
+	{
+		unsigned r = ofc_sema_storage__find(build, i, &node_off[i]);
+		if (class_id[r] == build->count)
+		{
+			class_id[r] = storage->class_count++;
+			class_base[class_id[r]] = node_off[i];
+
+			ofc_sema_storage_class_t* class
+				= &storage->class[class_id[r]];
+			class->common = NULL;
+			class->size   = 0;
+			class->first  = 0;
+			class->count  = 0;
+		}
+
+		unsigned c = class_id[r];
+		ofc_sema_storage_class_t* class = &storage->class[c];
+
+		const ofc_sema_common_t* common
+			= build->node[i].common;
+		if (common)
+		{
+			if (class->common)
+			{
+				ofc_sparse_ref_warning(
+					(common->count > 0 ? common->decl[0]->name : OFC_SPARSE_REF_EMPTY),
+					"EQUIVALENCE associates COMMON /%.*s/ with /%.*s/",
+					class->common->name.size, class->common->name.base,
+					common->name.size, common->name.base);
+				continue;
+			}
+
+			class->common = common;
+			class_base[c] = node_off[i];
+		}
+		else if (!class->common
+			&& (node_off[i] < class_base[c]))
+		{
+			class_base[c] = node_off[i];
+		}
+	}
+
+	for (i = 0; i < build->count; i++)
+	{
+		if (!build->node[i].decl)
+			continue;
+
+		unsigned c = class_id[ofc_sema_storage__find(build, i, NULL)];
+		ofc_sema_storage_class_t* class = &storage->class[c];
+
+		int64_t offset = node_off[i] - class_base[c];
+		if (offset < 0)
+		{
+			ofc_sparse_ref_warning(build->node[i].decl->name,
+				"EQUIVALENCE extends COMMON /%.*s/ before its start",
+				class->common->name.size, class->common->name.base);
+			offset = 0;
+		}
+
+		ofc_sema_storage_entry_t* entry
+			= &storage->entry[storage->count++];
+		entry->decl   = build->node[i].decl;
+		entry->class  = c;
+		entry->offset = offset;
+		entry->size   = build->node[i].size;
+
+		if ((entry->offset + entry->size) > class->size)
+			class->size = (entry->offset + entry->size);
+	}
+
+	free(node_off);
+	free(class_base);
+	free(class_id);
+	return true;
+}
+
+ofc_sema_storage_t* ofc_sema_storage_create(
+	const ofc_sema_scope_t* scope)
+{
+	if (!scope)
+		return NULL;
+
+	ofc_sema_storage_t* storage
+		= (ofc_sema_storage_t*)malloc(
+			sizeof(ofc_sema_storage_t));
+	if (!storage) return NULL;
+
+	storage->count       = 0;
+	storage->entry       = NULL;
+	storage->max_end     = NULL;
+	storage->class_count = 0;
+	storage->class       = NULL;
+	storage->map_size    = 0;
+	storage->map         = NULL;
+
+	ofc_sema_storage__build_t build;
+	build.count     = 0;
+	build.max_count = ofc_sema_storage__max_nodes(scope);
+	build.node = (ofc_sema_storage__node_t*)malloc(
+		sizeof(ofc_sema_storage__node_t) * (build.max_count + 1));
+	build.map = ofc_sema_storage__map_create(
+		build.max_count, &build.map_size);
+
+	bool success = (build.node && build.map
+		&& ofc_sema_storage__layout(&build, scope)
+		&& ofc_sema_storage__classify(storage, &build)
+		&& ofc_sema_storage__index(storage));
+
+	free(build.map);
+	free(build.node);
+
+	if (!success)
+	{
+		ofc_sema_storage_delete(storage);
+		return NULL;
+	}
+
+	return storage;
+}
+
+void ofc_sema_storage_delete(
+	ofc_sema_storage_t* storage)
+{
+	if (!storage)
+		return;
+
+	free(storage->map);
+	free(storage->class);
+	free(storage->max_end);
+	free(storage->entry);
+	free(storage);
+}
+
+
+const ofc_sema_storage_entry_t* ofc_sema_storage_find(
+	const ofc_sema_storage_t* storage,
+	const ofc_sema_decl_t* decl)
+{
+	if (!storage || !decl
+		|| !storage->map)
+		return NULL;
+
+	const ofc_sema_storage_slot_t* slot
+		= ofc_sema_storage__map_slot(
+			storage->map, storage->map_size, decl);
+	return (slot->decl ? &storage->entry[slot->index] : NULL);
+}
+
+
+static bool ofc_sema_storage__overlap(
+	const ofc_sema_storage_t* storage,
+	unsigned lo, unsigned hi,
+	unsigned first, unsigned last,
+	void* param,
+	bool (*func)(const ofc_sema_storage_entry_t* entry, void* param))
+{
+	while (lo < hi)
+	{
+		unsigned mid = lo + ((hi - lo) / 2);
+
+		/* Nothing in this subtree ends after the range starts. */
+		if (storage->max_end[mid] <= first)
+			return true;
+
+		if (!ofc_sema_storage__overlap(storage,
+			lo, mid, first, last, param, func))
+			return false;
+
+		/* Entries are sorted by offset, so nothing to the right can overlap. */
+		const ofc_sema_storage_entry_t* entry
+			= &storage->entry[mid];
+		if (entry->offset >= last)
+			return true;
+
+		if (((entry->offset + entry->size) > first)
+			&& !func(entry, param))
+			return false;
+
+		lo = (mid + 1);
+	}
+
+	return true;
+}
+
+bool ofc_sema_storage_overlap(
+	const ofc_sema_storage_t* storage,
+	unsigned class, unsigned offset, unsigned size,
+	void* param,
+	bool (*func)(const ofc_sema_storage_entry_t* entry, void* param))
+{
+	if (!storage || !func
+		|| (class >= storage->class_count))
+		return false;
+
+	if (size == 0)
+		return true;
+
+	const ofc_sema_storage_class_t* c
+		= &storage->class[class];
+	return ofc_sema_storage__overlap(
+		storage, c->first, (c->first + c->count),
+		offset, (offset + size), param, func);
+}
+
+
+typedef struct
+{
+	const ofc_sema_decl_t* decl;
+	void* param;
+	bool (*func)(const ofc_sema_storage_entry_t* entry, void* param);
+} ofc_sema_storage__alias_t;
+
+static bool ofc_sema_storage__alias(
+	const ofc_sema_storage_entry_t* entry, void* param)
+{
+	ofc_sema_storage__alias_t* alias = param;
+	if (entry->decl == alias->decl)
+		return true;
+	return alias->func(entry, alias->param);
+}
+
+bool ofc_sema_storage_alias(
+	const ofc_sema_storage_t* storage,
+	const ofc_sema_decl_t* decl,
+	void* param,
+	bool (*func)(const ofc_sema_storage_entry_t* entry, void* param))
+{
+	const ofc_sema_storage_entry_t* entry
+		= ofc_sema_storage_find(storage, decl);
+	if (!entry || !func)
+		return false;
+
+	ofc_sema_storage__alias_t alias
+		= { .decl = decl, .param = param, .func = func };
+	return ofc_sema_storage_overlap(
+		storage, entry->class, entry->offset, entry->size,
+		&alias, ofc_sema_storage__alias);
+}
+
+
+bool ofc_sema_storage_print(
+	const ofc_sema_storage_t* storage)
+{
+	if (!storage)
+		return false;
+
+	unsigned c;
+	for (c = 0; c < storage->class_count; c++)
+	{
+		const ofc_sema_storage_class_t* class
+			= &storage->class[c];
+		if (class->count == 0)
+			continue;
+
+		if (class->common)
+		{
+			printf("  /%.*s/:%u\n",
+				class->common->name.size,
+				class->common->name.base,
+				class->size);
+		}
+		else
+		{
+			printf("  EQUIVALENCE:%u\n", class->size);
+		}
+
+		unsigned i;
+		for (i = 0; i < class->count; i++)
+		{
+			const ofc_sema_storage_entry_t* entry
+				= &storage->entry[class->first + i];
+			printf("    %.*s:%u:%u\n",
+				entry->decl->name.string.size,
+				entry->decl->name.string.base,
+				entry->offset, entry->size);
+		}
+	}
+
+	return true;
+}
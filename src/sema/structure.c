@@ -27,6 +27,18 @@ static const ofc_str_ref_t* ofc_structure__member_name(
 }
 
 
+static void ofc_sema_structure__layout_delete(
+	ofc_sema_structure_layout_t* layout)
+{
+	if (!layout)
+		return;
+
+	ofc_hashmap_delete(layout->map);
+	free(layout->entry);
+	free(layout);
+}
+
+
 static ofc_sema_structure_t* ofc_sema__structure(
 	ofc_sema_scope_t* scope,
 	const ofc_parse_stmt_t* stmt)
@@ -35,7 +47,8 @@ static ofc_sema_structure_t* ofc_sema__structure(
 		return NULL;
 
 	const ofc_lang_opts_t* opts
-		= ofc_sparse_lang_opts(stmt->src.sparse);
+		= ofc_sparse_lang_opts(
+			ofc_sparse_loc_ref(stmt->src).sparse);
 	if (!opts) return NULL;
 
 	ofc_sema_structure_e type;
@@ -98,6 +111,8 @@ static ofc_sema_structure_t* ofc_sema__structure(
 	structure->count  = 0;
 	structure->member = NULL;
 
+	structure->layout = NULL;
+
 	structure->refcnt = 0;
 
 	if (stmt->structure.block)
@@ -127,14 +142,14 @@ static ofc_sema_structure_t* ofc_sema__structure(
 				if (structure->type
 					== OFC_SEMA_STRUCTURE_F90_TYPE_SEQUENCE)
 				{
-					ofc_sparse_ref_warning(
+					ofc_sparse_loc_warning(
 						stmt->structure.block->stmt[i]->src,
 						"Redundant SEQUENCE statement in TYPE");
 				}
 				else if (structure->type
 					!= OFC_SEMA_STRUCTURE_F90_TYPE)
 				{
-					ofc_sparse_ref_warning(
+					ofc_sparse_loc_warning(
 						stmt->structure.block->stmt[i]->src,
 						"SEQUENCE statement invalid"
 						" for VAX structures, ignoring");
@@ -168,6 +183,15 @@ static ofc_sema_structure_t* ofc_sema__structure(
 		}
 	}
 
+	/* Discard any layout computed before the member types were final. */
+	ofc_sema_structure__layout_delete(structure->layout);
+	structure->layout = NULL;
+	if (!ofc_sema_structure_layout(structure))
+	{
+		ofc_sema_structure_delete(structure);
+		return NULL;
+	}
+
 	return structure;
 }
 
@@ -251,6 +275,9 @@ void ofc_sema_structure_delete(
 
 	ofc_hashmap_delete(structure->map);
 
+	ofc_sema_structure__layout_delete(
+		structure->layout);
+
 	unsigned i;
 	for (i = 0; i < structure->count; i++)
 	{
@@ -306,6 +333,9 @@ static bool ofc_sema_structure__member_add(
 		structure->map, member))
 		return false;
 
+	ofc_sema_structure__layout_delete(structure->layout);
+	structure->layout = NULL;
+
 	structure->member[structure->count++] = member;
 	return true;
 }
@@ -387,68 +417,260 @@ bool ofc_sema_structure_member_add_structure(
 }
 
 
-bool ofc_sema_structure_member_count(
-	const ofc_sema_structure_t* structure,
+static const ofc_str_ref_t* ofc_sema_structure__layout_entry_name(
+	const ofc_sema_structure_layout_entry_t* entry)
+{
+	return (entry ? ofc_structure__member_name(entry->member) : NULL);
+}
+
+static bool ofc_sema_structure__member_size(
+	const ofc_sema_structure_member_t* member,
+	unsigned* size)
+{
+	if (member->is_structure)
+		return ofc_sema_structure_size(
+			member->structure, size);
+	return ofc_sema_decl_size(
+		member->decl, size);
+}
+
+static bool ofc_sema_structure__member_elem_count(
+	const ofc_sema_structure_member_t* member,
 	unsigned* count)
 {
-	if (!structure)
-		return false;
+	if (member->is_structure)
+		return ofc_sema_structure_elem_count(
+			member->structure, count);
+	return ofc_sema_decl_elem_count(
+		member->decl, count);
+}
 
-	unsigned i, c;
-	for (i = 0, c = 0; i < structure->count; i++)
+/* Adds the named members of each level before those of its anonymous
+   members, in order, so the nearest declaration of a name wins. */
+static bool ofc_sema_structure__layout_map(
+	ofc_sema_structure_layout_t* layout,
+	const ofc_sema_structure_t* structure,
+	unsigned first)
+{
+	unsigned i, e;
+	for (i = 0, e = first; i < structure->count; i++)
 	{
-		unsigned rc = 1;
-		if (ofc_sema_structure__member_anon(
-			structure->member[i]))
+		ofc_sema_structure_member_t* member
+			= structure->member[i];
+
+		if (ofc_sema_structure__member_anon(member))
 		{
-			if (!ofc_sema_structure_member_count(
-				structure->member[i]->structure, &rc))
-				return false;
+			const ofc_sema_structure_layout_t* mlayout
+				= ofc_sema_structure_layout(member->structure);
+			if (!mlayout) return false;
+			e += mlayout->count;
+			continue;
 		}
-		c += rc;
+
+		ofc_sema_structure_layout_entry_t* entry
+			= &layout->entry[e++];
+		if (!ofc_hashmap_find(layout->map,
+			ofc_sema_structure__layout_entry_name(entry))
+			&& !ofc_hashmap_add(layout->map, entry))
+			return false;
+	}
+
+	for (i = 0, e = first; i < structure->count; i++)
+	{
+		ofc_sema_structure_member_t* member
+			= structure->member[i];
+
+		if (!ofc_sema_structure__member_anon(member))
+		{
+			e++;
+			continue;
+		}
+
+		if (!ofc_sema_structure__layout_map(
+			layout, member->structure, e))
+			return false;
+		e += member->structure->layout->count;
 	}
 
-	if (count) *count = c;
 	return true;
 }
 
-ofc_sema_decl_t* ofc_sema_structure_member_get_decl_offset(
-	ofc_sema_structure_t* structure,
-	unsigned offset)
+const ofc_sema_structure_layout_t* ofc_sema_structure_layout(
+	const ofc_sema_structure_t* structure)
 {
-	if (!structure
-		|| !structure->member)
+	if (!structure)
 		return NULL;
 
-	unsigned i, o;
-	for (i = 0, o = offset; i < structure->count; i++)
+	if (structure->layout)
+		return structure->layout;
+
+	ofc_sema_structure_layout_t* layout
+		= (ofc_sema_structure_layout_t*)malloc(
+			sizeof(ofc_sema_structure_layout_t));
+	if (!layout) return NULL;
+
+	layout->map = ofc_hashmap_create(
+		(void*)(global_opts.case_sensitive
+			? ofc_str_ref_ptr_hash
+			: ofc_str_ref_ptr_hash_ci),
+		(void*)(global_opts.case_sensitive
+			? ofc_str_ref_ptr_equal
+			: ofc_str_ref_ptr_equal_ci),
+		(void*)ofc_sema_structure__layout_entry_name,
+		NULL);
+	if (!layout->map)
 	{
-		if (ofc_sema_structure__member_anon(
-			structure->member[i]))
+		free(layout);
+		return NULL;
+	}
+
+	layout->count = 0;
+	layout->entry = NULL;
+
+	bool is_union = ofc_sema_structure_is_union(structure);
+
+	unsigned i;
+	for (i = 0; i < structure->count; i++)
+	{
+		ofc_sema_structure_member_t* member
+			= structure->member[i];
+
+		if (ofc_sema_structure__member_anon(member))
 		{
-			unsigned count;
-			if (!ofc_sema_structure_member_count(
-				structure->member[i]->structure, &count))
+			const ofc_sema_structure_layout_t* mlayout
+				= ofc_sema_structure_layout(member->structure);
+			if (!mlayout)
+			{
+				ofc_sema_structure__layout_delete(layout);
 				return NULL;
-
-			if (o < count)
-				return ofc_sema_structure_member_get_decl_offset(
-					structure, o);
-			o -= count;
+			}
+			layout->count += mlayout->count;
 		}
 		else
 		{
-			if (o == 0)
+			layout->count++;
+		}
+	}
+
+	if (layout->count > 0)
+	{
+		layout->entry = (ofc_sema_structure_layout_entry_t*)malloc(
+			sizeof(ofc_sema_structure_layout_entry_t) * layout->count);
+		if (!layout->entry)
+		{
+			ofc_sema_structure__layout_delete(layout);
+			return NULL;
+		}
+	}
+
+	unsigned usize = 0, ssize = 0;
+	unsigned ucount = 0, scount = 0;
+	layout->size_valid       = true;
+	layout->elem_count_valid = true;
+
+	unsigned e;
+	for (i = 0, e = 0; i < structure->count; i++)
+	{
+		ofc_sema_structure_member_t* member
+			= structure->member[i];
+
+		unsigned offset = (is_union ? 0 : ssize);
+
+		if (ofc_sema_structure__member_anon(member))
+		{
+			const ofc_sema_structure_layout_t* mlayout
+				= member->structure->layout;
+
+			unsigned j;
+			for (j = 0; j < mlayout->count; j++, e++)
 			{
-				if (structure->member[i]->is_structure)
-					return NULL;
-				return structure->member[i]->decl;
+				layout->entry[e] = mlayout->entry[j];
+				layout->entry[e].offset_valid
+					= (layout->entry[e].offset_valid
+						&& (is_union || layout->size_valid));
+				layout->entry[e].offset += offset;
 			}
-			o -= 1;
+		}
+		else
+		{
+			ofc_sema_structure_layout_entry_t* entry
+				= &layout->entry[e++];
+			entry->member       = member;
+			entry->offset_valid = (is_union || layout->size_valid);
+			entry->offset       = offset;
+			entry->size_valid   = ofc_sema_structure__member_size(
+				member, &entry->size);
+			if (!entry->size_valid)
+				entry->size = 0;
+		}
+
+		unsigned msize;
+		if (layout->size_valid
+			&& ofc_sema_structure__member_size(member, &msize))
+		{
+			if (msize > usize)
+				usize = msize;
+			ssize += msize;
+		}
+		else
+		{
+			layout->size_valid = false;
+		}
+
+		unsigned mcount;
+		if (layout->elem_count_valid
+			&& ofc_sema_structure__member_elem_count(member, &mcount))
+		{
+			if (mcount > ucount)
+				ucount = mcount;
+			scount += mcount;
+		}
+		else
+		{
+			layout->elem_count_valid = false;
 		}
 	}
 
-	return NULL;
+	layout->size       = (is_union ? usize : ssize);
+	layout->elem_count = (is_union ? ucount : scount);
+
+	if (!ofc_sema_structure__layout_map(
+		layout, structure, 0))
+	{
+		ofc_sema_structure__layout_delete(layout);
+		return NULL;
+	}
+
+	/* The layout is a cache, so it's fine to set it through a const. */
+	((ofc_sema_structure_t*)structure)->layout = layout;
+	return layout;
+}
+
+
+bool ofc_sema_structure_member_count(
+	const ofc_sema_structure_t* structure,
+	unsigned* count)
+{
+	const ofc_sema_structure_layout_t* layout
+		= ofc_sema_structure_layout(structure);
+	if (!layout) return false;
+
+	if (count) *count = layout->count;
+	return true;
+}
+
+ofc_sema_decl_t* ofc_sema_structure_member_get_decl_offset(
+	ofc_sema_structure_t* structure,
+	unsigned offset)
+{
+	const ofc_sema_structure_layout_t* layout
+		= ofc_sema_structure_layout(structure);
+	if (!layout || (offset >= layout->count))
+		return NULL;
+
+	const ofc_sema_structure_member_t* member
+		= layout->entry[offset].member;
+	return (member->is_structure ? NULL : member->decl);
 }
 
 ofc_sema_decl_t* ofc_sema_structure_member_get_decl_name(
@@ -458,31 +680,24 @@ ofc_sema_decl_t* ofc_sema_structure_member_get_decl_name(
 	if (!structure)
 		return NULL;
 
+	/* Named members don't need the layout, which is
+	   rebuilt when a member is added. */
 	ofc_sema_structure_member_t* member
 		= ofc_hashmap_find_modify(
 			structure->map, &name);
-	if (member)
-	{
-		if (member->is_structure)
-			return NULL;
-		return member->decl;
-	}
-
-	unsigned i;
-	for (i = 0; i < structure->count; i++)
+	if (!member)
 	{
-		member = structure->member[i];
-		if (!member->is_structure
-			|| !ofc_sema_structure__member_anon(member))
-			continue;
-
-		ofc_sema_decl_t* decl
-			= ofc_sema_structure_member_get_decl_name(
-				member->structure, name);
-		if (decl) return decl;
+		const ofc_sema_structure_layout_t* layout
+			= ofc_sema_structure_layout(structure);
+		if (!layout) return NULL;
+
+		const ofc_sema_structure_layout_entry_t* entry
+			= ofc_hashmap_find(layout->map, &name);
+		if (!entry) return NULL;
+		member = entry->member;
 	}
 
-	return NULL;
+	return (member->is_structure ? NULL : member->decl);
 }
 
 bool ofc_sema_structure_member_offset(
@@ -490,41 +705,31 @@ bool ofc_sema_structure_member_offset(
 	const ofc_sema_decl_t* member,
 	unsigned* offset)
 {
-	if (!structure || !member)
+	if (!member)
 		return false;
 
-	unsigned i, o;
-	for (i = 0, o = 0; i < structure->count; i++)
+	const ofc_sema_structure_layout_t* layout
+		= ofc_sema_structure_layout(structure);
+	if (!layout) return false;
+
+	const ofc_sema_structure_layout_entry_t* entry
+		= ofc_hashmap_find(layout->map, &member->name.string);
+	if (entry && !entry->member->is_structure
+		&& (entry->member->decl == member))
 	{
-		if (!structure->member[i]->is_structure)
-		{
-            if (structure->member[i]->decl == member)
-			{
-				if (offset) *offset = o;
-				return true;
-			}
-			o++;
-		}
-		else if (ofc_sema_structure__member_anon(
-			structure->member[i]))
-		{
-			unsigned ao;
-			if (ofc_sema_structure_member_offset(
-				structure->member[i]->structure, member, &ao))
-			{
-				if (offset) *offset = (o + ao);
-				return true;
-			}
+		if (offset) *offset = (entry - layout->entry);
+		return true;
+	}
 
-			unsigned ac;
-			if (!ofc_sema_structure_member_count(
-				structure->member[i]->structure, &ac))
-				return false;
-			o += ac;
-		}
-		else
+	/* A shadowed name, this shouldn't happen in valid code. */
+	unsigned i;
+	for (i = 0; i < layout->count; i++)
+	{
+		if (!layout->entry[i].member->is_structure
+			&& (layout->entry[i].member->decl == member))
 		{
-			o++;
+			if (offset) *offset = i;
+			return true;
 		}
 	}
 
@@ -590,41 +795,12 @@ bool ofc_sema_structure_size(
 	const ofc_sema_structure_t* structure,
 	unsigned* size)
 {
-	if (!structure)
+	const ofc_sema_structure_layout_t* layout
+		= ofc_sema_structure_layout(structure);
+	if (!layout || !layout->size_valid)
 		return false;
 
-	unsigned usize = 0;
-	unsigned ssize = 0;
-	unsigned i;
-	for (i = 0; i < structure->count; i++)
-	{
-		unsigned msize;
-		if (structure->member[i]->is_structure)
-		{
-			if (!ofc_sema_structure_size(
-				structure->member[i]->structure, &msize))
-				return false;
-		}
-		else
-		{
-			if (!ofc_sema_decl_size(
-				structure->member[i]->decl, &msize))
-				return false;
-		}
-
-		if (msize > usize)
-			usize = msize;
-		ssize += msize;
-	}
-
-	if (size)
-	{
-		if (ofc_sema_structure_is_union(structure))
-			*size = usize;
-		else
-			*size = ssize;
-	}
-
+	if (size) *size = layout->size;
 	return true;
 }
 
@@ -632,41 +808,12 @@ bool ofc_sema_structure_elem_count(
 	const ofc_sema_structure_t* structure,
 	unsigned* count)
 {
-	if (!structure)
+	const ofc_sema_structure_layout_t* layout
+		= ofc_sema_structure_layout(structure);
+	if (!layout || !layout->elem_count_valid)
 		return false;
 
-	unsigned ucount = 0;
-	unsigned scount = 0;
-	unsigned i;
-	for (i = 0; i < structure->count; i++)
-	{
-		unsigned mcount;
-		if (structure->member[i]->is_structure)
-		{
-			if (!ofc_sema_structure_elem_count(
-				structure->member[i]->structure, &mcount))
-				return false;
-		}
-		else
-		{
-			if (!ofc_sema_decl_elem_count(
-				structure->member[i]->decl, &mcount))
-				return false;
-		}
-
-		if (mcount > ucount)
-			ucount = mcount;
-		scount += mcount;
-	}
-
-	if (count)
-	{
-		if (ofc_sema_structure_is_union(structure))
-			*count = ucount;
-		else
-			*count = scount;
-	}
-
+	if (count) *count = layout->elem_count;
 	return true;
 }
 
@@ -105,7 +105,23 @@ ofc_sema_kind_e ofc_sema_type_get_kind(
 }
 
 
-static ofc_hashmap_t* ofc_sema_type__map = NULL;
+/* Types are interned in a lock-free table, nodes are only ever pushed
+   onto the head of a bucket and are never removed until exit, so lookups
+   don't need a lock and may run alongside inserts on other threads. */
+
+#define OFC_SEMA_TYPE__BUCKETS 1024
+
+typedef struct ofc_sema_type__node_s ofc_sema_type__node_t;
+
+struct ofc_sema_type__node_s
+{
+	ofc_sema_type_t        type;
+	uint32_t               hash;
+	ofc_sema_type__node_t* next;
+};
+
+static ofc_sema_type__node_t* ofc_sema_type__bucket[OFC_SEMA_TYPE__BUCKETS];
+static bool ofc_sema_type__cleanup_registered = false;
 
 static const char* ofc_sema_type__name[] =
 {
@@ -177,14 +193,6 @@ const char* ofc_sema_type_str_cast_rep(
 	return ofc_sema_type__cast[type->type];
 }
 
-static void ofc_sema_type__delete(ofc_sema_type_t* type)
-{
-	if (!type)
-		return;
-
-	free(type);
-}
-
 uint8_t ofc_sema_type_hash(
 	const ofc_sema_type_t* type)
 {
@@ -217,15 +225,72 @@ uint8_t ofc_sema_type_hash(
 	return hash;
 }
 
-static const ofc_sema_type_t* ofc_sema_type__key(
+/* Must agree with ofc_sema_type_compare. */
+static uint32_t ofc_sema_type__hash(
 	const ofc_sema_type_t* type)
 {
-	return type;
+	if (!type)
+		return 0;
+
+	uint32_t hash = (type->type + 1) * 2654435761U;
+
+	switch (type->type)
+	{
+		case OFC_SEMA_TYPE_POINTER:
+		case OFC_SEMA_TYPE_FUNCTION:
+			hash ^= ofc_sema_type__hash(type->subtype);
+			break;
+
+		case OFC_SEMA_TYPE_CHARACTER:
+			hash ^= type->len * 40503U;
+			hash ^= (type->len_var ? 0x80000000U : 0);
+			hash ^= type->kind << 24;
+			break;
+
+		case OFC_SEMA_TYPE_SUBROUTINE:
+		case OFC_SEMA_TYPE_TYPE:
+		case OFC_SEMA_TYPE_RECORD:
+			break;
+
+		default:
+			hash ^= type->kind << 24;
+			break;
+	}
+
+	return (hash ^ (hash >> 15));
 }
 
-static void ofc_sema_type__map_cleanup(void)
+static void ofc_sema_type__cleanup(void)
 {
-	ofc_hashmap_delete(ofc_sema_type__map);
+	unsigned i;
+	for (i = 0; i < OFC_SEMA_TYPE__BUCKETS; i++)
+	{
+		ofc_sema_type__node_t* node
+			= ofc_sema_type__bucket[i];
+		ofc_sema_type__bucket[i] = NULL;
+
+		while (node)
+		{
+			ofc_sema_type__node_t* next = node->next;
+			free(node);
+			node = next;
+		}
+	}
+}
+
+static const ofc_sema_type_t* ofc_sema_type__find(
+	const ofc_sema_type__node_t* node,
+	const ofc_sema_type__node_t* end,
+	const ofc_sema_type_t* type, uint32_t hash)
+{
+	for (; node && (node != end); node = node->next)
+	{
+		if ((node->hash == hash)
+			&& ofc_sema_type_compare(&node->type, type))
+			return &node->type;
+	}
+
+	return NULL;
 }
 
 static const ofc_sema_type_t* ofc_sema_type__create(
@@ -265,19 +330,6 @@ static const ofc_sema_type_t* ofc_sema_type__create(
 			break;
 	}
 
-	if (!ofc_sema_type__map)
-	{
-		ofc_sema_type__map = ofc_hashmap_create(
-			(void*)ofc_sema_type_hash,
-			(void*)ofc_sema_type_compare,
-			(void*)ofc_sema_type__key,
-			(void*)ofc_sema_type__delete);
-		if (!ofc_sema_type__map)
-			return NULL;
-
-		atexit(ofc_sema_type__map_cleanup);
-	}
-
 	ofc_sema_type_t stype =
 		{
 			.type  = type,
@@ -309,25 +361,47 @@ static const ofc_sema_type_t* ofc_sema_type__create(
 		}
 	}
 
+	uint32_t hash = ofc_sema_type__hash(&stype);
+	ofc_sema_type__node_t** bucket
+		= &ofc_sema_type__bucket[hash % OFC_SEMA_TYPE__BUCKETS];
+
+	ofc_sema_type__node_t* head
+		= __atomic_load_n(bucket, __ATOMIC_ACQUIRE);
 	const ofc_sema_type_t* gtype
-		= ofc_hashmap_find(
-			ofc_sema_type__map, &stype);
+		= ofc_sema_type__find(head, NULL, &stype, hash);
 	if (gtype) return gtype;
 
-	ofc_sema_type_t* ntype
-		= (ofc_sema_type_t*)malloc(
-			sizeof(ofc_sema_type_t));
-	if (!ntype) return NULL;
-	*ntype = stype;
-
-	if (!ofc_hashmap_add(
-		ofc_sema_type__map, ntype))
+	ofc_sema_type__node_t* node
+		= (ofc_sema_type__node_t*)malloc(
+			sizeof(ofc_sema_type__node_t));
+	if (!node) return NULL;
+	node->type = stype;
+	node->hash = hash;
+	node->next = head;
+
+	/* On failure head is reloaded, only the nodes pushed since
+	   our last search need checking for a racing insert. */
+	ofc_sema_type__node_t* searched = node->next;
+	while (!__atomic_compare_exchange_n(
+		bucket, &node->next, node, true,
+		__ATOMIC_RELEASE, __ATOMIC_ACQUIRE))
 	{
-		ofc_sema_type__delete(ntype);
-		return NULL;
+		gtype = ofc_sema_type__find(
+			node->next, searched, &stype, hash);
+		if (gtype)
+		{
+			free(node);
+			return gtype;
+		}
+		searched = node->next;
 	}
 
-	return ntype;
+	if (!__atomic_exchange_n(
+		&ofc_sema_type__cleanup_registered,
+		true, __ATOMIC_ACQ_REL))
+		atexit(ofc_sema_type__cleanup);
+
+	return &node->type;
 }
 
 const ofc_sema_type_t* ofc_sema_type_create_primitive(
@@ -465,14 +539,14 @@ const ofc_sema_type_t* ofc_sema_type(
 
 		if (!resolved)
 		{
-			ofc_sparse_ref_error(ptype->count_expr->src,
+			ofc_sparse_loc_error(ptype->count_expr->src,
 				"Type LEN expression couldn't be resolved");
 			return NULL;
 		}
 
 		if (len == 0)
 		{
-			ofc_sparse_ref_error(ptype->count_expr->src,
+			ofc_sparse_loc_error(ptype->count_expr->src,
 				"Type LEN must be greater than zero");
 			return NULL;
 		}
@@ -485,7 +559,7 @@ const ofc_sema_type_t* ofc_sema_type(
 		case OFC_PARSE_TYPE_DOUBLE_COMPLEX:
 			if (ptype->size != 0)
 			{
-				ofc_sparse_ref_error(ptype->count_expr->src,
+				ofc_sparse_loc_error(ptype->count_expr->src,
 					"Can't specify size of DOUBLE type");
 				return NULL;
 			}
@@ -705,149 +779,158 @@ const ofc_sema_type_t* ofc_sema_type_set_len(
 }
 
 
+/* Interning means a racing store writes the same pointer,
+   except for TYPE and RECORD where the first store wins. */
+static const ofc_sema_type_t* ofc_sema_type__cache(
+	const ofc_sema_type_t** cache,
+	const ofc_sema_type_t* type)
+{
+	if (!type)
+		return NULL;
+
+	const ofc_sema_type_t* expected = NULL;
+	if (!__atomic_compare_exchange_n(
+		cache, &expected, type, false,
+		__ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+		return expected;
+	return type;
+}
+
 const ofc_sema_type_t* ofc_sema_type_logical_default(void)
 {
 	static const ofc_sema_type_t* logical = NULL;
 
-	if (!logical)
-	{
-		logical = ofc_sema_type_create_primitive(
-			OFC_SEMA_TYPE_LOGICAL,
-			OFC_SEMA_KIND_DEFAULT);
-	}
+	const ofc_sema_type_t* cached
+		= __atomic_load_n(&logical, __ATOMIC_ACQUIRE);
+	if (cached) return cached;
 
-	return logical;
+	return ofc_sema_type__cache(&logical,
+		ofc_sema_type_create_primitive(
+			OFC_SEMA_TYPE_LOGICAL,
+			OFC_SEMA_KIND_DEFAULT));
 }
 
 const ofc_sema_type_t* ofc_sema_type_integer_default(void)
 {
 	static const ofc_sema_type_t* integer = NULL;
 
-	if (!integer)
-	{
-		integer = ofc_sema_type_create_primitive(
-			OFC_SEMA_TYPE_INTEGER,
-			OFC_SEMA_KIND_DEFAULT);
-	}
+	const ofc_sema_type_t* cached
+		= __atomic_load_n(&integer, __ATOMIC_ACQUIRE);
+	if (cached) return cached;
 
-	return integer;
+	return ofc_sema_type__cache(&integer,
+		ofc_sema_type_create_primitive(
+			OFC_SEMA_TYPE_INTEGER,
+			OFC_SEMA_KIND_DEFAULT));
 }
 
 const ofc_sema_type_t* ofc_sema_type_real_default(void)
 {
 	static const ofc_sema_type_t* real = NULL;
 
-	if (!real)
-	{
-		real = ofc_sema_type_create_primitive(
-			OFC_SEMA_TYPE_REAL,
-			OFC_SEMA_KIND_DEFAULT);
-	}
+	const ofc_sema_type_t* cached
+		= __atomic_load_n(&real, __ATOMIC_ACQUIRE);
+	if (cached) return cached;
 
-	return real;
+	return ofc_sema_type__cache(&real,
+		ofc_sema_type_create_primitive(
+			OFC_SEMA_TYPE_REAL,
+			OFC_SEMA_KIND_DEFAULT));
 }
 
 const ofc_sema_type_t* ofc_sema_type_double_default(void)
 {
 	static const ofc_sema_type_t* dbl = NULL;
 
-	if (!dbl)
-	{
-		const ofc_sema_type_t* real
-			= ofc_sema_type_real_default();
-		if (!real) return NULL;
+	const ofc_sema_type_t* cached
+		= __atomic_load_n(&dbl, __ATOMIC_ACQUIRE);
+	if (cached) return cached;
 
-		dbl = ofc_sema_type_create_primitive(
+	return ofc_sema_type__cache(&dbl,
+		ofc_sema_type_create_primitive(
 			OFC_SEMA_TYPE_REAL,
-			OFC_SEMA_KIND_DOUBLE);
-	}
-
-	return dbl;
+			OFC_SEMA_KIND_DOUBLE));
 }
 
 const ofc_sema_type_t* ofc_sema_type_complex_default(void)
 {
 	static const ofc_sema_type_t* complex = NULL;
 
-	if (!complex)
-	{
-		complex = ofc_sema_type_create_primitive(
-			OFC_SEMA_TYPE_COMPLEX,
-			OFC_SEMA_KIND_DEFAULT);
-	}
+	const ofc_sema_type_t* cached
+		= __atomic_load_n(&complex, __ATOMIC_ACQUIRE);
+	if (cached) return cached;
 
-	return complex;
+	return ofc_sema_type__cache(&complex,
+		ofc_sema_type_create_primitive(
+			OFC_SEMA_TYPE_COMPLEX,
+			OFC_SEMA_KIND_DEFAULT));
 }
 
 const ofc_sema_type_t* ofc_sema_type_double_complex_default(void)
 {
 	static const ofc_sema_type_t* dbl_complex = NULL;
 
-	if (!dbl_complex)
-	{
-		const ofc_sema_type_t* real
-			= ofc_sema_type_real_default();
-		if (!real) return NULL;
+	const ofc_sema_type_t* cached
+		= __atomic_load_n(&dbl_complex, __ATOMIC_ACQUIRE);
+	if (cached) return cached;
 
-		dbl_complex = ofc_sema_type_create_primitive(
+	return ofc_sema_type__cache(&dbl_complex,
+		ofc_sema_type_create_primitive(
 			OFC_SEMA_TYPE_COMPLEX,
-			OFC_SEMA_KIND_DOUBLE);
-	}
-
-	return dbl_complex;
+			OFC_SEMA_KIND_DOUBLE));
 }
 
 const ofc_sema_type_t* ofc_sema_type_byte_default(void)
 {
 	static const ofc_sema_type_t* byte = NULL;
 
-	if (!byte)
-	{
-		byte = ofc_sema_type_create_primitive(
-			OFC_SEMA_TYPE_BYTE,
-			OFC_SEMA_KIND_DEFAULT);
-	}
+	const ofc_sema_type_t* cached
+		= __atomic_load_n(&byte, __ATOMIC_ACQUIRE);
+	if (cached) return cached;
 
-	return byte;
+	return ofc_sema_type__cache(&byte,
+		ofc_sema_type_create_primitive(
+			OFC_SEMA_TYPE_BYTE,
+			OFC_SEMA_KIND_DEFAULT));
 }
 
 const ofc_sema_type_t* ofc_sema_type_subroutine(void)
 {
 	static const ofc_sema_type_t* subroutine = NULL;
 
-	if (!subroutine)
-	{
-		subroutine = ofc_sema_type__create(
-			OFC_SEMA_TYPE_SUBROUTINE, OFC_SEMA_KIND_NONE, 0, false, NULL);
-	}
+	const ofc_sema_type_t* cached
+		= __atomic_load_n(&subroutine, __ATOMIC_ACQUIRE);
+	if (cached) return cached;
 
-	return subroutine;
+	return ofc_sema_type__cache(&subroutine,
+		ofc_sema_type__create(
+			OFC_SEMA_TYPE_SUBROUTINE, OFC_SEMA_KIND_NONE, 0, false, NULL));
 }
 
 const ofc_sema_type_t* ofc_sema_type_type(void)
 {
 	static const ofc_sema_type_t* type = NULL;
 
-	if (!type)
-	{
-		type = ofc_sema_type__create(
-			OFC_SEMA_TYPE_TYPE, OFC_SEMA_KIND_NONE, 0, false, NULL);
-	}
+	const ofc_sema_type_t* cached
+		= __atomic_load_n(&type, __ATOMIC_ACQUIRE);
+	if (cached) return cached;
 
-	return type;
+	return ofc_sema_type__cache(&type,
+		ofc_sema_type__create(
+			OFC_SEMA_TYPE_TYPE, OFC_SEMA_KIND_NONE, 0, false, NULL));
 }
 
 const ofc_sema_type_t* ofc_sema_type_record(void)
 {
 	static const ofc_sema_type_t* type = NULL;
 
-	if (!type)
-	{
-		type = ofc_sema_type__create(
-			OFC_SEMA_TYPE_RECORD, OFC_SEMA_KIND_NONE, 0, false, NULL);
-	}
+	const ofc_sema_type_t* cached
+		= __atomic_load_n(&type, __ATOMIC_ACQUIRE);
+	if (cached) return cached;
 
-	return type;
+	return ofc_sema_type__cache(&type,
+		ofc_sema_type__create(
+			OFC_SEMA_TYPE_RECORD, OFC_SEMA_KIND_NONE, 0, false, NULL));
 }
 
 
@@ -42,6 +42,53 @@ static ofc_sema_typeval_t* NO_OPT ofc_sema_typeval__alloc(
 	return alloc_typeval;
 }
 
+/* Character data is immutable once created so it's shared between
+   copies, with a count of extra references stored in front of it. */
+typedef struct
+{
+	unsigned ref;
+} ofc_sema_typeval__character_t;
+
+char* ofc_sema_typeval_character_alloc(unsigned size)
+{
+	ofc_sema_typeval__character_t* header
+		= (ofc_sema_typeval__character_t*)malloc(
+			sizeof(ofc_sema_typeval__character_t) + size);
+	if (!header) return NULL;
+
+	header->ref = 0;
+	return (char*)&header[1];
+}
+
+static bool ofc_sema_typeval__character_reference(char* character)
+{
+	if (!character)
+		return false;
+
+	ofc_sema_typeval__character_t* header
+		= &((ofc_sema_typeval__character_t*)character)[-1];
+
+	unsigned nref = header->ref + 1;
+	if (nref == 0) return false;
+
+	header->ref = nref;
+	return true;
+}
+
+static void ofc_sema_typeval__character_release(char* character)
+{
+	if (!character)
+		return;
+
+	ofc_sema_typeval__character_t* header
+		= &((ofc_sema_typeval__character_t*)character)[-1];
+
+	if (header->ref > 0)
+		header->ref -= 1;
+	else
+		free(header);
+}
+
 static bool ofc_sema_typeval__in_range(
 	const ofc_sema_typeval_t* typeval)
 {
@@ -311,7 +358,7 @@ static ofc_sema_typeval_t* ofc_sema_typeval__integer_literal(
 		}
 	}
 
-	typeval.src = literal->src;
+	typeval.src = ofc_sparse_ref_loc(literal->src);
 
 	return ofc_sema_typeval__alloc(typeval);
 }
@@ -520,7 +567,7 @@ static ofc_sema_typeval_t* ofc_sema_typeval__real_literal(
 		}
 	}
 
-	typeval.src = literal->src;
+	typeval.src = ofc_sparse_ref_loc(literal->src);
 
 	return ofc_sema_typeval__alloc(typeval);
 }
@@ -575,7 +622,7 @@ static ofc_sema_typeval_t* ofc_sema_typeval__complex_literal(
 		}
 	}
 
-	typeval.src = literal->src;
+	typeval.src = ofc_sparse_ref_loc(literal->src);
 
 	return ofc_sema_typeval__alloc(typeval);
 }
@@ -664,7 +711,7 @@ static ofc_sema_typeval_t* ofc_sema_typeval__character_literal(
 	}
 	else
 	{
-		typeval.character = (char*)malloc(sizeof(char) * size);
+		typeval.character = ofc_sema_typeval_character_alloc(size);
 		if (!typeval.character)
 			return NULL;
 
@@ -695,11 +742,12 @@ static ofc_sema_typeval_t* ofc_sema_typeval__character_literal(
 		}
 	}
 
-	typeval.src = literal->src;
+	typeval.src = ofc_sparse_ref_loc(literal->src);
 
 	ofc_sema_typeval_t* atv
 		= ofc_sema_typeval__alloc(typeval);
-	if (!atv && !is_byte) free(typeval.character);
+	if (!atv && !is_byte)
+		ofc_sema_typeval__character_release(typeval.character);
 	return atv;
 }
 
@@ -748,7 +796,7 @@ static ofc_sema_typeval_t* ofc_sema_typeval__logical_literal(
 	else
 		typeval.logical = literal->logical;
 
-	typeval.src = literal->src;
+	typeval.src = ofc_sparse_ref_loc(literal->src);
 
 	return ofc_sema_typeval__alloc(typeval);
 }
@@ -788,7 +836,7 @@ static ofc_sema_typeval_t* ofc_sema_typeval__byte_literal(
 
 ofc_sema_typeval_t* ofc_sema_typeval_create_integer(
 	int value, ofc_sema_kind_e kind,
-	ofc_sparse_ref_t ref)
+	ofc_sparse_loc_t loc)
 {
 	if (kind == OFC_SEMA_KIND_NONE)
 		kind = OFC_SEMA_KIND_4_BYTE;
@@ -805,7 +853,7 @@ ofc_sema_typeval_t* ofc_sema_typeval_create_integer(
 
 	typeval->type = type;
 	typeval->integer = value;
-	typeval->src = ref;
+	typeval->src = loc;
 
 	if (!ofc_sema_typeval__in_range(typeval))
 	{
@@ -818,7 +866,7 @@ ofc_sema_typeval_t* ofc_sema_typeval_create_integer(
 
 ofc_sema_typeval_t* ofc_sema_typeval_create_logical(
 	bool value, unsigned kind,
-	ofc_sparse_ref_t ref)
+	ofc_sparse_loc_t loc)
 {
 	if (kind == OFC_SEMA_KIND_NONE)
 		kind = OFC_SEMA_KIND_DEFAULT;
@@ -835,13 +883,13 @@ ofc_sema_typeval_t* ofc_sema_typeval_create_logical(
 
 	typeval->type = type;
 	typeval->logical = value;
-	typeval->src = ref;
+	typeval->src = loc;
 	return typeval;
 }
 
 ofc_sema_typeval_t* ofc_sema_typeval_create_real(
 	long double value, ofc_sema_kind_e kind,
-	ofc_sparse_ref_t ref)
+	ofc_sparse_loc_t loc)
 {
 	if (kind == OFC_SEMA_KIND_NONE)
 		kind = OFC_SEMA_KIND_10_BYTE;
@@ -858,14 +906,14 @@ ofc_sema_typeval_t* ofc_sema_typeval_create_real(
 
 	typeval->type = type;
 	typeval->real = value;
-	typeval->src  = ref;
+	typeval->src  = loc;
 	return typeval;
 }
 
 ofc_sema_typeval_t* ofc_sema_typeval_create_complex(
 	long double real, long double imaginary,
 	ofc_sema_kind_e kind,
-	ofc_sparse_ref_t ref)
+	ofc_sparse_loc_t loc)
 {
 	if (kind == OFC_SEMA_KIND_NONE)
 		kind = OFC_SEMA_KIND_10_BYTE;
@@ -883,13 +931,13 @@ ofc_sema_typeval_t* ofc_sema_typeval_create_complex(
 	typeval->type = type;
 	typeval->complex.real = real;
 	typeval->complex.imaginary = imaginary;
-	typeval->src  = ref;
+	typeval->src  = loc;
 	return typeval;
 }
 
 ofc_sema_typeval_t* ofc_sema_typeval_create_character(
 	const char* data, ofc_sema_kind_e kind, unsigned len,
-	ofc_sparse_ref_t ref)
+	ofc_sparse_loc_t loc)
 {
 	if (len == 0)
 		return NULL;
@@ -911,8 +959,8 @@ ofc_sema_typeval_t* ofc_sema_typeval_create_character(
 	if (!typeval) return NULL;
 
 	typeval->type = type;
-	typeval->character = (char*)malloc(ts);
-	typeval->src = ref;
+	typeval->character = ofc_sema_typeval_character_alloc(ts);
+	typeval->src = loc;
 
 	if (!typeval->character)
 	{
@@ -983,7 +1031,7 @@ void ofc_sema_typeval_delete(
 
 	if (typeval->type
 		&& (typeval->type->type == OFC_SEMA_TYPE_CHARACTER))
-		free(typeval->character);
+		ofc_sema_typeval__character_release(typeval->character);
 
 	free(typeval);
 }
@@ -1086,10 +1134,12 @@ ofc_sema_typeval_t* ofc_sema_typeval_copy(
 	if (copy->type->type == OFC_SEMA_TYPE_CHARACTER)
 	{
 		unsigned size = ofc_sema_typeval_size(typeval);
-		copy->character = NULL;
-		if (size > 0)
+		if (!ofc_sema_typeval__character_reference(copy->character))
+			copy->character = NULL;
+
+		if (!copy->character && (size > 0))
 		{
-			copy->character = malloc(size);
+			copy->character = ofc_sema_typeval_character_alloc(size);
 			if (!copy->character)
 			{
 				free(copy);
@@ -1155,7 +1205,7 @@ ofc_sema_typeval_t* ofc_sema_typeval_cast(
 			return ctv;
 		}
 
-		ofc_sparse_ref_warning(typeval->src,
+		ofc_sparse_loc_warning(typeval->src,
 			"Casting CHARACTER to INTEGER");
 
 		tv.integer = 0;
@@ -1182,13 +1232,15 @@ ofc_sema_typeval_t* ofc_sema_typeval_cast(
 
 		if (tsize > csize)
 		{
-			ofc_sparse_ref_error(typeval->src,
+			ofc_sparse_loc_error(typeval->src,
 				"Can't cast CHARACTER to a smaller kind.");
 			return NULL;
 		}
 		else if (tsize < csize)
 		{
-			tv.character = (char*)malloc(len_type * csize);
+			tv.character = ofc_sema_typeval_character_alloc(
+				len_type * csize);
+			if (!tv.character) return NULL;
 
 			unsigned wchar;
 			for (wchar = 0; wchar < len_type; wchar += csize)
@@ -1214,9 +1266,17 @@ ofc_sema_typeval_t* ofc_sema_typeval_cast(
 				}
 			}
 		}
+		else if ((len_tval == len_type)
+			&& ofc_sema_typeval__character_reference(typeval->character))
+		{
+			/* Same length and kind, so share the data. */
+			tv.character = typeval->character;
+		}
 		else
 		{
-			tv.character = (char*)malloc(len_type * csize);
+			tv.character = ofc_sema_typeval_character_alloc(
+				len_type * csize);
+			if (!tv.character) return NULL;
 
 			if (len_tval < len_type)
 			{
@@ -1248,6 +1308,9 @@ ofc_sema_typeval_t* ofc_sema_typeval_cast(
 	bool large_literal = false;
 	bool lossy_cast = false;
 
+	/* An invalid cast leaves the value unset. */
+	tv.integer = 0;
+
 	switch (type->type)
 	{
 		case OFC_SEMA_TYPE_LOGICAL:
@@ -1267,7 +1330,7 @@ ofc_sema_typeval_t* ofc_sema_typeval_cast(
 
 	if (large_literal)
 	{
-		ofc_sparse_ref_error(typeval->src,
+		ofc_sparse_loc_error(typeval->src,
 			"Literal too large for compiler");
 		return NULL;
 	}
@@ -1410,7 +1473,7 @@ ofc_sema_typeval_t* ofc_sema_typeval_cast(
 
 	if (invalid_cast)
 	{
-		ofc_sparse_ref_error(typeval->src,
+		ofc_sparse_loc_error(typeval->src,
 			"Can't cast %s to %s",
 			ofc_sema_type_str_rep(typeval->type),
 			ofc_sema_type_str_rep(type));
@@ -1419,7 +1482,7 @@ ofc_sema_typeval_t* ofc_sema_typeval_cast(
 
 	if (lossy_cast)
 	{
-		ofc_sparse_ref_warning(typeval->src,
+		ofc_sparse_loc_warning(typeval->src,
 			"Cast from %s to %s is lossy",
 			ofc_sema_type_str_rep(typeval->type),
 			ofc_sema_type_str_rep(type));
@@ -1640,8 +1703,8 @@ ofc_sema_typeval_t* ofc_sema_typeval_power(
 	ofc_sema_typeval_t tv;
 	tv.type = a->type;
 
-	tv.src = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	tv.src = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		a->src, b->src, &tv.src);
 
 	switch (a->type->type)
@@ -1700,8 +1763,8 @@ ofc_sema_typeval_t* ofc_sema_typeval_multiply(
 	ofc_sema_typeval_t tv;
 	tv.type = a->type;
 
-	tv.src = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	tv.src = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		a->src, b->src, &tv.src);
 
 	switch (a->type->type)
@@ -1762,11 +1825,11 @@ ofc_sema_typeval_t* ofc_sema_typeval_concat(
 		a->type->kind, len, false);
 	if (!tv.type) return NULL;
 
-	tv.src = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	tv.src = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		a->src, b->src, &tv.src);
 
-	tv.character = (char*)malloc(sizeof(char) * len);
+	tv.character = ofc_sema_typeval_character_alloc(len);
 	if (!tv.character) return NULL;
 
 	memcpy(tv.character, a->character, len_a);
@@ -1774,7 +1837,7 @@ ofc_sema_typeval_t* ofc_sema_typeval_concat(
 
 	ofc_sema_typeval_t* ret
 		= ofc_sema_typeval__alloc(tv);
-	if (!ret) free(tv.character);
+	if (!ret) ofc_sema_typeval__character_release(tv.character);
 	return ret;
 }
 
@@ -1791,8 +1854,8 @@ ofc_sema_typeval_t* ofc_sema_typeval_divide(
 	ofc_sema_typeval_t tv;
 	tv.type = a->type;
 
-	tv.src = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	tv.src = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		a->src, b->src, &tv.src);
 
 	switch (a->type->type)
@@ -1816,7 +1879,7 @@ ofc_sema_typeval_t* ofc_sema_typeval_divide(
 		case OFC_SEMA_TYPE_BYTE:
 			if (b->integer == 0)
 			{
-				ofc_sparse_ref_error(a->src,
+				ofc_sparse_loc_error(a->src,
 					"Divide by zero");
 				return NULL;
 			}
@@ -1842,8 +1905,8 @@ ofc_sema_typeval_t* ofc_sema_typeval_add(
 	ofc_sema_typeval_t tv;
 	tv.type = a->type;
 
-	tv.src = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	tv.src = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		a->src, b->src, &tv.src);
 
 	switch (a->type->type)
@@ -1881,8 +1944,8 @@ ofc_sema_typeval_t* ofc_sema_typeval_subtract(
 	ofc_sema_typeval_t tv;
 	tv.type = a->type;
 
-	tv.src = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	tv.src = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		a->src, b->src, &tv.src);
 
 	switch (a->type->type)
@@ -1931,7 +1994,7 @@ ofc_sema_typeval_t* ofc_sema_typeval_negate(
 			tv.integer = -a->integer;
 			if (-tv.integer != a->integer)
 			{
-				ofc_sparse_ref_error(a->src,
+				ofc_sparse_loc_error(a->src,
 					"Overflow in constant negate");
 				return NULL;
 			}
@@ -1958,8 +2021,8 @@ ofc_sema_typeval_t* ofc_sema_typeval_eq(
 		OFC_SEMA_TYPE_LOGICAL,
 		OFC_SEMA_KIND_DEFAULT);
 
-	tv.src = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	tv.src = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		a->src, b->src, &tv.src);
 
 	if (a->type->type == OFC_SEMA_TYPE_CHARACTER)
@@ -2018,8 +2081,8 @@ ofc_sema_typeval_t* ofc_sema_typeval_ne(
 		OFC_SEMA_TYPE_LOGICAL,
 		OFC_SEMA_KIND_DEFAULT);
 
-	tv.src = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	tv.src = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		a->src, b->src, &tv.src);
 
 	if (a->type->type == OFC_SEMA_TYPE_CHARACTER)
@@ -2078,8 +2141,8 @@ ofc_sema_typeval_t* ofc_sema_typeval_lt(
 		OFC_SEMA_TYPE_LOGICAL,
 		OFC_SEMA_KIND_DEFAULT);
 
-	tv.src = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	tv.src = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		a->src, b->src, &tv.src);
 
 	if (a->type->type == OFC_SEMA_TYPE_CHARACTER)
@@ -2150,8 +2213,8 @@ ofc_sema_typeval_t* ofc_sema_typeval_le(
 		OFC_SEMA_TYPE_LOGICAL,
 		OFC_SEMA_KIND_DEFAULT);
 
-	tv.src = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	tv.src = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		a->src, b->src, &tv.src);
 
 	if (a->type->type == OFC_SEMA_TYPE_CHARACTER)
@@ -2222,8 +2285,8 @@ ofc_sema_typeval_t* ofc_sema_typeval_gt(
 		OFC_SEMA_TYPE_LOGICAL,
 		OFC_SEMA_KIND_DEFAULT);
 
-	tv.src = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	tv.src = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		a->src, b->src, &tv.src);
 
 	if (a->type->type == OFC_SEMA_TYPE_CHARACTER)
@@ -2294,8 +2357,8 @@ ofc_sema_typeval_t* ofc_sema_typeval_ge(
 		OFC_SEMA_TYPE_LOGICAL,
 		OFC_SEMA_KIND_DEFAULT);
 
-	tv.src = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	tv.src = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		a->src, b->src, &tv.src);
 
 	if (a->type->type == OFC_SEMA_TYPE_CHARACTER)
@@ -2389,8 +2452,8 @@ ofc_sema_typeval_t* ofc_sema_typeval_and(
 	ofc_sema_typeval_t tv;
 	tv.type = a->type;
 
-	tv.src = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	tv.src = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		a->src, b->src, &tv.src);
 
 	switch (a->type->type)
@@ -2422,8 +2485,8 @@ ofc_sema_typeval_t* ofc_sema_typeval_or(
 	ofc_sema_typeval_t tv;
 	tv.type = a->type;
 
-	tv.src = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	tv.src = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		a->src, b->src, &tv.src);
 
 	switch (a->type->type)
@@ -2455,8 +2518,8 @@ ofc_sema_typeval_t* ofc_sema_typeval_xor(
 	ofc_sema_typeval_t tv;
 	tv.type = a->type;
 
-	tv.src = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	tv.src = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		a->src, b->src, &tv.src);
 
 	switch (a->type->type)
@@ -2490,8 +2553,8 @@ ofc_sema_typeval_t* ofc_sema_typeval_eqv(
 		OFC_SEMA_TYPE_LOGICAL,
 		OFC_SEMA_KIND_DEFAULT);
 
-	tv.src = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	tv.src = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		a->src, b->src, &tv.src);
 
 	switch (a->type->type)
@@ -2524,8 +2587,8 @@ ofc_sema_typeval_t* ofc_sema_typeval_neqv(
 		OFC_SEMA_TYPE_LOGICAL,
 		OFC_SEMA_KIND_DEFAULT);
 
-	tv.src = OFC_SPARSE_REF_EMPTY;
-	ofc_sparse_ref_bridge(
+	tv.src = OFC_SPARSE_LOC_EMPTY;
+	ofc_sparse_loc_bridge(
 		a->src, b->src, &tv.src);
 
 	switch (a->type->type)
@@ -2694,7 +2757,7 @@ bool ofc_sema_typeval_print(ofc_colstr_t*cs,
 		case OFC_SEMA_TYPE_INTEGER:
 			if (kind != OFC_SEMA_KIND_DEFAULT)
 			{
-				ofc_sparse_ref_error(typeval->src,
+				ofc_sparse_loc_error(typeval->src,
 					"Unable to print constant with non-default KIND");
 				/* TODO - TYPEVAL - Print alternative INTEGER KINDs. */
 				return false;
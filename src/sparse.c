@@ -21,11 +21,12 @@
 #include "ofc/file.h"
 
 
+/* Each entry is a run of characters which are contiguous in the parent,
+   the length of a run is implied by the offset of the next entry. */
 typedef struct
 {
-	const char* ptr;
-	unsigned    len;
-	unsigned    off;
+	unsigned off;
+	unsigned poff;
 } ofc_sparse_entry_t;
 
 struct ofc_sparse_s
@@ -36,14 +37,188 @@ struct ofc_sparse_s
 	unsigned len, count, max_count;
 	ofc_sparse_entry_t* entry;
 
-	char* strz;
+	/* Text is copied into strz as it's appended, so locking is cheap. */
+	char*    strz;
+	unsigned max_len;
+	bool     locked;
+
+	/* Built at lock time: run has a bit set for the first character of
+	   each entry, and rank holds the number of entries which start before
+	   each word of run. For sparse chains more than one level deep foff
+	   holds the file offset of each entry, fsplit the offsets in this
+	   sparse and the file wherever an entry moves to another run of the
+	   file, and fend the file offset of the end. */
+	uint64_t* run;
+	unsigned* rank;
+	unsigned* foff;
+	unsigned  fend;
+
+	unsigned            fsplit_count, fsplit_max;
+	ofc_sparse_entry_t* fsplit;
 
 	ofc_label_table_t* labels;
 
+	/* First position of the sparse in the location space,
+	   zero if it doesn't have one. */
+	uint32_t loc;
+
 	unsigned ref;
 };
 
 
+typedef struct
+{
+	uint32_t            loc;
+	unsigned            len;
+	const ofc_sparse_t* sparse;
+} ofc_sparse__loc_entry_t;
+
+/* Locked sparses sorted by position, a deleted sparse releases its range.
+   Positions are given out in order and only reuse a released range once
+   the end of the space is reached. */
+static struct
+{
+	unsigned                 count, max;
+	ofc_sparse__loc_entry_t* entry;
+	uint32_t                 next;
+} ofc_sparse__loc_map = { 0 };
+
+static const ofc_file_t* ofc_sparse__file(
+	const ofc_sparse_t* sparse);
+
+static void ofc_sparse__loc_cleanup(void)
+{
+	free(ofc_sparse__loc_map.entry);
+	memset(&ofc_sparse__loc_map, 0x00, sizeof(ofc_sparse__loc_map));
+}
+
+/* Returns the index to insert a range of len at, and its position in loc,
+   or count + 1 if there's no space left. */
+static unsigned ofc_sparse__loc_slot(unsigned len, uint32_t* loc)
+{
+	/* Positions include the end of the sparse. */
+	uint32_t next = ofc_sparse__loc_map.next;
+	if ((UINT32_MAX - next) > len)
+	{
+		*loc = next;
+		return ofc_sparse__loc_map.count;
+	}
+
+	uint32_t start = 1;
+	unsigned i;
+	for (i = 0; i <= ofc_sparse__loc_map.count; i++)
+	{
+		uint32_t end = (i < ofc_sparse__loc_map.count
+			? ofc_sparse__loc_map.entry[i].loc : UINT32_MAX);
+		if ((end - start) > len)
+		{
+			*loc = start;
+			return i;
+		}
+
+		if (i < ofc_sparse__loc_map.count)
+		{
+			start = ofc_sparse__loc_map.entry[i].loc
+				+ ofc_sparse__loc_map.entry[i].len + 1;
+		}
+	}
+
+	return (ofc_sparse__loc_map.count + 1);
+}
+
+static void ofc_sparse__loc_add(ofc_sparse_t* sparse)
+{
+	if (ofc_sparse__loc_map.next == 0)
+	{
+		ofc_sparse__loc_map.next = 1;
+		atexit(ofc_sparse__loc_cleanup);
+	}
+
+	uint32_t loc;
+	unsigned i = ofc_sparse__loc_slot(sparse->len, &loc);
+	if (i > ofc_sparse__loc_map.count)
+	{
+		ofc_file_error(ofc_sparse__file(sparse), NULL,
+			"Source location space exhausted,"
+			" positions in this file can't be reported");
+		return;
+	}
+
+	if (ofc_sparse__loc_map.count >= ofc_sparse__loc_map.max)
+	{
+		unsigned max = (ofc_sparse__loc_map.max > 0
+			? (ofc_sparse__loc_map.max * 2) : 16);
+		ofc_sparse__loc_entry_t* nentry
+			= (ofc_sparse__loc_entry_t*)realloc(ofc_sparse__loc_map.entry,
+				(sizeof(ofc_sparse__loc_entry_t) * max));
+		if (!nentry) return;
+		ofc_sparse__loc_map.entry = nentry;
+		ofc_sparse__loc_map.max   = max;
+	}
+
+	memmove(&ofc_sparse__loc_map.entry[i + 1],
+		&ofc_sparse__loc_map.entry[i],
+		(sizeof(ofc_sparse__loc_entry_t)
+			* (ofc_sparse__loc_map.count - i)));
+	ofc_sparse__loc_map.count++;
+
+	ofc_sparse__loc_entry_t* entry
+		= &ofc_sparse__loc_map.entry[i];
+	entry->loc    = loc;
+	entry->len    = sparse->len;
+	entry->sparse = sparse;
+
+	if (loc >= ofc_sparse__loc_map.next)
+		ofc_sparse__loc_map.next = loc + sparse->len + 1;
+	sparse->loc = loc;
+}
+
+/* Returns the index of the entry containing pos, or count if there isn't one. */
+static unsigned ofc_sparse__loc_index(uint32_t pos)
+{
+	unsigned first = 0;
+	unsigned last  = ofc_sparse__loc_map.count;
+	while (first < last)
+	{
+		unsigned mid = first + ((last - first) / 2);
+		const ofc_sparse__loc_entry_t* entry
+			= &ofc_sparse__loc_map.entry[mid];
+		if (pos < entry->loc)
+			last = mid;
+		else if ((pos - entry->loc) > entry->len)
+			first = (mid + 1);
+		else
+			return mid;
+	}
+
+	return ofc_sparse__loc_map.count;
+}
+
+static void ofc_sparse__loc_remove(const ofc_sparse_t* sparse)
+{
+	unsigned i = ofc_sparse__loc_index(sparse->loc);
+	if ((i >= ofc_sparse__loc_map.count)
+		|| (ofc_sparse__loc_map.entry[i].sparse != sparse))
+		return;
+
+	ofc_sparse__loc_map.count--;
+	memmove(&ofc_sparse__loc_map.entry[i],
+		&ofc_sparse__loc_map.entry[i + 1],
+		(sizeof(ofc_sparse__loc_entry_t)
+			* (ofc_sparse__loc_map.count - i)));
+}
+
+static const ofc_sparse_t* ofc_sparse__loc_find(uint32_t pos)
+{
+	if (pos == 0)
+		return NULL;
+
+	unsigned i = ofc_sparse__loc_index(pos);
+	return (i < ofc_sparse__loc_map.count
+		? ofc_sparse__loc_map.entry[i].sparse : NULL);
+}
+
+
 
 static ofc_sparse_t* ofc_sparse__create(
 	ofc_file_t* file, ofc_sparse_t* parent)
@@ -69,7 +244,20 @@ static ofc_sparse_t* ofc_sparse__create(
 	sparse->max_count = 0;
 	sparse->entry     = NULL;
 
-	sparse->strz = NULL;
+	sparse->strz    = NULL;
+	sparse->max_len = 0;
+	sparse->locked  = false;
+
+	sparse->run  = NULL;
+	sparse->rank = NULL;
+	sparse->foff = NULL;
+	sparse->fend = 0;
+
+	sparse->fsplit_count = 0;
+	sparse->fsplit_max   = 0;
+	sparse->fsplit       = NULL;
+
+	sparse->loc = 0;
 
 	sparse->ref = 0;
 
@@ -128,11 +316,18 @@ void ofc_sparse_delete(ofc_sparse_t* sparse)
 		return;
 	}
 
+	if (sparse->loc != 0)
+		ofc_sparse__loc_remove(sparse);
+
 	ofc_sparse_delete(sparse->parent);
 	ofc_file_delete(sparse->file);
 
 	ofc_label_table_delete(sparse->labels);
 
+	free(sparse->fsplit);
+	free(sparse->foff);
+	free(sparse->rank);
+	free(sparse->run);
 	free(sparse->strz);
 	free(sparse->entry);
 	free(sparse);
@@ -147,6 +342,43 @@ unsigned ofc_sparse_len(const ofc_sparse_t* sparse)
 
 
 
+static const char* ofc_sparse__base(
+	const ofc_sparse_t* sparse)
+{
+	if (sparse->parent)
+		return sparse->parent->strz;
+	return ofc_file_get_strz(sparse->file);
+}
+
+static unsigned ofc_sparse__entry_len(
+	const ofc_sparse_t* sparse, unsigned index)
+{
+	unsigned end = ((index + 1) < sparse->count
+		? sparse->entry[index + 1].off : sparse->len);
+	return (end - sparse->entry[index].off);
+}
+
+
+bool ofc_sparse_reserve(
+	ofc_sparse_t* sparse, unsigned len)
+{
+	if (!sparse || sparse->locked)
+		return false;
+
+	if ((sparse->len + len) < sparse->len)
+		return false;
+
+	unsigned nmax = sparse->len + len + 1;
+	if (nmax <= sparse->max_len)
+		return true;
+
+	char* nstrz = (char*)realloc(sparse->strz, nmax);
+	if (!nstrz) return false;
+	sparse->strz    = nstrz;
+	sparse->max_len = nmax;
+	return true;
+}
+
 bool ofc_sparse_append_strn(
 	ofc_sparse_t* sparse,
 	const char* src, unsigned len)
@@ -158,8 +390,12 @@ bool ofc_sparse_append_strn(
 	if (!src)
 		return false;
 
-	/* If strz has been called disallow further modifications. */
-	if (sparse->strz)
+	/* If the sparse is locked disallow further modifications. */
+	if (sparse->locked)
+		return false;
+
+	const char* base = ofc_sparse__base(sparse);
+	if (!base || (src < base))
 		return false;
 
 	if (sparse->count >= sparse->max_count)
@@ -174,80 +410,279 @@ bool ofc_sparse_append_strn(
 		sparse->max_count = ncount;
 	}
 
-	sparse->entry[sparse->count].ptr = src;
-	sparse->entry[sparse->count].len = len;
-	sparse->entry[sparse->count].off = sparse->len;
-	sparse->count++;
+	if ((sparse->len + len + 1) > sparse->max_len)
+	{
+		unsigned nmax = (sparse->max_len << 1);
+		if (nmax < (sparse->len + len + 1))
+			nmax = (sparse->len + len + 1);
+		if (nmax < 256) nmax = 256;
+
+		if (!ofc_sparse_reserve(sparse, (nmax - sparse->len - 1)))
+			return false;
+	}
+
+	memcpy(&sparse->strz[sparse->len], src, len);
+
+	/* Text which carries on from the end of the last entry in the parent
+	   extends that entry rather than starting a new one. */
+	unsigned poff = (src - base);
+	if ((sparse->count == 0)
+		|| (poff != (sparse->entry[sparse->count - 1].poff
+			+ (sparse->len - sparse->entry[sparse->count - 1].off))))
+	{
+		sparse->entry[sparse->count].off  = sparse->len;
+		sparse->entry[sparse->count].poff = poff;
+		sparse->count++;
+	}
 	sparse->len += len;
 
 	return true;
 }
 
-void ofc_sparse_lock(ofc_sparse_t* sparse)
+/* Finds the entry containing offset in O(1) using the run bitmap. */
+static unsigned ofc_sparse__index(
+	const ofc_sparse_t* sparse, unsigned off)
 {
-	if (!sparse || sparse->strz)
-		return;
-
-	sparse->strz = (char*)malloc(sparse->len + 1);
-	if (!sparse->strz) return;
+	if (off >= sparse->len)
+		return (sparse->count - 1);
 
-	unsigned i, j;
-	for (i = 0, j = 0; i < sparse->count; j += sparse->entry[i++].len)
-		memcpy(&sparse->strz[j], sparse->entry[i].ptr, sparse->entry[i].len);
-	sparse->strz[j] = '\0';
+	unsigned word = (off >> 6);
+	uint64_t mask = (~0ULL >> (63 - (off & 63)));
+	return sparse->rank[word]
+		+ __builtin_popcountll(sparse->run[word] & mask) - 1;
 }
 
-const char* ofc_sparse_strz(const ofc_sparse_t* sparse)
+/* Returns true if any entry starts in the range [first, last). */
+static bool ofc_sparse__run_start(
+	const ofc_sparse_t* sparse, unsigned first, unsigned last)
 {
-	return (sparse ? sparse->strz : NULL);
+	while (first < last)
+	{
+		unsigned word = (first >> 6);
+		unsigned bit  = (first & 63);
+		unsigned size = 64 - bit;
+		if (size > (last - first))
+			size = (last - first);
+
+		uint64_t mask = (size == 64 ? ~0ULL : (((1ULL << size) - 1) << bit));
+		if (sparse->run[word] & mask)
+			return true;
+
+		first += size;
+	}
+
+	return false;
 }
 
+/* Returns the file offset of off, which must have one, and sets run to
+   the number of characters from there which are contiguous in the file. */
+static unsigned ofc_sparse__file_run(
+	const ofc_sparse_t* sparse, unsigned off, unsigned* run)
+{
+	unsigned index = ofc_sparse__index(sparse, off);
+	unsigned start = sparse->entry[index].off;
+	unsigned end   = start + ofc_sparse__entry_len(sparse, index);
+	unsigned base  = (sparse->foff
+		? sparse->foff[index] : sparse->entry[index].poff);
 
-static bool ofc_sparse__ptr(
-	const ofc_sparse_t* sparse, const char* ptr,
-	ofc_sparse_entry_t* entry, unsigned* offset,
-	ofc_sparse_entry_t** prev)
+	if (sparse->fsplit_count > 0)
+	{
+		/* Find the first split after off. */
+		unsigned first = 0, last = sparse->fsplit_count;
+		while (first < last)
+		{
+			unsigned mid = first + ((last - first) / 2);
+			if (sparse->fsplit[mid].off <= off)
+				first = mid + 1;
+			else
+				last = mid;
+		}
+
+		if ((first > 0) && (sparse->fsplit[first - 1].off > start))
+		{
+			start = sparse->fsplit[first - 1].off;
+			base  = sparse->fsplit[first - 1].poff;
+		}
+		if ((first < sparse->fsplit_count)
+			&& (sparse->fsplit[first].off < end))
+			end = sparse->fsplit[first].off;
+	}
+
+	if (run) *run = (off < end ? (end - off) : 0);
+	return base + (off - start);
+}
+
+static bool ofc_sparse__file_offset(
+	const ofc_sparse_t* sparse, unsigned off, unsigned* foff)
 {
-	if (!sparse || !sparse->strz || !ptr)
+	if (sparse->foff)
+	{
+		*foff = (off < sparse->len ? ofc_sparse__file_run(
+			sparse, off, NULL) : sparse->fend);
+		return true;
+	}
+
+	/* A sparse with no file or parent, can't have a file pointer. */
+	if (sparse->parent || !sparse->file
+		|| (sparse->count == 0))
 		return false;
 
-	uintptr_t off = ((uintptr_t)ptr - (uintptr_t)sparse->strz);
-	if (off > sparse->len)
+	*foff = ofc_sparse__file_run(sparse, off, NULL);
+	return true;
+}
+
+static bool ofc_sparse__fsplit_add(
+	ofc_sparse_t* sparse, unsigned off, unsigned foff)
+{
+	if (sparse->fsplit_count >= sparse->fsplit_max)
+	{
+		unsigned nmax = (sparse->fsplit_max << 1);
+		if (nmax == 0) nmax = 16;
+
+		ofc_sparse_entry_t* nsplit = (ofc_sparse_entry_t*)realloc(
+			sparse->fsplit, (sizeof(ofc_sparse_entry_t) * nmax));
+		if (!nsplit) return false;
+		sparse->fsplit     = nsplit;
+		sparse->fsplit_max = nmax;
+	}
+
+	sparse->fsplit[sparse->fsplit_count].off  = off;
+	sparse->fsplit[sparse->fsplit_count].poff = foff;
+	sparse->fsplit_count++;
+	return true;
+}
+
+static bool ofc_sparse__build_index(ofc_sparse_t* sparse)
+{
+	unsigned words = (sparse->len >> 6) + 1;
+
+	sparse->run = (uint64_t*)calloc(words, sizeof(uint64_t));
+	sparse->rank = (unsigned*)malloc(words * sizeof(unsigned));
+	if (!sparse->run || !sparse->rank)
 		return false;
 
-	unsigned mid;
-	if (off == sparse->len)
+	unsigned i;
+	for (i = 0; i < sparse->count; i++)
 	{
-		/* Pointing at end of sparse. */
-		mid = (sparse->count - 1);
+		unsigned off = sparse->entry[i].off;
+		sparse->run[off >> 6] |= (1ULL << (off & 63));
 	}
-	else
+
+	sparse->rank[0] = 0;
+	for (i = 1; i < words; i++)
+	{
+		sparse->rank[i] = sparse->rank[i - 1]
+			+ __builtin_popcountll(sparse->run[i - 1]);
+	}
+
+	const ofc_sparse_t* parent = sparse->parent;
+	if (!parent || (sparse->count == 0)
+		|| (!parent->foff && (parent->parent
+			|| !parent->file || (parent->count == 0))))
+		return true;
+
+	/* Flatten the chain so file pointers don't depend on its depth,
+	   an entry only needs splitting where it spans runs of the parent
+	   which aren't contiguous in the file. */
+	sparse->foff = (unsigned*)malloc(
+		sparse->count * sizeof(unsigned));
+	if (!sparse->foff)
+		return false;
+
+	for (i = 0; i < sparse->count; i++)
 	{
-		unsigned hi  = (sparse->count - 1);
-		unsigned lo  = 0;
+		unsigned off  = sparse->entry[i].off;
+		unsigned poff = sparse->entry[i].poff;
+		unsigned len  = ofc_sparse__entry_len(sparse, i);
 
-		for (mid = lo + ((hi - lo) / 2); hi != lo; mid = lo + ((hi - lo) / 2))
+		unsigned run;
+		sparse->foff[i] = ofc_sparse__file_run(parent, poff, &run);
+		while (run < len)
 		{
-			unsigned start = sparse->entry[mid].off;
-			unsigned end   = start + sparse->entry[mid].len;
+			if (run == 0)
+				return false;
 
-			if (off < start)
-				hi = (mid - 1);
-			else if (off >= end)
-				lo = (mid + 1);
-			else
-				break;
+			off  += run;
+			poff += run;
+			len  -= run;
+
+			unsigned foff = ofc_sparse__file_run(parent, poff, &run);
+			if (!ofc_sparse__fsplit_add(sparse, off, foff))
+				return false;
 		}
 	}
 
-	off -= sparse->entry[mid].off;
+	unsigned last = (sparse->count - 1);
+	return ofc_sparse__file_offset(parent,
+		(sparse->entry[last].poff + ofc_sparse__entry_len(sparse, last)),
+		&sparse->fend);
+}
+
+void ofc_sparse_lock(ofc_sparse_t* sparse)
+{
+	if (!sparse || sparse->locked)
+		return;
+
+	if (!ofc_sparse__build_index(sparse))
+	{
+		free(sparse->fsplit);
+		free(sparse->foff);
+		free(sparse->rank);
+		free(sparse->run);
+		sparse->fsplit       = NULL;
+		sparse->fsplit_count = 0;
+		sparse->foff         = NULL;
+		sparse->rank         = NULL;
+		sparse->run          = NULL;
+		return;
+	}
 
-	if (prev  ) *prev   = ((off == 0) && (mid > 0) ? &sparse->entry[mid - 1] : NULL);
-	if (entry ) *entry  = sparse->entry[mid];
-	if (offset) *offset = off;
+	/* Shrink the buffer to fit, pointers into strz are only handed out
+	   once the sparse is locked. */
+	char* nstrz = (char*)realloc(sparse->strz, sparse->len + 1);
+	if (!nstrz) return;
+	sparse->strz    = nstrz;
+	sparse->max_len = sparse->len + 1;
+
+	sparse->strz[sparse->len] = '\0';
+	sparse->locked = true;
+
+	ofc_sparse__loc_add(sparse);
+}
+
+const char* ofc_sparse_strz(const ofc_sparse_t* sparse)
+{
+	return (sparse && sparse->locked ? sparse->strz : NULL);
+}
+
+
+static bool ofc_sparse__ptr(
+	const ofc_sparse_t* sparse, const char* ptr,
+	unsigned* index, unsigned* offset)
+{
+	if (!sparse || !sparse->locked || !ptr
+		|| (sparse->count == 0))
+		return false;
+
+	uintptr_t off = ((uintptr_t)ptr - (uintptr_t)sparse->strz);
+	if (off > sparse->len)
+		return false;
+
+	unsigned i = ofc_sparse__index(sparse, off);
+	if (index ) *index  = i;
+	if (offset) *offset = (off - sparse->entry[i].off);
 	return true;
 }
 
+/* Translates an offset within an entry into a pointer in the parent. */
+static const char* ofc_sparse__entry_ptr(
+	const ofc_sparse_t* sparse, unsigned index, unsigned offset)
+{
+	const char* base = ofc_sparse__base(sparse);
+	if (!base) return NULL;
+	return &base[sparse->entry[index].poff + offset];
+}
+
 static const ofc_file_t* ofc_sparse__file(
 	const ofc_sparse_t* sparse)
 {
@@ -265,7 +700,7 @@ static const ofc_file_t* ofc_sparse__file(
 bool ofc_sparse_label_add(
 	ofc_sparse_t* sparse, unsigned number)
 {
-	if (!sparse || sparse->strz)
+	if (!sparse || sparse->locked)
 		return false;
 	return ofc_label_table_add(
 		sparse->labels, sparse->len, number);
@@ -274,7 +709,7 @@ bool ofc_sparse_label_add(
 bool ofc_sparse_label_find(
 	const ofc_sparse_t* sparse, const char* ptr, unsigned* number)
 {
-	if (!sparse || !sparse->strz)
+	if (!sparse || !sparse->locked)
 		return false;
 
 	unsigned offset = ((uintptr_t)ptr - (uintptr_t)sparse->strz);
@@ -286,39 +721,42 @@ bool ofc_sparse_label_find(
 	if (!sparse->parent)
 		return false;
 
-	ofc_sparse_entry_t entry;
-	ofc_sparse_entry_t* prev = NULL;
-
+	unsigned index;
 	if (!ofc_sparse__ptr(sparse, ptr,
-		&entry, &offset, &prev))
+		&index, &offset))
 		return false;
 
 	/* If we're at an the start of an entry, ensure there's no label attached
 	   to the end of the previous entry. */
-	if (prev && ofc_sparse_label_find(
-		sparse->parent, &prev->ptr[prev->len], number))
+	if ((offset == 0) && (index > 0) && ofc_sparse_label_find(
+		sparse->parent, ofc_sparse__entry_ptr(sparse, (index - 1),
+			ofc_sparse__entry_len(sparse, (index - 1))), number))
 		return true;
 
 	return ofc_sparse_label_find(
-		sparse->parent, &entry.ptr[offset], number);
+		sparse->parent, ofc_sparse__entry_ptr(sparse, index, offset), number);
 }
 
 
 bool ofc_sparse_sequential(
 	const ofc_sparse_t* sparse, const char* ptr, unsigned size)
 {
-	if (!sparse || !ptr)
+	if (!sparse || !sparse->locked || !ptr
+		|| (sparse->count == 0))
 		return false;
 
-	ofc_sparse_entry_t entry;
-	unsigned offset;
+	uintptr_t off = ((uintptr_t)ptr - (uintptr_t)sparse->strz);
+	if (off > sparse->len)
+		return false;
 
-	if (!ofc_sparse__ptr(
-		sparse, ptr,
-		&entry, &offset, NULL))
-		return NULL;
+	if (size == 0)
+		return true;
+	if ((off + size) > sparse->len)
+		return false;
 
-	return ((offset + size) <= entry.len);
+	/* Sequential if no entry starts after the first character. */
+	return !ofc_sparse__run_start(
+		sparse, (off + 1), (off + size));
 }
 
 const char* ofc_sparse_parent_pointer(
@@ -327,15 +765,13 @@ const char* ofc_sparse_parent_pointer(
 	if (!sparse || !ptr)
 		return NULL;
 
-	ofc_sparse_entry_t entry;
-	unsigned offset;
-
+	unsigned index, offset;
 	if (!ofc_sparse__ptr(
 		sparse, ptr,
-		&entry, &offset, NULL))
+		&index, &offset))
 		return NULL;
 
-	return &entry.ptr[offset];
+	return ofc_sparse__entry_ptr(sparse, index, offset);
 }
 
 
@@ -379,48 +815,98 @@ bool ofc_sparse_ref_bridge(
 
 
 
-static const char* ofc_sparse__file_pointer(
-	const ofc_sparse_t* sparse, const char* ptr,
-	const char** sol)
+ofc_sparse_loc_t ofc_sparse_loc(
+	const ofc_sparse_t* sparse, const char* ptr, unsigned size)
 {
-	ofc_sparse_entry_t entry;
-	unsigned offset;
+	if (!sparse || (sparse->loc == 0) || !ptr)
+		return OFC_SPARSE_LOC_EMPTY;
 
-	if (!ofc_sparse__ptr(
-		sparse, ptr,
-		&entry, &offset, NULL))
-		return NULL;
+	uintptr_t off = ((uintptr_t)ptr - (uintptr_t)sparse->strz);
+	if ((off > sparse->len)
+		|| (size > (sparse->len - off)))
+		return OFC_SPARSE_LOC_EMPTY;
 
-	const char* pptr = &entry.ptr[offset];
+	return (ofc_sparse_loc_t)
+	{
+		.pos  = sparse->loc + off,
+		.size = size
+	};
+}
 
-	if (sparse->parent)
+ofc_sparse_ref_t ofc_sparse_loc_ref(ofc_sparse_loc_t loc)
+{
+	const ofc_sparse_t* sparse
+		= ofc_sparse__loc_find(loc.pos);
+	if (!sparse) return OFC_SPARSE_REF_EMPTY;
+
+	return ofc_sparse_ref(sparse,
+		&sparse->strz[loc.pos - sparse->loc], loc.size);
+}
+
+bool ofc_sparse_loc_bridge(
+	ofc_sparse_loc_t a, ofc_sparse_loc_t b,
+	ofc_sparse_loc_t* c)
+{
+	if (ofc_sparse_loc_empty(a))
 	{
-		return ofc_sparse__file_pointer(
-			sparse->parent, pptr, sol);
+		*c = (ofc_sparse_loc_t){ .pos = b.pos, .size = b.size };
+		return true;
 	}
 
-	/* A sparse with no file or parent, can't have a file pointer. */
-	if (!sparse->file)
+	if (!ofc_sparse_loc_empty(b))
+	{
+		if (ofc_sparse__loc_find(a.pos)
+			!= ofc_sparse__loc_find(b.pos))
+			return false;
+		a.size = (b.pos - a.pos) + b.size;
+	}
+
+	*c = a;
+	return true;
+}
+
+
+static const char* ofc_sparse__file_pointer(
+	const ofc_sparse_t* sparse, const char* ptr,
+	const char** sol)
+{
+	if (!sparse || !sparse->locked || !ptr)
+		return NULL;
+
+	uintptr_t off = ((uintptr_t)ptr - (uintptr_t)sparse->strz);
+	if (off > sparse->len)
+		return NULL;
+
+	unsigned foff;
+	if (!ofc_sparse__file_offset(sparse, off, &foff))
 		return NULL;
 
+	const ofc_file_t* file = ofc_sparse__file(sparse);
+	const char* fstrz = ofc_file_get_strz(file);
+	if (!fstrz) return NULL;
+
 	if (sol)
 	{
-		const char* s = sparse->strz;
-		const char* p;
-		for (p = sparse->strz; p < ptr; p++)
+		/* The start of line is in the root sparse, walk down to it. */
+		const ofc_sparse_t* root = sparse;
+		const char* rptr = ptr;
+		while (root->parent)
 		{
-			if (ofc_is_vspace(*p))
-				s = &p[1];
+			rptr = ofc_sparse_parent_pointer(root, rptr);
+			if (!rptr) return NULL;
+			root = root->parent;
 		}
 
-		ofc_sparse_entry_t sol_entry;
-		if (ofc_sparse__ptr(
-			sparse, s,
-			&sol_entry, &offset, NULL))
-			*sol = &sol_entry.ptr[offset];
+		const char* s;
+		for (s = rptr; (s > root->strz) && !ofc_is_vspace(s[-1]); s--);
+
+		unsigned sol_off;
+		if (ofc_sparse__file_offset(root,
+			((uintptr_t)s - (uintptr_t)root->strz), &sol_off))
+			*sol = &fstrz[sol_off];
 	}
 
-	return pptr;
+	return &fstrz[foff];
 }
 
 const char* ofc_sparse_file_pointer(
@@ -514,3 +1000,27 @@ void ofc_sparse_ref_warning(
 	ofc_sparse_warning_va(ref.sparse, ref.string, format, args);
 	va_end(args);
 }
+
+void ofc_sparse_loc_error(
+	ofc_sparse_loc_t loc,
+	const char* format, ...)
+{
+	ofc_sparse_ref_t ref = ofc_sparse_loc_ref(loc);
+
+	va_list args;
+	va_start(args, format);
+	ofc_sparse_error_va(ref.sparse, ref.string, format, args);
+	va_end(args);
+}
+
+void ofc_sparse_loc_warning(
+	ofc_sparse_loc_t loc,
+	const char* format, ...)
+{
+	ofc_sparse_ref_t ref = ofc_sparse_loc_ref(loc);
+
+	va_list args;
+	va_start(args, format);
+	ofc_sparse_warning_va(ref.sparse, ref.string, format, args);
+	va_end(args);
+}
@@ -25,28 +25,36 @@ bool ofc_str_ref_empty(const ofc_str_ref_t ref)
 	return (ref.size == 0);
 }
 
+ofc_atom_t ofc_str_ref_atom(const ofc_str_ref_t ref)
+{
+	if (ref.atom != OFC_ATOM_NONE)
+		return ref.atom;
+	return ofc_atom(ref.base, ref.size);
+}
+
+/* Hashes the case-folded bytes, so the same hash is valid for both
+   case sensitive and insensitive comparisons. This never interns. */
 uint8_t ofc_str_ref_hash(const ofc_str_ref_t ref)
 {
 	if (!ref.base)
 		return 0;
 
-	uint8_t hash;
+	uint32_t h = 2166136261U;
 	unsigned i;
-	for (i = 0, hash = 0; i < ref.size; i++)
-		hash += ref.base[i];
-	return hash;
+	for (i = 0; i < ref.size; i++)
+	{
+		h ^= (uint8_t)toupper((unsigned char)ref.base[i]);
+		h *= 16777619U;
+	}
+
+	h ^= (h >> 16);
+	h ^= (h >> 8);
+	return (uint8_t)h;
 }
 
 uint8_t ofc_str_ref_hash_ci(const ofc_str_ref_t ref)
 {
-	if (!ref.base)
-		return 0;
-
-	uint8_t hash;
-	unsigned i;
-	for (i = 0, hash = 0; i < ref.size; i++)
-		hash += toupper(ref.base[i]);
-	return hash;
+	return ofc_str_ref_hash(ref);
 }
 
 ofc_str_ref_t ofc_str_ref_bridge(
@@ -76,11 +84,20 @@ bool ofc_str_ref_equal(const ofc_str_ref_t a, const ofc_str_ref_t b)
 	if (a.base == b.base)
 		return true;
 
+	if ((a.atom != OFC_ATOM_NONE)
+		&& (b.atom != OFC_ATOM_NONE)
+		&& (a.atom != b.atom))
+		return false;
+
 	return (strncmp(a.base, b.base, a.size) == 0);
 }
 
 bool ofc_str_ref_equal_ci(const ofc_str_ref_t a, const ofc_str_ref_t b)
 {
+	if ((a.atom != OFC_ATOM_NONE)
+		&& (b.atom != OFC_ATOM_NONE))
+		return (a.atom == b.atom);
+
 	if (a.size != b.size)
 		return false;
 
@@ -31,6 +31,7 @@ ofc_string_t* ofc_string_create(const char* base, unsigned size)
 
 	string->base = (size == 0 ? NULL : (char*)malloc(size + 1));
 	string->size = (string->base ? size : 0);
+	string->borrowed = false;
 	if (string->base)
 	{
 		if (base)
@@ -47,8 +48,28 @@ ofc_string_t* ofc_string_create(const char* base, unsigned size)
 	return string;
 }
 
+ofc_string_t* ofc_string_create_ref(const char* base, unsigned size)
+{
+	ofc_string_t* string
+		= (ofc_string_t*)malloc(
+			sizeof(ofc_string_t));
+	if (!string)
+		return NULL;
+
+	string->base = (size == 0 ? NULL : (char*)base);
+	string->size = (string->base ? size : 0);
+	string->borrowed = true;
+	return string;
+}
+
 ofc_string_t* ofc_string_copy(const ofc_string_t* src)
 {
+	if (src->borrowed)
+	{
+		return ofc_string_create_ref(
+			src->base, src->size);
+	}
+
 	return ofc_string_create(
 		src->base, src->size);
 }
@@ -58,7 +79,8 @@ void ofc_string_delete(ofc_string_t* string)
 	if (!string)
 		return;
 
-	free(string->base);
+	if (!string->borrowed)
+		free(string->base);
 	free(string);
 }
 
@@ -71,7 +93,7 @@ bool ofc_string_empty(const ofc_string_t* string)
 
 const char* ofc_string_strz(const ofc_string_t* string)
 {
-	if (!string)
+	if (!string || string->borrowed)
 		return NULL;
 	return string->base;
 }